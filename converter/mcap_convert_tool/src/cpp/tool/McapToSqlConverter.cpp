@@ -47,8 +47,11 @@
 #include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollection.hpp>
 #include <ddsrecorder_participants/common/time_utils.hpp>
 #include <ddsrecorder_participants/constants.hpp>
+#include <ddsrecorder_participants/recorder/handler/sql/CdrKeyExtractor.hpp>
+#include <ddsrecorder_participants/recorder/handler/sql/KeyCache.hpp>
 #include <ddsrecorder_participants/recorder/handler/sql/SqlWriter.hpp>
 #include <ddsrecorder_participants/recorder/message/SqlMessage.hpp>
+#include <ddsrecorder_participants/recorder/message/TopicRegistry.hpp>
 #include <ddsrecorder_participants/recorder/output/FileTracker.hpp>
 #include <ddsrecorder_participants/recorder/output/OutputSettings.hpp>
 #include <ddsrecorder_participants/replayer/DynamicTypesSupport.hpp>
@@ -82,8 +85,9 @@ class McapReaderParticipantAccessor : public participants::McapReaderParticipant
 {
 public:
 
-    using participants::BaseReaderParticipant::create_payload_;
     using participants::McapReaderParticipant::close_file_;
+    using participants::McapReaderParticipant::create_message_payload_;
+    using participants::McapReaderParticipant::get_writer_guid_;
     using participants::McapReaderParticipant::open_file_;
     using participants::McapReaderParticipant::read_mcap_messages_;
 
@@ -128,16 +132,6 @@ public:
         return payload_pool_;
     }
 
-    const mcap::KeyValueMap& sequence_by_source_guid_index() const noexcept
-    {
-        return sequence_by_source_guid_index_;
-    }
-
-    const mcap::KeyValueMap& source_guid_by_sequence() const noexcept
-    {
-        return source_guid_by_sequence_;
-    }
-
     const std::map<std::pair<std::string, std::string>, ddspipe::core::types::DdsTopic>& topics() const noexcept
     {
         return topics_;
@@ -149,22 +143,7 @@ std::string get_writer_guid_string_(
         const McapReaderParticipantAccessor& reader,
         const mcap::MessageView& message)
 {
-    const auto sequence_str = std::to_string(message.message.sequence);
-    const auto source_guid_it = reader.source_guid_by_sequence().find(sequence_str);
-
-    if (source_guid_it == reader.source_guid_by_sequence().end())
-    {
-        return {};
-    }
-
-    const auto writer_guid_it = reader.sequence_by_source_guid_index().find(source_guid_it->second);
-
-    if (writer_guid_it == reader.sequence_by_source_guid_index().end())
-    {
-        return {};
-    }
-
-    return writer_guid_it->second;
+    return reader.get_writer_guid_(message.message.sequence);
 }
 
 ddspipe::core::types::Guid to_guid_(
@@ -355,10 +334,29 @@ void McapToSqlConverter::convert()
     const auto registered_dynamic_types = participants::detail::register_dynamic_types(dynamic_types_collection);
     const auto dynamic_types_by_name = participants::detail::build_dynamic_types(registered_dynamic_types);
 
+    // Extractors of the keys straight from the CDR payloads (only for the supported types)
+    std::map<std::string, participants::CdrKeyExtractor> key_extractors;
+
+    for (const auto& [type_name, dynamic_type] : dynamic_types_by_name)
+    {
+        if (participants::is_dependency_type_key(type_name))
+        {
+            continue;
+        }
+
+        participants::CdrKeyExtractor key_extractor(dynamic_type);
+
+        if (key_extractor.is_supported())
+        {
+            key_extractors.emplace(type_name, std::move(key_extractor));
+        }
+    }
+
     auto output_settings = create_output_settings_(output_file_);
     auto file_tracker = std::make_shared<participants::FileTracker>(output_settings);
     participants::SqlWriter sql_writer(output_settings, file_tracker, true, false, participants::DataFormat::both);
 
+    participants::TopicRegistry topic_registry;
     std::set<ddspipe::core::types::DdsTopic> written_topics;
     std::set<std::string> written_partitions;
     std::set<std::string> written_topic_partitions;
@@ -376,12 +374,13 @@ void McapToSqlConverter::convert()
         const auto hydrate_message_range = [
             &pending_messages,     // messages (ith)
             &pending_type_names,     // dynamic_types for the message (ith)
-            &dynamic_types_by_name     // lookup table from type_name to dynamic_type
+            &dynamic_types_by_name,     // lookup table from type_name to dynamic_type
+            &key_extractors     // lookup table from type_name to key extractor (read-only, shared by workers)
                 ](const std::size_t begin, const std::size_t end) // Indices (example 0-512)
                 {
                     // Each worker keeps its own caches to avoid sharing mutable
                     // DynamicData/key state across threads
-                    std::map<ddspipe::core::types::InstanceHandle, std::string> keys_by_instance_handle;
+                    participants::KeyCache keys_by_instance_handle;
                     std::map<std::string, DynamicSerializationContext> serialization_contexts;
 
                     // Create the serialization context for types. Reducing the construction in every message
@@ -403,9 +402,6 @@ void McapToSqlConverter::convert()
                     {
                         // SQL
                         auto& sql_message = pending_messages[i];
-                        // timestamps
-                        sql_message.log_time_sql = participants::to_sql_timestamp(sql_message.log_time);
-                        sql_message.publish_time_sql = participants::to_sql_timestamp(sql_message.publish_time);
 
                         if (pending_type_names[i].empty())
                         {
@@ -432,22 +428,30 @@ void McapToSqlConverter::convert()
 
                         deserialize_payload_to_json_(sql_message, serialization_context_it->second);
 
-                        const auto key_it = has_instance_handle ?
+                        const auto cached_key = has_instance_handle ?
                                 keys_by_instance_handle.find(sql_message.instance_handle) :
-                                keys_by_instance_handle.end();
+                                nullptr;
 
-                        if (has_instance_handle && key_it != keys_by_instance_handle.end())
+                        if (cached_key != nullptr)
                         {
-                            sql_message.key = key_it->second;
+                            sql_message.key = *cached_key;
                         }
                         else
                         {
-                            sql_message.set_key(dynamic_type_it->second);
-                            if (has_instance_handle)
+                            const auto key_extractor_it = key_extractors.find(pending_type_names[i]);
+
+                            if (key_extractor_it == key_extractors.end() ||
+                                    !key_extractor_it->second.extract(sql_message.payload, sql_message.key))
                             {
-                                keys_by_instance_handle[sql_message.instance_handle] = sql_message.key;
+                                sql_message.set_key(dynamic_type_it->second);
                             }
                         }
+
+                        if (has_instance_handle)
+                        {
+                            // Cache the key (or mark it as the most recently used one)
+                            keys_by_instance_handle.insert(sql_message.instance_handle, sql_message.key);
+                        }
                     }
                 };
 
@@ -551,10 +555,17 @@ void McapToSqlConverter::convert()
                 continue;
             }
 
-            auto data = reader.create_payload_(message.message.data, message.message.dataSize);
+            auto data = reader.create_message_payload_(message);
+
+            if (data == nullptr)
+            {
+                continue;
+            }
+
             data->source_guid = to_guid_(writer_guid_str);
 
-            participants::SqlMessage sql_message(*data, reader.payload_pool(), topic_it->second);
+            participants::SqlMessage sql_message(
+                *data, reader.payload_pool(), topic_registry.intern(topic_it->second));
             sql_message.writer_guid_string = writer_guid_str;
             sql_message.sequence_number = fastdds::rtps::SequenceNumber_t(
                 static_cast<uint64_t>(message.message.sequence));
@@ -564,11 +575,11 @@ void McapToSqlConverter::convert()
             sql_message.publish_time = fastdds::dds::Time_t(
                 static_cast<int32_t>(message.message.publishTime / 1000000000ULL),
                 static_cast<uint32_t>(message.message.publishTime % 1000000000ULL));
-            sql_message.partition = get_writer_partition_(sql_message.topic, writer_guid_str);
+            sql_message.partition = get_writer_partition_(*sql_message.topic, writer_guid_str);
 
             write_topic_metadata_(
                 sql_writer,
-                sql_message.topic,
+                *sql_message.topic,
                 sql_message.partition,
                 written_topics,
                 written_partitions,
@@ -579,8 +590,8 @@ void McapToSqlConverter::convert()
             {
                 EPROSIMA_LOG_WARNING(
                     DDSREPLAYER,
-                    "Type information for topic " << sql_message.topic.topic_name()
-                                                  << " with type " << sql_message.topic.type_name
+                    "Type information for topic " << sql_message.topic->topic_name()
+                                                  << " with type " << sql_message.topic->type_name
                                                   << " is not available. Storing only CDR payload.");
                 pending_type_names.emplace_back();
             }
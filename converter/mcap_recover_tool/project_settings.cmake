@@ -0,0 +1,65 @@
+# Copyright 2026 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+###############################################################################
+# Set settings for project mcap_recover_tool
+###############################################################################
+
+set(MODULE_NAME
+    mcap_recover_tool)
+
+set(MODULE_SUMMARY
+    "C++ application to recover the MCAP recordings of a DDS Recorder that was not closed.")
+
+set(MODULE_FIND_PACKAGES
+    fastcdr
+    fastdds
+    cpp_utils
+    ddspipe_core
+    ddsrecorder_participants)
+
+if(WIN32)
+    set(MODULE_FIND_PACKAGES
+        ${MODULE_FIND_PACKAGES}
+        lz4
+        zstd)
+endif()
+
+set(MODULE_DEPENDENCIES
+    fastcdr
+    fastdds
+    cpp_utils
+    ddspipe_core
+    ddsrecorder_participants
+    $<IF:$<BOOL:${WIN32}>,lz4::lz4,lz4>
+    $<IF:$<BOOL:${WIN32}>,$<IF:$<TARGET_EXISTS:zstd::libzstd_shared>,zstd::libzstd_shared,zstd::libzstd_static>,zstd>)
+
+set(MODULE_THIRDPARTY_HEADERONLY
+    mcap
+    optionparser)
+
+set(MODULE_THIRDPARTY_PATH
+    "../../thirdparty")
+
+set(MODULE_LICENSE_FILE_PATH
+    "../../LICENSE")
+
+set(MODULE_VERSION_FILE_PATH
+    "../../VERSION")
+
+set(MODULE_TARGET_NAME
+    "ddsrecorder-recover")
+
+set(MODULE_CPP_VERSION
+    C++17)
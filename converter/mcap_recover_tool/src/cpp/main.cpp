@@ -0,0 +1,102 @@
+// Copyright 2026 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <exception>
+#include <memory>
+
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/logging/BaseLogConfiguration.hpp>
+#include <cpp_utils/logging/StdLogConsumer.hpp>
+#include <cpp_utils/Log.hpp>
+#include <cpp_utils/utils.hpp>
+
+#include <ddsrecorder_participants/recorder/handler/mcap/McapRecovery.hpp>
+
+#include "user_interface/arguments_configuration.hpp"
+
+int main(
+        int argc,
+        char** argv)
+{
+    eprosima::ddsrecorder::recover::CommandlineArgsMcapRecover commandline_args;
+
+    const auto arg_parse_result =
+            eprosima::ddsrecorder::recover::parse_arguments(argc, argv, commandline_args);
+
+    if (arg_parse_result == eprosima::ddsrecorder::recover::ProcessReturnCode::help_argument ||
+            arg_parse_result == eprosima::ddsrecorder::recover::ProcessReturnCode::version_argument)
+    {
+        return static_cast<int>(eprosima::ddsrecorder::recover::ProcessReturnCode::success);
+    }
+    else if (arg_parse_result != eprosima::ddsrecorder::recover::ProcessReturnCode::success)
+    {
+        return static_cast<int>(arg_parse_result);
+    }
+
+    eprosima::utils::BaseLogConfiguration log_configuration;
+    log_configuration.verbosity = commandline_args.log_verbosity;
+    log_configuration.filter = commandline_args.log_filter;
+
+    eprosima::utils::Log::ClearConsumers();
+    eprosima::utils::Log::SetVerbosity(log_configuration.verbosity);
+    eprosima::utils::Log::RegisterConsumer(std::make_unique<eprosima::utils::StdLogConsumer>(&log_configuration));
+
+    logUser(DDSRECORDER_EXECUTION, "Starting DDS Recorder Recover execution.");
+
+    int return_code = static_cast<int>(eprosima::ddsrecorder::recover::ProcessReturnCode::success);
+
+    try
+    {
+        eprosima::ddsrecorder::participants::McapRecovery recovery(commandline_args.input_file);
+
+        const auto recovery_start = std::chrono::steady_clock::now();
+        const auto result = recovery.recover(commandline_args.output_file);
+        const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - recovery_start);
+
+        if (result.complete)
+        {
+            logUser(DDSRECORDER_EXECUTION,
+                    commandline_args.input_file << " was closed correctly. There is nothing to recover.");
+        }
+        else
+        {
+            logUser(DDSRECORDER_EXECUTION,
+                    "Recovered " << result.message_count << " messages in " << result.chunk_count << " chunks (" <<
+                    eprosima::utils::from_bytes(result.data_size) << ") in " << elapsed_ms.count() << " ms. " <<
+                    result.decompressed_chunk_count << " chunks were decompressed, and " <<
+                    eprosima::utils::from_bytes(result.dropped_size) << " of incomplete data were dropped.");
+        }
+
+        logUser(DDSRECORDER_EXECUTION, "Finishing DDS Recorder Recover execution correctly.");
+    }
+    catch (const eprosima::utils::InitializationException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_ERROR,
+                "Error recovering the MCAP file. Error message:\n " << e.what());
+        return_code = static_cast<int>(eprosima::ddsrecorder::recover::ProcessReturnCode::execution_failed);
+    }
+    catch (const std::exception& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_ERROR,
+                "Unexpected error running DDS Recorder Recover. Error message:\n " << e.what());
+        return_code = static_cast<int>(eprosima::ddsrecorder::recover::ProcessReturnCode::execution_failed);
+    }
+
+    eprosima::utils::Log::Flush();
+    eprosima::utils::Log::ClearConsumers();
+
+    return return_code;
+}
@@ -0,0 +1,64 @@
+// Copyright 2026 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include <ddspipe_core/configuration/CommandlineArgs.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace recover {
+
+struct CommandlineArgsMcapRecover : public ddspipe::core::CommandlineArgs
+{
+    // MCAP file to recover
+    std::string input_file{""};
+
+    // File to write the recovered MCAP to (empty to recover the input file in place)
+    std::string output_file{""};
+
+    CommandlineArgsMcapRecover()
+    {
+        log_filter[utils::VerbosityKind::Info].set_value("DDSRECORDER", utils::FuzzyLevelValues::fuzzy_level_default);
+        log_filter[utils::VerbosityKind::Warning].set_value("DDSRECORDER",
+                utils::FuzzyLevelValues::fuzzy_level_default);
+        log_filter[utils::VerbosityKind::Error].set_value("", utils::FuzzyLevelValues::fuzzy_level_default);
+    }
+
+    bool is_valid(
+            utils::Formatter& error_msg) const noexcept override
+    {
+        if (input_file.empty())
+        {
+            error_msg << "Option '-i' / '--input-file' is required.";
+            return false;
+        }
+
+        if (output_file == input_file)
+        {
+            error_msg << "Option '-o' / '--output-file' must differ from the input file (omit it to recover the "
+                      << "input file in place).";
+            return false;
+        }
+
+        return ddspipe::core::CommandlineArgs::is_valid(error_msg);
+    }
+
+};
+
+} /* namespace recover */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,93 @@
+// Copyright 2026 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include "user_interface/arguments_configuration.hpp"
+
+namespace {
+
+std::vector<char*> argv_from_(
+        std::vector<std::string>& args)
+{
+    std::vector<char*> argv;
+    argv.reserve(args.size());
+
+    for (auto& arg : args)
+    {
+        argv.push_back(arg.data());
+    }
+
+    return argv;
+}
+
+eprosima::ddsrecorder::recover::ProcessReturnCode parse_(
+        std::vector<std::string> args)
+{
+    auto argv = argv_from_(args);
+    eprosima::ddsrecorder::recover::CommandlineArgsMcapRecover commandline_args;
+
+    return eprosima::ddsrecorder::recover::parse_arguments(
+        static_cast<int>(argv.size()),
+        argv.data(),
+        commandline_args);
+}
+
+} // namespace
+
+TEST(McapRecoverTest, help_argument)
+{
+    ASSERT_EQ(parse_({"ddsrecorder-recover", "--help"}),
+            eprosima::ddsrecorder::recover::ProcessReturnCode::help_argument);
+}
+
+TEST(McapRecoverTest, version_argument)
+{
+    ASSERT_EQ(parse_({"ddsrecorder-recover", "--version"}),
+            eprosima::ddsrecorder::recover::ProcessReturnCode::version_argument);
+}
+
+TEST(McapRecoverTest, missing_input)
+{
+    ASSERT_EQ(parse_({"ddsrecorder-recover", "-o", "recovered.mcap"}),
+            eprosima::ddsrecorder::recover::ProcessReturnCode::incorrect_argument);
+}
+
+TEST(McapRecoverTest, same_output_is_invalid)
+{
+    const auto input_file = std::filesystem::temp_directory_path() / "mcap_recover_tool_test.mcap";
+    std::ofstream(input_file).put('\0');
+
+    ASSERT_EQ(parse_({"ddsrecorder-recover", "-i", input_file.string(), "-o", input_file.string()}),
+            eprosima::ddsrecorder::recover::ProcessReturnCode::incorrect_argument);
+
+    ASSERT_EQ(parse_({"ddsrecorder-recover", "-i", input_file.string()}),
+            eprosima::ddsrecorder::recover::ProcessReturnCode::success);
+
+    std::filesystem::remove(input_file);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
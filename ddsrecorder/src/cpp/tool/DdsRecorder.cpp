@@ -24,6 +24,7 @@
 
 #include <ddsrecorder_participants/recorder/handler/BaseHandler.hpp>
 #include <ddsrecorder_participants/recorder/handler/HandlerContext.hpp>
+#include <ddsrecorder_participants/recorder/handler/HandlerFanOut.hpp>
 #include <ddsrecorder_participants/recorder/handler/mcap/McapHandler.hpp>
 #include <ddsrecorder_participants/recorder/handler/mcap/McapHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/handler/sql/SqlHandler.hpp>
@@ -186,8 +187,25 @@ DdsRecorder::DdsRecorder(
     apply_content_filters_(configuration_.dds_configuration->content_topic_filter_dict, {}, dyn_participant_);
     applied_content_filters_ = configuration_.dds_configuration->content_topic_filter_dict;
 
+    // When recording both MCAP and SQL, a single participant receives every sample and hands it to both handlers
+    std::shared_ptr<participants::HandlerFanOut> handler_fan_out;
+
+    if (configuration_.mcap_enabled && configuration_.sql_enabled)
+    {
+        handler_fan_out = std::make_shared<participants::HandlerFanOut>();
+    }
+
     if (configuration_.mcap_enabled)
     {
+        // Split the MCAP size budget between the main MCAP files and the topic groups
+        std::vector<participants::McapTopicGroup> topic_groups = configuration_.mcap_topic_groups;
+
+        if (!load_topic_groups_resource_limits(mcap_output_settings, topic_groups, error_msg))
+        {
+            EPROSIMA_LOG_ERROR(DDSRECORDER, "Error loading the resource limits of the topic groups: " << error_msg);
+            throw InitializationException("Error loading the resource limits of the topic groups, not enough space");
+        }
+
         // Create MCAP Handler configuration
         participants::McapHandlerConfiguration handler_config(
             mcap_output_settings,
@@ -201,6 +219,31 @@ DdsRecorder::DdsRecorder(
             configuration_.record_types,
             configuration_.ros2_types);
 
+        handler_config.max_buffer_memory = configuration_.max_buffer_memory;
+        handler_config.async_write = configuration_.async_write;
+        handler_config.async_write_queue_size = configuration_.async_write_queue_size;
+        handler_config.adaptive_compression = configuration_.mcap_adaptive_compression;
+        handler_config.prepare_next_file = configuration_.mcap_prepare_next_file;
+        handler_config.io_backend = configuration_.mcap_io_backend;
+        handler_config.checkpoint_period = configuration_.mcap_checkpoint_period;
+
+        handler_config.topic_groups = std::move(topic_groups);
+
+        if (configuration_.mcap_dictionary_enabled)
+        {
+            handler_config.dictionary_samples = configuration_.mcap_dictionary_samples;
+            handler_config.dictionary_max_size = configuration_.mcap_dictionary_max_size;
+        }
+
+        if (configuration_.event_window_spill_enabled)
+        {
+            handler_config.event_window_spill_file =
+                    (std::filesystem::path(configuration_.event_window_spill_path) /
+                    "mcap_event_window.spill").string();
+            handler_config.event_window_spill_size = configuration_.event_window_spill_size;
+            handler_config.event_window_spill_threshold = configuration_.event_window_spill_memory_threshold;
+        }
+
         auto mcap_handler_context = HandlerContext::create_context(
             HandlerContext::HandlerKind::MCAP,
             &handler_config,
@@ -209,7 +252,8 @@ DdsRecorder::DdsRecorder(
             participants_database_,
             discovery_database_,
             handler_state,
-            on_disk_full_lambda);
+            on_disk_full_lambda,
+            handler_fan_out);
 
         handler_contexts_.init_handler_context(mcap_handler_context);
     }
@@ -228,6 +272,21 @@ DdsRecorder::DdsRecorder(
             configuration_.ros2_types,
             configuration_.sql_data_format);
 
+        handler_config.max_key_cache_entries = configuration_.sql_key_cache_max_entries;
+        handler_config.max_key_cache_memory = configuration_.sql_key_cache_max_memory;
+        handler_config.max_buffer_memory = configuration_.max_buffer_memory;
+        handler_config.async_write = configuration_.async_write;
+        handler_config.async_write_queue_size = configuration_.async_write_queue_size;
+
+        if (configuration_.event_window_spill_enabled)
+        {
+            handler_config.event_window_spill_file =
+                    (std::filesystem::path(configuration_.event_window_spill_path) /
+                    "sql_event_window.spill").string();
+            handler_config.event_window_spill_size = configuration_.event_window_spill_size;
+            handler_config.event_window_spill_threshold = configuration_.event_window_spill_memory_threshold;
+        }
+
         // Create SQL Handler context
         auto sql_handler_context = HandlerContext::create_context(
             HandlerContext::HandlerKind::SQL,
@@ -237,7 +296,8 @@ DdsRecorder::DdsRecorder(
             participants_database_,
             discovery_database_,
             handler_state,
-            on_disk_full_lambda);
+            on_disk_full_lambda,
+            handler_fan_out);
 
         handler_contexts_.init_handler_context(sql_handler_context);
     }
@@ -552,6 +612,78 @@ bool DdsRecorder::load_resource_limits(
     return true;
 }
 
+bool DdsRecorder::load_topic_groups_resource_limits(
+        participants::OutputSettings& mcap_output_settings,
+        std::vector<participants::McapTopicGroup>& topic_groups,
+        utils::Formatter& error_msg)
+{
+    if (topic_groups.empty())
+    {
+        return true;
+    }
+
+    auto& mcap_resource_limits = mcap_output_settings.resource_limits;
+
+    // The groups with a max size take it from the MCAP budget
+    std::uint64_t space_available = mcap_resource_limits.max_size_;
+    std::uint64_t outputs_sharing_space = 1;
+
+    for (const auto& topic_group : topic_groups)
+    {
+        const auto max_size = topic_group.resource_limits.max_size_;
+
+        if (max_size == 0)
+        {
+            outputs_sharing_space++;
+        }
+        else if (max_size > space_available)
+        {
+            error_msg << "The max size of topic group " << topic_group.name << " (" << utils::from_bytes(max_size)
+                      << ") exceeds the MCAP space left (" << utils::from_bytes(space_available) << ").";
+            return false;
+        }
+        else
+        {
+            space_available -= max_size;
+        }
+    }
+
+    // The main MCAP files and the groups without a max size share the remaining space evenly
+    const std::uint64_t shared_max_size = space_available / outputs_sharing_space;
+
+    if (outputs_sharing_space > 1 && shared_max_size == 0)
+    {
+        error_msg << "There is no MCAP space left for the topic groups without a max size.";
+        return false;
+    }
+
+    const auto& share_space = [&](participants::ResourceLimitsStruct& resource_limits)
+            {
+                resource_limits.max_size_ = shared_max_size;
+
+                if (resource_limits.max_file_size_ == 0 || resource_limits.max_file_size_ > shared_max_size)
+                {
+                    resource_limits.max_file_size_ = shared_max_size;
+                }
+            };
+
+    share_space(mcap_resource_limits);
+
+    for (auto& topic_group : topic_groups)
+    {
+        if (topic_group.resource_limits.max_size_ == 0)
+        {
+            share_space(topic_group.resource_limits);
+        }
+        else if (topic_group.resource_limits.max_file_size_ == 0)
+        {
+            topic_group.resource_limits.max_file_size_ = topic_group.resource_limits.max_size_;
+        }
+    }
+
+    return true;
+}
+
 } /* namespace recorder */
 } /* namespace ddsrecorder */
 } /* namespace eprosima */
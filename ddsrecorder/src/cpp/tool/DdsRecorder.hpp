@@ -17,6 +17,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include <cpp_utils/event/MultipleEventHandler.hpp>
 #include <cpp_utils/ReturnCode.hpp>
@@ -37,6 +38,7 @@
 #include <ddsrecorder_participants/recorder/handler/HandlerContextCollection.hpp>
 #include <ddsrecorder_participants/recorder/monitoring/DdsRecorderMonitor.hpp>
 #include <ddsrecorder_participants/recorder/handler/BaseHandler.hpp>
+#include <ddsrecorder_participants/recorder/handler/mcap/McapHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/output/FileTracker.hpp>
 
 #include <ddsrecorder_yaml/recorder/YamlReaderConfiguration.hpp>
@@ -164,6 +166,23 @@ protected:
             participants::OutputSettings& sql_output_settings,
             utils::Formatter& error_msg);
 
+    /**
+     * @brief Split the MCAP size budget between the main MCAP files and the files of the topic groups.
+     *
+     * The MCAP max size bounds the size of every MCAP file: the topic groups with a max size take it from the MCAP
+     * budget, and the main MCAP files share the remaining space evenly with the topic groups without a max size.
+     *
+     * @param mcap_output_settings: Reference to the output settings for the MCAP recorder (with its limits loaded).
+     * @param topic_groups: Reference to the topic groups whose resource limits are loaded.
+     * @param error_msg: Reference to the error message to be filled in case of error.
+     *
+     * @return Error flag if the max sizes of the topic groups exceed the MCAP max size.
+     */
+    bool load_topic_groups_resource_limits(
+            participants::OutputSettings& mcap_output_settings,
+            std::vector<participants::McapTopicGroup>& topic_groups,
+            utils::Formatter& error_msg);
+
     //! Configuration of the DDS Recorder
     yaml::RecorderConfiguration configuration_;
 
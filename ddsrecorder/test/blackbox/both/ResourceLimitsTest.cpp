@@ -12,13 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cstdint>
 #include <filesystem>
 
+#include <mcap/internal.hpp>
+#include <mcap/reader.hpp>
+
 #include <cpp_utils/testing/gtest_aux.hpp>
 #include <gtest/gtest.h>
 
-
 #include <fastdds/dds/domain/DomainParticipant.hpp>
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
@@ -478,6 +481,164 @@ protected:
         }
     }
 
+    void test_compressed_max_file_size(
+            const mcap::Compression compression,
+            const std::uint32_t compression_threads)
+    {
+        // Chunks much smaller than the files, so the files are filled chunk by chunk
+        constexpr std::uint32_t MAX_FILE_SIZE = 16 * 1024;
+        constexpr std::uint32_t CHUNK_SIZE = 2 * 1024;
+        constexpr std::uint32_t NUMBER_OF_FILES = 10;
+
+        const std::string OUTPUT_FILE_NAME = std::string("compressed_max_file_size_test_") +
+                mcap::internal::CompressionString(compression) + "_" + std::to_string(compression_threads);
+        const auto OUTPUT_FILE_PATHS = get_output_file_paths_(NUMBER_OF_FILES, OUTPUT_FILE_NAME, test::FileTypes::MCAP);
+
+        reset_configuration_(test::FileTypes::MCAP, OUTPUT_FILE_NAME, NUMBER_OF_FILES * MAX_FILE_SIZE, MAX_FILE_SIZE);
+        configuration_->mcap_writer_options.compression = compression;
+        configuration_->mcap_writer_options.chunkSize = CHUNK_SIZE;
+        configuration_->mcap_writer_options.compressionThreads = compression_threads;
+
+        // Delete the output files if they exist
+        for (const auto& path : OUTPUT_FILE_PATHS)
+        {
+            ASSERT_TRUE(delete_file_(path));
+        }
+
+        {
+            ddsrecorder::recorder::DdsRecorder recorder(*configuration_,
+                    ddsrecorder::recorder::DdsRecorderStateCode::RUNNING,
+                    OUTPUT_FILE_NAME);
+
+            // Send the messages that fill a few uncompressed files, so the compressed ones are rotated a few times
+            publish_msgs_(8 * MAX_FILE_SIZE / limits_->BYTES_MESSAGE);
+
+            // Make sure the DDS Recorder has received all the messages
+            ASSERT_EQ(writer_->wait_for_acknowledgments(test::MAX_WAITING_TIME), RETCODE_OK);
+
+            // All the messages have been sent. Stop the DDS Recorder.
+            recorder.stop();
+        }
+
+        std::uint32_t number_of_files = 0;
+
+        while (number_of_files < NUMBER_OF_FILES && std::filesystem::exists(OUTPUT_FILE_PATHS[number_of_files]))
+        {
+            number_of_files++;
+        }
+
+        ASSERT_GT(number_of_files, 1u);
+
+        for (std::uint32_t i = 0; i < number_of_files; i++)
+        {
+            const auto file_size = std::filesystem::file_size(OUTPUT_FILE_PATHS[i]);
+
+            ASSERT_LE(file_size, MAX_FILE_SIZE);
+
+            if (i + 1 == number_of_files)
+            {
+                // The last file was closed before it was full
+                continue;
+            }
+
+            // A rotated file is full: it only lacks the chunk that did not fit, and the space reserved for what is
+            // written when closing it (its attachments, metadata and summary) that it did not use up
+            mcap::McapReader reader;
+            ASSERT_TRUE(reader.open(OUTPUT_FILE_PATHS[i].string()).ok());
+            ASSERT_TRUE(reader.readSummary(mcap::ReadSummaryMethod::NoFallbackScan).ok());
+
+            std::uint64_t data_end = 0;
+
+            for (const auto& chunk_index : reader.chunkIndexes())
+            {
+                const auto chunk_end = chunk_index.chunkStartOffset + chunk_index.chunkLength;
+                data_end = std::max(data_end, chunk_end + chunk_index.messageIndexLength);
+            }
+
+            reader.close();
+
+            ASSERT_GT(data_end, 0u);
+
+            const auto closing_size = file_size - data_end;
+
+            ASSERT_GE(file_size + CHUNK_SIZE + closing_size, MAX_FILE_SIZE)
+                << "File " << OUTPUT_FILE_PATHS[i] << " was rotated at " << file_size << " bytes, with "
+                << closing_size << " bytes written when closing it";
+        }
+    }
+
+    void test_prepare_next_file()
+    {
+        constexpr std::uint32_t NUMBER_OF_BATCHES = 8;
+        const std::string OUTPUT_FILE_NAME = "prepare_next_file_test_mcap";
+
+        reset_configuration_(test::FileTypes::MCAP, OUTPUT_FILE_NAME, limits_->MAX_SIZE, limits_->MAX_FILE_SIZE, true);
+        configuration_->mcap_prepare_next_file = 80;
+
+        const auto find_output_files = [&]()
+                {
+                    std::vector<std::filesystem::path> output_files;
+
+                    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::current_path()))
+                    {
+                        if (entry.path().filename().string().rfind(OUTPUT_FILE_NAME + "_", 0) == 0)
+                        {
+                            output_files.push_back(entry.path());
+                        }
+                    }
+
+                    return output_files;
+                };
+
+        // Delete the output files if they exist
+        for (const auto& path : find_output_files())
+        {
+            ASSERT_TRUE(delete_file_(path));
+        }
+
+        {
+            ddsrecorder::recorder::DdsRecorder recorder(*configuration_,
+                    ddsrecorder::recorder::DdsRecorderStateCode::RUNNING,
+                    OUTPUT_FILE_NAME);
+
+            // Fill more files than fit in the max-size, so the files prepared in the background are rotated
+            for (std::uint32_t i = 0; i < NUMBER_OF_BATCHES; i++)
+            {
+                fill_file({}, i);
+            }
+
+            // All the messages have been sent. Stop the DDS Recorder.
+            recorder.stop();
+        }
+
+        const auto output_files = find_output_files();
+        paths_.insert(paths_.end(), output_files.begin(), output_files.end());
+
+        ASSERT_GT(output_files.size(), 1u);
+
+        std::uint64_t total_size = 0;
+
+        for (const auto& path : output_files)
+        {
+            // Every file has been renamed to its final name (and the next file prepared when stopping removed)
+            ASSERT_EQ(path.extension(), ".mcap") << "File " << path << " has not been renamed";
+
+            // Every file is complete
+            mcap::McapReader reader;
+            ASSERT_TRUE(reader.open(path.string()).ok());
+            ASSERT_TRUE(reader.readSummary(mcap::ReadSummaryMethod::NoFallbackScan).ok()) << "File " << path;
+            ASSERT_TRUE(reader.footer().has_value());
+            reader.close();
+
+            const auto file_size = std::filesystem::file_size(path);
+            ASSERT_LE(file_size, limits_->MAX_FILE_SIZE);
+
+            total_size += file_size;
+        }
+
+        ASSERT_LE(total_size, limits_->MAX_SIZE);
+    }
+
     DomainParticipant* participant_ = nullptr;
     Publisher* publisher_ = nullptr;
     Topic* topic_ = nullptr;
@@ -565,6 +726,50 @@ TEST_F(ResourceLimitsTest, sql_log_rotation)
     test_log_rotation(test::FileTypes::SQL);
 }
 
+/**
+ * @brief Test that the DDS Recorder fills compressed MCAP files up to the max-file-size.
+ *
+ * The size of a compressed chunk is only known once it is written, so the DDS Recorder syncs the size of the file
+ * with the bytes actually written (and estimates the chunks not written yet).
+ *
+ * CASES:
+ * - check that no file exceeds the max-file-size.
+ * - check that every rotated file is short of the max-file-size by at most a chunk and what is written when closing it.
+ * - check it with the chunks compressed inline and in compression threads.
+ */
+TEST_F(ResourceLimitsTest, mcap_compressed_max_file_size)
+{
+    limits_ = &mcap_limits_;
+    test_compressed_max_file_size(mcap::Compression::Zstd, 0);
+}
+TEST_F(ResourceLimitsTest, mcap_compressed_max_file_size_threads)
+{
+    limits_ = &mcap_limits_;
+    test_compressed_max_file_size(mcap::Compression::Zstd, 2);
+}
+TEST_F(ResourceLimitsTest, mcap_compressed_max_file_size_lz4_threads)
+{
+    limits_ = &mcap_limits_;
+    test_compressed_max_file_size(mcap::Compression::Lz4, 2);
+}
+
+/**
+ * @brief Test that the DDS Recorder rotates the MCAP files it prepares in the background.
+ *
+ * With prepare-next-file, the next file is opened in the background before the current one is full, and the full
+ * file is closed and renamed in the background while the next one is written.
+ *
+ * CASES:
+ * - check that every file has been renamed out of its temporary name.
+ * - check that every file is a valid MCAP file with a summary.
+ * - check that the aggregate size of the files doesn't exceed the max-size.
+ */
+TEST_F(ResourceLimitsTest, mcap_prepare_next_file)
+{
+    limits_ = &mcap_limits_;
+    test_prepare_next_file();
+}
+
 int main(
         int argc,
         char** argv)
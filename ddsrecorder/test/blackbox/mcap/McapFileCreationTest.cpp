@@ -36,6 +36,7 @@
 #include <ddspipe_core/types/dds/TopicQoS.hpp>
 
 #include <ddsrecorder_participants/common/time_utils.hpp>
+#include <ddsrecorder_participants/recorder/handler/mcap/McapHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/output/OutputSettings.hpp>
 #include <ddsrecorder_yaml/recorder/yaml_configuration_tags.hpp>
 
@@ -301,6 +302,47 @@ TEST_F(McapFileCreationTest, mcap_data_num_msgs_downsampling)
     ASSERT_EQ(read_messages_count, expected_messages);
 }
 
+/**
+ * Verify that the DDS Recorder records the topics of a topic group in the group's own MCAP file.
+ *
+ * CASES:
+ *  - Verify that the messages of the topic are recorded in the file of the group.
+ *  - Verify that the main file has the schemas but no messages.
+ */
+TEST_F(McapFileCreationTest, mcap_topic_group)
+{
+    const std::string OUTPUT_FILE_NAME = "mcap_topic_group";
+    const auto OUTPUT_FILE_PATH = get_output_file_path_(OUTPUT_FILE_NAME + ".mcap");
+    const auto GROUP_OUTPUT_FILE_PATH = get_output_file_path_(OUTPUT_FILE_NAME + "_group.mcap");
+
+    constexpr auto NUMBER_OF_MESSAGES = 10;
+
+    ASSERT_TRUE(delete_file_(OUTPUT_FILE_PATH));
+    ASSERT_TRUE(delete_file_(GROUP_OUTPUT_FILE_PATH));
+
+    ddsrecorder::participants::McapTopicGroup topic_group;
+    topic_group.name = "group";
+    topic_group.topics = test::TOPIC_NAME;
+    configuration_->mcap_topic_groups.push_back(topic_group);
+
+    // Record messages
+    record_messages_(OUTPUT_FILE_NAME, NUMBER_OF_MESSAGES);
+
+    // Read the messages recorded in the file of the group
+    auto read_messages = read_messages_(GROUP_OUTPUT_FILE_PATH);
+    ASSERT_EQ(count_messages_(read_messages), NUMBER_OF_MESSAGES);
+
+    // Read the messages recorded in the main file
+    mcap::McapReader main_reader;
+    ASSERT_TRUE(main_reader.open(OUTPUT_FILE_PATH).ok());
+    ASSERT_TRUE(main_reader.readSummary(mcap::ReadSummaryMethod::NoFallbackScan).ok());
+
+    ASSERT_FALSE(main_reader.schemas().empty());
+    ASSERT_EQ(main_reader.statistics()->messageCount, 0u);
+
+    main_reader.close();
+}
+
 // //////////////////////
 // // With transitions //
 // //////////////////////
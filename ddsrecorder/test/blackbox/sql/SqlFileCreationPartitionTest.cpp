@@ -1179,7 +1179,7 @@ TEST_F(SqlFileCreationPartitionTest, transition_paused_event_less_window_partiti
     exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT MIN(log_time) FROM Messages;", {}, [&](sqlite3_stmt* stmt)
             {
                 // Verify the oldest recorded message was recorded in the event window
-                const auto log_time = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const auto log_time = static_cast<mcap::Timestamp>(sqlite3_column_int64(stmt, 0));
                 const auto log_time_ts = ddsrecorder::participants::to_std_timestamp(log_time);
                 const auto log_time_tks = ddsrecorder::participants::to_ticks(log_time_ts);
 
@@ -1243,7 +1243,7 @@ TEST_F(SqlFileCreationPartitionTest, transition_paused_event_max_window_partitio
     exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT MIN(log_time) FROM Messages;", {}, [&](sqlite3_stmt* stmt)
             {
                 // Verify the oldest recorded message was recorded in the event window
-                const auto log_time = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const auto log_time = static_cast<mcap::Timestamp>(sqlite3_column_int64(stmt, 0));
                 const auto log_time_ts = ddsrecorder::participants::to_std_timestamp(log_time);
                 const auto log_time_tks = ddsrecorder::participants::to_ticks(log_time_ts);
 
@@ -1310,7 +1310,7 @@ TEST_F(SqlFileCreationPartitionTest, transition_paused_event_start_partition)
     exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT MIN(log_time) FROM Messages;", {}, [&](sqlite3_stmt* stmt)
             {
                 // Verify the oldest recorded message was recorded in the event window
-                const auto log_time = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const auto log_time = static_cast<mcap::Timestamp>(sqlite3_column_int64(stmt, 0));
                 const auto log_time_ts = ddsrecorder::participants::to_std_timestamp(log_time);
                 const auto log_time_tks = ddsrecorder::participants::to_ticks(log_time_ts);
 
@@ -1373,7 +1373,7 @@ TEST_F(SqlFileCreationPartitionTest, transition_paused_event_suspend_partition)
     exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT MIN(log_time) FROM Messages;", {}, [&](sqlite3_stmt* stmt)
             {
                 // Verify the oldest recorded message was recorded in the event window
-                const auto log_time = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const auto log_time = static_cast<mcap::Timestamp>(sqlite3_column_int64(stmt, 0));
                 const auto log_time_ts = ddsrecorder::participants::to_std_timestamp(log_time);
                 const auto log_time_tks = ddsrecorder::participants::to_ticks(log_time_ts);
 
@@ -1436,7 +1436,7 @@ TEST_F(SqlFileCreationPartitionTest, transition_paused_event_stop_partition)
     exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT MIN(log_time) FROM Messages;", {}, [&](sqlite3_stmt* stmt)
             {
                 // Verify the oldest recorded message was recorded in the event window
-                const auto log_time = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const auto log_time = static_cast<mcap::Timestamp>(sqlite3_column_int64(stmt, 0));
                 const auto log_time_ts = ddsrecorder::participants::to_std_timestamp(log_time);
                 const auto log_time_tks = ddsrecorder::participants::to_ticks(log_time_ts);
 
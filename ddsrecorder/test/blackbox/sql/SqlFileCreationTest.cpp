@@ -17,8 +17,10 @@
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <sqlite/sqlite3.h>
@@ -30,10 +32,14 @@
 #include <cpp_utils/Formatter.hpp>
 #include <cpp_utils/ros2_mangling.hpp>
 
+#include <ddspipe_core/efficiency/payload/FastPayloadPool.hpp>
 #include <ddspipe_core/types/dds/TopicQoS.hpp>
 
 #include <ddsrecorder_participants/common/time_utils.hpp>
+#include <ddsrecorder_participants/constants.hpp>
 #include <ddsrecorder_participants/recorder/output/OutputSettings.hpp>
+#include <ddsrecorder_participants/replayer/BaseReaderParticipantConfiguration.hpp>
+#include <ddsrecorder_participants/replayer/SqlReaderParticipant.hpp>
 
 #include <tool/DdsRecorder.hpp>
 
@@ -42,6 +48,21 @@
 
 using namespace eprosima;
 
+namespace test {
+
+/**
+ * SqlReaderParticipant exposing the SQL files it reads.
+ */
+class SqlCatalogReader : public ddsrecorder::participants::SqlReaderParticipant
+{
+public:
+
+    using SqlReaderParticipant::SqlReaderParticipant;
+    using SqlReaderParticipant::find_files_;
+};
+
+} // namespace test
+
 class SqlFileCreationTest : public FileCreationTest
 {
 public:
@@ -138,6 +159,51 @@ protected:
         sqlite3_close(database);
     }
 
+    struct Shard
+    {
+        std::string name;
+        std::int64_t begin_time;
+        std::int64_t end_time;
+    };
+
+    std::vector<Shard> read_catalog_(
+            const std::string& catalog_path)
+    {
+        std::vector<Shard> shards;
+
+        exec_sql_statement_(catalog_path, "SELECT name, begin_time, end_time FROM Shards ORDER BY rowid;", {},
+                [&](sqlite3_stmt* stmt)
+                {
+                    // Every shard is closed (and its time range written) when the recorder is destroyed
+                    ASSERT_NE(sqlite3_column_type(stmt, 1), SQLITE_NULL);
+                    ASSERT_NE(sqlite3_column_type(stmt, 2), SQLITE_NULL);
+
+                    shards.push_back({reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
+                                      sqlite3_column_int64(stmt, 1), sqlite3_column_int64(stmt, 2)});
+                });
+
+        return shards;
+    }
+
+    void record_shards_(
+            const std::string& output_file_name,
+            const std::string& catalog_path,
+            const unsigned int number_of_messages,
+            const unsigned int max_number_of_shards)
+    {
+        configuration_->sql_resource_limits.resource_limits_struct.max_file_duration_ = 1;
+
+        ASSERT_TRUE(delete_file_(catalog_path));
+
+        for (unsigned int i = 0; i < max_number_of_shards; i++)
+        {
+            ASSERT_TRUE(delete_file_(get_output_file_path_(output_file_name + "_" + std::to_string(i) + ".db")));
+        }
+
+        // Record messages
+        record_messages_(output_file_name, number_of_messages);
+    }
+
 };
 
 /**
@@ -307,6 +373,70 @@ TEST_F(SqlFileCreationTest, sql_data_format_both)
     ASSERT_GT(read_message_count, 0);
 }
 
+/**
+ * Verify that the DDS Recorder formats the messages written in a large batch (hydrated by several threads) the same
+ * as the messages written one by one (hydrated by the writing thread).
+ *
+ * CASES:
+ *  - Verify that the data_json of every message of the batch matches the message sent, in the same order.
+ *  - Verify that the data_json and the key of every message of the batch match the ones written one by one.
+ */
+TEST_F(SqlFileCreationTest, sql_data_format_both_parallel)
+{
+    const std::string OUTPUT_FILE_NAME = "sql_data_format_both_parallel";
+    const auto OUTPUT_FILE_PATH = get_output_file_path_(OUTPUT_FILE_NAME + ".db");
+
+    const std::string SERIAL_OUTPUT_FILE_NAME = "sql_data_format_both_serial";
+    const auto SERIAL_OUTPUT_FILE_PATH = get_output_file_path_(SERIAL_OUTPUT_FILE_NAME + ".db");
+
+    // Enough messages for several hydration workers (at least 64 messages each)
+    constexpr auto NUMBER_OF_MESSAGES = 300;
+
+    ASSERT_TRUE(delete_file_(OUTPUT_FILE_PATH));
+    ASSERT_TRUE(delete_file_(SERIAL_OUTPUT_FILE_PATH));
+
+    configuration_->sql_data_format = ddsrecorder::participants::DataFormat::both;
+
+    // Record the messages one by one
+    configuration_->buffer_size = 1;
+    record_messages_(SERIAL_OUTPUT_FILE_NAME, NUMBER_OF_MESSAGES);
+
+    // Record the messages in a single batch
+    configuration_->buffer_size = NUMBER_OF_MESSAGES;
+    const auto sent_messages = record_messages_(OUTPUT_FILE_NAME, NUMBER_OF_MESSAGES);
+
+    const std::string statement = "SELECT data_json, key FROM Messages ORDER BY log_time;";
+
+    std::vector<std::pair<std::string, std::string>> serial_messages;
+
+    exec_sql_statement_(SERIAL_OUTPUT_FILE_PATH, statement, {}, [&](sqlite3_stmt* stmt)
+            {
+                serial_messages.emplace_back(
+                    reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
+                    reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)));
+            });
+
+    ASSERT_EQ(serial_messages.size(), NUMBER_OF_MESSAGES);
+
+    std::size_t read_message_count = 0;
+
+    exec_sql_statement_(OUTPUT_FILE_PATH, statement, {}, [&](sqlite3_stmt* stmt)
+            {
+                ASSERT_LT(read_message_count, sent_messages.size());
+
+                const auto i = read_message_count++;
+
+                const std::string read_data_json = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const std::string read_key = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+
+                ASSERT_EQ(read_data_json, to_json(sent_messages[i]));
+                ASSERT_EQ(read_data_json, serial_messages[i].first);
+                ASSERT_EQ(read_key, serial_messages[i].second);
+            });
+
+    ASSERT_EQ(read_message_count, NUMBER_OF_MESSAGES);
+}
+
 /**
  * Verify that the DDS Recorder records topics properly in an SQL file.
  *
@@ -425,6 +555,258 @@ TEST_F(SqlFileCreationTest, sql_data_num_msgs)
             });
 }
 
+/**
+ * Verify that the DDS Recorder removes the oldest messages of a full SQL file when file rotation is enabled.
+ *
+ * CASES:
+ *  - Verify that some messages are removed, but not all of them.
+ *  - Verify that exactly the oldest messages are removed.
+ *  - Verify that the partitions of the removed messages are removed with them.
+ */
+TEST_F(SqlFileCreationTest, sql_file_rotation_removes_oldest)
+{
+    const std::string OUTPUT_FILE_NAME = "sql_file_rotation_removes_oldest";
+    const auto OUTPUT_FILE_PATH = get_output_file_path_(OUTPUT_FILE_NAME + ".db");
+
+    constexpr auto NUMBER_OF_MESSAGES = 300;
+
+    // Room for around a hundred messages on top of the empty database
+    constexpr std::uint64_t MAX_SIZE = 64 * 1024;
+
+    auto& resource_limits = configuration_->sql_resource_limits.resource_limits_struct;
+    resource_limits.max_size_ = MAX_SIZE;
+    resource_limits.max_file_size_ = MAX_SIZE;
+    resource_limits.file_rotation_ = true;
+
+    ASSERT_TRUE(delete_file_(OUTPUT_FILE_PATH));
+
+    // Record messages
+    record_messages_(OUTPUT_FILE_NAME, NUMBER_OF_MESSAGES);
+
+    // The messages kept are the newest ones, with no gaps between them
+    exec_sql_statement_(OUTPUT_FILE_PATH,
+            "SELECT COUNT(*), MIN(sequence_number), MAX(sequence_number) FROM Messages;", {},
+            [&](sqlite3_stmt* stmt)
+            {
+                const auto recorded_messages = sqlite3_column_int64(stmt, 0);
+                ASSERT_GT(recorded_messages, 0);
+                ASSERT_LT(recorded_messages, NUMBER_OF_MESSAGES);
+
+                ASSERT_EQ(sqlite3_column_int64(stmt, 2), NUMBER_OF_MESSAGES);
+                ASSERT_EQ(sqlite3_column_int64(stmt, 1), NUMBER_OF_MESSAGES - recorded_messages + 1);
+            });
+
+    // Every message kept has its partition, and no partition is left from the removed messages
+    exec_sql_statement_(OUTPUT_FILE_PATH,
+            "SELECT (SELECT COUNT(*) FROM Messages), (SELECT COUNT(*) FROM MessagesPartitions);", {},
+            [&](sqlite3_stmt* stmt)
+            {
+                ASSERT_EQ(sqlite3_column_int64(stmt, 0), sqlite3_column_int64(stmt, 1));
+            });
+
+    exec_sql_statement_(OUTPUT_FILE_PATH,
+            "SELECT COUNT(*) FROM MessagesPartitions mp WHERE NOT EXISTS (SELECT 1 FROM Messages m "
+            "WHERE m.writer_guid = mp.writer_guid AND m.sequence_number = mp.sequence_number);", {},
+            [&](sqlite3_stmt* stmt)
+            {
+                ASSERT_EQ(sqlite3_column_int(stmt, 0), 0);
+            });
+}
+
+/**
+ * Verify that the DDS Recorder splits the SQL output in shards by duration, and keeps a catalog of their time ranges.
+ *
+ * CASES:
+ *  - Verify that several shards are recorded, and listed in the catalog in the order they were recorded.
+ *  - Verify that the time range of each shard in the catalog is the one of its messages.
+ *  - Verify that the time ranges of the shards do not overlap.
+ *  - Verify that every message is recorded in exactly one shard.
+ */
+TEST_F(SqlFileCreationTest, sql_shards_catalog)
+{
+    const std::string OUTPUT_FILE_NAME = "sql_shards_catalog";
+    const auto CATALOG_PATH = get_output_file_path_(
+        OUTPUT_FILE_NAME + ddsrecorder::participants::SQL_CATALOG_SUFFIX + ".db");
+
+    // Around 3.5 seconds of messages, split in shards of 1 second
+    constexpr auto NUMBER_OF_MESSAGES = 350;
+    constexpr auto MAX_NUMBER_OF_SHARDS = 8;
+
+    record_shards_(OUTPUT_FILE_NAME, CATALOG_PATH, NUMBER_OF_MESSAGES, MAX_NUMBER_OF_SHARDS);
+
+    const auto shards = read_catalog_(CATALOG_PATH);
+
+    ASSERT_GT(shards.size(), 1u);
+    ASSERT_LE(shards.size(), MAX_NUMBER_OF_SHARDS);
+
+    std::int64_t recorded_messages = 0;
+
+    for (std::size_t i = 0; i < shards.size(); i++)
+    {
+        const auto& shard = shards[i];
+        const auto shard_path = get_output_file_path_(shard.name);
+
+        ASSERT_TRUE(std::filesystem::exists(shard_path));
+        ASSERT_LE(shard.begin_time, shard.end_time);
+
+        if (i > 0)
+        {
+            ASSERT_GT(shard.begin_time, shards[i - 1].end_time);
+        }
+
+        exec_sql_statement_(shard_path, "SELECT COUNT(*), MIN(log_time), MAX(log_time) FROM Messages;", {},
+                [&](sqlite3_stmt* stmt)
+                {
+                    recorded_messages += sqlite3_column_int64(stmt, 0);
+
+                    ASSERT_EQ(sqlite3_column_int64(stmt, 1), shard.begin_time);
+                    ASSERT_EQ(sqlite3_column_int64(stmt, 2), shard.end_time);
+                });
+    }
+
+    ASSERT_EQ(recorded_messages, NUMBER_OF_MESSAGES);
+}
+
+/**
+ * Verify that the DDS Replayer reads a SQL output split in shards through its catalog.
+ *
+ * CASES:
+ *  - Verify that every shard is read, in the order they were recorded, when no time range is set.
+ *  - Verify that only the shards overlapping the time range to replay are read.
+ *  - Verify that the topics of the shards are read once.
+ */
+TEST_F(SqlFileCreationTest, sql_shards_catalog_replay)
+{
+    const std::string OUTPUT_FILE_NAME = "sql_shards_catalog_replay";
+    const auto CATALOG_PATH = get_output_file_path_(
+        OUTPUT_FILE_NAME + ddsrecorder::participants::SQL_CATALOG_SUFFIX + ".db");
+
+    // Around 3.5 seconds of messages, split in shards of 1 second
+    constexpr auto NUMBER_OF_MESSAGES = 350;
+    constexpr auto MAX_NUMBER_OF_SHARDS = 8;
+
+    record_shards_(OUTPUT_FILE_NAME, CATALOG_PATH, NUMBER_OF_MESSAGES, MAX_NUMBER_OF_SHARDS);
+
+    const auto shards = read_catalog_(CATALOG_PATH);
+
+    ASSERT_GT(shards.size(), 1u);
+
+    auto reader_configuration = std::make_shared<ddsrecorder::participants::BaseReaderParticipantConfiguration>();
+    const auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+
+    {
+        test::SqlCatalogReader reader(reader_configuration, payload_pool, CATALOG_PATH);
+
+        // Every shard is read
+        const auto files = reader.find_files_();
+
+        ASSERT_EQ(files.size(), shards.size());
+
+        for (std::size_t i = 0; i < shards.size(); i++)
+        {
+            ASSERT_EQ(std::filesystem::path(files[i]).filename().string(), shards[i].name);
+        }
+
+        // The topic is recorded in every shard, but read once
+        std::set<utils::Heritable<ddspipe::core::types::DdsTopic>> topics;
+        ddsrecorder::participants::DynamicTypesCollection types;
+
+        reader.process_summary(topics, types);
+
+        ASSERT_EQ(topics.size(), 1u);
+        ASSERT_EQ((*topics.begin())->m_topic_name, test::TOPIC_NAME);
+    }
+
+    // Replay only the first message of the last shard
+    const auto& last_shard = shards.back();
+    const auto begin_time = ddsrecorder::participants::to_std_timestamp(
+        static_cast<mcap::Timestamp>(last_shard.begin_time));
+
+    reader_configuration->begin_time.set_value(begin_time);
+    reader_configuration->end_time.set_value(begin_time);
+
+    {
+        test::SqlCatalogReader reader(reader_configuration, payload_pool, CATALOG_PATH);
+
+        // Only the last shard is read
+        const auto files = reader.find_files_();
+
+        ASSERT_EQ(files.size(), 1u);
+        ASSERT_EQ(std::filesystem::path(files[0]).filename().string(), last_shard.name);
+    }
+}
+
+/**
+ * Verify that the DDS Recorder records the timestamps as integers in a versioned SQL file, and that the messages are
+ * read in their replay order without sorting them.
+ *
+ * CASES:
+ *  - Verify that the schema version is stored in the SQL file.
+ *  - Verify that the timestamps are recorded as integers.
+ *  - Verify that the replay query uses the log time index instead of a temporary B-tree.
+ *  - Verify that the writers and topics of the messages are stored once, and read through the views.
+ */
+TEST_F(SqlFileCreationTest, sql_schema_version)
+{
+    const std::string OUTPUT_FILE_NAME = "sql_schema_version";
+    const auto OUTPUT_FILE_PATH = get_output_file_path_(OUTPUT_FILE_NAME + ".db");
+
+    constexpr auto NUMBER_OF_MESSAGES = 16;
+
+    ASSERT_TRUE(delete_file_(OUTPUT_FILE_PATH));
+
+    const auto OUTPUT_FILE_PATH_MCAP = get_output_file_path_(OUTPUT_FILE_NAME + ".mcap");
+    ASSERT_TRUE(delete_file_(OUTPUT_FILE_PATH_MCAP));
+
+    // Record messages
+    record_messages_(OUTPUT_FILE_NAME, NUMBER_OF_MESSAGES);
+
+    exec_sql_statement_(OUTPUT_FILE_PATH, "PRAGMA user_version;", {}, [&](sqlite3_stmt* stmt)
+            {
+                ASSERT_EQ(sqlite3_column_int(stmt, 0), ddsrecorder::participants::SQL_SCHEMA_VERSION);
+            });
+
+    exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT typeof(log_time), typeof(publish_time) FROM Messages;", {},
+            [&](sqlite3_stmt* stmt)
+            {
+                ASSERT_EQ(std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0))), "integer");
+                ASSERT_EQ(std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1))), "integer");
+            });
+
+    exec_sql_statement_(
+        OUTPUT_FILE_PATH,
+        "EXPLAIN QUERY PLAN SELECT m.log_time, t.name, t.type, m.data_cdr, w.guid FROM MessagesData m "
+        "JOIN Topics t ON m.topic_id = t.id JOIN Writers w ON m.writer_id = w.id "
+        "WHERE m.log_time >= CAST(? AS INTEGER) AND m.log_time <= CAST(? AS INTEGER) AND m.data_cdr_size > 0 "
+        "ORDER BY m.log_time, m.writer_id, m.sequence_number;",
+        {"0", "9223372036854775807"},
+        [&](sqlite3_stmt* stmt)
+        {
+            const std::string detail = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+            ASSERT_EQ(detail.find("TEMP B-TREE"), std::string::npos);
+        });
+
+    // The writer and the topic of the messages are stored once, and the views keep the shape of the messages tables
+    exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT COUNT(*) FROM Writers;", {}, [&](sqlite3_stmt* stmt)
+            {
+                ASSERT_EQ(sqlite3_column_int(stmt, 0), 1);
+            });
+
+    exec_sql_statement_(OUTPUT_FILE_PATH,
+            "SELECT COUNT(*), COUNT(DISTINCT writer_guid), COUNT(DISTINCT topic) FROM Messages;", {},
+            [&](sqlite3_stmt* stmt)
+            {
+                ASSERT_EQ(sqlite3_column_int(stmt, 0), NUMBER_OF_MESSAGES);
+                ASSERT_EQ(sqlite3_column_int(stmt, 1), 1);
+                ASSERT_EQ(sqlite3_column_int(stmt, 2), 1);
+            });
+
+    exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT COUNT(*) FROM MessagesPartitions;", {}, [&](sqlite3_stmt* stmt)
+            {
+                ASSERT_EQ(sqlite3_column_int(stmt, 0), NUMBER_OF_MESSAGES);
+            });
+}
+
 /**
  * Verify that DDS Recorder applies topic content filters configured in DDS settings.
  *
@@ -1101,7 +1483,7 @@ TEST_F(SqlFileCreationTest, transition_paused_event_less_window)
     exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT MIN(log_time) FROM Messages;", {}, [&](sqlite3_stmt* stmt)
             {
                 // Verify the oldest recorded message was recorded in the event window
-                const auto log_time = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const auto log_time = static_cast<mcap::Timestamp>(sqlite3_column_int64(stmt, 0));
                 const auto log_time_ts = ddsrecorder::participants::to_std_timestamp(log_time);
                 const auto log_time_tks = ddsrecorder::participants::to_ticks(log_time_ts);
 
@@ -1160,7 +1542,7 @@ TEST_F(SqlFileCreationTest, transition_paused_event_max_window)
     exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT MIN(log_time) FROM Messages;", {}, [&](sqlite3_stmt* stmt)
             {
                 // Verify the oldest recorded message was recorded in the event window
-                const auto log_time = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const auto log_time = static_cast<mcap::Timestamp>(sqlite3_column_int64(stmt, 0));
                 const auto log_time_ts = ddsrecorder::participants::to_std_timestamp(log_time);
                 const auto log_time_tks = ddsrecorder::participants::to_ticks(log_time_ts);
 
@@ -1222,7 +1604,7 @@ TEST_F(SqlFileCreationTest, transition_paused_event_start)
     exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT MIN(log_time) FROM Messages;", {}, [&](sqlite3_stmt* stmt)
             {
                 // Verify the oldest recorded message was recorded in the event window
-                const auto log_time = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const auto log_time = static_cast<mcap::Timestamp>(sqlite3_column_int64(stmt, 0));
                 const auto log_time_ts = ddsrecorder::participants::to_std_timestamp(log_time);
                 const auto log_time_tks = ddsrecorder::participants::to_ticks(log_time_ts);
 
@@ -1280,7 +1662,7 @@ TEST_F(SqlFileCreationTest, transition_paused_event_suspend)
     exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT MIN(log_time) FROM Messages;", {}, [&](sqlite3_stmt* stmt)
             {
                 // Verify the oldest recorded message was recorded in the event window
-                const auto log_time = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const auto log_time = static_cast<mcap::Timestamp>(sqlite3_column_int64(stmt, 0));
                 const auto log_time_ts = ddsrecorder::participants::to_std_timestamp(log_time);
                 const auto log_time_tks = ddsrecorder::participants::to_ticks(log_time_ts);
 
@@ -1338,7 +1720,7 @@ TEST_F(SqlFileCreationTest, transition_paused_event_stop)
     exec_sql_statement_(OUTPUT_FILE_PATH, "SELECT MIN(log_time) FROM Messages;", {}, [&](sqlite3_stmt* stmt)
             {
                 // Verify the oldest recorded message was recorded in the event window
-                const auto log_time = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                const auto log_time = static_cast<mcap::Timestamp>(sqlite3_column_int64(stmt, 0));
                 const auto log_time_ts = ddsrecorder::participants::to_std_timestamp(log_time);
                 const auto log_time_tks = ddsrecorder::participants::to_ticks(log_time_ts);
 
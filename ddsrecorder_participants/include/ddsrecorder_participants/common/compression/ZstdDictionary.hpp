@@ -0,0 +1,153 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ZstdDictionary.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+// Forward declarations
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DCtx_s;
+struct ZSTD_DDict_s;
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Zstd dictionary to compress (and decompress) small messages one by one.
+ *
+ * Small messages of the same type share most of their content, which a dictionary trained from a few of them
+ * captures, so they compress well even on their own.
+ * The compressed messages are plain zstd frames, so they are told apart from CDR payloads by the zstd magic number.
+ *
+ * @warning Not thread-safe: the compression and decompression contexts are reused among calls.
+ */
+class ZstdDictionary
+{
+public:
+
+    //! Default max size [bytes] of a trained dictionary
+    static constexpr std::uint64_t DEFAULT_MAX_SIZE = 16 * 1024;
+
+    //! Max size [bytes] of the messages compressed with a dictionary (larger ones compress well within the chunks)
+    static constexpr std::uint64_t MAX_MESSAGE_SIZE = 4 * 1024;
+
+    /**
+     * @brief Builds the compression and decompression contexts of \c dictionary .
+     *
+     * @param dictionary        Dictionary, as returned by \c train .
+     * @param compression_level Zstd compression level.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    ZstdDictionary(
+            const std::string& dictionary,
+            int compression_level = 3);
+
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    ~ZstdDictionary();
+
+    ZstdDictionary(
+            const ZstdDictionary&) = delete;
+    ZstdDictionary& operator =(
+            const ZstdDictionary&) = delete;
+
+    /**
+     * @brief Trains a dictionary from \c samples .
+     *
+     * @param samples  Messages to train the dictionary from.
+     * @param max_size Max size [bytes] of the dictionary.
+     *
+     * @return The dictionary, or an empty string if it could not be trained (e.g. too few or too different samples).
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    static std::string train(
+            const std::vector<std::string>& samples,
+            std::uint64_t max_size = DEFAULT_MAX_SIZE);
+
+    //! Whether \c data is a zstd frame (i.e. a message compressed with a dictionary)
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    static bool is_compressed(
+            const std::byte* data,
+            std::uint64_t size) noexcept;
+
+    //! Whether the contexts of the dictionary could be built
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool is_valid() const noexcept;
+
+    //! The dictionary
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    const std::string& data() const noexcept;
+
+    /**
+     * @brief Compresses a message with the dictionary.
+     *
+     * @param [in]  data       Message to compress.
+     * @param [in]  size       Size [bytes] of the message.
+     * @param [out] compressed Compressed message.
+     *
+     * @return Whether the message was compressed (and is smaller than the original one).
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool compress(
+            const std::byte* data,
+            std::uint64_t size,
+            std::vector<std::byte>& compressed) const;
+
+    /**
+     * @brief Decompresses a message compressed with the dictionary.
+     *
+     * @param [in]  data         Compressed message.
+     * @param [in]  size         Size [bytes] of the compressed message.
+     * @param [out] decompressed Original message.
+     *
+     * @return Whether the message was decompressed.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool decompress(
+            const std::byte* data,
+            std::uint64_t size,
+            std::vector<std::byte>& decompressed) const;
+
+protected:
+
+    //! Dictionary
+    std::string dictionary_;
+
+    //! Digested dictionary to compress
+    ZSTD_CDict_s* compression_dictionary_{nullptr};
+
+    //! Digested dictionary to decompress
+    ZSTD_DDict_s* decompression_dictionary_{nullptr};
+
+    //! Reused compression context
+    ZSTD_CCtx_s* compression_context_{nullptr};
+
+    //! Reused decompression context
+    ZSTD_DCtx_s* decompression_context_{nullptr};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
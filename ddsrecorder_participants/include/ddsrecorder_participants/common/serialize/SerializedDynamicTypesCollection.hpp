@@ -0,0 +1,107 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SerializedDynamicTypesCollection.hpp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollection.hpp>
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * CDR serialization of a \c DynamicTypesCollection built one \c DynamicType at a time.
+ *
+ * Each type is serialized on its own and appended to the collection, so adding a type costs as much as serializing
+ * that type, instead of serializing the whole collection again.
+ * The result is a regular XCDR serialized \c DynamicTypesCollection, deserialized by \c Serializer::deserialize .
+ */
+class SerializedDynamicTypesCollection
+{
+public:
+
+    /**
+     * @brief Serializes \c dynamic_type so it can be appended to the collection.
+     *
+     * @param [in]  dynamic_type    Type to serialize.
+     * @param [out] serialized_type Serialized type, to be passed to \c append .
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    static void serialize(
+            const DynamicType& dynamic_type,
+            std::string& serialized_type);
+
+    /**
+     * @brief Size [bytes] of the collection once \c serialized_type is appended.
+     *
+     * @param serialized_type Type serialized by \c serialize .
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::uint64_t size_after_append(
+            const std::string& serialized_type) const noexcept;
+
+    /**
+     * @brief Appends a type serialized by \c serialize to the collection.
+     *
+     * @param serialized_type Type serialized by \c serialize .
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void append(
+            const std::string& serialized_type);
+
+    //! Number of types in the collection
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::uint32_t count() const noexcept;
+
+    //! Whether the collection has no types
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool empty() const noexcept;
+
+    //! The serialized collection (empty if it has no types)
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    const std::string& str() const noexcept;
+
+protected:
+
+    //! Size [bytes] of the encapsulation preceding the collection (and each serialized type)
+    static constexpr std::uint64_t ENCAPSULATION_SIZE = 4;
+
+    //! Size [bytes] of the encapsulation and of the number of types preceding the types
+    static constexpr std::uint64_t HEADER_SIZE = ENCAPSULATION_SIZE + sizeof(std::uint32_t);
+
+    //! Alignment [bytes] of each type in the collection
+    static constexpr std::uint64_t TYPE_ALIGNMENT = 4;
+
+    //! Padding [bytes] needed before appending a type to a collection of \c size bytes
+    static std::uint64_t padding_(
+            std::uint64_t size) noexcept;
+
+    //! The serialized collection
+    std::string serialized_collection_;
+
+    //! The number of types in the collection
+    std::uint32_t count_{0};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,150 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SourceGuidIndex.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ddspipe_core/types/dds/Guid.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Compact binary index of the writer (source GUID) of each message in an MCAP file, by message sequence.
+ *
+ * Each writer is stored once, and each message takes the 2 bytes of its writer's index.
+ * The messages are grouped in runs of consecutive sequences, so looking up the messages in the order they were written
+ * takes constant time.
+ *
+ * Serialized format (little-endian):
+ * - version (uint32)
+ * - number of writers (uint32), and for each writer: the length of its GUID (uint32) and the GUID string.
+ * - number of runs (uint32), and for each run: its first sequence (uint32), its number of messages (uint32), and the
+ *   index of the writer of each message (uint16 each).
+ */
+class SourceGuidIndex
+{
+public:
+
+    //! Version of the serialized format
+    static constexpr std::uint32_t VERSION = 1;
+
+    //! Writer index of the messages whose writer could not be indexed
+    static constexpr std::uint16_t UNKNOWN_WRITER = 0xFFFF;
+
+    //! Max growth [bytes] of the serialized index when adding a message (a new run and a new writer)
+    static constexpr std::uint64_t MAX_MESSAGE_SIZE = 128;
+
+    /**
+     * @brief Adds the message \c sequence , published by \c writer_guid .
+     *
+     * @note The GUID of each writer is only formatted the first time one of its messages is added.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void add(
+            std::uint32_t sequence,
+            const ddspipe::core::types::Guid& writer_guid);
+
+    /**
+     * @brief Looks up the writer of the message \c sequence .
+     *
+     * @note Only for deserialized indexes (which have their runs sorted). Not thread-safe (it caches the last run).
+     *
+     * @return The GUID string of the writer, or nullptr if the message is not indexed.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    const std::string* find(
+            std::uint32_t sequence) const;
+
+    //! Removes every message and writer
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void clear();
+
+    //! Whether no message is indexed
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool empty() const noexcept;
+
+    //! Size [bytes] of the serialized index
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::uint64_t serialized_size() const noexcept;
+
+    /**
+     * @brief Serializes the index.
+     *
+     * @param [out] serialized Serialized index.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void serialize(
+            std::string& serialized) const;
+
+    /**
+     * @brief Replaces the index with a serialized one.
+     *
+     * @param serialized Serialized index.
+     *
+     * @return Whether \c serialized is a valid index (if not, the index is left empty).
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool deserialize(
+            const std::string& serialized);
+
+protected:
+
+    //! Messages with consecutive sequences
+    struct Run
+    {
+        //! Sequence of the first message
+        std::uint32_t first_sequence;
+
+        //! Writer index of each message
+        std::vector<std::uint16_t> writers;
+    };
+
+    //! Size [bytes] of the version, the number of writers and the number of runs
+    static constexpr std::uint64_t HEADER_SIZE = 3 * sizeof(std::uint32_t);
+
+    //! Size [bytes] of the first sequence and number of messages of a run
+    static constexpr std::uint64_t RUN_HEADER_SIZE = 2 * sizeof(std::uint32_t);
+
+    //! The GUID string of each writer, by writer index
+    std::vector<std::string> writer_guids_;
+
+    //! The index of each writer
+    std::map<ddspipe::core::types::Guid, std::uint16_t> writer_indexes_;
+
+    //! The indexed messages
+    std::vector<Run> runs_;
+
+    //! The size of the serialized index
+    std::uint64_t serialized_size_{HEADER_SIZE};
+
+    //! The run of the last message looked up
+    mutable std::size_t last_run_{0};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -105,6 +105,16 @@ DDSRECORDER_PARTICIPANTS_DllAPI
 std::uint64_t to_ticks(
         const utils::Timestamp& time);
 
+/**
+ * @brief This method converts a timestamp in Fast DDS format to nanoseconds.
+ *
+ * @param [in] time Timestamp to convert
+ * @return Timestamp in nanoseconds
+ */
+DDSRECORDER_PARTICIPANTS_DllAPI
+std::uint64_t to_ticks(
+        const fastdds::rtps::Time_t& time);
+
 } /* namespace participants */
 } /* namespace ddsrecorder */
 } /* namespace eprosima */
@@ -82,6 +82,9 @@ public:
                     m_mcap_file_creation_failure = x.m_mcap_file_creation_failure;
 
                     m_disk_full = x.m_disk_full;
+        m_buffer_memory_full = x.m_buffer_memory_full;
+
+                    m_buffer_memory_full = x.m_buffer_memory_full;
 
     }
 
@@ -94,6 +97,7 @@ public:
     {
         m_mcap_file_creation_failure = x.m_mcap_file_creation_failure;
         m_disk_full = x.m_disk_full;
+        m_buffer_memory_full = x.m_buffer_memory_full;
     }
 
     /*!
@@ -107,6 +111,9 @@ public:
                     m_mcap_file_creation_failure = x.m_mcap_file_creation_failure;
 
                     m_disk_full = x.m_disk_full;
+        m_buffer_memory_full = x.m_buffer_memory_full;
+
+                    m_buffer_memory_full = x.m_buffer_memory_full;
 
         return *this;
     }
@@ -121,6 +128,7 @@ public:
 
         m_mcap_file_creation_failure = x.m_mcap_file_creation_failure;
         m_disk_full = x.m_disk_full;
+        m_buffer_memory_full = x.m_buffer_memory_full;
         return *this;
     }
 
@@ -132,7 +140,8 @@ public:
             const DdsRecorderMonitoringErrorStatus& x) const
     {
         return (m_mcap_file_creation_failure == x.m_mcap_file_creation_failure &&
-           m_disk_full == x.m_disk_full);
+           m_disk_full == x.m_disk_full &&
+           m_buffer_memory_full == x.m_buffer_memory_full);
     }
 
     /*!
@@ -203,11 +212,41 @@ public:
     }
 
 
+    /*!
+     * @brief This function sets a value in member buffer_memory_full
+     * @param _buffer_memory_full New value for member buffer_memory_full
+     */
+    eProsima_user_DllExport void buffer_memory_full(
+            bool _buffer_memory_full)
+    {
+        m_buffer_memory_full = _buffer_memory_full;
+    }
+
+    /*!
+     * @brief This function returns the value of member buffer_memory_full
+     * @return Value of member buffer_memory_full
+     */
+    eProsima_user_DllExport bool buffer_memory_full() const
+    {
+        return m_buffer_memory_full;
+    }
+
+    /*!
+     * @brief This function returns a reference to member buffer_memory_full
+     * @return Reference to member buffer_memory_full
+     */
+    eProsima_user_DllExport bool& buffer_memory_full()
+    {
+        return m_buffer_memory_full;
+    }
+
+
 
 private:
 
     bool m_mcap_file_creation_failure{false};
     bool m_disk_full{false};
+    bool m_buffer_memory_full{false};
 
 };
 /*!
@@ -243,6 +282,10 @@ public:
     {
                     m_ddsrecorder_error_status = x.m_ddsrecorder_error_status;
 
+                    m_key_cache_hits = x.m_key_cache_hits;
+
+                    m_key_cache_misses = x.m_key_cache_misses;
+
     }
 
     /*!
@@ -255,6 +298,8 @@ public:
 
     {
         m_ddsrecorder_error_status = std::move(x.m_ddsrecorder_error_status);
+        m_key_cache_hits = x.m_key_cache_hits;
+        m_key_cache_misses = x.m_key_cache_misses;
     }
 
     /*!
@@ -268,6 +313,10 @@ public:
 
                     m_ddsrecorder_error_status = x.m_ddsrecorder_error_status;
 
+                    m_key_cache_hits = x.m_key_cache_hits;
+
+                    m_key_cache_misses = x.m_key_cache_misses;
+
         return *this;
     }
 
@@ -281,6 +330,8 @@ public:
         MonitoringStatus::operator =(std::move(x));
 
         m_ddsrecorder_error_status = std::move(x.m_ddsrecorder_error_status);
+        m_key_cache_hits = x.m_key_cache_hits;
+        m_key_cache_misses = x.m_key_cache_misses;
         return *this;
     }
 
@@ -295,7 +346,9 @@ public:
                 {
                     return false;
                 }
-        return (m_ddsrecorder_error_status == x.m_ddsrecorder_error_status);
+        return (m_ddsrecorder_error_status == x.m_ddsrecorder_error_status &&
+           m_key_cache_hits == x.m_key_cache_hits &&
+           m_key_cache_misses == x.m_key_cache_misses);
     }
 
     /*!
@@ -347,10 +400,70 @@ public:
     }
 
 
+    /*!
+     * @brief This function sets a value in member key_cache_hits
+     * @param _key_cache_hits New value for member key_cache_hits
+     */
+    eProsima_user_DllExport void key_cache_hits(
+            uint64_t _key_cache_hits)
+    {
+        m_key_cache_hits = _key_cache_hits;
+    }
+
+    /*!
+     * @brief This function returns the value of member key_cache_hits
+     * @return Value of member key_cache_hits
+     */
+    eProsima_user_DllExport uint64_t key_cache_hits() const
+    {
+        return m_key_cache_hits;
+    }
+
+    /*!
+     * @brief This function returns a reference to member key_cache_hits
+     * @return Reference to member key_cache_hits
+     */
+    eProsima_user_DllExport uint64_t& key_cache_hits()
+    {
+        return m_key_cache_hits;
+    }
+
+
+    /*!
+     * @brief This function sets a value in member key_cache_misses
+     * @param _key_cache_misses New value for member key_cache_misses
+     */
+    eProsima_user_DllExport void key_cache_misses(
+            uint64_t _key_cache_misses)
+    {
+        m_key_cache_misses = _key_cache_misses;
+    }
+
+    /*!
+     * @brief This function returns the value of member key_cache_misses
+     * @return Value of member key_cache_misses
+     */
+    eProsima_user_DllExport uint64_t key_cache_misses() const
+    {
+        return m_key_cache_misses;
+    }
+
+    /*!
+     * @brief This function returns a reference to member key_cache_misses
+     * @return Reference to member key_cache_misses
+     */
+    eProsima_user_DllExport uint64_t& key_cache_misses()
+    {
+        return m_key_cache_misses;
+    }
+
+
 
 private:
 
     DdsRecorderMonitoringErrorStatus m_ddsrecorder_error_status;
+    uint64_t m_key_cache_hits{0};
+    uint64_t m_key_cache_misses{0};
 
 };
 
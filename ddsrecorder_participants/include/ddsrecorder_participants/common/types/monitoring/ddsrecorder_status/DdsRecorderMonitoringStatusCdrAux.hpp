@@ -23,10 +23,10 @@
 #define FAST_DDS_GENERATED__DDSRECORDERMONITORINGSTATUSCDRAUX_HPP
 
 #include "DdsRecorderMonitoringStatus.hpp"
-constexpr uint32_t DdsRecorderMonitoringErrorStatus_max_cdr_typesize {6UL};
+constexpr uint32_t DdsRecorderMonitoringErrorStatus_max_cdr_typesize {7UL};
 constexpr uint32_t DdsRecorderMonitoringErrorStatus_max_key_cdr_typesize {0UL};
 
-constexpr uint32_t DdsRecorderMonitoringStatus_max_cdr_typesize {18UL};
+constexpr uint32_t DdsRecorderMonitoringStatus_max_cdr_typesize {36UL};
 constexpr uint32_t DdsRecorderMonitoringStatus_max_key_cdr_typesize {0UL};
 
 
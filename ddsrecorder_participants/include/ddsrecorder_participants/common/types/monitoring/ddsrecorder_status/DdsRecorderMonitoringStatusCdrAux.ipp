@@ -56,6 +56,9 @@ eProsima_user_DllExport size_t calculate_serialized_size(
         calculated_size += calculator.calculate_member_serialized_size(eprosima::fastcdr::MemberId(1),
                 data.disk_full(), current_alignment);
 
+        calculated_size += calculator.calculate_member_serialized_size(eprosima::fastcdr::MemberId(2),
+                data.buffer_memory_full(), current_alignment);
+
 
     calculated_size += calculator.end_calculate_type_serialized_size(previous_encoding, current_alignment);
 
@@ -76,6 +79,7 @@ eProsima_user_DllExport void serialize(
     scdr
         << eprosima::fastcdr::MemberId(0) << data.mcap_file_creation_failure()
         << eprosima::fastcdr::MemberId(1) << data.disk_full()
+        << eprosima::fastcdr::MemberId(2) << data.buffer_memory_full()
 ;
     scdr.end_serialize_type(current_state);
 }
@@ -101,6 +105,10 @@ eProsima_user_DllExport void deserialize(
                                                 dcdr >> data.disk_full();
                                             break;
 
+                                        case 2:
+                                                dcdr >> data.buffer_memory_full();
+                                            break;
+
                     default:
                         ret_value = false;
                         break;
@@ -120,6 +128,8 @@ void serialize_key(
 
                         scdr << data.disk_full();
 
+                        scdr << data.buffer_memory_full();
+
 }
 
 
@@ -148,6 +158,12 @@ eProsima_user_DllExport size_t calculate_serialized_size(
         calculated_size += calculator.calculate_member_serialized_size(eprosima::fastcdr::MemberId(2),
                 data.ddsrecorder_error_status(), current_alignment);
 
+        calculated_size += calculator.calculate_member_serialized_size(eprosima::fastcdr::MemberId(3),
+                data.key_cache_hits(), current_alignment);
+
+        calculated_size += calculator.calculate_member_serialized_size(eprosima::fastcdr::MemberId(4),
+                data.key_cache_misses(), current_alignment);
+
 
     calculated_size += calculator.end_calculate_type_serialized_size(previous_encoding, current_alignment);
 
@@ -169,6 +185,8 @@ eProsima_user_DllExport void serialize(
         << eprosima::fastcdr::MemberId(0) << data.error_status()
         << eprosima::fastcdr::MemberId(1) << data.has_errors()
         << eprosima::fastcdr::MemberId(2) << data.ddsrecorder_error_status()
+        << eprosima::fastcdr::MemberId(3) << data.key_cache_hits()
+        << eprosima::fastcdr::MemberId(4) << data.key_cache_misses()
 ;
     scdr.end_serialize_type(current_state);
 }
@@ -198,6 +216,14 @@ eProsima_user_DllExport void deserialize(
                                                 dcdr >> data.ddsrecorder_error_status();
                                             break;
 
+                                        case 3:
+                                                dcdr >> data.key_cache_hits();
+                                            break;
+
+                                        case 4:
+                                                dcdr >> data.key_cache_misses();
+                                            break;
+
                     default:
                         ret_value = false;
                         break;
@@ -32,9 +32,33 @@ constexpr const char* QOS_SERIALIZATION_KEYED("keyed");
 // Dynamic types serialization
 constexpr const char* DYNAMIC_TYPES_ATTACHMENT_NAME("dynamic_types");
 
+// Source GUID index (writer of each message, see SourceGuidIndex)
+constexpr const char* SOURCE_GUID_INDEX_ATTACHMENT_NAME("source_guid_index");
+
+// Checkpoint of the schemas and channels of an MCAP file, to recover it if it is not closed (see McapRecovery)
+constexpr const char* CHECKPOINT_ATTACHMENT_NAME("checkpoint");
+
+// Zstd dictionaries (one attachment per schema, named after the prefix and the schema name)
+constexpr const char* ZSTD_DICTIONARY_ATTACHMENT_PREFIX("zstd_dictionary/");
+
+// Message encoding of the channels whose messages may be compressed with the zstd dictionary of their schema
+// NOTE: Their messages are either CDR payloads or zstd frames, so they can only be read by the DDS Replayer
+constexpr const char* ZSTD_DICTIONARY_MESSAGE_ENCODING("cdr+zstd-dictionary");
+
+// Name of the zstd dictionary attachment of a channel's schema (channel metadata)
+constexpr const char* ZSTD_DICTIONARY_METADATA("zstd-dictionary");
+
 // ROS 2 Types metadata
 constexpr const char* ROS2_TYPES("ros2-types");
 
+// SQL schema version (stored as the user_version of the database)
+// NOTE: Files recorded with version 1 store the writers, topics and types of the messages as text in their Messages
+//       table, and files recorded before it (version 0) store the timestamps as text too (see to_sql_timestamp)
+constexpr int SQL_SCHEMA_VERSION(2);
+
+// Suffix of the catalog of the SQL shards (the SQL files split by duration)
+constexpr const char* SQL_CATALOG_SUFFIX("_catalog");
+
 
 
 // Version metadata
@@ -43,6 +67,7 @@ constexpr const char* VERSION_METADATA_RELEASE("release");
 constexpr const char* VERSION_METADATA_COMMIT("commit");
 // Partitions metadata
 constexpr const char* PARTITIONS("partitions"); // partitions of the channel
+// NOTE: Only read from files recorded before the source GUID index attachment
 constexpr const char* VERSION_METADATA_MESSAGE_NAME("messages_guid"); // the guid associated with a message
 constexpr const char* VERSION_METADATA_MESSAGE_INDEX_NAME("messages_guid_index"); // the guid associated with a message
 
@@ -19,14 +19,16 @@
 #pragma once
 
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <fastdds/dds/xtypes/type_representation/detail/dds_xtypes_typeobject.hpp>
 #include <fastdds/dds/xtypes/type_representation/TypeObject.hpp>
@@ -41,8 +43,10 @@
 #include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollection.hpp>
 #include <ddsrecorder_participants/library/library_dll.h>
 #include <ddsrecorder_participants/recorder/message/BaseMessage.hpp>
+#include <ddsrecorder_participants/recorder/message/TopicRegistry.hpp>
 #include <ddsrecorder_participants/recorder/handler/BaseHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/handler/BaseWriter.hpp>
+#include <ddsrecorder_participants/recorder/handler/EventWindowBuffer.hpp>
 
 namespace eprosima {
 namespace ddsrecorder {
@@ -110,7 +114,7 @@ public:
     /**
      * @brief Enable handler instance
      *
-     * Enables the writer.
+     * Enables the writer, and launches the writer thread if \c async_write is enabled.
      */
     DDSRECORDER_PARTICIPANTS_DllAPI
     virtual void enable();
@@ -118,7 +122,7 @@ public:
     /**
      * @brief Disable handler instance
      *
-     * Disables the writer.
+     * Waits for the writer thread (if any) to write all queued samples, and disables the writer.
      */
     DDSRECORDER_PARTICIPANTS_DllAPI
     virtual void disable();
@@ -183,6 +187,12 @@ public:
 
 protected:
 
+    //! Contiguous batch of samples, as stored in the buffer and handed over to be written
+    using SamplesBatch = std::vector<std::shared_ptr<const BaseMessage>>;
+
+    //! FIFO of samples with unknown type
+    using SamplesQueue = std::deque<std::shared_ptr<const BaseMessage>>;
+
     //! Flag code controlling the event thread routine
     enum class EventCode
     {
@@ -204,7 +214,8 @@ protected:
     void event_thread_routine_();
 
     /**
-     * @brief Stop event thread, and clear \c samples_buffer_ and \c pending_samples_paused_ structures
+     * @brief Stop event thread, and clear \c samples_buffer_ , \c event_window_buffer_ and \c pending_samples_paused_
+     * structures
      *
      * A (locked) lock wrapping \c event_cv_mutex_ is passed so it can be released just before joining the thread.
      *
@@ -235,13 +246,46 @@ protected:
     /**
      * @brief Adds samples to \c samples_buffer.
      *
-     * For each sample in \c samples, it writes it to disk and removes it from \c samples.
+     * For each sample in \c samples, it adds it to \c samples_buffer and removes it from \c samples.
      * The method ends when \c samples is empty.
      *
-     * @param [in] samples List of samples to be added.
+     * @param [in] samples Queue of samples to be added.
+     */
+    void add_samples_to_buffer_nts_(
+            SamplesQueue& samples);
+
+    /**
+     * @brief Adds samples to \c samples_buffer (sorted by reception time), leaving \c samples empty.
+     *
+     * @param [in] samples Event window buffer with the samples to be added.
      */
     void add_samples_to_buffer_nts_(
-            std::list<std::shared_ptr<const BaseMessage>>& samples);
+            EventWindowBuffer& samples);
+
+    /**
+     * @brief Sends the samples in \c samples_buffer_ to be written to disk, leaving it empty.
+     *
+     * @param [in] deferred Whether the caller writes the dispatched samples once \c mtx_ is released.
+     */
+    void flush_samples_buffer_nts_(
+            bool deferred = false);
+
+    /**
+     * @brief Returns the memory [bytes] taken by the payloads of every buffered sample.
+     */
+    std::uint64_t buffered_memory_nts_() const;
+
+    /**
+     * @brief Frees buffered samples until their memory is below \c max_buffer_memory (if set).
+     *
+     * In RUNNING state, \c samples_buffer_ is written early and the oldest pending samples are written without schema
+     * (or dropped if \c only_with_schema ).
+     * In PAUSED state, \c event_window_buffer_ is spilled to file (if enabled), and then the oldest samples in
+     * \c event_window_buffer_ and \c pending_samples_paused_ are dropped.
+     *
+     * In both cases, the oldest samples are those received first, whatever their type.
+     */
+    void enforce_memory_limit_nts_();
 
     /**
      * @brief Adds a sample to \c pending_samples_.
@@ -272,24 +316,81 @@ protected:
     void dump_pending_samples_nts_(
             const std::string& type_name);
 
+    /**
+     * @brief Sends \c samples to be written to disk.
+     *
+     * \c samples are swapped with an empty (recycled) batch and moved to the writer queue, so no sample is copied.
+     *
+     * If \c async_write is enabled and the writer thread is running, the writer thread writes them later on
+     * (blocking while the queue is full).
+     * Otherwise, they are written to disk directly unless \c deferred is set, in which case the caller is expected
+     * to call \c write_dispatched_samples_ once \c mtx_ is released.
+     *
+     * In all cases, \c samples is empty when the method returns.
+     *
+     * @param [in] samples  Batch of samples to be written.
+     * @param [in] deferred Whether to postpone the (synchronous) write until \c write_dispatched_samples_ is called.
+     */
+    void dispatch_samples_nts_(
+            SamplesBatch& samples,
+            bool deferred = false);
+
+    /**
+     * @brief Write to disk the batches in \c writer_queue_ (in order) if the writer thread is not running.
+     *
+     * @note It does not require \c mtx_ to be taken, so it is called after releasing it when a full buffer has been
+     * dispatched, thus not blocking the reception of samples while writing to disk.
+     */
+    void write_dispatched_samples_();
+
+    /**
+     * @brief Take the next batch from \c writer_queue_ , recycling the (already written) batch in \c samples .
+     *
+     * @note Must be called with \c writer_cv_mutex_ taken.
+     *
+     * @param [in,out] samples Batch already written, replaced by the next batch to write.
+     */
+    void pop_dispatched_samples_nts_(
+            SamplesBatch& samples);
+
+    /**
+     * @brief Launch the writer thread.
+     */
+    void start_writer_thread_();
+
+    /**
+     * @brief Stop the writer thread once every queued sample has been written.
+     */
+    void stop_writer_thread_();
+
+    /**
+     * @brief Write to disk the batches of samples in \c writer_queue_ as soon as they are queued.
+     *
+     * The loop is exited when \c writer_stop_ is set and \c writer_queue_ is empty.
+     */
+    void writer_thread_routine_();
+
     /**
      * @brief Writes \c samples to disk.
      *
      * For each sample in \c samples, it writes it to disk and removes it from \c samples.
      * The method ends when \c samples is empty.
      *
-     * @param [in] samples List of samples to be written.
+     * @note Always called with \c write_mtx_ taken, but not necessarily with \c mtx_ taken (see \c async_write).
+     *
+     * @param [in] samples Batch of samples to be written.
      */
     virtual void write_samples_(
-            std::list<std::shared_ptr<const BaseMessage>>& samples) = 0;
+            SamplesBatch& samples) = 0;
 
     /**
      * @brief Remove samples older than [now - event_window].
      *
      * This method removes samples older than [now - event_window] from:
-     * - \c samples_buffer_
-     * - \c pending_samples_
+     * - \c event_window_buffer_
      * - \c pending_samples_paused_
+     *
+     * Samples are kept in one-second buckets, so outdated buckets are dropped at once without visiting their samples.
      */
     void remove_outdated_samples_nts_();
 
@@ -374,14 +475,57 @@ protected:
     //! MCAP/SQL writer
     BaseWriter* writer_;
 
-    //! Samples buffer
-    std::list<std::shared_ptr<const BaseMessage>> samples_buffer_;
+    //! Topics of the received samples, shared among them (declared before the buffers so it outlives them)
+    TopicRegistry topics_;
+
+    //! Samples buffer (preallocated to \c buffer_size )
+    SamplesBatch samples_buffer_;
+
+    //! Samples buffer in PAUSED state, where samples received in the last \c event_window seconds are kept
+    EventWindowBuffer event_window_buffer_;
 
     //! Structure where messages (received in RUNNING state) with unknown type are kept
-    std::map<std::string, std::list<std::shared_ptr<const BaseMessage>>> pending_samples_;
+    std::map<std::string, SamplesQueue> pending_samples_;
 
     //! Structure where messages (received in PAUSED state) with unknown type are kept
-    std::map<std::string, std::list<std::shared_ptr<const BaseMessage>>> pending_samples_paused_;
+    std::map<std::string, EventWindowBuffer> pending_samples_paused_;
+
+    //! Memory [bytes] taken by the payloads in \c samples_buffer_
+    std::uint64_t samples_buffer_memory_{0};
+
+    //! Memory [bytes] taken by the payloads in \c pending_samples_
+    std::uint64_t pending_samples_memory_{0};
+
+    ///////////////////////
+    // WRITER MANAGEMENT //
+    ///////////////////////
+
+    //! Mutex serializing calls to \c write_samples_ (and protecting the data structures accessed from it)
+    std::mutex write_mtx_;
+
+    //! Writer thread (only launched if \c async_write is enabled)
+    std::thread writer_thread_;
+
+    //! Batches of samples waiting to be written
+    std::deque<SamplesBatch> writer_queue_;
+
+    //! Already written (empty) batches, kept to be swapped with full buffers without allocating
+    std::vector<SamplesBatch> spare_batches_;
+
+    //! Max number of batches in \c spare_batches_
+    static constexpr std::size_t MAX_SPARE_BATCHES_ = 2;
+
+    //! Number of samples in \c writer_queue_
+    std::size_t writer_queue_size_ = 0;
+
+    //! Signals writer thread to exit once \c writer_queue_ is empty
+    bool writer_stop_ = false;
+
+    //! Writer condition variable
+    std::condition_variable writer_cv_;
+
+    //! Writer condition variable mutex (protects \c writer_queue_ and \c spare_batches_ )
+    std::mutex writer_cv_mutex_;
 
     //////////////////////////////
     // DYNAMIC TYPES COLLECTION //
@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+
 #include <ddsrecorder_participants/recorder/output/OutputSettings.hpp>
 
 namespace eprosima {
@@ -89,6 +92,24 @@ struct BaseHandlerConfiguration
 
     //! Whether to generate schemas as OMG IDL or ROS2 msg
     bool ros2_types;
+
+    //! Max memory [bytes] taken by the payloads kept in the buffers (0 <-> no limit)
+    std::uint64_t max_buffer_memory{0};
+
+    //! Write samples to disk from a dedicated thread instead of from the threads receiving them
+    bool async_write{false};
+
+    //! Max number of samples queued for the writer thread before reception is blocked (applies to async_write)
+    unsigned int async_write_queue_size{10000};
+
+    //! File where the payloads of the event window are spilled to (applies to paused state, empty <-> no spill)
+    std::string event_window_spill_file{};
+
+    //! Size [bytes] of the event window spill file
+    std::uint64_t event_window_spill_size{0};
+
+    //! Max memory [bytes] taken by the payloads of the event window before spilling them to file
+    std::uint64_t event_window_spill_threshold{0};
 };
 
 } /* namespace participants */
@@ -0,0 +1,221 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file EventWindowBuffer.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/handler/EventWindowSpill.hpp>
+#include <ddsrecorder_participants/recorder/message/BaseMessage.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Buffer keeping the samples received in PAUSED state, grouped by the second of their reception time.
+ *
+ * Since samples are (mostly) received in \c log_time order, expiring the samples outside the event window just drops
+ * whole buckets from the front of the buffer, instead of sweeping every sample.
+ *
+ * Optionally, the payloads of the oldest samples are spilled to an \c EventWindowSpill file once the payloads kept in
+ * memory exceed a threshold, so the event window is bounded by disk space instead of memory. Spilled payloads are read
+ * back when the samples are moved out of the buffer.
+ *
+ * The buffered samples are not modified: a spilled sample is replaced by a copy without payload (see
+ * \c BaseMessage::copy_with_payload ), so its payload is released once no one else references the sample.
+ */
+class EventWindowBuffer
+{
+public:
+
+    using SamplesBatch = std::vector<std::shared_ptr<const BaseMessage>>;
+
+    /**
+     * @brief Spills the payloads of the oldest samples to \c spill whenever the payloads in memory exceed
+     * \c memory_threshold bytes.
+     *
+     * @param spill            Spill file where payloads are written.
+     * @param memory_threshold Max memory [bytes] taken by the payloads kept in memory.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void enable_spill(
+            std::unique_ptr<EventWindowSpill> spill,
+            std::uint64_t memory_threshold);
+
+    /**
+     * @brief Adds a sample to the bucket corresponding to its \c log_time .
+     *
+     * @param sample Sample to be added.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void push_back(
+            std::shared_ptr<const BaseMessage> sample);
+
+    /**
+     * @brief Removes the samples whose \c log_time is older than \c threshold .
+     *
+     * Buckets fully older than \c threshold are dropped at once, and only the samples in the bucket containing
+     * \c threshold are checked one by one.
+     *
+     * @param threshold Reception time of the oldest sample to keep.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void remove_outdated(
+            const ddspipe::core::types::DataTime& threshold);
+
+    /**
+     * @brief Returns the oldest sample (i.e. the first one in the oldest bucket).
+     *
+     * @pre The buffer is not empty.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    const BaseMessage& front() const;
+
+    /**
+     * @brief Removes the oldest sample (i.e. the first one in the oldest bucket).
+     *
+     * @pre The buffer is not empty.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void pop_front();
+
+    /**
+     * @brief Spills the payloads of the oldest samples until the payloads in memory take at most \c memory bytes.
+     *
+     * Does nothing if spilling is not enabled.
+     *
+     * @param memory Max memory [bytes] taken by the payloads kept in memory.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void spill(
+            std::uint64_t memory);
+
+    /**
+     * @brief Moves the oldest \c max_samples samples (sorted by bucket) to the end of \c samples .
+     *
+     * Spilled payloads are read back from the spill file, so moving the buffer in chunks bounds the memory required.
+     *
+     * @param samples     Batch where samples are appended.
+     * @param max_samples Max number of samples to move (every sample by default).
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void move_to(
+            SamplesBatch& samples,
+            std::size_t max_samples = std::numeric_limits<std::size_t>::max());
+
+    /**
+     * @brief Removes every sample.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void clear() noexcept;
+
+    //! Number of samples in the buffer
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::size_t size() const noexcept;
+
+    //! Whether the buffer has no samples
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool empty() const noexcept;
+
+    //! Memory [bytes] taken by the payloads of the samples in the buffer (not counting the spilled ones)
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::uint64_t memory() const noexcept;
+
+protected:
+
+    //! Sample in the buffer
+    struct Entry
+    {
+        //! Buffered sample (a copy without payload if spilled)
+        std::shared_ptr<const BaseMessage> sample;
+
+        //! Payload of the sample in the spill file (if spilled)
+        std::optional<EventWindowSpill::RecordId> record;
+    };
+
+    //! Samples received within the same second
+    struct Bucket
+    {
+        //! Samples in reception order
+        std::vector<Entry> entries;
+
+        //! Memory [bytes] taken by the payloads of \c entries (not counting the spilled ones)
+        std::uint64_t memory{0};
+
+        //! Number of leading \c entries already visited by \c spill (spilled, or too large to be spilled)
+        std::size_t spill_position{0};
+    };
+
+    /**
+     * @brief Moves the payload of \c entry to the spill file, dropping the oldest buckets (but \c bucket) to make room.
+     *
+     * @return Whether the payload was spilled.
+     */
+    bool spill_entry_(
+            std::map<std::int32_t, Bucket>::iterator bucket,
+            Entry& entry);
+
+    /**
+     * @brief Reads the payload of \c entry back from the spill file.
+     *
+     * @return Whether the payload was restored.
+     */
+    bool restore_entry_(
+            Entry& entry);
+
+    /**
+     * @brief Releases the space taken in the spill file by \c entry (if spilled).
+     */
+    void release_entry_(
+            const Entry& entry);
+
+    /**
+     * @brief Removes the oldest bucket.
+     */
+    void pop_front_bucket_();
+
+    //! Samples grouped by the second (of their \c log_time ) they were received in
+    std::map<std::int32_t, Bucket> buckets_;
+
+    //! Number of samples in \c buckets_
+    std::size_t size_{0};
+
+    //! Memory [bytes] taken by the payloads of the samples in \c buckets_ (not counting the spilled ones)
+    std::uint64_t memory_{0};
+
+    //! Spill file (if spilling is enabled)
+    std::unique_ptr<EventWindowSpill> spill_;
+
+    //! Max memory [bytes] taken by the payloads kept in memory before spilling them
+    std::uint64_t spill_threshold_{0};
+
+    //! Buckets older than this key have already been spilled (the bucket of this key may still receive samples)
+    std::int32_t next_spill_key_{std::numeric_limits<std::int32_t>::min()};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
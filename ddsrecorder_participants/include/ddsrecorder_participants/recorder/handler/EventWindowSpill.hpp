@@ -0,0 +1,165 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file EventWindowSpill.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Preallocated file, mapped in memory, where the payloads of the samples in the event window are spilled to.
+ *
+ * The file is used as a ring: payloads are appended after the newest one, wrapping around to the beginning of the file
+ * when reaching its end. Payloads may be released in any order, but their space is only reused once every older
+ * payload has been released too.
+ */
+class EventWindowSpill
+{
+public:
+
+    //! Identifier of a payload stored in the spill file
+    using RecordId = std::uint64_t;
+
+    /**
+     * @brief Creates (or truncates) \c file_path, reserves \c capacity bytes in disk and maps it in memory.
+     *
+     * @param file_path Path of the spill file.
+     * @param capacity  Size [bytes] of the spill file.
+     *
+     * @throw \c InitializationException if the file cannot be created, reserved or mapped.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    EventWindowSpill(
+            const std::string& file_path,
+            std::uint64_t capacity);
+
+    /**
+     * @brief Unmaps and removes the spill file.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    ~EventWindowSpill();
+
+    EventWindowSpill(
+            const EventWindowSpill&) = delete;
+
+    EventWindowSpill& operator =(
+            const EventWindowSpill&) = delete;
+
+    /**
+     * @brief Copies \c size bytes from \c data to the spill file.
+     *
+     * @param [in]  data   Payload to be copied.
+     * @param [in]  size   Size [bytes] of the payload.
+     * @param [out] record Identifier of the stored payload.
+     *
+     * @return Whether there was enough free space for the payload.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool write(
+            const void* data,
+            std::uint32_t size,
+            RecordId& record);
+
+    /**
+     * @brief Copies the payload identified by \c record to \c data.
+     *
+     * @pre \c data has room for \c size(record) bytes.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void read(
+            RecordId record,
+            void* data) const;
+
+    //! Size [bytes] of the payload identified by \c record
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::uint32_t size(
+            RecordId record) const;
+
+    /**
+     * @brief Releases the space taken by the payload identified by \c record.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void release(
+            RecordId record);
+
+    /**
+     * @brief Releases every payload.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void clear() noexcept;
+
+    //! Size [bytes] of the spill file
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::uint64_t capacity() const noexcept;
+
+protected:
+
+    //! Payload stored in the spill file
+    struct Record
+    {
+        //! Position of the payload in the file
+        std::uint64_t offset;
+
+        //! Size [bytes] of the payload
+        std::uint32_t size;
+
+        //! Whether the payload has been released (but its space cannot be reused yet)
+        bool released;
+    };
+
+    //! Records in the order they were written
+    std::deque<Record> records_;
+
+    //! Identifier of the first record in \c records_
+    RecordId first_record_{0};
+
+    //! Position where the next payload is written
+    std::uint64_t head_{0};
+
+    //! Path of the spill file
+    std::string file_path_;
+
+    //! Size [bytes] of the spill file
+    std::uint64_t capacity_;
+
+    //! Spill file mapped in memory
+    std::byte* data_{nullptr};
+
+#if defined(_WIN32)
+    //! Handle of the spill file
+    void* file_handle_{nullptr};
+
+    //! Handle of the file mapping
+    void* mapping_handle_{nullptr};
+#else
+    //! File descriptor of the spill file
+    int file_descriptor_{-1};
+#endif // if defined(_WIN32)
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -46,6 +46,7 @@ namespace participants {
 class BaseHandler;
 class FileTracker;
 class HandlerContextCollection;
+class HandlerFanOut;
 enum class BaseHandlerStateCode;
 
 /**
@@ -91,6 +92,9 @@ public:
      * @param discovery_database Shared pointer to the discovery database.
      * @param init_state Initial handler state code.
      * @param on_disk_full_callback Callback to invoke when disk is full.
+     * @param fan_out Optional fan-out shared with other contexts. If given, the handler is fed by the (single)
+     *                participant of the fan-out, which is created with \c participant_configuration by the first
+     *                context sharing it.
      *
      * @return Shared pointer to the created \c HandlerContext.
      */
@@ -102,7 +106,8 @@ public:
             std::shared_ptr<eprosima::ddspipe::core::ParticipantsDatabase> participants_database,
             std::shared_ptr<eprosima::ddspipe::core::DiscoveryDatabase> discovery_database,
             const participants::BaseHandlerStateCode& init_state,
-            const std::function<void()>& on_disk_full_callback);
+            const std::function<void()>& on_disk_full_callback,
+            std::shared_ptr<HandlerFanOut> fan_out = nullptr);
 
 protected:
 
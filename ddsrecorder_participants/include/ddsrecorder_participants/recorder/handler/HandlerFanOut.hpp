@@ -0,0 +1,107 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file HandlerFanOut.hpp
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <fastdds/dds/xtypes/dynamic_types/DynamicType.hpp>
+
+#include <ddspipe_participants/participant/dynamic_types/ISchemaHandler.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddspipe {
+namespace participants {
+
+class SchemaParticipant;
+
+} /* namespace participants */
+} /* namespace ddspipe */
+
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * @brief Schema handler forwarding the schemas and samples received by a single participant to several handlers.
+ *
+ * When recording to several outputs at once (i.e. MCAP and SQL), every handler is fed by the same
+ * \c SchemaParticipant through this class, so each sample is routed and delivered by the DDS Pipe only once.
+ *
+ * @warning Handlers must be added before the participant starts receiving data.
+ *
+ * @implements ISchemaHandler
+ */
+class HandlerFanOut : public ddspipe::participants::ISchemaHandler
+{
+public:
+
+    /**
+     * @brief Adds a handler to which schemas and samples are forwarded.
+     *
+     * @param [in] handler Handler to be added.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void add_handler(
+            std::shared_ptr<ddspipe::participants::ISchemaHandler> handler);
+
+    /**
+     * @brief Forwards a schema to every handler.
+     *
+     * @param [in] dynamic_type DynamicType containing the type information.
+     * @param [in] type_identifier The TypeIdentifier that uniquely identifies the type.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void add_schema(
+            const fastdds::dds::DynamicType::_ref_type& dynamic_type,
+            const fastdds::dds::xtypes::TypeIdentifier& type_identifier) override;
+
+    /**
+     * @brief Forwards a data sample to every handler.
+     *
+     * @param [in] topic DDS topic associated to this sample.
+     * @param [in] data Sample to be added.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void add_data(
+            const ddspipe::core::types::DdsTopic& topic,
+            ddspipe::core::types::RtpsPayloadData& data) override;
+
+    //! Participant feeding the handlers (if already created)
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::shared_ptr<ddspipe::participants::SchemaParticipant> get_schema_participant() const;
+
+    //! Set the participant feeding the handlers
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void set_schema_participant(
+            const std::shared_ptr<ddspipe::participants::SchemaParticipant>& schema_participant);
+
+protected:
+
+    //! Handlers to which schemas and samples are forwarded
+    std::vector<std::shared_ptr<ddspipe::participants::ISchemaHandler>> handlers_;
+
+    //! Participant feeding the handlers (not owned, as it owns this instance)
+    std::weak_ptr<ddspipe::participants::SchemaParticipant> schema_participant_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,239 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DirectFileWriter.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mcap/writer.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * MCAP output that bypasses the page cache, for sustained high-bandwidth recordings.
+ *
+ * The file is opened with \c O_DIRECT and preallocated ahead of the writes (up to its max size), so it is not
+ * fragmented as it grows.
+ * The bytes written by the MCAP library are gathered in aligned buffers, which are written by a background thread
+ * with at most \c max_in_flight_writes buffers queued at once (the MCAP writer blocks when they are all in flight).
+ * When the file ends, the last buffer is padded to the alignment and the file is truncated to the bytes written.
+ * When the file is flushed, a padded copy of the buffer being filled is written as well, and overwritten once the
+ * buffer is full.
+ * If a write fails, the bytes after it are dropped and \c failed reports it, so the file can be abandoned.
+ *
+ * @note Only supported on Linux. If the filesystem does not support \c O_DIRECT (e.g. tmpfs), the file is written
+ * through the page cache with the same buffers.
+ */
+class DirectFileWriter : public mcap::IWritable
+{
+public:
+
+    //! Alignment [bytes] of the buffers, and of the offset and size of each write
+    static constexpr std::uint64_t ALIGNMENT{4096};
+
+    //! Default size [bytes] of each buffer
+    static constexpr std::uint64_t DEFAULT_BUFFER_SIZE{1024 * 1024};
+
+    //! Default max number of buffers queued to be written
+    static constexpr std::uint32_t DEFAULT_MAX_IN_FLIGHT_WRITES{4};
+
+    //! Size [bytes] preallocated at once ahead of the writes
+    static constexpr std::uint64_t PREALLOCATION_STEP{64 * 1024 * 1024};
+
+    /**
+     * @brief Constructor
+     *
+     * @param buffer_size Size of each buffer (rounded up to \c ALIGNMENT ).
+     * @param max_in_flight_writes Max number of buffers queued to be written.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    DirectFileWriter(
+            const std::uint64_t buffer_size = DEFAULT_BUFFER_SIZE,
+            const std::uint32_t max_in_flight_writes = DEFAULT_MAX_IN_FLIGHT_WRITES);
+
+    /**
+     * @brief Destructor
+     *
+     * Ends the file if it was not ended.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    ~DirectFileWriter() override;
+
+    /**
+     * @brief Whether this platform supports the direct output.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    static bool is_supported() noexcept;
+
+    /**
+     * @brief Creates the file.
+     *
+     * @param filename The file to create (truncated if it exists).
+     * @param max_preallocated_size The size up to which the file is preallocated (0 to not preallocate it). A failure
+     * to preallocate is not an error.
+     * @return A non-success status if the file could not be created.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    mcap::Status open(
+            const std::string& filename,
+            const std::uint64_t max_preallocated_size);
+
+    /**
+     * @brief Writes the pending bytes, waits for every write, and truncates the file to its size.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void end() override;
+
+    /**
+     * @brief Writes the pending bytes (the last ones padded to the alignment) and waits for every write.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void flush() override;
+
+    /**
+     * @brief The number of bytes written to the file (including the ones still buffered).
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    uint64_t size() const override;
+
+    /**
+     * @brief Whether a write to the file has failed (e.g. because the disk is full).
+     *
+     * The bytes written after a failed write are dropped, so the file is incomplete from then on.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool failed() const noexcept;
+
+protected:
+
+    //! An aligned buffer
+    using Buffer = std::unique_ptr<std::byte, void (*)(void*)>;
+
+    //! A buffer queued to be written
+    struct PendingWrite
+    {
+        //! The buffer
+        Buffer buffer;
+
+        //! The offset of the buffer in the file
+        std::uint64_t offset;
+
+        //! The number of bytes to write (a multiple of \c ALIGNMENT )
+        std::uint64_t size;
+    };
+
+    /**
+     * @brief Appends the bytes to the current buffer, queueing it to be written when it is full.
+     */
+    void handleWrite(
+            const std::byte* data,
+            uint64_t size) override;
+
+    /**
+     * @brief Queues the current buffer to be written and takes a free one (waiting for one if needed).
+     *
+     * @param size The number of bytes of the current buffer to write.
+     */
+    void submit_buffer_(
+            const std::uint64_t size);
+
+    /**
+     * @brief Writes the queued buffers until the file is ended.
+     */
+    void write_thread_routine_();
+
+    /**
+     * @brief Preallocates the next \c PREALLOCATION_STEP bytes of the file if a write would go past the preallocated
+     * ones.
+     *
+     * @param end_offset The offset at which the write ends.
+     */
+    void preallocate_(
+            const std::uint64_t end_offset);
+
+    //! Allocates an aligned buffer
+    Buffer allocate_buffer_() const;
+
+    //! The size of each buffer
+    const std::uint64_t buffer_size_;
+
+    //! The number of buffers that can be queued to be written
+    const std::uint32_t max_in_flight_writes_;
+
+    //! The file descriptor of the file (-1 if not open)
+    int file_descriptor_{-1};
+
+    //! The name of the file
+    std::string filename_;
+
+    //! The number of bytes written to the file (including the ones still buffered)
+    std::uint64_t size_{0};
+
+    //! The offset of the current buffer in the file
+    std::uint64_t buffer_offset_{0};
+
+    //! The number of bytes in the current buffer
+    std::uint64_t buffer_used_{0};
+
+    //! The number of bytes preallocated (only accessed by the write thread)
+    std::uint64_t preallocated_size_{0};
+
+    //! The size up to which the file is preallocated (only accessed by the write thread)
+    std::uint64_t max_preallocated_size_{0};
+
+    //! The buffer being filled
+    Buffer buffer_;
+
+    //! The buffers that are not being filled nor written
+    std::vector<Buffer> free_buffers_;
+
+    //! The buffers queued to be written
+    std::deque<PendingWrite> pending_writes_;
+
+    //! Whether the write thread must stop once the queued buffers have been written
+    bool stop_{false};
+
+    //! Whether a write has failed (the following bytes are dropped)
+    std::atomic<bool> failed_{false};
+
+    //! The thread writing the queued buffers
+    std::thread write_thread_;
+
+    //! The mutex to protect the queued and free buffers
+    std::mutex mutex_;
+
+    //! Notified when a buffer is queued or written
+    std::condition_variable cv_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,117 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapCompressionPolicy.hpp
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <mcap/mcap.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Class that adapts the compression of the chunks of an MCAP file to the load.
+ *
+ * The compression is lowered one step when compressing a chunk takes too long compared to the time it took to fill it
+ * (or when the compression threads fall behind), and raised back one step after enough chunks have been compressed
+ * with plenty of spare time.
+ */
+class McapCompressionPolicy
+{
+public:
+
+    //! The compression settings of a step
+    using Step = std::pair<mcap::Compression, mcap::CompressionLevel>;
+
+    /**
+     * @brief Constructor
+     *
+     * @param mcap_configuration The configuration of the MCAP writer (with the configured compression).
+     * @param adaptive Whether to step down from the configured compression under load.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    McapCompressionPolicy(
+            const mcap::McapWriterOptions& mcap_configuration,
+            const bool adaptive);
+
+    /**
+     * @brief Whether there is more than one step to choose from.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool is_adaptive() const;
+
+    /**
+     * @brief The compression settings to step through, from the configured one down to no compression.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    const std::vector<Step>& steps() const;
+
+    /**
+     * @brief The index in \c steps of the compression settings in use.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::size_t step_index() const;
+
+    /**
+     * @brief The compression settings in use.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    const Step& step() const;
+
+    /**
+     * @brief Adapts the compression of the next chunks, once a chunk has been completed.
+     *
+     * @param fill_time The time it took to fill the chunk.
+     * @param compression_time The time it took to compress the last chunk written.
+     * @param pending_chunks The number of chunks handed over to the compression threads and not written yet.
+     * @return Whether the compression settings changed.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool on_chunk(
+            const std::chrono::nanoseconds fill_time,
+            const std::chrono::nanoseconds compression_time,
+            const std::size_t pending_chunks);
+
+    // The number of consecutive idle chunks before raising the compression one step
+    static constexpr std::uint32_t IDLE_CHUNKS_TO_RAISE_COMPRESSION{16};
+
+protected:
+
+    // The number of threads compressing the chunks (0 to compress them inline)
+    const std::uint32_t compression_threads_;
+
+    // The compression settings to step through, from the configured one down to no compression
+    std::vector<Step> steps_;
+
+    // The index in steps_ of the compression settings in use
+    std::size_t step_{0};
+
+    // The number of consecutive chunks compressed with plenty of spare time
+    std::uint32_t idle_chunks_{0};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -19,10 +19,12 @@
 #pragma once
 
 #include <functional>
-#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <regex>
 #include <string>
+#include <vector>
 
 #include <mcap/mcap.hpp>
 
@@ -49,6 +51,9 @@ namespace participants {
  * Class that manages the interaction between DDS Pipe (\c SchemaParticipant) and MCAP files through mcap library.
  * Payloads are efficiently passed from DDS Pipe to mcap without copying data (only references).
  *
+ * The topics of each topic group are recorded to the group's own MCAP files, through its own \c McapWriter .
+ * Every writer receives every schema and dynamic type, so the schema ids are the same in every file.
+ *
  * @implements BaseHandler
  */
 class McapHandler : public BaseHandler
@@ -61,7 +66,7 @@ public:
      * Creates McapHandler instance with given configuration, payload pool and initial state.
      * Opens temporal MCAP file where data is to be written.
      *
-     * @throw InitializationException if creation fails (fail to open MCAP file).
+     * @throw InitializationException if creation fails (fail to open MCAP file, or invalid topic group regex).
      *
      * @warning Command methods (\c start , \c pause , \c stop , and \c trigger_event) are not thread safe
      * among themselves. This is, they are expected to be executed sequentially and all in the same thread.
@@ -91,7 +96,13 @@ public:
     virtual ~McapHandler();
 
     /**
-     * @brief Disable MCAP handler instance
+     * @brief Enable MCAP handler instance (and the writers of the topic groups)
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void enable() override;
+
+    /**
+     * @brief Disable MCAP handler instance (and the writers of the topic groups)
      */
     DDSRECORDER_PARTICIPANTS_DllAPI
     void disable() override;
@@ -135,14 +146,13 @@ protected:
     /**
      * @brief Writes \c samples to disk.
      *
-     * For each sample in \c samples, it downcasts it to \c McapMessage, writes it to disk, and removes it from
-     * \c samples.
-     * The method ends when \c samples is empty.
+     * For each sample in \c samples, it downcasts it to \c McapMessage and writes it to disk.
+     * The method ends by clearing \c samples.
      *
-     * @param [in] samples List of samples to be written.
+     * @param [in] samples Batch of samples to be written.
      */
     void write_samples_(
-            std::list<std::shared_ptr<const BaseMessage>>& samples) override;
+            SamplesBatch& samples) override;
 
     /**
      * @brief Create and add to \c mcap_writer_ channel associated to given \c topic
@@ -167,17 +177,17 @@ protected:
             const ddspipe::core::types::DdsTopic& topic);
 
     /**
-     * @brief Update channels with \c old_schema_id to use \c new_schema_id instead.
+     * @brief Update channels with \c old_schema_id to use \c new_schema instead.
      *
      * Its main purpose is to update channels previously created with blank schema after having received their
      * corresponding topic type.
      *
      * @param [in] old_schema_id Schema id used by the channels to be updated
-     * @param [in] new_schema_id Schema id with which to update channels (using \c old_schema_id)
+     * @param [in] new_schema    Schema with which to update channels (using \c old_schema_id)
      */
     void update_channels_nts_(
             const mcap::SchemaId& old_schema_id,
-            const mcap::SchemaId& new_schema_id);
+            const mcap::Schema& new_schema);
 
     /**
      * @brief Attempt to get schema with name \c schema_name.
@@ -189,6 +199,37 @@ protected:
     mcap::SchemaId get_schema_id_nts_(
             const std::string& schema_name);
 
+    /**
+     * @brief Write \c schema to every writer, so its id is the same in every file.
+     *
+     * @param [in] schema Schema to write (its id is set by the writers).
+     */
+    void write_schema_nts_(
+            mcap::Schema& schema);
+
+    /**
+     * @brief Get the writer of the files the data in \c topic is recorded to.
+     *
+     * The first topic group whose regex matches the topic name is taken, or \c mcap_writer_ if none does.
+     *
+     * @param [in] topic Topic whose writer to get.
+     */
+    McapWriter& get_writer_(
+            const ddspipe::core::types::DdsTopic& topic);
+
+    //! Writer of the MCAP files of a topic group
+    struct TopicGroupWriter
+    {
+        //! Regex matched against the names of the topics of the group
+        std::regex topics;
+
+        //! File tracker of the files of the group
+        std::shared_ptr<FileTracker> file_tracker;
+
+        //! MCAP writer of the files of the group
+        std::unique_ptr<McapWriter> writer;
+    };
+
     //! Configuration
     const McapHandlerConfiguration configuration_;
 
@@ -201,8 +242,14 @@ protected:
     //! Channels map
     std::map<ddspipe::core::types::DdsTopic, mcap::Channel> channels_;
 
-    //! Channels map by id
-    std::map<mcap::ChannelId, mcap::Channel> channels_by_id_;
+    //! Writers of the topic groups
+    std::vector<TopicGroupWriter> topic_group_writers_;
+
+    //! Writer of each topic, by topic name (cached the first time the topic is matched against the topic groups)
+    std::map<std::string, McapWriter*> topic_writers_;
+
+    //! Protects \c topic_writers_ (the samples are written outside \c mtx_ )
+    std::mutex topic_writers_mtx_;
 };
 
 } /* namespace participants */
@@ -18,15 +18,44 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include <mcap/mcap.hpp>
 
+#include <cpp_utils/macros/custom_enumeration.hpp>
+
+#include <ddsrecorder_participants/common/compression/ZstdDictionary.hpp>
 #include <ddsrecorder_participants/recorder/handler/BaseHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/output/OutputSettings.hpp>
+#include <ddsrecorder_participants/recorder/output/ResourceLimits.hpp>
 
 namespace eprosima {
 namespace ddsrecorder {
 namespace participants {
 
+ENUMERATION_BUILDER(
+    McapIoBackend,
+    buffered,
+    direct
+    );
+
+/**
+ * Group of topics recorded to their own MCAP files, with their own size budget.
+ */
+struct McapTopicGroup
+{
+    //! Name of the group, appended to the name of its files
+    std::string name;
+
+    //! Regex matched against the names of the topics of the group
+    std::string topics;
+
+    //! Resource limits of the files of the group
+    ResourceLimitsStruct resource_limits;
+};
+
 /**
  * Structure encapsulating all of \c McapHandler configuration options.
  */
@@ -81,6 +110,27 @@ struct McapHandlerConfiguration : public BaseHandlerConfiguration
 
     //! Mcap writer configuration options
     mcap::McapWriterOptions mcap_writer_options;
+
+    //! Lower the compression of the chunks under load (and raise it back up to the configured one when idle)
+    bool adaptive_compression{false};
+
+    //! Number of small messages of each schema to train its zstd dictionary from (0 to disable the dictionaries)
+    std::uint32_t dictionary_samples{0};
+
+    //! Max size of each zstd dictionary
+    std::uint64_t dictionary_max_size{ZstdDictionary::DEFAULT_MAX_SIZE};
+
+    //! Percentage of the max file size at which the next file is opened in the background (0 to disable it)
+    std::uint32_t prepare_next_file{0};
+
+    //! How the MCAP files are written to disk
+    McapIoBackend io_backend{McapIoBackend::buffered};
+
+    //! Period [s] at which the MCAP file is checkpointed, so it can be recovered after a crash (0 to disable it)
+    std::uint32_t checkpoint_period{0};
+
+    //! Groups of topics recorded to their own MCAP files (the topics in no group are recorded to the main ones)
+    std::vector<McapTopicGroup> topic_groups;
 };
 
 } /* namespace participants */
@@ -0,0 +1,267 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapRecovery.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <mcap/mcap.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Rebuilds the summary of an MCAP file that was not closed (e.g. the recorder was killed).
+ *
+ * The data section is walked record by record, reading only the headers of the chunks and their message indexes, so
+ * the time it takes is proportional to the number of chunks rather than to the size of the file:
+ * - The chunk indexes and the statistics are rebuilt from the chunk headers and their message indexes.
+ * - The schemas and channels are taken from the last checkpoint (see \c serialize_checkpoint ). Only the chunks with
+ *   channels missing from it (i.e. added after it, or every chunk if the file has no checkpoints) are decompressed.
+ * - The attachments and metadata are indexed.
+ *
+ * The data after the last complete record is dropped. If the message indexes of the last chunk are incomplete, they
+ * are rebuilt from the chunk.
+ */
+class McapRecovery
+{
+public:
+
+    //! Outcome of a recovery
+    struct Result
+    {
+        //! Whether the file was already closed (nothing is written then)
+        bool complete{false};
+
+        //! Size [bytes] of the data section kept
+        std::uint64_t data_size{0};
+
+        //! Size [bytes] of the incomplete data dropped at the end of the file
+        std::uint64_t dropped_size{0};
+
+        //! Number of chunks recovered
+        std::uint32_t chunk_count{0};
+
+        //! Number of chunks decompressed to find their channels (or rebuild their message indexes)
+        std::uint32_t decompressed_chunk_count{0};
+
+        //! Number of messages recovered
+        std::uint64_t message_count{0};
+    };
+
+    /**
+     * @brief Serializes a checkpoint: the schemas and channels of an MCAP file, as MCAP records.
+     *
+     * @param schemas The schemas of the file.
+     * @param channels The channels of the file.
+     * @param [out] serialized Serialized checkpoint.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    static void serialize_checkpoint(
+            const std::map<mcap::SchemaId, mcap::Schema>& schemas,
+            const std::map<mcap::ChannelId, mcap::Channel>& channels,
+            std::string& serialized);
+
+    /**
+     * @brief Constructor
+     *
+     * @param input_file The MCAP file to recover.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    McapRecovery(
+            const std::string& input_file);
+
+    /**
+     * @brief Rebuilds the summary of the MCAP file.
+     *
+     * @param output_file The file to write the recovered MCAP to. If empty, the input file is recovered in place: it
+     * is truncated after its last complete record and the summary is appended to it.
+     * @return The outcome of the recovery.
+     * @throws \c InitializationException if the input file is not an MCAP file, or the files cannot be read or written.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    Result recover(
+            const std::string& output_file = "");
+
+protected:
+
+    //! Closes a file on destruction
+    using FilePtr = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+    /**
+     * @brief Walks the data section of the file, indexing its records.
+     *
+     * @return Whether the file was already closed.
+     */
+    bool scan_();
+
+    /**
+     * @brief Indexes the chunk at \c offset .
+     *
+     * @return Whether the chunk header is valid.
+     */
+    bool read_chunk_(
+            const std::uint64_t offset,
+            const std::uint64_t length);
+
+    /**
+     * @brief Indexes the message index at \c offset , of the last chunk.
+     *
+     * @return Whether the message index is valid.
+     */
+    bool read_message_index_(
+            const std::uint64_t offset,
+            const std::uint64_t length);
+
+    /**
+     * @brief Counts the message (not in a chunk) at \c offset .
+     *
+     * @return Whether the message is valid.
+     */
+    bool read_message_(
+            const std::uint64_t offset,
+            const std::uint64_t length);
+
+    /**
+     * @brief Indexes the attachment at \c offset , taking the schemas and channels of checkpoints.
+     *
+     * @return Whether the attachment is valid.
+     */
+    bool read_attachment_(
+            const std::uint64_t offset);
+
+    /**
+     * @brief Indexes the metadata at \c offset .
+     *
+     * @return Whether the metadata is valid.
+     */
+    bool read_metadata_(
+            const std::uint64_t offset);
+
+    /**
+     * @brief Takes the schemas and channels of a serialized checkpoint.
+     */
+    void read_checkpoint_(
+            const std::byte* data,
+            const std::uint64_t size);
+
+    /**
+     * @brief Drops the message indexes of the last chunk, to rebuild them from the chunk.
+     */
+    void drop_last_message_indexes_();
+
+    /**
+     * @brief Decompresses the chunks with unknown channels (and the one whose message indexes are rebuilt).
+     */
+    void recover_chunks_();
+
+    /**
+     * @brief Decompresses a chunk, taking its schemas and channels (and rebuilding its message indexes).
+     *
+     * @return Whether the chunk could be decompressed.
+     */
+    bool recover_chunk_(
+            const mcap::ChunkIndex& chunk_index,
+            const bool rebuild_message_indexes);
+
+    /**
+     * @brief Copies the data section of the input file to \c output .
+     */
+    void copy_data_(
+            std::FILE* output);
+
+    /**
+     * @brief Writes the rebuilt message indexes, the data end, the summary and the footer to \c output .
+     */
+    void write_summary_(
+            std::FILE* output);
+
+    /**
+     * @brief Reads \c size bytes of the input file at \c offset .
+     *
+     * @return The bytes read (valid until the next read), or nullptr if there are not enough bytes.
+     */
+    const std::byte* read_(
+            const std::uint64_t offset,
+            const std::uint64_t size);
+
+    //! Size [bytes] of the opcode and length of a record
+    static constexpr std::uint64_t RECORD_HEADER_SIZE{9};
+
+    //! Max size [bytes] read of a chunk to parse its header
+    static constexpr std::uint64_t CHUNK_HEADER_MAX_SIZE{256};
+
+    //! Size [bytes] of the data copied at once to an output file
+    static constexpr std::uint64_t COPY_BUFFER_SIZE{1024 * 1024};
+
+    //! The MCAP file to recover
+    const std::string input_file_;
+
+    //! The input file (nullptr if not open)
+    FilePtr input_{nullptr, std::fclose};
+
+    //! The reader of the input file
+    std::unique_ptr<mcap::FileReader> reader_;
+
+    //! The offset at which the data section kept ends
+    std::uint64_t data_end_{0};
+
+    //! The schemas found, by id
+    std::map<mcap::SchemaId, mcap::Schema> schemas_;
+
+    //! The channels found, by id
+    std::map<mcap::ChannelId, mcap::Channel> channels_;
+
+    //! The index of each chunk
+    std::vector<mcap::ChunkIndex> chunk_indexes_;
+
+    //! The number of messages of each channel in the last chunk
+    std::unordered_map<mcap::ChannelId, std::uint64_t> last_chunk_message_counts_;
+
+    //! Whether the message indexes of the last chunk are rebuilt from it
+    bool rebuild_last_message_indexes_{false};
+
+    //! The message indexes rebuilt for the last chunk, by channel
+    std::map<mcap::ChannelId, mcap::MessageIndex> rebuilt_message_indexes_;
+
+    //! The index of each attachment
+    std::vector<mcap::AttachmentIndex> attachment_indexes_;
+
+    //! The index of each metadata
+    std::vector<mcap::MetadataIndex> metadata_indexes_;
+
+    //! The statistics of the file
+    mcap::Statistics statistics_{};
+
+    //! The number of chunks decompressed
+    std::uint32_t decompressed_chunk_count_{0};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -54,12 +54,11 @@ public:
     ~McapSizeTracker();
 
     /**
-     * @brief Initialize the tracker with a given \c space_available and \c size_tolerance.
+     * @brief Initialize the tracker with a given \c space_available.
      */
     DDSRECORDER_PARTICIPANTS_DllAPI
     void init(
             const std::uint64_t& space_available,
-            const std::uint64_t& size_tolerance,
             const std::string& filepath);
 
     DDSRECORDER_PARTICIPANTS_DllAPI
@@ -98,10 +97,50 @@ public:
             const uint64_t& payload_size_to_write,
             const uint64_t& payload_size_to_remove);
 
+    /**
+     * @brief Allocates the space for a new version of an attachment whose previous version has already been written
+     * (i.e. by a checkpoint), so its space is no longer allocated.
+     *
+     * The minimum size of the next files only increases by the growth of the attachment.
+     *
+     * @throws \c FullFileException if there is not enough space for it.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void attachment_to_rewrite(
+            const uint64_t& payload_size_to_write,
+            const uint64_t& payload_size_written);
+
     DDSRECORDER_PARTICIPANTS_DllAPI
     void attachment_written(
             const uint64_t& payload_size);
 
+    /**
+     * @brief Resizes the space allocated for the source GUID index attachment.
+     *
+     * Unlike other attachments, the index only holds the messages of the current file, so it does not increase the
+     * minimum size of the next files.
+     * A size of 0 stands for no attachment.
+     *
+     * @throws \c FullFileException if there is not enough space to resize it.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void source_guid_index_to_write(
+            const uint64_t& payload_size_to_write,
+            const uint64_t& payload_size_to_remove);
+
+    /**
+     * @brief Allocates the space for an attachment written in a checkpoint.
+     *
+     * Unlike other attachments, checkpoints are not rewritten in the next files, so they do not increase the minimum
+     * size of the next files.
+     * Skipping a checkpoint is harmless, so a full file is not an error.
+     *
+     * @return Whether there is enough space for the attachment.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool checkpoint_to_write(
+            const uint64_t& payload_size);
+
     DDSRECORDER_PARTICIPANTS_DllAPI
     void metadata_to_write(
             const mcap::Metadata& metadata);
@@ -110,6 +149,21 @@ public:
     void metadata_written(
             const mcap::Metadata& metadata);
 
+    /**
+     * @brief Replaces the estimated written size with the bytes actually written to the MCAP file.
+     *
+     * The space allocated for objects not yet written is kept.
+     *
+     * @param flushed_size  Bytes written to the MCAP file, once compressed.
+     * @param buffered_size Upper bound of the bytes written to the MCAP writer but not to the file yet.
+     * @param chunk_count   Number of chunks closed in the MCAP file.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void sync(
+            const std::uint64_t& flushed_size,
+            const std::uint64_t& buffered_size,
+            const std::uint64_t& chunk_count);
+
     DDSRECORDER_PARTICIPANTS_DllAPI
     std::uint64_t get_potential_mcap_size() const;
 
@@ -185,18 +239,15 @@ protected:
     //! Written (estimated) file size, that takes into account written objects
     std::uint64_t written_mcap_size_{MCAP_FILE_OVERHEAD};
 
-    /* To have a size checker of the MCAP file, we need to check the size of the file every X bytes but the file may not be written yet
-     * so we need a variable to "time" the check (variation between written_mcap_size_ and checked_written_mcap_size_) and another variable
-     * to store the size of the file the last time it was checked to know if it has been updated (checked_actual_mcap_size_)
+    /**
+     * Estimated size of the written objects that are not in the file yet, and are not buffered by the MCAP writer
+     * either: the summary section and the footer, and the schemas and channels (only written to a chunk with the first
+     * message in them).
      */
-    // The value written_mcap_size_ had when doing the last check
-    std::uint64_t checked_written_mcap_size_{0};
+    std::uint64_t summary_mcap_size_{MCAP_FILE_OVERHEAD};
 
-    // The actual size of the mcap file the last time it was checked
-    std::uint64_t checked_actual_mcap_size_{0};
-
-    // Threshold of bytes stimated between checks before checking the size of the file again. This value is set to half size_tolerance in init
-    std::uint64_t check_interval_{500 * 1024}; // 300 KB
+    //! Number of channels written
+    std::uint64_t channel_count_{0};
 
     //! The minimum size of an MCAP file without data
     std::uint64_t min_mcap_size_{MCAP_FILE_OVERHEAD};
@@ -209,11 +260,6 @@ protected:
 
     bool enabled_ = false;
 
-    // Number of potential messages
-    int potential_count;
-    // Number of written messages
-    int written_count;
-
     //! MCAP file overhead
     /**
      * To reach this number, we use the following constants:
@@ -236,9 +282,21 @@ protected:
     //! Additional overhead size for a MCAP attachment
     static constexpr std::uint64_t MCAP_ATTACHMENT_OVERHEAD{58 + 70}; // Write Attachment + Write AttachmentIndex
 
+    //! Size of the index of a MCAP attachment, in the summary section
+    static constexpr std::uint64_t MCAP_ATTACHMENT_INDEX_OVERHEAD{70}; // Write AttachmentIndex
+
     //! Additional overhead size for a MCAP metadata
     static constexpr std::uint64_t MCAP_METADATA_OVERHEAD{17 + 29}; // Write Metadata + Write MetadataIndex
 
+    //! Additional overhead size of the index of a MCAP metadata, in the summary section
+    static constexpr std::uint64_t MCAP_METADATA_INDEX_OVERHEAD{29}; // Write MetadataIndex
+
+    //! Size of the index of a MCAP chunk, in the summary section
+    static constexpr std::uint64_t MCAP_CHUNK_INDEX_OVERHEAD{73}; // Write ChunkIndex
+
+    //! Additional size of the index of a MCAP chunk for each channel
+    static constexpr std::uint64_t MCAP_CHUNK_INDEX_CHANNEL_OVERHEAD{10}; // messageIndexOffsetsSize
+
 };
 
 } /* namespace participants */
@@ -18,13 +18,31 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <mcap/mcap.hpp>
 
 #include <fastdds/rtps/common/SerializedPayload.hpp>
 
+#include <ddsrecorder_participants/common/compression/ZstdDictionary.hpp>
+#include <ddsrecorder_participants/common/serialize/SerializedDynamicTypesCollection.hpp>
+#include <ddsrecorder_participants/common/serialize/SourceGuidIndex.hpp>
 #include <ddsrecorder_participants/library/library_dll.h>
+#include <ddsrecorder_participants/recorder/exceptions/FullDiskException.hpp>
+#include <ddsrecorder_participants/recorder/handler/mcap/McapCompressionPolicy.hpp>
+#include <ddsrecorder_participants/recorder/handler/mcap/McapHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/handler/mcap/McapSizeTracker.hpp>
 #include <ddsrecorder_participants/recorder/handler/BaseWriter.hpp>
 
@@ -49,15 +67,41 @@ public:
      * @param mcap_configuration The MCAP writer options.
      * @param file_tracker The file tracker to track the files written by the output library.
      * @param record_types Whether to record the types.
+     * @param adaptive_compression Whether to lower the compression of the chunks under load (and raise it back up to
+     * the one in \c mcap_configuration when the load drops).
+     * @param dictionary_samples Number of small messages of each schema to train its zstd dictionary from (0 to not
+     * compress the messages with dictionaries).
+     * @param dictionary_max_size Max size of each zstd dictionary.
+     * @param prepare_next_file Percentage of the max file size at which the next MCAP file is opened in the background
+     * (0 to open it when the current one is full). The full files are then closed in the background too.
+     * @param io_backend How the MCAP files are written to disk.
+     * @param checkpoint_period Period [s] at which the MCAP file is checkpointed (0 to not checkpoint it): the chunk
+     * in progress is written, along with the attachments needed to read the file, and the file is flushed, so it can
+     * be recovered (see \c McapRecovery ) if it is not closed.
      */
     McapWriter(
             const OutputSettings& configuration,
             const mcap::McapWriterOptions& mcap_configuration,
             std::shared_ptr<FileTracker>& file_tracker,
-            const bool record_types = true);
+            const bool record_types = true,
+            const bool adaptive_compression = false,
+            const std::uint32_t dictionary_samples = 0,
+            const std::uint64_t dictionary_max_size = ZstdDictionary::DEFAULT_MAX_SIZE,
+            const std::uint32_t prepare_next_file = 0,
+            const McapIoBackend io_backend = McapIoBackend::buffered,
+            const std::uint32_t checkpoint_period = 0);
+
+    /**
+     * @brief Destructor
+     *
+     * Stops the checkpoints, closes the current file and waits for the files being closed in the background.
+     */
+    ~McapWriter();
 
     /**
      * @brief Disable the writer.
+     *
+     * Waits for the files being closed in the background, and removes the next file if it was already prepared.
      */
     void disable() override;
 
@@ -76,34 +120,21 @@ public:
             const T& data);
 
     /**
-     * @brief Updates the dynamic types payload.
+     * @brief Adds a dynamic type to the dynamic types payload.
      *
-     * The dynamic types payload is written down as an attachment when the MCAP file is being closed.
+     * The dynamic types payload is written down as an attachment when the MCAP file is being closed (and when it is
+     * checkpointed, if it has grown since the last checkpoint).
+     * Only the new type is serialized, so adding a type does not depend on the number of types already added.
      *
-     * @param dynamic_types_payload The dynamic types payload to be written.
+     * @param dynamic_type The dynamic type to be added.
      *
      * After a \c FullFileException :
      * - @throws \c InconsistencyException if the allocated space is not enough to close the current file or to open a
      * new one.
      * - @throws \c InitializationException if the MCAP library fails to open a new file.
      */
-    void update_dynamic_types(
-            const std::string& dynamic_types_payload);
-
-    /**
-     * @brief Adds the pair sequence_number, source guid in the dictionary.
-     *
-     * @param sequence_number The sequence number associated with a message.
-     * @param source_guid The guid associated with a message.
-     *
-     * After a \c FullFileException :
-     * - @throws \c InconsistencyException if the allocated space is not enough to close the current file or to open a
-     * new one.
-     * - @throws \c InitializationException if the MCAP library fails to open a new file.
-     */
-    void add_message_sourceguid(
-            uint32_t sequence_number,
-            const std::string source_guid);
+    void add_dynamic_type(
+            const DynamicType& dynamic_type);
 
 protected:
 
@@ -122,10 +153,23 @@ protected:
     /**
      * @brief Closes the current file.
      *
+     * If the next file is prepared in the background, the attachments and the summary are written (and the file
+     * renamed) in the background too.
+     *
      * @throws \c InconsistencyException if there is not enough space to write the attachment.
      */
     void close_current_file_nts_() override;
 
+    /**
+     * @brief Closes the current file and opens a new one, since the current one has been open for longer than the
+     * max file duration.
+     *
+     * If there is no space left for the new file, the writer is disabled and \c on_disk_full_ is called.
+     *
+     * @throws \c InitializationException if the MCAP library fails to open the new file.
+     */
+    void split_file_nts_();
+
     /**
      * @brief Writes data to the MCAP file.
      *
@@ -137,14 +181,39 @@ protected:
             const T& data);
 
     /**
-     * @brief Writes the attachment to the MCAP file.
+     * @brief Collects the attachments to write when closing the MCAP file: the zstd dictionaries, the dynamic types
+     * payload and the source GUID index (skipping the ones already written by a checkpoint).
      *
-     * The attachment is written down as a message with the attachment data.
-     * The size of the attachment is allocated by calling \c update_dynamic_types.
+     * The size of the attachments is allocated as they grow (the space reserved for the index but not used is
+     * released here).
      *
-     * @throws \c FullFileException if the MCAP file is full.
+     * @return The name and data of each attachment, in the order they must be written.
      */
-    void write_attachment_nts_();
+    std::vector<std::pair<std::string, std::string>> collect_attachments_nts_();
+
+    /**
+     * @brief Checkpoints the MCAP file, if it has changed since the last checkpoint.
+     *
+     * Writes the chunk in progress, the zstd dictionaries not written yet, the dynamic types payload (if it has
+     * grown) and the schemas and channels (if they have changed), and flushes the file.
+     * The attachments that do not fit in the file are left to be written when it is closed.
+     */
+    void write_checkpoint_nts_();
+
+    /**
+     * @brief Checkpoints the MCAP file every \c checkpoint_period_ seconds until the writer is destroyed.
+     */
+    void checkpoint_thread_routine_();
+
+    /**
+     * @brief Compresses a message with the zstd dictionary of its schema, training the dictionary first if enough
+     * samples have been collected.
+     *
+     * @param message The message to compress. If compressed, it is pointed to \c compressed_message_ .
+     * @throws \c FullFileException if the MCAP file is full when allocating the space of a new dictionary.
+     */
+    void compress_message_nts_(
+            mcap::Message& message);
 
     /**
      * @brief Writes the channels to the MCAP file.
@@ -161,16 +230,24 @@ protected:
     void write_metadata_version_nts_();
 
     /**
-     * @brief Writes the messages metadata to the MCAP file.
+     * @brief Creates the metadata with the version, written at the beginning of every MCAP file.
+     */
+    static mcap::Metadata version_metadata_();
+
+    /**
+     * @brief Accounts for the version metadata, schemas and channels written by the rotation thread in the prepared
+     * MCAP file, and writes the schemas and channels received since it was prepared.
      *
-     * @param metadata_name The name of the map in the metadata.
-     * @param map The map that is going to be writed in the metadata.
+     * @throws \c FullFileException if the MCAP file is full.
+     */
+    void write_prepared_file_nts_();
+
+    /**
+     * @brief Allocates more space for the source GUID index if a new message might not fit in it.
      *
      * @throws \c FullFileException if the MCAP file is full.
      */
-    void write_metadata_messages_nts_(
-            const std::string metadata_name,
-            const mcap::KeyValueMap map);
+    void reserve_source_guid_index_nts_();
 
     /**
      * @brief Writes the schemas to the MCAP file.
@@ -179,25 +256,110 @@ protected:
      */
     void write_schemas_nts_();
 
+    /**
+     * @brief Updates the size tracker with the bytes actually written to the MCAP file.
+     *
+     * The bytes are counted by the MCAP writer's data sink, so the file is never \c stat 'ed.
+     */
+    void sync_size_nts_();
+
+    /**
+     * @brief Checks that the bytes written to the MCAP file have reached it.
+     *
+     * @throws \c FullDiskException if a write to the file has failed.
+     */
+    void check_data_sink_nts_() const;
+
+    /**
+     * @brief Closes the MCAP file after a failed write, disables the writer and notifies the disk is full.
+     *
+     * @param e The exception thrown by \c check_data_sink_nts_ .
+     */
+    void on_write_failed_nts_(
+            const FullDiskException& e);
+
+    /**
+     * @brief Adapts the compression of the next chunks to the load, once a chunk has been completed.
+     *
+     * The step to take is decided by the compression policy.
+     */
+    void adapt_compression_nts_();
+
+    /**
+     * @brief Opens an MCAP file with the configured I/O backend.
+     *
+     * @param writer The MCAP writer to open.
+     * @param filename The file to open.
+     * @return A non-success status if the file could not be opened.
+     */
+    mcap::Status open_mcap_file_(
+            mcap::McapWriter& writer,
+            const std::string& filename) const;
+
+    /**
+     * @brief Opens the next MCAP file in the background, under the name reserved in the file tracker.
+     */
+    void prepare_next_file_nts_();
+
+    /**
+     * @brief Waits for the next MCAP file to be prepared and takes it.
+     *
+     * @param filename The name the next MCAP file was given by the file tracker.
+     * @return The writer of the next MCAP file, or nullptr if it was not prepared (or was prepared under another name).
+     */
+    std::unique_ptr<mcap::McapWriter> take_next_writer_nts_(
+            const std::string& filename);
+
+    /**
+     * @brief Removes the next MCAP file if it was prepared, releasing its name in the file tracker.
+     */
+    void discard_next_file_nts_();
+
+    /**
+     * @brief Waits for the task preparing the next MCAP file to finish.
+     *
+     * @param [out] filename The temporary filename of the next MCAP file.
+     * @return The writer of the next MCAP file (nullptr if it could not be opened).
+     */
+    std::unique_ptr<mcap::McapWriter> wait_next_writer_nts_(
+            std::string& filename);
+
+    /**
+     * @brief Queues a task to run in the rotation thread.
+     */
+    void post_rotation_task_(
+            std::function<void()> task);
+
+    /**
+     * @brief Waits until every task queued in the rotation thread has run.
+     */
+    void wait_rotation_tasks_();
+
+    /**
+     * @brief Runs the tasks queued in the rotation thread until the writer is destroyed.
+     */
+    void rotation_thread_routine_();
+
     // The configuration for the MCAP library
     const mcap::McapWriterOptions mcap_configuration_;
 
     // Track the size of the current MCAP file
     McapSizeTracker size_tracker_;
 
-    // The writer from the MCAP library
-    mcap::McapWriter writer_;
+    // The writer from the MCAP library (never nullptr)
+    std::unique_ptr<mcap::McapWriter> writer_;
 
     // The dynamic types payload to be written as an attachment
-    std::string dynamic_types_;
+    SerializedDynamicTypesCollection dynamic_types_;
 
-    // The dictionary of sequence-guid
-    mcap::KeyValueMap source_guid_by_sequence_;
-    // The indexation dictionary for the source_guids
-    mcap::KeyValueMap source_guid_by_sequence_index_;
+    // The writer of each message in the current MCAP file
+    SourceGuidIndex source_guid_index_;
 
-    // The (Auxiliar) dictionary of guid-sequence
-    mcap::KeyValueMap sequence_by_source_guid_index_;
+    // The space allocated for the source GUID index in the current MCAP file
+    std::uint64_t source_guid_index_reserved_{0};
+
+    // The space allocated for the source GUID index at once
+    static constexpr std::uint64_t SOURCE_GUID_INDEX_RESERVATION_STEP{512};
 
     // The channels that have been written
     std::map<mcap::ChannelId, mcap::Channel> channels_;
@@ -205,6 +367,105 @@ protected:
     // The schemas that have been written
     std::map<mcap::SchemaId, mcap::Schema> schemas_;
 
+    // The compression of the next chunks
+    McapCompressionPolicy compression_policy_;
+
+    // The number of chunks in the current MCAP file when the compression was last adapted
+    std::uint64_t last_chunk_count_{0};
+
+    // The time at which the current MCAP file was opened
+    std::chrono::steady_clock::time_point file_open_time_;
+
+    // The time at which the compression was last adapted
+    std::chrono::steady_clock::time_point last_chunk_time_;
+
+    // The number of small messages of each schema to train its zstd dictionary from (0 to disable the dictionaries)
+    const std::uint32_t dictionary_samples_;
+
+    // The max size of each zstd dictionary
+    const std::uint64_t dictionary_max_size_;
+
+    // The small messages collected to train the zstd dictionaries, by schema name
+    std::map<std::string, std::vector<std::string>> dictionary_samples_by_schema_;
+
+    // The trained zstd dictionaries, by schema name (nullptr if the training failed)
+    std::map<std::string, std::unique_ptr<ZstdDictionary>> dictionaries_;
+
+    // The buffer of the last message compressed with a dictionary
+    std::vector<std::byte> compressed_message_;
+
+    // How the MCAP files are written to disk
+    const McapIoBackend io_backend_;
+
+    // The percentage of the max file size at which the next MCAP file is prepared (0 to disable it)
+    const std::uint32_t prepare_next_file_;
+
+    // The size of the current MCAP file at which the next one is prepared (0 to not prepare it)
+    std::uint64_t prepare_next_file_size_{0};
+
+    // Whether the next MCAP file has been requested to the rotation thread
+    bool next_file_requested_{false};
+
+    // The next MCAP file, opened by the rotation thread (nullptr if it could not be opened)
+    std::unique_ptr<mcap::McapWriter> next_writer_;
+
+    // The temporary filename of the next MCAP file
+    std::string next_filename_;
+
+    // Whether the rotation thread has finished preparing the next MCAP file
+    bool next_file_prepared_{false};
+
+    // The number of schemas written in the next MCAP file by the rotation thread
+    std::size_t next_file_schemas_{0};
+
+    // The number of channels written in the next MCAP file by the rotation thread
+    std::size_t next_file_channels_{0};
+
+    // The thread that prepares the next MCAP files and closes the full ones
+    std::thread rotation_thread_;
+
+    // The tasks queued in the rotation thread
+    std::deque<std::function<void()>> rotation_tasks_;
+
+    // Whether the rotation thread is running a task
+    bool rotation_busy_{false};
+
+    // Whether the rotation thread must stop once its tasks have run
+    bool rotation_stop_{false};
+
+    // The mutex to protect the rotation tasks and the next MCAP file
+    std::mutex rotation_mutex_;
+
+    // Notified when a rotation task is queued or has run
+    std::condition_variable rotation_cv_;
+
+    // The period [s] at which the MCAP file is checkpointed (0 to disable the checkpoints)
+    const std::uint32_t checkpoint_period_;
+
+    // Whether the schemas or channels have changed since the last checkpoint
+    bool checkpoint_outdated_{false};
+
+    // The number of messages in the current MCAP file at the last checkpoint
+    std::uint64_t checkpointed_message_count_{0};
+
+    // The size of the dynamic types payload written by the last checkpoint
+    std::uint64_t checkpointed_dynamic_types_size_{0};
+
+    // The schema names of the zstd dictionaries written by the checkpoints
+    std::set<std::string> checkpointed_dictionaries_;
+
+    // The thread that checkpoints the MCAP files
+    std::thread checkpoint_thread_;
+
+    // Whether the checkpoint thread must stop
+    bool checkpoint_stop_{false};
+
+    // The mutex to protect the checkpoint thread stop
+    std::mutex checkpoint_mutex_;
+
+    // Notified when the checkpoint thread must stop
+    std::condition_variable checkpoint_cv_;
+
     // The size of an empty MCAP file
     static constexpr std::uint64_t MIN_MCAP_SIZE{2056};
 };
@@ -50,6 +50,10 @@ void McapWriter::write(
             on_disk_full_();
         }
     }
+    catch (const FullDiskException& e)
+    {
+        on_write_failed_nts_(e);
+    }
 }
 
 } /* namespace participants */
@@ -0,0 +1,86 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file CdrKeyExtractor.hpp
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <fastdds/dds/xtypes/dynamic_types/DynamicType.hpp>
+
+#include <ddspipe_core/types/dds/Payload.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Extracts the key of a sample straight from its CDR payload, decoding only the key members of its type.
+ *
+ * The key is formatted as the JSON object \c SqlMessage::set_key produces (same members, order and formatting), so
+ * both can be used interchangeably.
+ *
+ * Only a subset of types is supported: final or appendable structures (without inheritance nor optional members)
+ * whose key members are booleans, integers, ASCII strings or structures thereof, and whose preceding members are
+ * primitives, strings, structures, sequences or arrays thereof.
+ * Samples of other types must fall back to \c SqlMessage::set_key .
+ */
+class CdrKeyExtractor
+{
+public:
+
+    /**
+     * @brief Builds the extractor of the keys of \c dynamic_type .
+     *
+     * @param dynamic_type DynamicType of the samples.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    CdrKeyExtractor(
+            const fastdds::dds::DynamicType::_ref_type& dynamic_type);
+
+    //! Whether the keys of the type can be extracted straight from the CDR payload
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool is_supported() const noexcept;
+
+    /**
+     * @brief Extracts the key of the sample serialized in \c payload .
+     *
+     * @param [in]  payload CDR serialized sample (with its encapsulation header).
+     * @param [out] key     JSON-serialized key of the sample (only set on success).
+     *
+     * @return Whether the key could be extracted (the type is supported, and the encoding too).
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    bool extract(
+            const ddspipe::core::types::Payload& payload,
+            std::string& key) const;
+
+    //! Layout of a (supported) type in a CDR payload
+    struct Node;
+
+protected:
+
+    //! Layout of the type of the samples (nullptr if not supported)
+    std::shared_ptr<const Node> root_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
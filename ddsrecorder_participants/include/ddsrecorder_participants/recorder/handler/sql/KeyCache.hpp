@@ -0,0 +1,138 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file KeyCache.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <ddspipe_core/types/dds/Payload.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Bounded cache of the (JSON-serialized) keys of the instances, by instance handle.
+ *
+ * When full, the least recently used key is evicted.
+ *
+ * @warning \c find may be called concurrently (it does not refresh the entries), but not while calling \c insert .
+ */
+class KeyCache
+{
+public:
+
+    //! Default max number of keys in the cache
+    static constexpr std::uint64_t DEFAULT_MAX_ENTRIES = 100000;
+
+    /**
+     * @brief Constructs an empty cache.
+     *
+     * @param max_entries Max number of keys in the cache (0 for no limit).
+     * @param max_memory  Max memory [bytes] taken by the keys in the cache (0 for no limit).
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    KeyCache(
+            std::uint64_t max_entries = DEFAULT_MAX_ENTRIES,
+            std::uint64_t max_memory = 0);
+
+    /**
+     * @brief Looks up the key of the instance \c instance_handle , counting it as a hit or a miss.
+     *
+     * @return The cached key, or nullptr if not cached.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    const std::string* find(
+            const ddspipe::core::types::InstanceHandle& instance_handle) const;
+
+    /**
+     * @brief Caches the key of the instance \c instance_handle (or refreshes it if already cached), evicting the least
+     * recently used keys if the cache gets full.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void insert(
+            const ddspipe::core::types::InstanceHandle& instance_handle,
+            const std::string& key);
+
+    //! Number of cached keys
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::size_t size() const noexcept;
+
+    //! Memory [bytes] taken by the cached keys
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::uint64_t memory() const noexcept;
+
+    /**
+     * @brief Returns the number of hits and misses since the previous call, resetting them.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void take_accesses(
+            std::uint64_t& hits,
+            std::uint64_t& misses);
+
+protected:
+
+    //! Hash of the 16 bytes of an instance handle
+    struct InstanceHandleHash
+    {
+        std::size_t operator ()(
+                const ddspipe::core::types::InstanceHandle& instance_handle) const noexcept;
+    };
+
+    using Entry = std::pair<ddspipe::core::types::InstanceHandle, std::string>;
+
+    //! Memory [bytes] taken by an entry
+    static std::uint64_t entry_memory_(
+            const Entry& entry) noexcept;
+
+    //! Evict the least recently used keys until the cache is within its limits
+    void evict_();
+
+    //! Cached keys, from the most to the least recently used
+    std::list<Entry> entries_;
+
+    //! Position in \c entries_ of the key of each instance
+    std::unordered_map<ddspipe::core::types::InstanceHandle, std::list<Entry>::iterator, InstanceHandleHash> index_;
+
+    //! Max number of keys in the cache (0 for no limit)
+    std::uint64_t max_entries_;
+
+    //! Max memory [bytes] taken by the keys in the cache (0 for no limit)
+    std::uint64_t max_memory_;
+
+    //! Memory [bytes] taken by the cached keys
+    std::uint64_t memory_{0};
+
+    //! Number of keys found since the accesses were last taken
+    mutable std::atomic<std::uint64_t> hits_{0};
+
+    //! Number of keys not found since the accesses were last taken
+    mutable std::atomic<std::uint64_t> misses_{0};
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -18,11 +18,13 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
-#include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <fastdds/dds/xtypes/dynamic_types/DynamicType.hpp>
 #include <fastdds/dds/xtypes/type_representation/detail/dds_xtypes_typeobject.hpp>
@@ -36,6 +38,8 @@
 #include <ddsrecorder_participants/recorder/message/BaseMessage.hpp>
 #include <ddsrecorder_participants/recorder/message/SqlMessage.hpp>
 #include <ddsrecorder_participants/recorder/handler/BaseHandler.hpp>
+#include <ddsrecorder_participants/recorder/handler/sql/CdrKeyExtractor.hpp>
+#include <ddsrecorder_participants/recorder/handler/sql/KeyCache.hpp>
 #include <ddsrecorder_participants/recorder/output/FileTracker.hpp>
 #include <ddsrecorder_participants/recorder/handler/sql/SqlHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/handler/sql/SqlWriter.hpp>
@@ -125,26 +129,55 @@ protected:
     /**
      * @brief Writes \c samples to disk.
      *
-     * For each sample in \c samples, it downcasts it to \c SqlMessage, writes it to disk, and removes it from
-     * \c samples.
-     * The method ends when \c samples is empty.
+     * For each sample in \c samples, it downcasts it to \c SqlMessage , writes its topic and partitions (if not
+     * written yet), hydrates it (see \c hydrate_samples_ ) and writes it to disk.
+     * The method ends by clearing \c samples.
      *
-     * @param [in] samples List of samples to be written.
+     * @param [in] samples Batch of samples to be written.
      */
     void write_samples_(
-            std::list<std::shared_ptr<const BaseMessage>>& samples) override;
+            SamplesBatch& samples) override;
+
+    /**
+     * @brief Deserializes the payloads of \c samples to JSON (if required by the data format) and sets their keys.
+     *
+     * Large batches are split in slices hydrated in parallel, each by a different thread.
+     *
+     * @warning \c write_mtx_ must be taken, so \c received_types_ and \c keys_ are not modified meanwhile.
+     *
+     * @param [in,out] samples Samples to be hydrated.
+     */
+    void hydrate_samples_(
+            std::vector<SqlMessage>& samples) const;
+
+    /**
+     * @brief Hydrates the samples in [\c begin , \c end ) of \c samples .
+     *
+     * @param [in,out] samples Samples to be hydrated.
+     * @param [in]     begin   Index of the first sample to hydrate.
+     * @param [in]     end     Index past the last sample to hydrate.
+     */
+    void hydrate_sample_range_(
+            std::vector<SqlMessage>& samples,
+            std::size_t begin,
+            std::size_t end) const;
 
     /**
      * @brief Sets the key of a sample.
      *
-     * If the key was previously stored in \c keys_, it sets it.
-     * If not, it is set from the payload of the \c sql_sample.
-     * The key is stored in \c keys.
+     * If the key is cached in \c keys_, it sets it.
+     * If not, it is extracted from the CDR payload of the \c sql_sample if its type is supported by
+     * \c CdrKeyExtractor , and from its JSON-serialized payload otherwise.
      *
-     * @param [in] sql_sample SqlMessage to set the key.
+     * @param [in] sql_sample   SqlMessage to set the key.
+     * @param [in] dynamic_type DynamicType of the sample (nullptr if not received yet).
      */
     void set_key_(
-            SqlMessage& sql_sample);
+            SqlMessage& sql_sample,
+            const fastdds::dds::DynamicType::_ref_type& dynamic_type) const;
+
+    //! Min number of samples hydrated by each thread
+    static constexpr std::size_t MIN_SAMPLES_PER_HYDRATION_WORKER_ = 64;
 
     //! Configuration
     const SqlHandlerConfiguration configuration_;
@@ -161,8 +194,11 @@ protected:
     //! (Table: TopicsPartitions) Partitions of a writer_guid and sequence_number that the SQL writer has written
     std::set<std::string> written_topic_partitions_;
 
-    //! Map instance handles (hashed/serialized keys) to JSON-serialized keys
-    std::map<ddspipe::core::types::InstanceHandle, std::string> keys_;
+    //! Map instance handles (hashed/serialized keys) to JSON-serialized keys (bounded, least recently used evicted)
+    KeyCache keys_;
+
+    //! Extractors of the keys of the received types (supported by \c CdrKeyExtractor ), by type name
+    std::map<std::string, CdrKeyExtractor> key_extractors_;
 };
 
 } /* namespace participants */
@@ -18,9 +18,12 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <cpp_utils/macros/custom_enumeration.hpp>
 
 #include <ddsrecorder_participants/recorder/handler/BaseHandlerConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/handler/sql/KeyCache.hpp>
 #include <ddsrecorder_participants/recorder/output/OutputSettings.hpp>
 
 namespace eprosima {
@@ -82,6 +85,12 @@ struct SqlHandlerConfiguration : public BaseHandlerConfiguration
 
     //! Whether to store data in cdr, in json, or in both.
     DataFormat data_format;
+
+    //! Max number of instance keys cached (0 for no limit).
+    std::uint64_t max_key_cache_entries{KeyCache::DEFAULT_MAX_ENTRIES};
+
+    //! Max memory [bytes] taken by the instance keys cached (0 for no limit).
+    std::uint64_t max_key_cache_memory{0};
 };
 
 } /* namespace participants */
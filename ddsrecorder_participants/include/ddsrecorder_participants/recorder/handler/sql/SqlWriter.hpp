@@ -18,8 +18,18 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
 #include <sqlite/sqlite3.h>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include <cstdint>
@@ -44,6 +54,20 @@ public:
             const bool ros2_types = false,
             const DataFormat data_format = DataFormat::both);
 
+    /**
+     * @brief Destructor
+     *
+     * Closes the current file and waits for the shards being closed in the background.
+     */
+    ~SqlWriter();
+
+    /**
+     * @brief Disable the writer.
+     *
+     * Waits for the shards being closed in the background, and removes the next shard if it was already prepared.
+     */
+    void disable() override;
+
     /**
      * @brief Writes data to the output file.
      *
@@ -121,6 +145,102 @@ protected:
      */
     void close_current_file_nts_() override;
 
+    /**
+     * @brief Closes the current file and opens a new one (the next shard), since the current one has been open for
+     * longer than the max file duration.
+     *
+     * If there is no space left for the new file, the writer is disabled and \c on_disk_full_ is called.
+     *
+     * @throws \c InitializationException if the SQL library fails to open the new file.
+     */
+    void split_file_nts_();
+
+    /**
+     * @brief Opens a SQL file, creating its tables and views.
+     *
+     * @param filename The name of the file.
+     * @param [out] database The opened database.
+     * @param [out] page_size The size of the pages of the database.
+     * @throws \c InitializationException if the SQL library fails to open the file or to create its tables.
+     */
+    void open_database_(
+            const std::string& filename,
+            sqlite3*& database,
+            std::uint64_t& page_size) const;
+
+    /**
+     * @brief Opens the catalog of the shards, creating it if it does not exist.
+     *
+     * @returns The catalog, or \c nullptr if it cannot be opened.
+     */
+    sqlite3* open_catalog_() const;
+
+    /**
+     * @brief Adds a shard to the catalog of the shards, removing the shards that no longer exist.
+     *
+     * @param shard_name The name of the shard in the catalog.
+     */
+    void add_shard_to_catalog_(
+            const std::string& shard_name) const;
+
+    /**
+     * @brief Writes the time range of a shard to the catalog of the shards (or removes it if it is empty).
+     *
+     * @param shard The database of the shard.
+     * @param shard_name The name of the shard in the catalog.
+     */
+    void close_shard_in_catalog_(
+            sqlite3* shard,
+            const std::string& shard_name) const;
+
+    /**
+     * @brief Opens the next shard in the background, under the name reserved in the file tracker.
+     */
+    void prepare_next_file_nts_();
+
+    /**
+     * @brief Waits for the next shard to be prepared and takes it.
+     *
+     * @param filename The name the next shard was given by the file tracker.
+     * @param [out] page_size The size of the pages of the next shard.
+     * @return The database of the next shard, or nullptr if it was not prepared (or was prepared under another name).
+     */
+    sqlite3* take_next_database_nts_(
+            const std::string& filename,
+            std::uint64_t& page_size);
+
+    /**
+     * @brief Removes the next shard if it was prepared, releasing its name in the file tracker.
+     */
+    void discard_next_file_nts_();
+
+    /**
+     * @brief Waits for the task preparing the next shard to finish.
+     *
+     * @param [out] filename The temporary filename of the next shard.
+     * @param [out] page_size The size of the pages of the next shard.
+     * @return The database of the next shard (nullptr if it could not be opened).
+     */
+    sqlite3* wait_next_database_nts_(
+            std::string& filename,
+            std::uint64_t& page_size);
+
+    /**
+     * @brief Queues a task to run in the rotation thread.
+     */
+    void post_rotation_task_(
+            std::function<void()> task);
+
+    /**
+     * @brief Waits until every task queued in the rotation thread has run.
+     */
+    void wait_rotation_tasks_();
+
+    /**
+     * @brief Runs the tasks queued in the rotation thread until the writer is destroyed.
+     */
+    void rotation_thread_routine_();
+
     /**
      * @brief Writes data to the SQL file.
      *
@@ -148,26 +268,100 @@ protected:
             const std::string& topic_type,
             const std::string& topic_partition);
 
+    /**
+     * @brief Writes the partitions of a writer of a topic to the SQL file, unless they were already written to it.
+     *
+     * @param topic The topic of the message to be written.
+     * @param writer_guid The GUID of the writer of the message to be written.
+     * @throws \c FullFileException if the SQL file is full.
+     *
+     * @throws \c InconsistencyException if there is a database error
+     */
+    void write_partitions_nts_(
+            const ddspipe::core::types::DdsTopic& topic,
+            const std::string& writer_guid);
+
+    /**
+     * @brief Looks up the id of a topic in the Topics table of the current file.
+     *
+     * @param topic The topic to look up.
+     *
+     * @returns A pointer to the id of the topic, or \c nullptr if it has not been written in the current file.
+     */
+    const std::int64_t* find_topic_id_nts_(
+            const ddspipe::core::types::DdsTopic& topic) const;
+
+    /**
+     * @brief Gets the id of a topic in the Topics table of the current file, writing the topic if it is new.
+     *
+     * @param topic The topic of the message to be written.
+     * @throws \c FullFileException if the SQL file is full.
+     *
+     * @throws \c InconsistencyException if there is a database error
+     *
+     * @returns The id of the topic.
+     */
+    std::int64_t get_topic_id_nts_(
+            const ddspipe::core::types::DdsTopic& topic);
+
+    /**
+     * @brief Gets the id of a writer in the Writers table of the current file, writing the writer if it is new.
+     *
+     * @param writer_guid The GUID of the writer of the message to be written.
+     * @throws \c FullFileException if the SQL file is full.
+     *
+     * @throws \c InconsistencyException if there is a database error
+     *
+     * @returns The id of the writer.
+     */
+    std::int64_t get_writer_id_nts_(
+            const std::string& writer_guid);
+
     /**
      * @brief Creates a new SQL table.
      *
+     * @param database The database to create the table in (closed if the creation fails).
      * @param table_name The name of the table.
      * @param table_definition The definition of the table.
      *
      * @throws \c InitializationException if the table creation fails.
      */
     void create_sql_table_(
+            sqlite3* database,
             const std::string& table_name,
-            const std::string& table_definition);
+            const std::string& table_definition) const;
 
     /**
-     * @brief Removes oldest entries (publish time wise) from the Messages table.
+     * @brief Prepares a SQL statement, unless it has already been prepared since the file was opened.
+     *
+     * The statements are cached and reused until the file is closed, instead of being prepared on every write.
+     *
+     * @param statement The cached statement.
+     * @param query The SQL query of the statement.
+     * @param description What the statement is for, to be shown in the error message.
+     *
+     * @throws \c InconsistencyException if the statement cannot be prepared.
+     */
+    void prepare_statement_nts_(
+            sqlite3_stmt*& statement,
+            const char* query,
+            const std::string& description);
+
+    /**
+     * @brief Finalizes the cached SQL statements, before closing the file.
+     */
+    void finalize_statements_nts_();
+
+    /**
+     * @brief Removes the oldest entries (insertion wise) from the MessagesData and MessagesPartitionsData tables.
+     *
+     * The entries are removed in a single range of rowids, and the pages they free are reclaimed at once.
      *
      * @param size_required The size required to be freed.
      *
-     * @throws \c FullDiskException if there are no enough entries to be removed.
+     * @throws \c FullFileException if there are no enough entries to be removed.
      *
-     * @throws \c InconsistencyException if it fails to prepare select statement
+     * @throws \c InconsistencyException if it fails to prepare or execute the statements
      *
      * @returns The size freed.
      */
@@ -204,7 +398,70 @@ protected:
     void check_file_size_();
 
     // The SQLite database
-    sqlite3* database_;
+    sqlite3* database_{nullptr};
+
+    // The SQL statements, prepared once per file and reset after each execution (nullptr until first used)
+    sqlite3_stmt* insert_type_statement_{nullptr};
+    sqlite3_stmt* insert_topic_statement_{nullptr};
+    sqlite3_stmt* insert_writer_statement_{nullptr};
+    sqlite3_stmt* insert_partition_statement_{nullptr};
+    sqlite3_stmt* insert_topic_partition_statement_{nullptr};
+    sqlite3_stmt* insert_message_statement_{nullptr};
+    sqlite3_stmt* insert_message_partition_statement_{nullptr};
+    sqlite3_stmt* select_oldest_statement_{nullptr};
+    sqlite3_stmt* delete_message_partition_statement_{nullptr};
+    sqlite3_stmt* delete_message_statement_{nullptr};
+
+    // The ids of the topics written in the current file (indexed by topic name and type name)
+    std::map<std::string, std::map<std::string, std::int64_t>> topic_ids_;
+
+    // The ids of the writers written in the current file (indexed by writer GUID)
+    std::unordered_map<std::string, std::int64_t> writer_ids_;
+
+    // The partition sets written in the current file
+    std::set<std::string> written_partitions_;
+
+    // The partitions of the topics written in the current file (indexed by topic name, type name and partition set)
+    std::set<std::tuple<std::string, std::string, std::string>> written_topic_partitions_;
+
+    // The time at which the current SQL file was opened
+    std::chrono::steady_clock::time_point file_open_time_;
+
+    // The name of the current file in the catalog of the shards (empty if the files are not split by duration)
+    std::string shard_name_;
+
+    // Whether the next shard has been requested to the rotation thread
+    bool next_file_requested_{false};
+
+    // The next shard, opened by the rotation thread (nullptr if it could not be opened)
+    sqlite3* next_database_{nullptr};
+
+    // The size of the pages of the next shard
+    std::uint64_t next_page_size_{0};
+
+    // The temporary filename of the next shard
+    std::string next_filename_;
+
+    // Whether the rotation thread has finished preparing the next shard
+    bool next_file_prepared_{false};
+
+    // The thread that prepares the next shards, closes the finished ones and keeps the catalog of the shards
+    std::thread rotation_thread_;
+
+    // The tasks queued in the rotation thread
+    std::deque<std::function<void()>> rotation_tasks_;
+
+    // Whether the rotation thread is running a task
+    bool rotation_busy_{false};
+
+    // Whether the rotation thread must stop once its tasks have run
+    bool rotation_stop_{false};
+
+    // The mutex to protect the rotation tasks and the next shard
+    std::mutex rotation_mutex_;
+
+    // Notified when a rotation task is queued or has run
+    std::condition_variable rotation_cv_;
 
     // The received dynamic types
     std::vector<DynamicType> dynamic_types_;
@@ -216,7 +473,7 @@ protected:
     const DataFormat data_format_;
 
     // The size of an empty SQL file
-    static constexpr std::uint64_t MIN_SQL_SIZE{33672};
+    static constexpr std::uint64_t MIN_SQL_SIZE{45960};
 
     // The maximum size of the wal file (in bytes) before being checkpointed to the actual database file. This value is set to quarter size_tolerance in constructor
     std::uint64_t size_checkpoint_{500 * 1024};
@@ -40,6 +40,9 @@ void SqlWriter::write(
         try
         {
             on_file_full_nts_(e, MIN_SQL_SIZE);
+
+            // Write the data that did not fit in the full file to the new one
+            write_nts_(data);
         }
         catch (const FullDiskException& e)
         {
@@ -47,6 +50,11 @@ void SqlWriter::write(
                     "FAIL_SQL_WRITE | Disk is full. Error message:\n " << e.what());
             on_disk_full_();
         }
+        catch (const FullFileException& e)
+        {
+            EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_HANDLER,
+                    "FAIL_SQL_WRITE | The data does not fit in a new SQL file. Error message:\n " << e.what());
+        }
     }
 }
 
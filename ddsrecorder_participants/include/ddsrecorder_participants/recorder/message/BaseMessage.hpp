@@ -58,12 +58,12 @@ struct DDSRECORDER_PARTICIPANTS_DllAPI BaseMessage
      *
      * @param data          The received data sample.
      * @param payload_pool  The \c PayloadPool that owns the payload.
-     * @param topic         The \c DdsTopic in which the payload was published.
+     * @param topic         The \c DdsTopic in which the payload was published (shared among messages).
      */
     BaseMessage(
             const ddspipe::core::types::RtpsPayloadData& data,
             std::shared_ptr<ddspipe::core::PayloadPool> payload_pool,
-            const ddspipe::core::types::DdsTopic& topic);
+            std::shared_ptr<const ddspipe::core::types::DdsTopic> topic);
 
     /**
      * @brief Message copy constructor
@@ -96,20 +96,41 @@ struct DDSRECORDER_PARTICIPANTS_DllAPI BaseMessage
      */
     std::uint32_t get_data_cdr_size() const;
 
+    /**
+     * @brief Copy the message, referencing \c payload instead of the message's payload.
+     *
+     * Messages are shared as const once created, so their payload cannot be replaced in place (e.g. when it is
+     * spilled to disk and read back later on). A copy referencing the new payload replaces them instead.
+     *
+     * @param payload The payload of the copy (referenced through \c payload_owner , not copied), or an empty payload
+     *                for a copy without payload.
+     */
+    virtual std::shared_ptr<const BaseMessage> copy_with_payload(
+            const ddspipe::core::types::Payload& payload) const;
+
     //! Serialized payload
     fastdds::rtps::SerializedPayload_t payload{};
 
     //! Payload owner (reference to \c PayloadPool which created/reserved it)
     ddspipe::core::PayloadPool* payload_owner{nullptr};
 
-    //! Topic in which the payload was published
-    ddspipe::core::types::DdsTopic topic;
+    //! Topic in which the payload was published (shared among messages, see \c TopicRegistry )
+    std::shared_ptr<const ddspipe::core::types::DdsTopic> topic;
 
     //! When the message was recorded or received for recording
     ddspipe::core::types::DataTime log_time;
 
     //! When the message was initially published
     ddspipe::core::types::DataTime publish_time;
+
+protected:
+
+    /**
+     * @brief Copy every field of \c msg but its payload, and reference \c payload instead (unless empty).
+     */
+    void copy_from_(
+            const BaseMessage& msg,
+            const ddspipe::core::types::Payload& payload);
 };
 
 } /* namespace participants */
@@ -25,6 +25,7 @@
 #include <mcap/types.hpp>
 
 #include <ddspipe_core/efficiency/payload/PayloadPool.hpp>
+#include <ddspipe_core/types/dds/Guid.hpp>
 #include <ddspipe_core/types/dds/Payload.hpp>
 #include <ddspipe_core/types/topic/dds/DdsTopic.hpp>
 
@@ -47,17 +48,26 @@ struct McapMessage : public BaseMessage, public mcap::Message
      *
      * @param data          The received data sample.
      * @param payload_pool  The \c PayloadPool that owns the payload.
-     * @param topic         The \c DdsTopic in which the payload was published.
+     * @param topic         The \c DdsTopic in which the payload was published (shared among messages).
      * @param channel_id    The \c ChannelId to which the message belongs.
      * @param log_publish_time Whether to log the publish time of the message.
      */
     McapMessage(
             const ddspipe::core::types::RtpsPayloadData& data,
             std::shared_ptr<ddspipe::core::PayloadPool> payload_pool,
-            const ddspipe::core::types::DdsTopic& topic,
+            std::shared_ptr<const ddspipe::core::types::DdsTopic> topic,
             const mcap::ChannelId channel_id,
             const bool log_publish_time);
 
+    /**
+     * @brief Copy the message, referencing \c payload instead of the message's payload.
+     */
+    std::shared_ptr<const BaseMessage> copy_with_payload(
+            const ddspipe::core::types::Payload& payload) const override;
+
+    // Writer of the message
+    ddspipe::core::types::Guid source_guid;
+
     // Number of McapMessages created
     static std::atomic<std::uint32_t> number_of_msgs;
 };
@@ -51,15 +51,21 @@ struct DDSRECORDER_PARTICIPANTS_DllAPI SqlMessage : public BaseMessage
      *
      * @param payload       The received data sample.
      * @param payload_pool  The \c PayloadPool that owns the payload.
-     * @param topic         The \c DdsTopic in which the payload was published.
+     * @param topic         The \c DdsTopic in which the payload was published (shared among messages).
      * @param key           The key of the message, if any.
      */
     SqlMessage(
             const ddspipe::core::types::RtpsPayloadData& payload,
             std::shared_ptr<ddspipe::core::PayloadPool> payload_pool,
-            const ddspipe::core::types::DdsTopic& topic,
+            std::shared_ptr<const ddspipe::core::types::DdsTopic> topic,
             const std::string& key = "");
 
+    /**
+     * @brief Copy the message, referencing \c payload instead of the message's payload.
+     */
+    std::shared_ptr<const BaseMessage> copy_with_payload(
+            const ddspipe::core::types::Payload& payload) const override;
+
     /**
      * @brief Deserialize the payload's data into a JSON object.
      *
@@ -109,10 +115,6 @@ struct DDSRECORDER_PARTICIPANTS_DllAPI SqlMessage : public BaseMessage
 
     // Partition assigned to the message writer
     std::string partition;
-
-    // Cached SQL-formatted timestamps when already available.
-    std::string log_time_sql;
-    std::string publish_time_sql;
 };
 
 } /* namespace participants */
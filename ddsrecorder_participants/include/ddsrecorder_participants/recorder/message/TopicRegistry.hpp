@@ -0,0 +1,65 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TopicRegistry.hpp
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <ddspipe_core/types/topic/dds/DdsTopic.hpp>
+
+#include <ddsrecorder_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+/**
+ * Registry of the topics in which messages are received, so messages share a single (immutable) copy of their topic
+ * instead of each carrying its own.
+ *
+ * A topic whose partitions or QoS change is registered again, so the messages received earlier keep the previous
+ * version.
+ *
+ * @warning This class is not thread safe.
+ */
+class TopicRegistry
+{
+public:
+
+    /**
+     * @brief Returns the registered copy of \c topic , registering it if not yet registered (or outdated).
+     *
+     * @param topic Topic to be registered.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::shared_ptr<const ddspipe::core::types::DdsTopic> intern(
+            const ddspipe::core::types::DdsTopic& topic);
+
+protected:
+
+    //! Registered topics, by topic name and type name
+    std::map<std::string, std::map<std::string, std::shared_ptr<const ddspipe::core::types::DdsTopic>, std::less<>>,
+            std::less<>> topics_;
+};
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
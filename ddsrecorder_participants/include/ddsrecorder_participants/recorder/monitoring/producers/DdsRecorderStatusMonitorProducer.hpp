@@ -14,6 +14,7 @@
 //
 #pragma once
 
+#include <cstdint>
 #include <mutex>
 
 #include <ddspipe_core/configuration/MonitorProducerConfiguration.hpp>
@@ -38,6 +39,7 @@ namespace participants {
  * The \c DdsRecorderStatusMonitorProducer produces the \c DdsRecorderMonitoringStatus by gathering data with the
  * \c StatusMonitorProducer's macros:
  * - \c monitor_error
+ * - \c monitor_key_cache_accesses
  *
  * The \c DdsRecorderStatusMonitorProducer consumes the \c DdsRecorderMonitoringStatus by using its consumers.
  */
@@ -114,6 +116,28 @@ public:
     virtual void add_error_to_status(
             const std::string& error) override;
 
+    /**
+     * @brief Add accesses to the key cache of the SQL handler to the \c DdsRecorderMonitoringStatus.
+     *
+     * @param hits   Number of keys found in the cache.
+     * @param misses Number of keys not found in the cache.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void add_key_cache_accesses_to_status(
+            std::uint64_t hits,
+            std::uint64_t misses);
+
+    /**
+     * @brief Add accesses to the key cache to the status of the registered \c DdsRecorderStatusMonitorProducer.
+     *
+     * Method called by the \c monitor_key_cache_accesses macro. It does nothing if the registered
+     * \c StatusMonitorProducer is not a \c DdsRecorderStatusMonitorProducer.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    static void report_key_cache_accesses(
+            std::uint64_t hits,
+            std::uint64_t misses);
+
 protected:
 
     // Produce data_.
@@ -128,6 +152,12 @@ protected:
     // DDS Recorder specific errors gathered by the producer.
     DdsRecorderMonitoringErrorStatus ddsrecorder_error_status_;
 
+    // Number of keys found in the key cache of the SQL handler.
+    std::uint64_t key_cache_hits_{0};
+
+    // Number of keys not found in the key cache of the SQL handler.
+    std::uint64_t key_cache_misses_{0};
+
     // Vector of consumers of the DdsRecorderMonitoringStatus.
     std::vector<std::unique_ptr<ddspipe::core::IMonitorConsumer<DdsRecorderMonitoringStatus>>> consumers_;
 };
@@ -136,6 +166,9 @@ protected:
 } // namespace ddsrecorder
 } // namespace eprosima
 
+#define monitor_key_cache_accesses(hits, misses) \
+    eprosima::ddsrecorder::participants::DdsRecorderStatusMonitorProducer::report_key_cache_accesses(hits, misses)
+
 namespace std {
 
 std::ostream& operator <<(
@@ -18,8 +18,10 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <cstdint>
 #include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -68,8 +70,8 @@ public:
      * If the current file is not empty, it is saved as written.
      *
      * If \c file_rotation is set and the new file is too large to fit in the available space, the oldest files are
-     * are removed until there is enough available space.
-     * The new file is stored as the current file.
+     * are removed until there is enough available space (waiting for them to be finished, see \c detach_file ).
+     * The new file is stored as the current file, with the name reserved by \c reserve_next_filename (if any).
      *
      * @param min_file_size The minimum size of the new file.
      * @throws \c FullDiskException if the disk is full.
@@ -84,6 +86,39 @@ public:
     DDSRECORDER_PARTICIPANTS_DllAPI
     void close_file() noexcept override;
 
+    /**
+     * @brief Closes the current file, leaving its rename to \c finish_file .
+     *
+     * It lets the output library finish writing the file (e.g. in another thread) while the next file is written.
+     *
+     * @return The closed file.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    File detach_file() noexcept;
+
+    /**
+     * @brief Renames a file closed by \c detach_file to its final name, and accounts for its actual size.
+     *
+     * @param file The file returned by \c detach_file .
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void finish_file(
+            const File& file) noexcept;
+
+    /**
+     * @brief Reserves the name of the next file, so it can be created before the current file is closed.
+     *
+     * @return The temporary filename of the next file.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::string reserve_next_filename() noexcept;
+
+    /**
+     * @brief Releases the name reserved by \c reserve_next_filename .
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    void release_next_filename() noexcept;
+
     /**
      * @brief Adds up the size of all the files in the tracker.
      *
@@ -149,6 +184,15 @@ protected:
     // The file that is currently being written
     File current_file_;
 
+    // The file reserved to be the next one (no name if none)
+    File next_file_;
+
+    // The ids of the files closed but not finished (see detach_file)
+    std::set<std::uint64_t> unfinished_files_;
+
+    // Notified when a file is finished
+    std::condition_variable file_finished_cv_;
+
     // The total size of all files in the tracker
     std::uint64_t size_{0};
 };
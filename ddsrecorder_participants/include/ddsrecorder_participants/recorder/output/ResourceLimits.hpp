@@ -34,6 +34,7 @@ struct ResourceLimitsStruct
     std::uint64_t max_file_size_{0};
     std::uint64_t size_tolerance_{1024 * 1024};     // Force the system to have a minimum tolerance of 1MB
     bool file_rotation_{false};
+    std::uint32_t max_file_duration_{0};            // Split the files open for longer than this [s] (0 to disable it)
 };
 
 } /* namespace participants */
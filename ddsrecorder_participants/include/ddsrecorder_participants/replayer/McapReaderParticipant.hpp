@@ -14,8 +14,13 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <mcap/reader.hpp>
 
@@ -23,6 +28,8 @@
 
 #include <ddspipe_core/efficiency/payload/PayloadPool.hpp>
 
+#include <ddsrecorder_participants/common/compression/ZstdDictionary.hpp>
+#include <ddsrecorder_participants/common/serialize/SourceGuidIndex.hpp>
 #include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollection.hpp>
 #include <ddsrecorder_participants/library/library_dll.h>
 #include <ddsrecorder_participants/replayer/BaseReaderParticipant.hpp>
@@ -82,6 +89,7 @@ public:
      *
      * Fills the topics with the MCAP file's channels and schemas.
      * Fills the types with the MCAP file's attachment.
+     * Loads the zstd dictionaries the small messages were compressed with.
      *
      * @param topics: Set of topics to be filled with the information from the MCAP file.
      * @param types:  DynamicTypesCollection instance to be filled with the types' information from the MCAP file.
@@ -130,13 +138,36 @@ protected:
      */
     mcap::LinearMessageView read_mcap_messages_();
 
+    /**
+     * @brief Create a payload from an MCAP message, decompressing it if it was compressed with a zstd dictionary.
+     *
+     * @param message: MCAP message with the raw data.
+     * @return The payload, or nullptr if the message could not be decompressed.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::unique_ptr<ddspipe::core::types::RtpsPayloadData> create_message_payload_(
+            const mcap::MessageView& message);
+
+    /**
+     * @brief Get the writer of an MCAP message.
+     *
+     * @param sequence: Sequence of the MCAP message.
+     * @return The GUID string of the writer, or an empty string if it is unknown.
+     */
+    DDSRECORDER_PARTICIPANTS_DllAPI
+    std::string get_writer_guid_(
+            std::uint32_t sequence) const;
+
     //! MCAP reader instance.
     mcap::McapReader mcap_reader_;
 
     //! Link a topic name and a type name to a DdsTopic instance
     std::map<std::pair<std::string, std::string>, ddspipe::core::types::DdsTopic> topics_;
 
-    // The dictionary of sequence-source_guid
+    //! The writer of each message, by message sequence
+    SourceGuidIndex source_guid_index_;
+
+    // The dictionary of sequence-source_guid (files recorded before the source GUID index)
     mcap::KeyValueMap source_guid_by_sequence_;
     // The indexation dictionary for the source_guid_indx-sequence
     mcap::KeyValueMap sequence_by_source_guid_index_;
@@ -149,6 +180,12 @@ protected:
 
     //! Set of writers guid that do not pass the partitions filter.
     std::set<std::string> filtered_writersguid_list_;
+
+    //! Zstd dictionaries the small messages were compressed with, by schema name
+    std::map<std::string, std::unique_ptr<ZstdDictionary>> dictionaries_;
+
+    //! Buffer of the last message decompressed with a zstd dictionary
+    std::vector<std::byte> decompressed_message_;
 };
 
 } /* namespace participants */
@@ -18,6 +18,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <sqlite/sqlite3.h>
 
@@ -106,15 +107,65 @@ public:
 protected:
 
     /**
-     * @brief Open the SQLite file.
+     * @brief Process the topics and the types stored in a SQLite file.
+     *
+     * @param file_path The path of the SQLite file.
+     * @param topics:   Set of topics to be filled with the information from the SQLite file.
+     * @param types:    DynamicTypesCollection instance to be filled with the types information from the SQLite file.
+     */
+    void process_summary_(
+            const std::string& file_path,
+            std::set<utils::Heritable<ddspipe::core::types::DdsTopic>>& topics,
+            DynamicTypesCollection& types);
+
+    /**
+     * @brief Process the messages stored in a SQLite file.
+     *
+     * @param file_path The path of the SQLite file.
+     * @param initial_timestamp The time at which the replay started.
+     * @param begin_time The log time of the first message to replay.
+     * @param end_time The log time of the last message to replay.
+     * @param [in,out] first_message_timestamp_set Whether a message has already been replayed (in any file).
+     * @param [in,out] first_message_timestamp The log time of the first message replayed (in any file).
+     */
+    void process_messages_(
+            const std::string& file_path,
+            const utils::Timestamp& initial_timestamp,
+            const utils::Timestamp& begin_time,
+            const utils::Timestamp& end_time,
+            bool& first_message_timestamp_set,
+            utils::Timestamp& first_message_timestamp);
+
+    /**
+     * @brief Open a SQLite file.
+     *
+     * @param file_path The path of the SQLite file.
      */
-    void open_file_();
+    void open_file_(
+            const std::string& file_path);
 
     /**
      * @brief Close the SQLite file.
      */
     void close_file_();
 
+    /**
+     * @brief Find the SQLite files to read.
+     *
+     * If the input file is a catalog of shards (recorded with a max file duration), the files are the shards that
+     * overlap the time range to replay, sorted in time. Otherwise, the file is the input file.
+     *
+     * @return The paths of the SQLite files to read.
+     */
+    std::vector<std::string> find_files_();
+
+    /**
+     * @brief Read the version of the schema of the SQLite file.
+     *
+     * @return The version of the schema (0 if the file was recorded before the schema was versioned).
+     */
+    int read_schema_version_();
+
     /**
      * @brief Execute a SQL statement.
      *
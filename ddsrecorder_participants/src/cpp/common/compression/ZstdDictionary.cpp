@@ -0,0 +1,158 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ZstdDictionary.cpp
+ */
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include <ddsrecorder_participants/common/compression/ZstdDictionary.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+ZstdDictionary::ZstdDictionary(
+        const std::string& dictionary,
+        int compression_level /* = 3 */)
+    : dictionary_(dictionary)
+{
+    compression_dictionary_ = ZSTD_createCDict(dictionary_.data(), dictionary_.size(), compression_level);
+    decompression_dictionary_ = ZSTD_createDDict(dictionary_.data(), dictionary_.size());
+    compression_context_ = ZSTD_createCCtx();
+    decompression_context_ = ZSTD_createDCtx();
+}
+
+ZstdDictionary::~ZstdDictionary()
+{
+    ZSTD_freeCDict(compression_dictionary_);
+    ZSTD_freeDDict(decompression_dictionary_);
+    ZSTD_freeCCtx(compression_context_);
+    ZSTD_freeDCtx(decompression_context_);
+}
+
+std::string ZstdDictionary::train(
+        const std::vector<std::string>& samples,
+        std::uint64_t max_size /* = DEFAULT_MAX_SIZE */)
+{
+    // ZDICT expects the samples back to back
+    std::string samples_buffer;
+    std::vector<std::size_t> samples_sizes;
+    samples_sizes.reserve(samples.size());
+
+    for (const auto& sample : samples)
+    {
+        samples_buffer += sample;
+        samples_sizes.push_back(sample.size());
+    }
+
+    std::string dictionary(max_size, '\0');
+
+    const auto dictionary_size = ZDICT_trainFromBuffer(
+        dictionary.data(), dictionary.size(), samples_buffer.data(), samples_sizes.data(),
+        static_cast<unsigned>(samples_sizes.size()));
+
+    if (ZDICT_isError(dictionary_size))
+    {
+        return {};
+    }
+
+    dictionary.resize(dictionary_size);
+    return dictionary;
+}
+
+bool ZstdDictionary::is_compressed(
+        const std::byte* data,
+        std::uint64_t size) noexcept
+{
+    // NOTE: CDR payloads start with their encapsulation, whose first byte is always 0
+    if (size < 4)
+    {
+        return false;
+    }
+
+    // The magic number is stored little-endian
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(data);
+    const std::uint32_t magic_number =
+            static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8) |
+            (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+
+    return magic_number == ZSTD_MAGICNUMBER;
+}
+
+bool ZstdDictionary::is_valid() const noexcept
+{
+    return compression_dictionary_ != nullptr && decompression_dictionary_ != nullptr &&
+           compression_context_ != nullptr && decompression_context_ != nullptr;
+}
+
+const std::string& ZstdDictionary::data() const noexcept
+{
+    return dictionary_;
+}
+
+bool ZstdDictionary::compress(
+        const std::byte* data,
+        std::uint64_t size,
+        std::vector<std::byte>& compressed) const
+{
+    if (!is_valid())
+    {
+        return false;
+    }
+
+    compressed.resize(ZSTD_compressBound(size));
+
+    const auto compressed_size = ZSTD_compress_usingCDict(
+        compression_context_, compressed.data(), compressed.size(), data, size, compression_dictionary_);
+
+    if (ZSTD_isError(compressed_size) || compressed_size >= size)
+    {
+        return false;
+    }
+
+    compressed.resize(compressed_size);
+    return true;
+}
+
+bool ZstdDictionary::decompress(
+        const std::byte* data,
+        std::uint64_t size,
+        std::vector<std::byte>& decompressed) const
+{
+    if (!is_valid())
+    {
+        return false;
+    }
+
+    const auto decompressed_size = ZSTD_getFrameContentSize(data, size);
+
+    if (decompressed_size == ZSTD_CONTENTSIZE_UNKNOWN || decompressed_size == ZSTD_CONTENTSIZE_ERROR)
+    {
+        return false;
+    }
+
+    decompressed.resize(decompressed_size);
+
+    const auto result = ZSTD_decompress_usingDDict(
+        decompression_context_, decompressed.data(), decompressed.size(), data, size, decompression_dictionary_);
+
+    return !ZSTD_isError(result) && result == decompressed_size;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,107 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SerializedDynamicTypesCollection.cpp
+ */
+
+#include <cstring>
+
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/rtps/common/SerializedPayload.hpp>
+
+#include <ddsrecorder_participants/common/serialize/SerializedDynamicTypesCollection.hpp>
+#include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollectionPubSubTypes.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+void SerializedDynamicTypesCollection::serialize(
+        const DynamicType& dynamic_type,
+        std::string& serialized_type)
+{
+    // Remove the const qualifier to serialize the dynamic type
+    auto dynamic_type_ptr = const_cast<DynamicType*>(&dynamic_type);
+
+    // NOTE: In XCDR (version 1) a collection is its number of types followed by the types, with no delimiters, so the
+    // types can be serialized on their own and then appended.
+    fastdds::dds::TypeSupport type_support(new DynamicTypePubSubType());
+    fastdds::rtps::SerializedPayload_t payload(type_support.calculate_serialized_size(dynamic_type_ptr,
+            fastdds::dds::XCDR_DATA_REPRESENTATION));
+    type_support.serialize(dynamic_type_ptr, payload, fastdds::dds::XCDR_DATA_REPRESENTATION);
+
+    serialized_type = std::string(reinterpret_cast<char*>(payload.data), payload.length);
+}
+
+std::uint64_t SerializedDynamicTypesCollection::size_after_append(
+        const std::string& serialized_type) const noexcept
+{
+    // The encapsulation of the type is replaced by the one of the collection
+    const auto type_size = serialized_type.size() - ENCAPSULATION_SIZE;
+
+    if (serialized_collection_.empty())
+    {
+        return HEADER_SIZE + type_size;
+    }
+
+    return serialized_collection_.size() + padding_(serialized_collection_.size()) + type_size;
+}
+
+void SerializedDynamicTypesCollection::append(
+        const std::string& serialized_type)
+{
+    if (serialized_collection_.empty())
+    {
+        // Reuse the encapsulation of the type (which sets the endianness of the whole collection)
+        serialized_collection_.append(serialized_type, 0, ENCAPSULATION_SIZE);
+        serialized_collection_.append(sizeof(count_), '\0');
+    }
+    else
+    {
+        serialized_collection_.append(padding_(serialized_collection_.size()), '\0');
+    }
+
+    serialized_collection_.append(serialized_type, ENCAPSULATION_SIZE, std::string::npos);
+
+    // Update the number of types (in the same endianness the types were serialized with)
+    count_++;
+    std::memcpy(&serialized_collection_[ENCAPSULATION_SIZE], &count_, sizeof(count_));
+}
+
+std::uint32_t SerializedDynamicTypesCollection::count() const noexcept
+{
+    return count_;
+}
+
+bool SerializedDynamicTypesCollection::empty() const noexcept
+{
+    return count_ == 0;
+}
+
+const std::string& SerializedDynamicTypesCollection::str() const noexcept
+{
+    return serialized_collection_;
+}
+
+std::uint64_t SerializedDynamicTypesCollection::padding_(
+        std::uint64_t size) noexcept
+{
+    // NOTE: The alignment is relative to the end of the encapsulation, which is itself aligned
+    return (TYPE_ALIGNMENT - size % TYPE_ALIGNMENT) % TYPE_ALIGNMENT;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,262 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SourceGuidIndex.cpp
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include <ddsrecorder_participants/common/serialize/SourceGuidIndex.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+void write_uint(
+        std::string& buffer,
+        std::uint64_t value,
+        std::size_t size)
+{
+    for (std::size_t i = 0; i < size; i++)
+    {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+bool read_uint(
+        const std::string& buffer,
+        std::size_t& position,
+        std::size_t size,
+        std::uint32_t& value)
+{
+    if (buffer.size() - position < size)
+    {
+        return false;
+    }
+
+    value = 0;
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        value |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(buffer[position++])) << (8 * i);
+    }
+
+    return true;
+}
+
+} // namespace
+
+void SourceGuidIndex::add(
+        std::uint32_t sequence,
+        const ddspipe::core::types::Guid& writer_guid)
+{
+    std::uint16_t writer_index = UNKNOWN_WRITER;
+
+    const auto writer_it = writer_indexes_.find(writer_guid);
+
+    if (writer_it != writer_indexes_.end())
+    {
+        writer_index = writer_it->second;
+    }
+    else if (writer_guids_.size() < UNKNOWN_WRITER)
+    {
+        std::ostringstream guid_ss;
+        guid_ss << writer_guid;
+
+        writer_index = static_cast<std::uint16_t>(writer_guids_.size());
+        writer_guids_.push_back(guid_ss.str());
+        writer_indexes_.emplace(writer_guid, writer_index);
+
+        serialized_size_ += sizeof(std::uint32_t) + writer_guids_.back().size();
+    }
+
+    if (runs_.empty() ||
+            static_cast<std::uint64_t>(runs_.back().first_sequence) + runs_.back().writers.size() != sequence)
+    {
+        runs_.push_back({sequence, {}});
+        serialized_size_ += RUN_HEADER_SIZE;
+    }
+
+    runs_.back().writers.push_back(writer_index);
+    serialized_size_ += sizeof(std::uint16_t);
+}
+
+const std::string* SourceGuidIndex::find(
+        std::uint32_t sequence) const
+{
+    const auto contains = [sequence](const Run& run)
+            {
+                return sequence >= run.first_sequence &&
+                       sequence - run.first_sequence < run.writers.size();
+            };
+
+    if (last_run_ >= runs_.size() || !contains(runs_[last_run_]))
+    {
+        // Find the last run starting at or before the sequence
+        auto run_it = std::upper_bound(runs_.begin(), runs_.end(), sequence,
+                        [](std::uint32_t sequence, const Run& run)
+                        {
+                            return sequence < run.first_sequence;
+                        });
+
+        if (run_it == runs_.begin() || !contains(*std::prev(run_it)))
+        {
+            return nullptr;
+        }
+
+        last_run_ = std::distance(runs_.begin(), std::prev(run_it));
+    }
+
+    const auto& run = runs_[last_run_];
+    const auto writer_index = run.writers[sequence - run.first_sequence];
+
+    if (writer_index >= writer_guids_.size())
+    {
+        return nullptr;
+    }
+
+    return &writer_guids_[writer_index];
+}
+
+void SourceGuidIndex::clear()
+{
+    writer_guids_.clear();
+    writer_indexes_.clear();
+    runs_.clear();
+    serialized_size_ = HEADER_SIZE;
+    last_run_ = 0;
+}
+
+bool SourceGuidIndex::empty() const noexcept
+{
+    return runs_.empty();
+}
+
+std::uint64_t SourceGuidIndex::serialized_size() const noexcept
+{
+    return serialized_size_;
+}
+
+void SourceGuidIndex::serialize(
+        std::string& serialized) const
+{
+    serialized.clear();
+    serialized.reserve(serialized_size_);
+
+    write_uint(serialized, VERSION, sizeof(std::uint32_t));
+
+    write_uint(serialized, writer_guids_.size(), sizeof(std::uint32_t));
+
+    for (const auto& writer_guid : writer_guids_)
+    {
+        write_uint(serialized, writer_guid.size(), sizeof(std::uint32_t));
+        serialized += writer_guid;
+    }
+
+    write_uint(serialized, runs_.size(), sizeof(std::uint32_t));
+
+    for (const auto& run : runs_)
+    {
+        write_uint(serialized, run.first_sequence, sizeof(std::uint32_t));
+        write_uint(serialized, run.writers.size(), sizeof(std::uint32_t));
+
+        for (const auto writer_index : run.writers)
+        {
+            write_uint(serialized, writer_index, sizeof(std::uint16_t));
+        }
+    }
+}
+
+bool SourceGuidIndex::deserialize(
+        const std::string& serialized)
+{
+    clear();
+
+    std::size_t position = 0;
+    std::uint32_t value;
+
+    if (!read_uint(serialized, position, sizeof(std::uint32_t), value) || value != VERSION)
+    {
+        return false;
+    }
+
+    std::uint32_t writers_count;
+
+    if (!read_uint(serialized, position, sizeof(std::uint32_t), writers_count))
+    {
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < writers_count; i++)
+    {
+        if (!read_uint(serialized, position, sizeof(std::uint32_t), value) || serialized.size() - position < value)
+        {
+            clear();
+            return false;
+        }
+
+        writer_guids_.push_back(serialized.substr(position, value));
+        position += value;
+    }
+
+    std::uint32_t runs_count;
+
+    if (!read_uint(serialized, position, sizeof(std::uint32_t), runs_count))
+    {
+        clear();
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < runs_count; i++)
+    {
+        Run run;
+        std::uint32_t messages_count;
+
+        if (!read_uint(serialized, position, sizeof(std::uint32_t), run.first_sequence) ||
+                !read_uint(serialized, position, sizeof(std::uint32_t), messages_count) ||
+                (serialized.size() - position) / sizeof(std::uint16_t) < messages_count)
+        {
+            clear();
+            return false;
+        }
+
+        run.writers.reserve(messages_count);
+
+        for (std::uint32_t j = 0; j < messages_count; j++)
+        {
+            read_uint(serialized, position, sizeof(std::uint16_t), value);
+            run.writers.push_back(static_cast<std::uint16_t>(value));
+        }
+
+        runs_.push_back(std::move(run));
+    }
+
+    // Sort the runs to look them up (messages may be written out of sequence order, e.g. pending samples)
+    std::sort(runs_.begin(), runs_.end(), [](const Run& lhs, const Run& rhs)
+            {
+                return lhs.first_sequence < rhs.first_sequence;
+            });
+
+    serialized_size_ = serialized.size();
+
+    return true;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
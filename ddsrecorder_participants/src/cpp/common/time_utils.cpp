@@ -148,6 +148,12 @@ std::uint64_t to_ticks(
     return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
 }
 
+std::uint64_t to_ticks(
+        const fastdds::rtps::Time_t& time)
+{
+    return time.seconds() * NS_PER_SEC + time.nanosec();
+}
+
 } /* namespace participants */
 } /* namespace ddsrecorder */
 } /* namespace eprosima */
@@ -119,6 +119,36 @@ void register_DdsRecorderMonitoringErrorStatus_type_identifier(
             CompleteStructMember member_disk_full = TypeObjectUtils::build_complete_struct_member(common_disk_full, detail_disk_full);
             TypeObjectUtils::add_complete_struct_member(member_seq_DdsRecorderMonitoringErrorStatus, member_disk_full);
         }
+        {
+            TypeIdentifierPair type_ids_buffer_memory_full;
+            ReturnCode_t return_code_buffer_memory_full {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_buffer_memory_full =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_bool", type_ids_buffer_memory_full);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_buffer_memory_full)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "buffer_memory_full Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_buffer_memory_full = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_buffer_memory_full = 0x00000002;
+            bool common_buffer_memory_full_ec {false};
+            CommonStructMember common_buffer_memory_full {TypeObjectUtils::build_common_struct_member(member_id_buffer_memory_full, member_flags_buffer_memory_full, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_buffer_memory_full, common_buffer_memory_full_ec))};
+            if (!common_buffer_memory_full_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure buffer_memory_full member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_buffer_memory_full = "buffer_memory_full";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_buffer_memory_full;
+            ann_custom_DdsRecorderMonitoringErrorStatus.reset();
+            CompleteMemberDetail detail_buffer_memory_full = TypeObjectUtils::build_complete_member_detail(name_buffer_memory_full, member_ann_builtin_buffer_memory_full, ann_custom_DdsRecorderMonitoringErrorStatus);
+            CompleteStructMember member_buffer_memory_full = TypeObjectUtils::build_complete_struct_member(common_buffer_memory_full, detail_buffer_memory_full);
+            TypeObjectUtils::add_complete_struct_member(member_seq_DdsRecorderMonitoringErrorStatus, member_buffer_memory_full);
+        }
         CompleteStructType struct_type_DdsRecorderMonitoringErrorStatus = TypeObjectUtils::build_complete_struct_type(struct_flags_DdsRecorderMonitoringErrorStatus, header_DdsRecorderMonitoringErrorStatus, member_seq_DdsRecorderMonitoringErrorStatus);
         if (eprosima::fastdds::dds::RETCODE_BAD_PARAMETER ==
                 TypeObjectUtils::build_and_register_struct_type_object(struct_type_DdsRecorderMonitoringErrorStatus, type_name_DdsRecorderMonitoringErrorStatus.to_string(), type_ids_DdsRecorderMonitoringErrorStatus))
@@ -197,6 +227,66 @@ void register_DdsRecorderMonitoringStatus_type_identifier(
             CompleteStructMember member_ddsrecorder_error_status = TypeObjectUtils::build_complete_struct_member(common_ddsrecorder_error_status, detail_ddsrecorder_error_status);
             TypeObjectUtils::add_complete_struct_member(member_seq_DdsRecorderMonitoringStatus, member_ddsrecorder_error_status);
         }
+        {
+            TypeIdentifierPair type_ids_key_cache_hits;
+            ReturnCode_t return_code_key_cache_hits {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_key_cache_hits =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint64_t", type_ids_key_cache_hits);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_key_cache_hits)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "key_cache_hits Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_key_cache_hits = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_key_cache_hits = 0x00000003;
+            bool common_key_cache_hits_ec {false};
+            CommonStructMember common_key_cache_hits {TypeObjectUtils::build_common_struct_member(member_id_key_cache_hits, member_flags_key_cache_hits, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_key_cache_hits, common_key_cache_hits_ec))};
+            if (!common_key_cache_hits_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure key_cache_hits member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_key_cache_hits = "key_cache_hits";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_key_cache_hits;
+            ann_custom_DdsRecorderMonitoringStatus.reset();
+            CompleteMemberDetail detail_key_cache_hits = TypeObjectUtils::build_complete_member_detail(name_key_cache_hits, member_ann_builtin_key_cache_hits, ann_custom_DdsRecorderMonitoringStatus);
+            CompleteStructMember member_key_cache_hits = TypeObjectUtils::build_complete_struct_member(common_key_cache_hits, detail_key_cache_hits);
+            TypeObjectUtils::add_complete_struct_member(member_seq_DdsRecorderMonitoringStatus, member_key_cache_hits);
+        }
+        {
+            TypeIdentifierPair type_ids_key_cache_misses;
+            ReturnCode_t return_code_key_cache_misses {eprosima::fastdds::dds::RETCODE_OK};
+            return_code_key_cache_misses =
+                eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_identifiers(
+                "_uint64_t", type_ids_key_cache_misses);
+
+            if (eprosima::fastdds::dds::RETCODE_OK != return_code_key_cache_misses)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION,
+                        "key_cache_misses Structure member TypeIdentifier unknown to TypeObjectRegistry.");
+                return;
+            }
+            StructMemberFlag member_flags_key_cache_misses = TypeObjectUtils::build_struct_member_flag(eprosima::fastdds::dds::xtypes::TryConstructFailAction::DISCARD,
+                    false, false, false, false);
+            MemberId member_id_key_cache_misses = 0x00000004;
+            bool common_key_cache_misses_ec {false};
+            CommonStructMember common_key_cache_misses {TypeObjectUtils::build_common_struct_member(member_id_key_cache_misses, member_flags_key_cache_misses, TypeObjectUtils::retrieve_complete_type_identifier(type_ids_key_cache_misses, common_key_cache_misses_ec))};
+            if (!common_key_cache_misses_ec)
+            {
+                EPROSIMA_LOG_ERROR(XTYPES_TYPE_REPRESENTATION, "Structure key_cache_misses member TypeIdentifier inconsistent.");
+                return;
+            }
+            MemberName name_key_cache_misses = "key_cache_misses";
+            eprosima::fastcdr::optional<AppliedBuiltinMemberAnnotations> member_ann_builtin_key_cache_misses;
+            ann_custom_DdsRecorderMonitoringStatus.reset();
+            CompleteMemberDetail detail_key_cache_misses = TypeObjectUtils::build_complete_member_detail(name_key_cache_misses, member_ann_builtin_key_cache_misses, ann_custom_DdsRecorderMonitoringStatus);
+            CompleteStructMember member_key_cache_misses = TypeObjectUtils::build_complete_struct_member(common_key_cache_misses, detail_key_cache_misses);
+            TypeObjectUtils::add_complete_struct_member(member_seq_DdsRecorderMonitoringStatus, member_key_cache_misses);
+        }
         CompleteStructType struct_type_DdsRecorderMonitoringStatus = TypeObjectUtils::build_complete_struct_type(struct_flags_DdsRecorderMonitoringStatus, header_DdsRecorderMonitoringStatus, member_seq_DdsRecorderMonitoringStatus);
         if (eprosima::fastdds::dds::RETCODE_BAD_PARAMETER ==
                 TypeObjectUtils::build_and_register_struct_type_object(struct_type_DdsRecorderMonitoringStatus, type_name_DdsRecorderMonitoringStatus.to_string(), type_ids_DdsRecorderMonitoringStatus))
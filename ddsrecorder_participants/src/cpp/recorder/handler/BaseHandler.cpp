@@ -17,6 +17,9 @@
  */
 
 #include <chrono>
+#include <iterator>
+#include <queue>
+#include <vector>
 
 #include <fastdds/dds/core/ReturnCode.hpp>
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
@@ -29,6 +32,7 @@
 
 #include <ddsrecorder_participants/common/serialize/Serializer.hpp>
 #include <ddsrecorder_participants/recorder/handler/BaseHandler.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/producers/DdsRecorderStatusMonitorProducer.hpp>
 #include <ddsrecorder_participants/replayer/DynamicTypesSupport.hpp>
 
 namespace eprosima {
@@ -45,6 +49,17 @@ BaseHandler::BaseHandler(
     , state_(BaseHandlerStateCode::STOPPED)
 {
     EPROSIMA_LOG_INFO(DDSRECORDER_BASE_HANDLER, "Creating handler instance.");
+
+    // Preallocate the buffer so no allocation is required when receiving samples
+    samples_buffer_.reserve(configuration_.buffer_size);
+
+    if (!configuration_.event_window_spill_file.empty())
+    {
+        event_window_buffer_.enable_spill(
+            std::make_unique<EventWindowSpill>(configuration_.event_window_spill_file,
+            configuration_.event_window_spill_size),
+            configuration_.event_window_spill_threshold);
+    }
 }
 
 BaseHandler::~BaseHandler()
@@ -81,12 +96,20 @@ void BaseHandler::enable()
     EPROSIMA_LOG_INFO(DDSRECORDER_BASE_HANDLER, "Enabling handler.");
 
     writer_->enable();
+
+    if (configuration_.async_write)
+    {
+        start_writer_thread_();
+    }
 }
 
 void BaseHandler::disable()
 {
     EPROSIMA_LOG_INFO(DDSRECORDER_BASE_HANDLER, "Disabling handler.");
 
+    // Write the queued samples before closing the file
+    stop_writer_thread_();
+
     writer_->disable();
 }
 
@@ -191,11 +214,12 @@ void BaseHandler::stop(
             {
                 // Free memory resources
                 pending_samples_.clear();
+                pending_samples_memory_ = 0;
             }
 
             // if prev_state == RUNNING -> writes buffer + added pending samples (if !only_with_schema)
             // if prev_state == PAUSED  -> writes added pending samples (if !only_with_schema)
-            write_samples_(samples_buffer_);
+            flush_samples_buffer_nts_();
 
             disable();
             break;
@@ -232,7 +256,7 @@ void BaseHandler::pause()
         else if (prev_state == BaseHandlerStateCode::RUNNING)
         {
             // Write data stored in buffer
-            write_samples_(samples_buffer_);
+            flush_samples_buffer_nts_();
         }
 
         // Launch event thread routine
@@ -334,10 +358,11 @@ void BaseHandler::event_thread_routine_()
                     // Move (paused) pending samples to buffer (or pending samples) before writing the buffer
                     for (auto& [_, pending] : pending_samples_paused_)
                     {
-                        while (!pending.empty())
-                        {
-                            const auto& sample = pending.front();
+                        SamplesBatch samples;
+                        pending.move_to(samples);
 
+                        for (auto& sample : samples)
+                        {
                             if (configuration_.max_pending_samples != 0)
                             {
                                 add_sample_to_pending_nts_(sample);
@@ -347,13 +372,17 @@ void BaseHandler::event_thread_routine_()
                                 // Add to buffer with blank schema
                                 add_sample_to_buffer_nts_(sample);
                             }
-
-                            pending.pop_front();
                         }
                     }
                 }
 
-                write_samples_(samples_buffer_);
+                // Write the samples in the event window (sorted by reception time)
+                // NOTE: move them in chunks, so spilled payloads are not read back all at once
+                do
+                {
+                    event_window_buffer_.move_to(samples_buffer_, configuration_.buffer_size);
+                    flush_samples_buffer_nts_();
+                } while (!event_window_buffer_.empty());
             }
 
             // Event routine iteration completed: reset and wait for next event
@@ -385,9 +414,187 @@ void BaseHandler::stop_event_thread_nts_(
     }
 
     samples_buffer_.clear();
+    samples_buffer_memory_ = 0;
+    event_window_buffer_.clear();
     pending_samples_paused_.clear();
 }
 
+void BaseHandler::dispatch_samples_nts_(
+        SamplesBatch& samples,
+        bool deferred /* = false */)
+{
+    if (samples.empty())
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> writer_lock(writer_cv_mutex_);
+
+    const bool async = writer_thread_.joinable();
+
+    if (async && writer_queue_size_ >= configuration_.async_write_queue_size)
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_BASE_HANDLER,
+                "The writer queue is full (" << writer_queue_size_ << " samples). Waiting for the writer thread...");
+
+        // NOTE: a batch is always accepted if the queue is empty, even if it exceeds the limit by itself
+        writer_cv_.wait(
+            writer_lock,
+            [&]
+            {
+                return writer_queue_size_ < configuration_.async_write_queue_size;
+            });
+    }
+
+    // Swap the samples with an empty batch, so the buffer keeps its (preallocated) capacity
+    SamplesBatch batch;
+
+    if (!spare_batches_.empty())
+    {
+        batch = std::move(spare_batches_.back());
+        spare_batches_.pop_back();
+    }
+    else
+    {
+        batch.reserve(configuration_.buffer_size);
+    }
+
+    std::swap(samples, batch);
+
+    writer_queue_size_ += batch.size();
+    writer_queue_.push_back(std::move(batch));
+
+    writer_lock.unlock(); // Unlock before notifying for efficiency purposes
+
+    if (async)
+    {
+        writer_cv_.notify_all();
+    }
+    else if (!deferred)
+    {
+        write_dispatched_samples_();
+    }
+}
+
+void BaseHandler::write_dispatched_samples_()
+{
+    // NOTE: keep write_mtx_ taken while popping so batches are written in the same order they were dispatched
+    std::lock_guard<std::mutex> write_lock(write_mtx_);
+
+    SamplesBatch samples;
+
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> writer_lock(writer_cv_mutex_);
+
+            if (writer_thread_.joinable())
+            {
+                // The writer thread is in charge of writing the queued batches
+                return;
+            }
+
+            pop_dispatched_samples_nts_(samples);
+        }
+
+        if (samples.empty())
+        {
+            return;
+        }
+
+        write_samples_(samples);
+    }
+}
+
+void BaseHandler::pop_dispatched_samples_nts_(
+        SamplesBatch& samples)
+{
+    // Keep the written batch (and its capacity) to be reused by the next dispatch
+    samples.clear();
+
+    if (samples.capacity() >= configuration_.buffer_size && spare_batches_.size() < MAX_SPARE_BATCHES_)
+    {
+        spare_batches_.push_back(std::move(samples));
+        samples = SamplesBatch();
+    }
+
+    if (writer_queue_.empty())
+    {
+        return;
+    }
+
+    samples = std::move(writer_queue_.front());
+    writer_queue_.pop_front();
+    writer_queue_size_ -= samples.size();
+}
+
+void BaseHandler::start_writer_thread_()
+{
+    std::lock_guard<std::mutex> writer_lock(writer_cv_mutex_);
+
+    if (writer_thread_.joinable())
+    {
+        return;
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_BASE_HANDLER, "Starting writer thread.");
+
+    writer_stop_ = false;
+    writer_thread_ = std::thread(&BaseHandler::writer_thread_routine_, this);
+}
+
+void BaseHandler::stop_writer_thread_()
+{
+    std::unique_lock<std::mutex> writer_lock(writer_cv_mutex_);
+
+    if (!writer_thread_.joinable())
+    {
+        return;
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_BASE_HANDLER, "Stopping writer thread.");
+
+    writer_stop_ = true;
+    writer_lock.unlock(); // Unlock prior to notification (for efficiency) and join (to avoid deadlock)
+    writer_cv_.notify_all();
+    writer_thread_.join();
+}
+
+void BaseHandler::writer_thread_routine_()
+{
+    SamplesBatch samples;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> writer_lock(writer_cv_mutex_);
+
+            writer_cv_.wait(
+                writer_lock,
+                [&]
+                {
+                    return !writer_queue_.empty() || writer_stop_;
+                });
+
+            pop_dispatched_samples_nts_(samples);
+        }
+
+        if (samples.empty())
+        {
+            // Stopped and every queued sample written
+            EPROSIMA_LOG_INFO(DDSRECORDER_BASE_HANDLER, "Finishing writer thread routine.");
+            break;
+        }
+
+        // Notify threads waiting for space in the queue
+        writer_cv_.notify_all();
+
+        // NOTE: mtx_ is not taken, so samples keep being received while writing to disk
+        std::lock_guard<std::mutex> write_lock(write_mtx_);
+        write_samples_(samples);
+    }
+}
+
 void BaseHandler::process_new_sample_nts_(
         std::shared_ptr<const BaseMessage> sample)
 {
@@ -397,11 +604,12 @@ void BaseHandler::process_new_sample_nts_(
         return;
     }
 
-    EPROSIMA_LOG_INFO(DDSRECORDER_BASE_HANDLER, "Adding data in topic " << sample->topic);
+    EPROSIMA_LOG_INFO(DDSRECORDER_BASE_HANDLER, "Adding data in topic " << *sample->topic);
 
-    if (received_types_.find(sample->topic.type_name) != received_types_.end())
+    if (received_types_.find(sample->topic->type_name) != received_types_.end())
     {
         add_sample_to_buffer_nts_(sample);
+        enforce_memory_limit_nts_();
         return;
     }
 
@@ -412,7 +620,7 @@ void BaseHandler::process_new_sample_nts_(
             if (configuration_.max_pending_samples != 0)
             {
                 EPROSIMA_LOG_INFO(DDSRECORDER_BASE_HANDLER,
-                        "Dynamic type for topic " << sample->topic << " not yet available, inserting to pending "
+                        "Dynamic type for topic " << *sample->topic << " not yet available, inserting to pending "
                         "samples queue.");
 
                 add_sample_to_pending_nts_(sample);
@@ -436,10 +644,10 @@ void BaseHandler::process_new_sample_nts_(
 
             EPROSIMA_LOG_INFO(
                 DDSRECORDER_BASE_HANDLER,
-                "Dynamic type for topic " << sample->topic << " not yet available, inserting to (paused) pending "
+                "Dynamic type for topic " << *sample->topic << " not yet available, inserting to (paused) pending "
                     "samples queue.");
 
-            pending_samples_paused_[sample->topic.type_name].push_back(sample);
+            pending_samples_paused_[sample->topic->type_name].push_back(sample);
             break;
 
         default:
@@ -448,12 +656,22 @@ void BaseHandler::process_new_sample_nts_(
             utils::tsnh(utils::Formatter() << "Trying to add sample to a stopped instance.");
             break;
     }
+
+    enforce_memory_limit_nts_();
 }
 
 void BaseHandler::add_sample_to_buffer_nts_(
         std::shared_ptr<const BaseMessage> sample)
 {
-    samples_buffer_.push_back(sample);
+    if (state_ == BaseHandlerStateCode::PAUSED)
+    {
+        // Keep the sample until it is outdated or an event is triggered
+        event_window_buffer_.push_back(std::move(sample));
+        return;
+    }
+
+    samples_buffer_memory_ += sample->payload.length;
+    samples_buffer_.push_back(std::move(sample));
 
     if (state_ != BaseHandlerStateCode::RUNNING || samples_buffer_.size() < configuration_.buffer_size)
     {
@@ -473,11 +691,19 @@ void BaseHandler::add_sample_to_buffer_nts_(
                                       << configuration_.buffer_size << "). Writing to disk...");
     }
 
-    write_samples_(samples_buffer_);
+    // NOTE: the buffer is swapped out under the lock, but written once the lock is released
+    flush_samples_buffer_nts_(true);
+}
+
+void BaseHandler::flush_samples_buffer_nts_(
+        bool deferred /* = false */)
+{
+    dispatch_samples_nts_(samples_buffer_, deferred);
+    samples_buffer_memory_ = 0;
 }
 
 void BaseHandler::add_samples_to_buffer_nts_(
-        std::list<std::shared_ptr<const BaseMessage>>& samples)
+        SamplesQueue& samples)
 {
     while (!samples.empty())
     {
@@ -486,35 +712,49 @@ void BaseHandler::add_samples_to_buffer_nts_(
     }
 }
 
+void BaseHandler::add_samples_to_buffer_nts_(
+        EventWindowBuffer& samples)
+{
+    SamplesBatch batch;
+    samples.move_to(batch);
+
+    for (auto& sample : batch)
+    {
+        add_sample_to_buffer_nts_(std::move(sample));
+    }
+}
+
 void BaseHandler::add_sample_to_pending_nts_(
         std::shared_ptr<const BaseMessage> sample)
 {
     assert(configuration_.max_pending_samples != 0);
 
-    auto& pending_samples = pending_samples_[sample->topic.type_name];
+    auto& pending_samples = pending_samples_[sample->topic->type_name];
 
     while (pending_samples.size() >= configuration_.max_pending_samples)
     {
         // The pending samples buffer is full. Discard the oldest sample.
         const auto oldest_sample = pending_samples.front();
         pending_samples.pop_front();
+        pending_samples_memory_ -= oldest_sample->payload.length;
 
         if (configuration_.only_with_schema)
         {
             EPROSIMA_LOG_WARNING(DDSRECORDER_BASE_HANDLER,
-                    "Dropping pending sample in type " << sample->topic.type_name << ": buffer limit ("
+                    "Dropping pending sample in type " << sample->topic->type_name << ": buffer limit ("
                                                        << configuration_.max_pending_samples << ") reached.");
         }
         else
         {
             EPROSIMA_LOG_INFO(DDSRECORDER_BASE_HANDLER,
                     "Buffer limit (" << configuration_.max_pending_samples <<  ") reached for type "
-                                     << sample->topic.type_name << ": writing oldest sample without schema.");
+                                     << sample->topic->type_name << ": writing oldest sample without schema.");
 
             add_sample_to_buffer_nts_(oldest_sample);
         }
     }
 
+    pending_samples_memory_ += sample->payload.length;
     pending_samples.push_back(sample);
 }
 
@@ -525,16 +765,24 @@ void BaseHandler::dump_pending_samples_nts_(
 
     if (pending_samples_.find(type_name) != pending_samples_.end())
     {
+        auto& pending_samples = pending_samples_[type_name];
+
+        for (const auto& sample : pending_samples)
+        {
+            pending_samples_memory_ -= sample->payload.length;
+        }
+
         if (state_ == BaseHandlerStateCode::PAUSED)
         {
             // The samples were received previously in the RUNNING state.
             // To avoid them being cleaned by the event thread, we write them directly.
-            write_samples_(pending_samples_[type_name]);
+            SamplesBatch samples(pending_samples.begin(), pending_samples.end());
+            dispatch_samples_nts_(samples);
         }
         else
         {
             // Move samples from pending_samples to buffer
-            add_samples_to_buffer_nts_(pending_samples_[type_name]);
+            add_samples_to_buffer_nts_(pending_samples);
         }
 
         pending_samples_.erase(type_name);
@@ -549,6 +797,154 @@ void BaseHandler::dump_pending_samples_nts_(
     }
 }
 
+std::uint64_t BaseHandler::buffered_memory_nts_() const
+{
+    std::uint64_t memory = samples_buffer_memory_ + pending_samples_memory_ + event_window_buffer_.memory();
+
+    for (const auto& it : pending_samples_paused_)
+    {
+        memory += it.second.memory();
+    }
+
+    return memory;
+}
+
+void BaseHandler::enforce_memory_limit_nts_()
+{
+    if (configuration_.max_buffer_memory == 0)
+    {
+        return;
+    }
+
+    // NOTE: computed once, and decreased with the memory of every sample released
+    auto memory = buffered_memory_nts_();
+
+    if (memory <= configuration_.max_buffer_memory)
+    {
+        return;
+    }
+
+    EPROSIMA_LOG_WARNING(DDSRECORDER_BASE_HANDLER,
+            "The memory buffered (" << memory << " bytes) exceeds its limit ("
+                                    << configuration_.max_buffer_memory << " bytes).");
+
+    monitor_error("BUFFER_MEMORY_FULL");
+
+    if (state_ == BaseHandlerStateCode::RUNNING)
+    {
+        // The samples with schema can be written right away
+        memory -= samples_buffer_memory_;
+        flush_samples_buffer_nts_(true);
+
+        // Release the oldest pending samples (of any type) until the memory is back under the limit
+        using PendingSamples = decltype(pending_samples_)::iterator;
+
+        const auto newer = [](const PendingSamples& lhs, const PendingSamples& rhs)
+                {
+                    return rhs->second.front()->log_time < lhs->second.front()->log_time;
+                };
+
+        std::priority_queue<PendingSamples, std::vector<PendingSamples>, decltype(newer)> oldest(newer);
+
+        for (auto it = pending_samples_.begin(); it != pending_samples_.end(); ++it)
+        {
+            if (!it->second.empty())
+            {
+                oldest.push(it);
+            }
+        }
+
+        while (memory > configuration_.max_buffer_memory && !oldest.empty())
+        {
+            auto it = oldest.top();
+            oldest.pop();
+
+            auto oldest_sample = std::move(it->second.front());
+            it->second.pop_front();
+
+            // NOTE: the sample is either dropped or written below, so its memory is released in both cases
+            pending_samples_memory_ -= oldest_sample->payload.length;
+            memory -= oldest_sample->payload.length;
+
+            if (it->second.empty())
+            {
+                pending_samples_.erase(it);
+            }
+            else
+            {
+                oldest.push(it);
+            }
+
+            if (configuration_.only_with_schema)
+            {
+                EPROSIMA_LOG_WARNING(DDSRECORDER_BASE_HANDLER,
+                        "Dropping pending sample in type " << oldest_sample->topic->type_name
+                                                           << ": memory limit reached.");
+            }
+            else
+            {
+                add_sample_to_buffer_nts_(std::move(oldest_sample));
+            }
+        }
+
+        flush_samples_buffer_nts_(true);
+    }
+    else if (state_ == BaseHandlerStateCode::PAUSED)
+    {
+        // Spill the event window to disk (if enabled) before discarding any sample
+        const auto event_window_memory = event_window_buffer_.memory();
+        const auto other_memory = memory - event_window_memory;
+
+        event_window_buffer_.spill(
+            configuration_.max_buffer_memory > other_memory ? configuration_.max_buffer_memory - other_memory : 0);
+
+        memory -= event_window_memory - event_window_buffer_.memory();
+
+        // Nothing is written while paused: discard the oldest samples (of any type) in the event window and in the
+        // pending samples
+        const auto newer = [](const EventWindowBuffer* lhs, const EventWindowBuffer* rhs)
+                {
+                    return rhs->front().log_time < lhs->front().log_time;
+                };
+
+        std::priority_queue<EventWindowBuffer*, std::vector<EventWindowBuffer*>, decltype(newer)> oldest(newer);
+
+        // NOTE: the event window is only trimmed while it keeps payloads in memory (the spilled ones take none)
+        if (event_window_buffer_.memory() > 0)
+        {
+            oldest.push(&event_window_buffer_);
+        }
+
+        for (auto& [_, pending] : pending_samples_paused_)
+        {
+            if (!pending.empty())
+            {
+                oldest.push(&pending);
+            }
+        }
+
+        while (memory > configuration_.max_buffer_memory && !oldest.empty())
+        {
+            auto samples = oldest.top();
+            oldest.pop();
+
+            const auto samples_memory = samples->memory();
+            samples->pop_front();
+            memory -= samples_memory - samples->memory();
+
+            if (!samples->empty() && (samples != &event_window_buffer_ || samples->memory() > 0))
+            {
+                oldest.push(samples);
+            }
+        }
+
+        for (auto it = pending_samples_paused_.begin(); it != pending_samples_paused_.end();)
+        {
+            it = it->second.empty() ? pending_samples_paused_.erase(it) : std::next(it);
+        }
+    }
+}
+
 void BaseHandler::remove_outdated_samples_nts_()
 {
     EPROSIMA_LOG_INFO(DDSRECORDER_BASE_HANDLER, "Removing outdated samples.");
@@ -560,18 +956,13 @@ void BaseHandler::remove_outdated_samples_nts_()
     // NOTE: the outdated pending samples are not removed since they must be written as soon as they receive their type.
 
     // Buffer
-    samples_buffer_.remove_if([&](const auto& sample)
-            {
-                return sample->log_time < threshold;
-            });
+    event_window_buffer_.remove_outdated(threshold);
 
     // Pending samples paused
-    for (auto& [_, pending] : pending_samples_paused_)
+    for (auto it = pending_samples_paused_.begin(); it != pending_samples_paused_.end();)
     {
-        pending.remove_if([&](const auto sample)
-                {
-                    return sample->log_time < threshold;
-                });
+        it->second.remove_outdated(threshold);
+        it = it->second.empty() ? pending_samples_paused_.erase(it) : std::next(it);
     }
 }
 
@@ -107,7 +107,8 @@ void BaseWriter::on_file_full_nts_(
     // Disable the writer in case opening a new file fails
     enabled_ = false;
 
-    if (configuration_.resource_limits.max_file_size_ == configuration_.resource_limits.max_size_)
+    if (configuration_.resource_limits.max_file_size_ == configuration_.resource_limits.max_size_ &&
+            configuration_.resource_limits.max_file_duration_ == 0)
     {
         // There can only be one file and it's full
         throw FullDiskException(e.what());
@@ -0,0 +1,346 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file EventWindowBuffer.cpp
+ */
+
+#include <algorithm>
+#include <iterator>
+
+#include <cpp_utils/Log.hpp>
+
+#include <ddsrecorder_participants/recorder/handler/EventWindowBuffer.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+void EventWindowBuffer::enable_spill(
+        std::unique_ptr<EventWindowSpill> spill,
+        std::uint64_t memory_threshold)
+{
+    spill_ = std::move(spill);
+    spill_threshold_ = memory_threshold;
+}
+
+void EventWindowBuffer::push_back(
+        std::shared_ptr<const BaseMessage> sample)
+{
+    const auto bucket_key = sample->log_time.seconds();
+    const auto sample_memory = sample->payload.length;
+
+    // Samples are expected in reception order, so they (almost) always belong to the last bucket
+    auto it = buckets_.end();
+
+    if (!buckets_.empty() && buckets_.rbegin()->first == bucket_key)
+    {
+        it = std::prev(buckets_.end());
+    }
+    else
+    {
+        it = buckets_.try_emplace(bucket_key).first;
+    }
+
+    it->second.entries.push_back({std::move(sample), std::nullopt});
+    it->second.memory += sample_memory;
+
+    size_++;
+    memory_ += sample_memory;
+
+    if (spill_ && memory_ > spill_threshold_)
+    {
+        spill(spill_threshold_);
+    }
+}
+
+void EventWindowBuffer::remove_outdated(
+        const ddspipe::core::types::DataTime& threshold)
+{
+    const auto threshold_key = threshold.seconds();
+
+    // Drop the buckets older than the threshold
+    while (!buckets_.empty() && buckets_.begin()->first < threshold_key)
+    {
+        pop_front_bucket_();
+    }
+
+    // Only the bucket containing the threshold may hold both outdated and valid samples
+    auto it = buckets_.begin();
+
+    if (it != buckets_.end() && it->first == threshold_key)
+    {
+        auto& bucket = it->second;
+
+        const auto valid = std::stable_partition(bucket.entries.begin(), bucket.entries.end(), [&](const auto& entry)
+                        {
+                            return !(entry.sample->log_time < threshold);
+                        });
+
+        for (auto entry = valid; entry != bucket.entries.end(); ++entry)
+        {
+            bucket.memory -= entry->sample->payload.length;
+            memory_ -= entry->sample->payload.length;
+            release_entry_(*entry);
+        }
+
+        size_ -= std::distance(valid, bucket.entries.end());
+        bucket.entries.erase(valid, bucket.entries.end());
+
+        // The remaining entries are visited again by the next spill (skipping the ones already spilled)
+        bucket.spill_position = 0;
+
+        if (bucket.entries.empty())
+        {
+            buckets_.erase(it);
+        }
+    }
+}
+
+const BaseMessage& EventWindowBuffer::front() const
+{
+    return *buckets_.begin()->second.entries.front().sample;
+}
+
+void EventWindowBuffer::pop_front()
+{
+    auto it = buckets_.begin();
+    auto& bucket = it->second;
+
+    if (bucket.entries.size() == 1)
+    {
+        pop_front_bucket_();
+        return;
+    }
+
+    const auto& entry = bucket.entries.front();
+    const auto sample_memory = entry.sample->payload.length;
+
+    release_entry_(entry);
+
+    size_--;
+    memory_ -= sample_memory;
+
+    // NOTE: erasing the first element of a bucket is linear on its size, which is bounded by the samples received
+    // in one second
+    bucket.entries.erase(bucket.entries.begin());
+    bucket.memory -= sample_memory;
+
+    if (bucket.spill_position > 0)
+    {
+        bucket.spill_position--;
+    }
+}
+
+void EventWindowBuffer::spill(
+        std::uint64_t memory)
+{
+    if (!spill_)
+    {
+        return;
+    }
+
+    auto it = buckets_.lower_bound(next_spill_key_);
+
+    while (memory_ > memory && it != buckets_.end())
+    {
+        auto& bucket = it->second;
+
+        for (; bucket.spill_position < bucket.entries.size() && memory_ > memory; bucket.spill_position++)
+        {
+            auto& entry = bucket.entries[bucket.spill_position];
+
+            if (entry.record || entry.sample->payload.length > spill_->capacity())
+            {
+                // Already spilled, or too large to ever fit in the spill file
+                continue;
+            }
+
+            if (!spill_entry_(it, entry))
+            {
+                // No room left in the spill file: keep the remaining payloads in memory
+                return;
+            }
+        }
+
+        // Continue from this bucket next time, since samples received later on in the same second are added to it
+        next_spill_key_ = it->first;
+        ++it;
+    }
+}
+
+void EventWindowBuffer::move_to(
+        SamplesBatch& samples,
+        std::size_t max_samples /* = std::numeric_limits<std::size_t>::max() */)
+{
+    samples.reserve(samples.size() + std::min(max_samples, size_));
+
+    auto it = buckets_.begin();
+
+    while (it != buckets_.end() && max_samples > 0)
+    {
+        auto& bucket = it->second;
+        const auto moved = std::min(max_samples, bucket.entries.size());
+
+        for (std::size_t i = 0; i < moved; i++)
+        {
+            auto& entry = bucket.entries[i];
+
+            if (!entry.record)
+            {
+                bucket.memory -= entry.sample->payload.length;
+                memory_ -= entry.sample->payload.length;
+            }
+            else if (!restore_entry_(entry))
+            {
+                EPROSIMA_LOG_WARNING(DDSRECORDER_EVENT_WINDOW_BUFFER,
+                        "Failed to read back spilled sample in topic " << *entry.sample->topic << ", dropping...");
+                continue;
+            }
+
+            samples.push_back(std::move(entry.sample));
+        }
+
+        size_ -= moved;
+        max_samples -= moved;
+
+        if (moved < bucket.entries.size())
+        {
+            bucket.entries.erase(bucket.entries.begin(), bucket.entries.begin() + moved);
+            bucket.spill_position -= std::min(bucket.spill_position, moved);
+            break;
+        }
+
+        it = buckets_.erase(it);
+    }
+}
+
+void EventWindowBuffer::clear() noexcept
+{
+    buckets_.clear();
+    size_ = 0;
+    memory_ = 0;
+
+    if (spill_)
+    {
+        spill_->clear();
+    }
+
+    next_spill_key_ = std::numeric_limits<std::int32_t>::min();
+}
+
+std::size_t EventWindowBuffer::size() const noexcept
+{
+    return size_;
+}
+
+bool EventWindowBuffer::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+std::uint64_t EventWindowBuffer::memory() const noexcept
+{
+    return memory_;
+}
+
+bool EventWindowBuffer::spill_entry_(
+        std::map<std::int32_t, Bucket>::iterator bucket,
+        Entry& entry)
+{
+    const auto& payload = entry.sample->payload;
+    const auto sample_memory = payload.length;
+
+    EventWindowSpill::RecordId record;
+
+    // The spill file is a ring: once full, the oldest samples are overwritten
+    while (!spill_->write(payload.data, sample_memory, record))
+    {
+        if (buckets_.begin() == bucket)
+        {
+            return false;
+        }
+
+        EPROSIMA_LOG_INFO(DDSRECORDER_EVENT_WINDOW_BUFFER,
+                "Event window spill file full: dropping the samples received in second " << buckets_.begin()->first
+                                                                                         << ".");
+
+        pop_front_bucket_();
+    }
+
+    // Keep a copy of the sample without payload, so the payload is released (unless referenced somewhere else)
+    entry.sample = entry.sample->copy_with_payload(ddspipe::core::types::Payload());
+    entry.record = record;
+
+    bucket->second.memory -= sample_memory;
+    memory_ -= sample_memory;
+
+    return true;
+}
+
+bool EventWindowBuffer::restore_entry_(
+        Entry& entry)
+{
+    const auto payload_owner = entry.sample->payload_owner;
+    const auto sample_memory = spill_->size(*entry.record);
+
+    ddspipe::core::types::Payload payload;
+    const bool restored = payload_owner->get_payload(sample_memory, payload);
+
+    if (restored)
+    {
+        spill_->read(*entry.record, payload.data);
+        payload.length = sample_memory;
+
+        // Replace the sample with a copy referencing the restored payload
+        entry.sample = entry.sample->copy_with_payload(payload);
+        payload_owner->release_payload(payload);
+    }
+
+    spill_->release(*entry.record);
+    entry.record.reset();
+
+    return restored;
+}
+
+void EventWindowBuffer::release_entry_(
+        const Entry& entry)
+{
+    if (entry.record)
+    {
+        spill_->release(*entry.record);
+    }
+}
+
+void EventWindowBuffer::pop_front_bucket_()
+{
+    auto it = buckets_.begin();
+
+    if (spill_)
+    {
+        for (const auto& entry : it->second.entries)
+        {
+            release_entry_(entry);
+        }
+    }
+
+    size_ -= it->second.entries.size();
+    memory_ -= it->second.memory;
+
+    buckets_.erase(it);
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
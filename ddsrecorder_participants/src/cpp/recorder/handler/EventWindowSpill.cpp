@@ -0,0 +1,284 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file EventWindowSpill.cpp
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // if defined(_WIN32)
+
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/Formatter.hpp>
+#include <cpp_utils/Log.hpp>
+
+#include <ddsrecorder_participants/recorder/handler/EventWindowSpill.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+#if defined(_WIN32)
+
+void unmap_file(
+        std::byte* data,
+        void* mapping_handle,
+        void* file_handle)
+{
+    if (data != nullptr)
+    {
+        UnmapViewOfFile(data);
+    }
+
+    if (mapping_handle != nullptr)
+    {
+        CloseHandle(mapping_handle);
+    }
+
+    if (file_handle != nullptr && file_handle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file_handle);
+    }
+}
+
+#else
+
+void unmap_file(
+        std::byte* data,
+        std::uint64_t capacity,
+        int file_descriptor)
+{
+    if (data != nullptr)
+    {
+        munmap(data, capacity);
+    }
+
+    if (file_descriptor >= 0)
+    {
+        close(file_descriptor);
+    }
+}
+
+#endif // if defined(_WIN32)
+
+} /* namespace */
+
+EventWindowSpill::EventWindowSpill(
+        const std::string& file_path,
+        std::uint64_t capacity)
+    : file_path_(file_path)
+    , capacity_(capacity)
+{
+    if (capacity_ == 0)
+    {
+        throw utils::InitializationException(
+                  STR_ENTRY << "Failed to create event window spill file " << file_path_ << ": its size must be > 0.");
+    }
+
+#if defined(_WIN32)
+    file_handle_ = CreateFileA(file_path_.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                    FILE_ATTRIBUTE_TEMPORARY, nullptr);
+
+    if (file_handle_ != INVALID_HANDLE_VALUE)
+    {
+        // NOTE: creating the mapping extends the file to its full size
+        mapping_handle_ = CreateFileMappingA(file_handle_, nullptr, PAGE_READWRITE,
+                        static_cast<DWORD>(capacity_ >> 32), static_cast<DWORD>(capacity_ & 0xFFFFFFFF), nullptr);
+    }
+
+    if (mapping_handle_ != nullptr)
+    {
+        data_ = static_cast<std::byte*>(MapViewOfFile(mapping_handle_, FILE_MAP_ALL_ACCESS, 0, 0, capacity_));
+    }
+
+    if (data_ == nullptr)
+    {
+        unmap_file(data_, mapping_handle_, file_handle_);
+
+        throw utils::InitializationException(
+                  STR_ENTRY << "Failed to map event window spill file " << file_path_ << " (error "
+                            << GetLastError() << ").");
+    }
+#else
+    file_descriptor_ = open(file_path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+
+    int error = file_descriptor_ < 0 ? errno : 0;
+
+    if (error == 0)
+    {
+#if defined(__linux__)
+        // Reserve the disk blocks up front, so writing to the mapping never fails for lack of space
+        error = posix_fallocate(file_descriptor_, 0, capacity_);
+#else
+        error = ftruncate(file_descriptor_, capacity_) == 0 ? 0 : errno;
+#endif // if defined(__linux__)
+    }
+
+    if (error == 0)
+    {
+        void* data = mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor_, 0);
+
+        if (data == MAP_FAILED)
+        {
+            error = errno;
+        }
+        else
+        {
+            data_ = static_cast<std::byte*>(data);
+        }
+    }
+
+    if (error != 0)
+    {
+        unmap_file(data_, capacity_, file_descriptor_);
+
+        std::error_code ec;
+        std::filesystem::remove(file_path_, ec);
+
+        throw utils::InitializationException(
+                  STR_ENTRY << "Failed to map event window spill file " << file_path_ << ": "
+                            << std::generic_category().message(error) << ".");
+    }
+#endif // if defined(_WIN32)
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_EVENT_WINDOW_SPILL,
+            "Created event window spill file " << file_path_ << " of " << capacity_ << " bytes.");
+}
+
+EventWindowSpill::~EventWindowSpill()
+{
+#if defined(_WIN32)
+    unmap_file(data_, mapping_handle_, file_handle_);
+#else
+    unmap_file(data_, capacity_, file_descriptor_);
+#endif // if defined(_WIN32)
+
+    std::error_code ec;
+    std::filesystem::remove(file_path_, ec);
+}
+
+bool EventWindowSpill::write(
+        const void* data,
+        std::uint32_t size,
+        RecordId& record)
+{
+    if (size == 0 || size > capacity_)
+    {
+        return false;
+    }
+
+    std::uint64_t offset = 0;
+
+    if (!records_.empty())
+    {
+        const auto tail = records_.front().offset;
+
+        if (head_ > tail)
+        {
+            // Free space: [head, capacity) and [0, tail)
+            if (capacity_ - head_ >= size)
+            {
+                offset = head_;
+            }
+            else if (tail >= size)
+            {
+                offset = 0;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // Wrapped around. Free space: [head, tail)
+            if (tail - head_ < size)
+            {
+                return false;
+            }
+
+            offset = head_;
+        }
+    }
+
+    std::memcpy(data_ + offset, data, size);
+
+    records_.push_back({offset, size, false});
+    head_ = offset + size;
+
+    record = first_record_ + records_.size() - 1;
+
+    return true;
+}
+
+void EventWindowSpill::read(
+        RecordId record,
+        void* data) const
+{
+    const auto& stored_record = records_[record - first_record_];
+
+    std::memcpy(data, data_ + stored_record.offset, stored_record.size);
+}
+
+std::uint32_t EventWindowSpill::size(
+        RecordId record) const
+{
+    return records_[record - first_record_].size;
+}
+
+void EventWindowSpill::release(
+        RecordId record)
+{
+    records_[record - first_record_].released = true;
+
+    // Reuse the space of the oldest records once released
+    while (!records_.empty() && records_.front().released)
+    {
+        records_.pop_front();
+        first_record_++;
+    }
+
+    if (records_.empty())
+    {
+        head_ = 0;
+    }
+}
+
+void EventWindowSpill::clear() noexcept
+{
+    first_record_ += records_.size();
+    records_.clear();
+    head_ = 0;
+}
+
+std::uint64_t EventWindowSpill::capacity() const noexcept
+{
+    return capacity_;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -24,6 +24,7 @@
 #include <ddsrecorder_participants/recorder/handler/mcap/McapHandler.hpp>
 #include <ddsrecorder_participants/recorder/handler/mcap/McapHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/handler/BaseHandler.hpp>
+#include <ddsrecorder_participants/recorder/handler/HandlerFanOut.hpp>
 #include <ddsrecorder_participants/recorder/handler/sql/SqlHandler.hpp>
 #include <ddsrecorder_participants/recorder/handler/sql/SqlHandlerConfiguration.hpp>
 
@@ -52,7 +53,8 @@ std::shared_ptr<HandlerContext> HandlerContext::create_context(
         std::shared_ptr<eprosima::ddspipe::core::ParticipantsDatabase> participants_database,
         std::shared_ptr<eprosima::ddspipe::core::DiscoveryDatabase> discovery_database,
         const participants::BaseHandlerStateCode& init_state,
-        const std::function<void()>& on_disk_full_callback)
+        const std::function<void()>& on_disk_full_callback,
+        std::shared_ptr<HandlerFanOut> fan_out /* = nullptr */)
 {
     std::shared_ptr<HandlerContext> handler_context;
     std::shared_ptr<BaseHandler> handler;
@@ -86,18 +88,35 @@ std::shared_ptr<HandlerContext> HandlerContext::create_context(
                       "Unknown handler kind: " + std::to_string(static_cast<int>(kind)));
     }
 
-    // Create Recorder Participant
-    auto participant = std::make_shared<eprosima::ddspipe::participants::SchemaParticipant>(
-        participant_configuration,
-        payload_pool,
-        discovery_database,
-        handler);
-
-    // Populate Participant Database with the sql recorder participant
-    participants_database->add_participant(
-        participant->id(),
-        participant
-        );
+    std::shared_ptr<eprosima::ddspipe::participants::SchemaParticipant> participant;
+
+    if (fan_out)
+    {
+        // Feed the handler from the participant shared with the other contexts
+        fan_out->add_handler(handler);
+        participant = fan_out->get_schema_participant();
+    }
+
+    if (!participant)
+    {
+        // Create Recorder Participant
+        participant = std::make_shared<eprosima::ddspipe::participants::SchemaParticipant>(
+            participant_configuration,
+            payload_pool,
+            discovery_database,
+            fan_out ? std::static_pointer_cast<ddspipe::participants::ISchemaHandler>(fan_out) : handler);
+
+        // Populate Participant Database with the recorder participant
+        participants_database->add_participant(
+            participant->id(),
+            participant
+            );
+
+        if (fan_out)
+        {
+            fan_out->set_schema_participant(participant);
+        }
+    }
 
     // Create entry
     handler_context.reset( new HandlerContext(
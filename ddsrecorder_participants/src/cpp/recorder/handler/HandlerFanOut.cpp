@@ -0,0 +1,65 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file HandlerFanOut.cpp
+ */
+
+#include <ddsrecorder_participants/recorder/handler/HandlerFanOut.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+void HandlerFanOut::add_handler(
+        std::shared_ptr<ddspipe::participants::ISchemaHandler> handler)
+{
+    handlers_.push_back(std::move(handler));
+}
+
+void HandlerFanOut::add_schema(
+        const fastdds::dds::DynamicType::_ref_type& dynamic_type,
+        const fastdds::dds::xtypes::TypeIdentifier& type_identifier)
+{
+    for (const auto& handler : handlers_)
+    {
+        handler->add_schema(dynamic_type, type_identifier);
+    }
+}
+
+void HandlerFanOut::add_data(
+        const ddspipe::core::types::DdsTopic& topic,
+        ddspipe::core::types::RtpsPayloadData& data)
+{
+    // NOTE: the payload is not copied, every handler takes a reference to it from the payload pool
+    for (const auto& handler : handlers_)
+    {
+        handler->add_data(topic, data);
+    }
+}
+
+std::shared_ptr<ddspipe::participants::SchemaParticipant> HandlerFanOut::get_schema_participant() const
+{
+    return schema_participant_.lock();
+}
+
+void HandlerFanOut::set_schema_participant(
+        const std::shared_ptr<ddspipe::participants::SchemaParticipant>& schema_participant)
+{
+    schema_participant_ = schema_participant;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
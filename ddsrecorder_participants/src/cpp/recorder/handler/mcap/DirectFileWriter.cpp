@@ -0,0 +1,359 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DirectFileWriter.cpp
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif // if defined(__linux__)
+
+#include <cpp_utils/Log.hpp>
+#include <cpp_utils/utils.hpp>
+
+#include <ddsrecorder_participants/recorder/handler/mcap/DirectFileWriter.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+std::uint64_t align_up(
+        const std::uint64_t size,
+        const std::uint64_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+DirectFileWriter::DirectFileWriter(
+        const std::uint64_t buffer_size,
+        const std::uint32_t max_in_flight_writes)
+    : buffer_size_(align_up(std::max<std::uint64_t>(buffer_size, 1), ALIGNMENT))
+    , max_in_flight_writes_(std::max<std::uint32_t>(max_in_flight_writes, 1))
+    , buffer_(nullptr, std::free)
+{
+    buffer_ = allocate_buffer_();
+
+    for (std::uint32_t i = 0; i < max_in_flight_writes_; i++)
+    {
+        free_buffers_.push_back(allocate_buffer_());
+    }
+}
+
+DirectFileWriter::~DirectFileWriter()
+{
+    end();
+}
+
+bool DirectFileWriter::is_supported() noexcept
+{
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif // if defined(__linux__)
+}
+
+mcap::Status DirectFileWriter::open(
+        const std::string& filename,
+        const std::uint64_t max_preallocated_size)
+{
+#if defined(__linux__)
+    filename_ = filename;
+    file_descriptor_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | O_DIRECT, 0644);
+
+    if (file_descriptor_ < 0 && errno == EINVAL)
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | The filesystem of " << filename << " does not support O_DIRECT. Writing it through the "
+                "page cache.");
+
+        file_descriptor_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    }
+
+    if (file_descriptor_ < 0)
+    {
+        return mcap::Status{mcap::StatusCode::OpenFailed, std::string("failed to open: ") + std::strerror(errno)};
+    }
+
+    size_ = 0;
+    preallocated_size_ = 0;
+    max_preallocated_size_ = max_preallocated_size;
+    buffer_offset_ = 0;
+    buffer_used_ = 0;
+    stop_ = false;
+    failed_ = false;
+    write_thread_ = std::thread(&DirectFileWriter::write_thread_routine_, this);
+
+    return mcap::StatusCode::Success;
+#else
+    static_cast<void>(max_preallocated_size);
+    return mcap::Status{mcap::StatusCode::OpenFailed, "failed to open " + filename + ": direct output not supported"};
+#endif // if defined(__linux__)
+}
+
+void DirectFileWriter::end()
+{
+    if (file_descriptor_ < 0)
+    {
+        return;
+    }
+
+#if defined(__linux__)
+    if (buffer_used_ > 0)
+    {
+        // The last write is padded to the alignment, and the padding truncated below
+        std::memset(buffer_.get() + buffer_used_, 0, align_up(buffer_used_, ALIGNMENT) - buffer_used_);
+        submit_buffer_(align_up(buffer_used_, ALIGNMENT));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+
+    cv_.notify_all();
+    write_thread_.join();
+
+    if (::ftruncate(file_descriptor_, size_) != 0)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Failed to truncate " << filename_ << " to " << utils::from_bytes(size_) << ": " <<
+                std::strerror(errno) << ".");
+    }
+
+    ::close(file_descriptor_);
+#endif // if defined(__linux__)
+
+    file_descriptor_ = -1;
+}
+
+void DirectFileWriter::flush()
+{
+    if (file_descriptor_ < 0 || failed_)
+    {
+        // Nothing else is written after a failed write
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (buffer_used_ > 0)
+    {
+        // Write a padded copy of the current buffer, which keeps being filled and overwrites the copy once full
+        cv_.wait(lock, [&]()
+                {
+                    return !free_buffers_.empty();
+                });
+
+        auto buffer = std::move(free_buffers_.back());
+        free_buffers_.pop_back();
+
+        const auto size = align_up(buffer_used_, ALIGNMENT);
+        std::memcpy(buffer.get(), buffer_.get(), buffer_used_);
+        std::memset(buffer.get() + buffer_used_, 0, size - buffer_used_);
+
+        pending_writes_.push_back({std::move(buffer), buffer_offset_, size});
+        cv_.notify_all();
+    }
+
+    cv_.wait(lock, [&]()
+            {
+                return free_buffers_.size() == max_in_flight_writes_;
+            });
+}
+
+uint64_t DirectFileWriter::size() const
+{
+    return size_;
+}
+
+bool DirectFileWriter::failed() const noexcept
+{
+    return failed_;
+}
+
+void DirectFileWriter::handleWrite(
+        const std::byte* data,
+        uint64_t size)
+{
+    size_ += size;
+
+    if (failed_)
+    {
+        // The bytes would be dropped by the write thread anyway
+        return;
+    }
+
+    while (size > 0)
+    {
+        const auto to_copy = std::min(size, buffer_size_ - buffer_used_);
+        std::memcpy(buffer_.get() + buffer_used_, data, to_copy);
+
+        buffer_used_ += to_copy;
+        data += to_copy;
+        size -= to_copy;
+
+        if (buffer_used_ == buffer_size_)
+        {
+            submit_buffer_(buffer_size_);
+        }
+    }
+}
+
+void DirectFileWriter::submit_buffer_(
+        const std::uint64_t size)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    pending_writes_.push_back({std::move(buffer_), buffer_offset_, size});
+    cv_.notify_all();
+
+    // Bound the writes in flight: wait for a buffer to be written if none is free
+    cv_.wait(lock, [&]()
+            {
+                return !free_buffers_.empty();
+            });
+
+    buffer_ = std::move(free_buffers_.back());
+    free_buffers_.pop_back();
+
+    buffer_offset_ += size;
+    buffer_used_ = 0;
+}
+
+void DirectFileWriter::write_thread_routine_()
+{
+#if defined(__linux__)
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true)
+    {
+        cv_.wait(lock, [&]()
+                {
+                    return stop_ || !pending_writes_.empty();
+                });
+
+        if (pending_writes_.empty())
+        {
+            // Stopped with every buffer written
+            return;
+        }
+
+        auto pending_write = std::move(pending_writes_.front());
+        pending_writes_.pop_front();
+
+        lock.unlock();
+
+        preallocate_(pending_write.offset + pending_write.size);
+
+        std::uint64_t written = 0;
+
+        while (!failed_ && written < pending_write.size)
+        {
+            const auto ret = ::pwrite(file_descriptor_, pending_write.buffer.get() + written,
+                            pending_write.size - written, pending_write.offset + written);
+
+            if (ret < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (ret <= 0)
+            {
+                EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+                        "MCAP_WRITE | Failed to write " << filename_ << ": " << std::strerror(errno) << ". The rest "
+                        "of the file is dropped.");
+
+                failed_ = true;
+                break;
+            }
+
+            written += static_cast<std::uint64_t>(ret);
+        }
+
+        lock.lock();
+
+        free_buffers_.push_back(std::move(pending_write.buffer));
+        cv_.notify_all();
+    }
+#endif // if defined(__linux__)
+}
+
+void DirectFileWriter::preallocate_(
+        const std::uint64_t end_offset)
+{
+#if defined(__linux__)
+    if (end_offset <= preallocated_size_ || preallocated_size_ >= max_preallocated_size_)
+    {
+        return;
+    }
+
+    // NOTE: Allocate large extents at once, so the filesystem lays the file out contiguously. The file is truncated to
+    // the bytes written when it ends.
+    const auto size = std::min(
+        std::max(end_offset, preallocated_size_ + PREALLOCATION_STEP),
+        max_preallocated_size_) - preallocated_size_;
+
+    if (::fallocate(file_descriptor_, 0, preallocated_size_, size) != 0)
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Failed to preallocate " << filename_ << ": " << std::strerror(errno) << ". The file "
+                "grows as it is written.");
+
+        max_preallocated_size_ = 0;
+        return;
+    }
+
+    preallocated_size_ += size;
+#else
+    static_cast<void>(end_offset);
+#endif // if defined(__linux__)
+}
+
+DirectFileWriter::Buffer DirectFileWriter::allocate_buffer_() const
+{
+    void* buffer = nullptr;
+
+#if defined(_WIN32)
+    buffer = std::malloc(buffer_size_);
+#else
+    if (posix_memalign(&buffer, ALIGNMENT, buffer_size_) != 0)
+    {
+        buffer = nullptr;
+    }
+#endif // if defined(_WIN32)
+
+    if (buffer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return Buffer(static_cast<std::byte*>(buffer), std::free);
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,128 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapCompressionPolicy.cpp
+ */
+
+#include <algorithm>
+
+#include <ddsrecorder_participants/recorder/handler/mcap/McapCompressionPolicy.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+McapCompressionPolicy::McapCompressionPolicy(
+        const mcap::McapWriterOptions& mcap_configuration,
+        const bool adaptive)
+    : compression_threads_(mcap_configuration.compressionThreads)
+{
+    const auto configured_step = std::make_pair(mcap_configuration.compression, mcap_configuration.compressionLevel);
+    steps_.push_back(configured_step);
+
+    if (!adaptive || mcap_configuration.compression == mcap::Compression::None)
+    {
+        return;
+    }
+
+    // From the heaviest to the lightest compression
+    const std::vector<Step> all_steps = {
+        {mcap::Compression::Zstd, mcap::CompressionLevel::Slowest},
+        {mcap::Compression::Zstd, mcap::CompressionLevel::Slow},
+        {mcap::Compression::Zstd, mcap::CompressionLevel::Default},
+        {mcap::Compression::Zstd, mcap::CompressionLevel::Fast},
+        {mcap::Compression::Zstd, mcap::CompressionLevel::Fastest},
+        {mcap::Compression::Lz4, mcap::CompressionLevel::Fastest},
+        {mcap::Compression::None, mcap::CompressionLevel::Default}
+    };
+
+    // Step down from the configured compression (LZ4 at a slower level steps down to the fastest one)
+    auto next_step = std::find(all_steps.begin(), all_steps.end(), configured_step);
+
+    if (next_step != all_steps.end())
+    {
+        ++next_step;
+    }
+    else
+    {
+        next_step = std::find(all_steps.begin(), all_steps.end(),
+                        std::make_pair(mcap::Compression::Lz4, mcap::CompressionLevel::Fastest));
+    }
+
+    steps_.insert(steps_.end(), next_step, all_steps.end());
+}
+
+bool McapCompressionPolicy::is_adaptive() const
+{
+    return steps_.size() > 1;
+}
+
+const std::vector<McapCompressionPolicy::Step>& McapCompressionPolicy::steps() const
+{
+    return steps_;
+}
+
+std::size_t McapCompressionPolicy::step_index() const
+{
+    return step_;
+}
+
+const McapCompressionPolicy::Step& McapCompressionPolicy::step() const
+{
+    return steps_[step_];
+}
+
+bool McapCompressionPolicy::on_chunk(
+        const std::chrono::nanoseconds fill_time,
+        const std::chrono::nanoseconds compression_time,
+        const std::size_t pending_chunks)
+{
+    // The time available to compress a chunk, so chunks are not compressed slower than they are filled
+    const auto compression_budget = fill_time * std::max<std::uint32_t>(compression_threads_, 1);
+
+    const bool backlog = compression_threads_ > 0 && pending_chunks >= compression_threads_;
+
+    if (backlog || compression_time * 2 > compression_budget)
+    {
+        idle_chunks_ = 0;
+
+        if (step_ + 1 == steps_.size())
+        {
+            return false;
+        }
+
+        ++step_;
+        return true;
+    }
+
+    if (compression_time * 10 < compression_budget && step_ > 0)
+    {
+        if (++idle_chunks_ < IDLE_CHUNKS_TO_RAISE_COMPRESSION)
+        {
+            return false;
+        }
+
+        idle_chunks_ = 0;
+        --step_;
+        return true;
+    }
+
+    idle_chunks_ = 0;
+    return false;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
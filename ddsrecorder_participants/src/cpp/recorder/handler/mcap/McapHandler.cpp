@@ -18,6 +18,7 @@
 
 #define MCAP_IMPLEMENTATION  // Define this in exactly one .cpp file
 
+#include <regex>
 #include <string>
 
 #include <mcap/reader.hpp>
@@ -25,6 +26,7 @@
 #include <fastdds/dds/xtypes/utils.hpp>
 
 #include <cpp_utils/exception/InconsistencyException.hpp>
+#include <cpp_utils/exception/InitializationException.hpp>
 #include <cpp_utils/ros2_mangling.hpp>
 
 #include <ddspipe_core/types/dynamic_types/schema.hpp>
@@ -48,7 +50,9 @@ McapHandler::McapHandler(
         const std::function<void()>& on_disk_full_lambda /* = nullptr */)
     : BaseHandler(config, payload_pool)
     , configuration_(config)
-    , mcap_writer_(config.output_settings, config.mcap_writer_options, file_tracker, config.record_types)
+    , mcap_writer_(config.output_settings, config.mcap_writer_options, file_tracker, config.record_types,
+            config.adaptive_compression, config.dictionary_samples, config.dictionary_max_size,
+            config.prepare_next_file, config.io_backend, config.checkpoint_period)
 {
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
             "MCAP_STATE | Creating MCAP handler instance.");
@@ -56,6 +60,40 @@ McapHandler::McapHandler(
     // Set the BaseHandler's writer
     writer_ = &mcap_writer_;
 
+    // Create the writers of the topic groups, each with its own files and size budget
+    for (const auto& topic_group : config.topic_groups)
+    {
+        auto output_settings = config.output_settings;
+        output_settings.filename += "_" + topic_group.name;
+        output_settings.resource_limits = topic_group.resource_limits;
+
+        TopicGroupWriter group_writer;
+
+        try
+        {
+            group_writer.topics = std::regex(topic_group.topics);
+        }
+        catch (const std::regex_error& e)
+        {
+            throw utils::InitializationException(
+                      STR_ENTRY << "Invalid regex " << topic_group.topics << " in topic group " << topic_group.name <<
+                          ": " << e.what());
+        }
+
+        group_writer.file_tracker = std::make_shared<FileTracker>(output_settings);
+        group_writer.writer = std::make_unique<McapWriter>(output_settings, config.mcap_writer_options,
+                        group_writer.file_tracker, config.record_types, config.adaptive_compression,
+                        config.dictionary_samples, config.dictionary_max_size, config.prepare_next_file,
+                        config.io_backend, config.checkpoint_period);
+
+        if (on_disk_full_lambda != nullptr)
+        {
+            group_writer.writer->set_on_disk_full_callback(on_disk_full_lambda);
+        }
+
+        topic_group_writers_.push_back(std::move(group_writer));
+    }
+
     // Initialize the BaseHandler
     init(init_state, on_disk_full_lambda);
 }
@@ -69,6 +107,16 @@ McapHandler::~McapHandler()
     stop(true);
 }
 
+void McapHandler::enable()
+{
+    for (auto& group_writer : topic_group_writers_)
+    {
+        group_writer.writer->enable();
+    }
+
+    BaseHandler::enable();
+}
+
 void McapHandler::disable()
 {
     // Ideally, the channels and schemas should be shared between the McapHandler and McapWriter.
@@ -78,6 +126,12 @@ void McapHandler::disable()
     // NOTE: disabling the BaseHandler disables the McapWriter which clears its channels
     BaseHandler::disable();
 
+    // NOTE: disable the writers of the topic groups once the queued samples have been written
+    for (auto& group_writer : topic_group_writers_)
+    {
+        group_writer.writer->disable();
+    }
+
     // Clear the channels after a disable so the old channels are not rewritten in every new file
     channels_.clear();
 }
@@ -87,7 +141,7 @@ void McapHandler::add_schema(
         const fastdds::dds::xtypes::TypeIdentifier& type_identifier)
 {
     // NOTE: Process schemas even if in STOPPED state to avoid losing them (only sent/received once in discovery)
-    std::lock_guard<std::mutex> lock(mtx_);
+    std::unique_lock<std::mutex> lock(mtx_);
 
     if (dynamic_type == nullptr)
     {
@@ -138,7 +192,7 @@ void McapHandler::add_schema(
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
             "MCAP_WRITE | Adding schema with name " << type_name << " :\n" << data << "\n");
 
-    mcap_writer_.write(new_schema);
+    write_schema_nts_(new_schema);
 
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
             "MCAP_WRITE | Schema created: " << new_schema.name << ".");
@@ -147,7 +201,7 @@ void McapHandler::add_schema(
     const auto it = schemas_.find(type_name);
     if (it != schemas_.end())
     {
-        update_channels_nts_(it->second.id, new_schema.id);
+        update_channels_nts_(it->second.id, new_schema);
     }
 
     // Store schema
@@ -158,18 +212,30 @@ void McapHandler::add_schema(
 
     if (configuration_.record_types)
     {
-        // Store dynamic type in dynamic_types collection
-        if (store_dynamic_type_(type_name, type_identifier))
+        // store_dynamic_type_ appends the type plus its dependencies; add all newly-added entries to the attachment
+        // (even if store_dynamic_type_ failed, as the dependencies already appended are valid and needed).
+        const auto previous_size = dynamic_types_.dynamic_types().size();
+        store_dynamic_type_(type_name, type_identifier);
+
+        const auto& collection = dynamic_types_.dynamic_types();
+
+        for (std::size_t i = previous_size; i < collection.size(); ++i)
         {
-            // Recalculate the attachment
-            std::string dynamic_types_serialized;
-            Serializer::serialize(dynamic_types_, dynamic_types_serialized);
-            mcap_writer_.update_dynamic_types(dynamic_types_serialized);
+            mcap_writer_.add_dynamic_type(collection[i]);
+
+            for (auto& group_writer : topic_group_writers_)
+            {
+                group_writer.writer->add_dynamic_type(collection[i]);
+            }
         }
     }
 
     // Check if there are any pending samples for this new type. If so, dump them.
     dump_pending_samples_nts_(type_name);
+
+    // Write the buffer if it was filled by the pending samples
+    lock.unlock();
+    write_dispatched_samples_();
 }
 
 void McapHandler::add_data(
@@ -194,34 +260,24 @@ void McapHandler::add_data(
     if (state_ != BaseHandlerStateCode::STOPPED)
     {
         const auto mcap_sample = std::make_shared<const McapMessage>(
-            data, payload_pool_, topic, channel_id, configuration_.log_publishTime);
+            data, payload_pool_, topics_.intern(topic), channel_id, configuration_.log_publishTime);
 
         process_new_sample_nts_(mcap_sample);
-
-        const auto it_channel = channels_by_id_.find(channel_id);
-        if (it_channel != channels_by_id_.end())
-        {
-            mcap::Channel channel = channels_by_id_[channel_id];
-
-            std::ostringstream guid_ss;
-            guid_ss << data.source_guid;
-
-            std::string source_guid = guid_ss.str();
-            uint32_t sequence_number = mcap_sample->number_of_msgs - 1;
-
-            mcap_writer_.add_message_sourceguid(sequence_number, guid_ss.str());
-        }
     }
+
+    // Write the buffer (if full) once the lock is released
+    lock.unlock();
+    write_dispatched_samples_();
 }
 
 void McapHandler::write_samples_(
-        std::list<std::shared_ptr<const BaseMessage>>& samples)
+        SamplesBatch& samples)
 {
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER, "Writing samples to MCAP file.");
 
-    while (!samples.empty())
+    for (const auto& sample : samples)
     {
-        const auto mcap_sample = static_cast<const McapMessage*>(samples.front().get());
+        const auto mcap_sample = static_cast<const McapMessage*>(sample.get());
 
         if (mcap_sample == nullptr)
         {
@@ -229,10 +285,10 @@ void McapHandler::write_samples_(
             continue;
         }
 
-        mcap_writer_.write(*mcap_sample);
-
-        samples.pop_front();
+        get_writer_(*mcap_sample->topic).write(*mcap_sample);
     }
+
+    samples.clear();
 }
 
 mcap::ChannelId McapHandler::create_channel_id_nts_(
@@ -254,7 +310,7 @@ mcap::ChannelId McapHandler::create_channel_id_nts_(
             std::string encoding = configuration_.ros2_types ? "ros2msg" : "omgidl";
             mcap::Schema blank_schema(topic.type_name, encoding, "");
 
-            mcap_writer_.write(blank_schema);
+            write_schema_nts_(blank_schema);
 
             schemas_.insert({topic.type_name, std::move(blank_schema)});
 
@@ -284,13 +340,22 @@ mcap::ChannelId McapHandler::create_channel_id_nts_(
     }
 
     metadata[PARTITIONS] = topic_partitions;
-    mcap::Channel new_channel(topic_name, "cdr", schema_id, metadata);
 
-    mcap_writer_.write(new_channel);
+    std::string message_encoding = "cdr";
+
+    if (configuration_.dictionary_samples > 0)
+    {
+        // Mark the channel, since its messages may be compressed with the dictionary of its schema
+        message_encoding = ZSTD_DICTIONARY_MESSAGE_ENCODING;
+        metadata[ZSTD_DICTIONARY_METADATA] = ZSTD_DICTIONARY_ATTACHMENT_PREFIX + schemas_.at(topic.type_name).name;
+    }
+
+    mcap::Channel new_channel(topic_name, message_encoding, schema_id, metadata);
+
+    get_writer_(topic).write(new_channel);
 
     auto channel_id = new_channel.id;
     channels_.insert({topic, std::move(new_channel)});
-    channels_by_id_.insert({channel_id, std::move(new_channel)});
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_HANDLER,
             "MCAP_WRITE | Channel created: " << topic << ".");
 
@@ -312,7 +377,7 @@ mcap::ChannelId McapHandler::get_channel_id_nts_(
 
 void McapHandler::update_channels_nts_(
         const mcap::SchemaId& old_schema_id,
-        const mcap::SchemaId& new_schema_id)
+        const mcap::Schema& new_schema)
 {
     for (auto& channel : channels_)
     {
@@ -322,9 +387,17 @@ void McapHandler::update_channels_nts_(
                     "MCAP_WRITE | Updating channel in topic " << channel.first.m_topic_name << ".");
 
             assert(utils::demangle_if_ros_topic(channel.first.m_topic_name) == channel.second.topic);
-            mcap::Channel new_channel(channel.second.topic, "cdr", new_schema_id, channel.second.metadata);
+            auto metadata = channel.second.metadata;
+
+            if (metadata.count(ZSTD_DICTIONARY_METADATA) > 0)
+            {
+                // The dictionaries are named after the schemas
+                metadata[ZSTD_DICTIONARY_METADATA] = ZSTD_DICTIONARY_ATTACHMENT_PREFIX + new_schema.name;
+            }
+
+            mcap::Channel new_channel(channel.second.topic, channel.second.messageEncoding, new_schema.id, metadata);
 
-            mcap_writer_.write(new_channel);
+            get_writer_(channel.first).write(new_channel);
 
             channel.second = std::move(new_channel);
         }
@@ -346,6 +419,50 @@ mcap::SchemaId McapHandler::get_schema_id_nts_(
     }
 }
 
+void McapHandler::write_schema_nts_(
+        mcap::Schema& schema)
+{
+    mcap_writer_.write(schema);
+
+    for (auto& group_writer : topic_group_writers_)
+    {
+        group_writer.writer->write(schema);
+    }
+}
+
+McapWriter& McapHandler::get_writer_(
+        const DdsTopic& topic)
+{
+    if (topic_group_writers_.empty())
+    {
+        return mcap_writer_;
+    }
+
+    std::lock_guard<std::mutex> lock(topic_writers_mtx_);
+
+    const auto it = topic_writers_.find(topic.m_topic_name);
+
+    if (it != topic_writers_.end())
+    {
+        return *it->second;
+    }
+
+    McapWriter* writer = &mcap_writer_;
+
+    for (auto& group_writer : topic_group_writers_)
+    {
+        if (std::regex_match(topic.m_topic_name, group_writer.topics))
+        {
+            writer = group_writer.writer.get();
+            break;
+        }
+    }
+
+    topic_writers_[topic.m_topic_name] = writer;
+
+    return *writer;
+}
+
 } /* namespace participants */
 } /* namespace ddsrecorder */
 } /* namespace eprosima */
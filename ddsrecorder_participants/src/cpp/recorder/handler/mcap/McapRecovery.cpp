@@ -0,0 +1,760 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file McapRecovery.cpp
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include <mcap/internal.hpp>
+
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/Formatter.hpp>
+#include <cpp_utils/Log.hpp>
+#include <cpp_utils/utils.hpp>
+
+#include <ddsrecorder_participants/constants.hpp>
+#include <ddsrecorder_participants/recorder/handler/mcap/McapRecovery.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+namespace {
+
+//! Whether a record with \c opcode can be in the data section of an MCAP file (after its header)
+bool is_data_record(
+        const mcap::OpCode opcode)
+{
+    switch (opcode)
+    {
+        case mcap::OpCode::Schema:
+        case mcap::OpCode::Channel:
+        case mcap::OpCode::Message:
+        case mcap::OpCode::Chunk:
+        case mcap::OpCode::MessageIndex:
+        case mcap::OpCode::Attachment:
+        case mcap::OpCode::Metadata:
+        case mcap::OpCode::DataEnd:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+void McapRecovery::serialize_checkpoint(
+        const std::map<mcap::SchemaId, mcap::Schema>& schemas,
+        const std::map<mcap::ChannelId, mcap::Channel>& channels,
+        std::string& serialized)
+{
+    mcap::BufferWriter buffer;
+
+    for (const auto& [_, schema] : schemas)
+    {
+        mcap::McapWriter::write(buffer, schema);
+    }
+
+    for (const auto& [_, channel] : channels)
+    {
+        mcap::McapWriter::write(buffer, channel);
+    }
+
+    serialized.assign(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+}
+
+McapRecovery::McapRecovery(
+        const std::string& input_file)
+    : input_file_(input_file)
+{
+}
+
+McapRecovery::Result McapRecovery::recover(
+        const std::string& output_file /* = "" */)
+{
+    input_.reset(std::fopen(input_file_.c_str(), "rb"));
+
+    if (input_ == nullptr)
+    {
+        throw utils::InitializationException(
+                  STR_ENTRY << "Failed to open " << input_file_ << ": " << std::strerror(errno) << ".");
+    }
+
+    reader_ = std::make_unique<mcap::FileReader>(input_.get());
+
+    Result result;
+    result.complete = scan_();
+    result.data_size = data_end_;
+    result.dropped_size = reader_->size() - data_end_;
+
+    if (result.complete)
+    {
+        return result;
+    }
+
+    recover_chunks_();
+
+    result.chunk_count = statistics_.chunkCount;
+    result.decompressed_chunk_count = decompressed_chunk_count_;
+    result.message_count = statistics_.messageCount;
+
+    FilePtr output{nullptr, std::fclose};
+
+    if (output_file.empty())
+    {
+        // Drop the incomplete data and append the summary
+        reader_.reset();
+        input_.reset();
+
+        std::error_code error;
+        std::filesystem::resize_file(input_file_, data_end_, error);
+
+        if (error)
+        {
+            throw utils::InitializationException(
+                      STR_ENTRY << "Failed to truncate " << input_file_ << ": " << error.message() << ".");
+        }
+
+        output.reset(std::fopen(input_file_.c_str(), "ab"));
+    }
+    else
+    {
+        output.reset(std::fopen(output_file.c_str(), "wb"));
+
+        if (output != nullptr)
+        {
+            copy_data_(output.get());
+        }
+    }
+
+    if (output == nullptr)
+    {
+        const auto& filename = output_file.empty() ? input_file_ : output_file;
+
+        throw utils::InitializationException(
+                  STR_ENTRY << "Failed to open " << filename << " for writing: " << std::strerror(errno) << ".");
+    }
+
+    write_summary_(output.get());
+
+    if (std::fclose(output.release()) != 0)
+    {
+        throw utils::InitializationException(
+                  STR_ENTRY << "Failed to write the recovered MCAP file: " << std::strerror(errno) << ".");
+    }
+
+    return result;
+}
+
+bool McapRecovery::scan_()
+{
+    constexpr std::uint64_t MAGIC_SIZE = sizeof(mcap::Magic);
+
+    const auto file_size = reader_->size();
+    const auto magic = read_(0, MAGIC_SIZE);
+
+    if (magic == nullptr || std::memcmp(magic, mcap::Magic, MAGIC_SIZE) != 0)
+    {
+        throw utils::InitializationException(STR_ENTRY << input_file_ << " is not an MCAP file.");
+    }
+
+    const auto header = read_(MAGIC_SIZE, RECORD_HEADER_SIZE);
+
+    if (header == nullptr || static_cast<mcap::OpCode>(header[0]) != mcap::OpCode::Header)
+    {
+        throw utils::InitializationException(STR_ENTRY << input_file_ << " has no MCAP header.");
+    }
+
+    std::uint64_t offset = MAGIC_SIZE + RECORD_HEADER_SIZE + mcap::internal::ParseUint64(header + 1);
+    bool last_chunk_closed = true;
+
+    data_end_ = std::min(offset, file_size);
+    statistics_ = {};
+    statistics_.messageStartTime = mcap::MaxTime;
+
+    while (offset <= file_size && file_size - offset >= RECORD_HEADER_SIZE)
+    {
+        const auto record_header = read_(offset, RECORD_HEADER_SIZE);
+        const auto opcode = static_cast<mcap::OpCode>(record_header[0]);
+        const auto length = mcap::internal::ParseUint64(record_header + 1);
+
+        if (!is_data_record(opcode) || length > file_size - offset - RECORD_HEADER_SIZE)
+        {
+            // The rest of the file was not written completely (or was preallocated)
+            break;
+        }
+
+        if (opcode == mcap::OpCode::DataEnd)
+        {
+            // The recorder was stopped while writing the summary, unless the file ends with the magic
+            const auto end_magic = read_(file_size - MAGIC_SIZE, MAGIC_SIZE);
+
+            if (end_magic != nullptr && std::memcmp(end_magic, mcap::Magic, MAGIC_SIZE) == 0)
+            {
+                return true;
+            }
+
+            break;
+        }
+
+        bool valid = true;
+
+        switch (opcode)
+        {
+            case mcap::OpCode::Schema:
+            case mcap::OpCode::Channel:
+            {
+                mcap::Record record;
+                valid = mcap::McapReader::ReadRecord(*reader_, offset, &record).ok();
+
+                if (valid && opcode == mcap::OpCode::Schema)
+                {
+                    mcap::Schema schema;
+                    valid = mcap::McapReader::ParseSchema(record, &schema).ok();
+
+                    if (valid)
+                    {
+                        schemas_[schema.id] = schema;
+                    }
+                }
+                else if (valid)
+                {
+                    mcap::Channel channel;
+                    valid = mcap::McapReader::ParseChannel(record, &channel).ok();
+
+                    if (valid)
+                    {
+                        channels_[channel.id] = channel;
+                    }
+                }
+
+                break;
+            }
+
+            case mcap::OpCode::Chunk:
+                valid = read_chunk_(offset, length);
+                break;
+
+            case mcap::OpCode::MessageIndex:
+                valid = read_message_index_(offset, length);
+                break;
+
+            case mcap::OpCode::Message:
+                valid = read_message_(offset, length);
+                break;
+
+            case mcap::OpCode::Attachment:
+                valid = read_attachment_(offset);
+                break;
+
+            case mcap::OpCode::Metadata:
+                valid = read_metadata_(offset);
+                break;
+
+            default:
+                break;
+        }
+
+        if (!valid)
+        {
+            break;
+        }
+
+        if (opcode == mcap::OpCode::Chunk)
+        {
+            last_chunk_closed = false;
+        }
+        else if (opcode != mcap::OpCode::MessageIndex)
+        {
+            // The message indexes of the last chunk are complete once another record follows them
+            last_chunk_closed = true;
+        }
+
+        offset += RECORD_HEADER_SIZE + length;
+        data_end_ = offset;
+    }
+
+    if (!last_chunk_closed)
+    {
+        drop_last_message_indexes_();
+    }
+
+    if (statistics_.messageCount == 0)
+    {
+        statistics_.messageStartTime = 0;
+    }
+
+    return false;
+}
+
+bool McapRecovery::read_chunk_(
+        const std::uint64_t offset,
+        const std::uint64_t length)
+{
+    // Message start and end times, uncompressed size and CRC, and compression length
+    constexpr std::uint64_t PREAMBLE_SIZE = 8 + 8 + 8 + 4 + 4;
+
+    const auto header_size = std::min(length, CHUNK_HEADER_MAX_SIZE);
+    const auto data = read_(offset + RECORD_HEADER_SIZE, header_size);
+
+    if (data == nullptr || header_size < PREAMBLE_SIZE)
+    {
+        return false;
+    }
+
+    mcap::ChunkIndex chunk_index;
+    chunk_index.messageStartTime = mcap::internal::ParseUint64(data);
+    chunk_index.messageEndTime = mcap::internal::ParseUint64(data + 8);
+    chunk_index.uncompressedSize = mcap::internal::ParseUint64(data + 8 + 8);
+    chunk_index.chunkStartOffset = offset;
+    chunk_index.chunkLength = RECORD_HEADER_SIZE + length;
+    chunk_index.messageIndexLength = 0;
+
+    std::uint64_t position = 8 + 8 + 8 + 4;
+
+    if (!mcap::internal::ParseString(data + position, header_size - position, &chunk_index.compression).ok())
+    {
+        return false;
+    }
+
+    position += 4 + chunk_index.compression.size();
+
+    if (!mcap::internal::ParseUint64(data + position, header_size - position, &chunk_index.compressedSize).ok())
+    {
+        return false;
+    }
+
+    chunk_indexes_.push_back(std::move(chunk_index));
+    last_chunk_message_counts_.clear();
+
+    statistics_.chunkCount++;
+
+    return true;
+}
+
+bool McapRecovery::read_message_index_(
+        const std::uint64_t offset,
+        const std::uint64_t length)
+{
+    // Channel id and length of the records
+    constexpr std::uint64_t PREAMBLE_SIZE = 2 + 4;
+
+    // Log time and offset of each message
+    constexpr std::uint64_t ENTRY_SIZE = 8 + 8;
+
+    const auto data = read_(offset + RECORD_HEADER_SIZE, PREAMBLE_SIZE);
+
+    if (data == nullptr || chunk_indexes_.empty())
+    {
+        return false;
+    }
+
+    const auto channel_id = mcap::internal::ParseUint16(data);
+    const auto records_size = mcap::internal::ParseUint32(data + 2);
+
+    if (PREAMBLE_SIZE + records_size != length || records_size % ENTRY_SIZE != 0)
+    {
+        return false;
+    }
+
+    auto& chunk_index = chunk_indexes_.back();
+    chunk_index.messageIndexOffsets[channel_id] = offset;
+    chunk_index.messageIndexLength += RECORD_HEADER_SIZE + length;
+
+    const auto message_count = records_size / ENTRY_SIZE;
+    last_chunk_message_counts_[channel_id] += message_count;
+    statistics_.channelMessageCounts[channel_id] += message_count;
+    statistics_.messageCount += message_count;
+
+    if (message_count > 0)
+    {
+        statistics_.messageStartTime = std::min(statistics_.messageStartTime, chunk_index.messageStartTime);
+        statistics_.messageEndTime = std::max(statistics_.messageEndTime, chunk_index.messageEndTime);
+    }
+
+    return true;
+}
+
+bool McapRecovery::read_message_(
+        const std::uint64_t offset,
+        const std::uint64_t length)
+{
+    // Channel id, sequence, log time and publish time
+    constexpr std::uint64_t PREAMBLE_SIZE = 2 + 4 + 8 + 8;
+
+    const auto data = read_(offset + RECORD_HEADER_SIZE, PREAMBLE_SIZE);
+
+    if (data == nullptr || length < PREAMBLE_SIZE)
+    {
+        return false;
+    }
+
+    const auto channel_id = mcap::internal::ParseUint16(data);
+    const auto log_time = mcap::internal::ParseUint64(data + 2 + 4);
+
+    statistics_.channelMessageCounts[channel_id]++;
+    statistics_.messageCount++;
+    statistics_.messageStartTime = std::min(statistics_.messageStartTime, log_time);
+    statistics_.messageEndTime = std::max(statistics_.messageEndTime, log_time);
+
+    return true;
+}
+
+bool McapRecovery::read_attachment_(
+        const std::uint64_t offset)
+{
+    mcap::Record record;
+    mcap::Attachment attachment;
+
+    if (!mcap::McapReader::ReadRecord(*reader_, offset, &record).ok() ||
+            !mcap::McapReader::ParseAttachment(record, &attachment).ok())
+    {
+        return false;
+    }
+
+    if (attachment.name == CHECKPOINT_ATTACHMENT_NAME)
+    {
+        read_checkpoint_(attachment.data, attachment.dataSize);
+    }
+
+    attachment_indexes_.emplace_back(attachment, offset);
+    statistics_.attachmentCount++;
+
+    return true;
+}
+
+bool McapRecovery::read_metadata_(
+        const std::uint64_t offset)
+{
+    mcap::Record record;
+    mcap::Metadata metadata;
+
+    if (!mcap::McapReader::ReadRecord(*reader_, offset, &record).ok() ||
+            !mcap::McapReader::ParseMetadata(record, &metadata).ok())
+    {
+        return false;
+    }
+
+    metadata_indexes_.emplace_back(metadata, offset);
+    statistics_.metadataCount++;
+
+    return true;
+}
+
+void McapRecovery::read_checkpoint_(
+        const std::byte* data,
+        const std::uint64_t size)
+{
+    mcap::BufferReader buffer;
+    buffer.reset(data, size, size);
+
+    mcap::RecordReader records(buffer, 0, size);
+
+    for (auto record = records.next(); record.has_value(); record = records.next())
+    {
+        if (record->opcode == mcap::OpCode::Schema)
+        {
+            mcap::Schema schema;
+
+            if (mcap::McapReader::ParseSchema(*record, &schema).ok())
+            {
+                schemas_[schema.id] = schema;
+            }
+        }
+        else if (record->opcode == mcap::OpCode::Channel)
+        {
+            mcap::Channel channel;
+
+            if (mcap::McapReader::ParseChannel(*record, &channel).ok())
+            {
+                channels_[channel.id] = channel;
+            }
+        }
+    }
+
+    if (!records.status().ok())
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_RECOVERY,
+                "MCAP_RECOVERY | Invalid checkpoint in " << input_file_ << ": " << records.status().message << ".");
+    }
+}
+
+void McapRecovery::drop_last_message_indexes_()
+{
+    auto& chunk_index = chunk_indexes_.back();
+
+    for (const auto& [channel_id, message_count] : last_chunk_message_counts_)
+    {
+        statistics_.channelMessageCounts[channel_id] -= message_count;
+        statistics_.messageCount -= message_count;
+    }
+
+    data_end_ = chunk_index.chunkStartOffset + chunk_index.chunkLength;
+    chunk_index.messageIndexOffsets.clear();
+    chunk_index.messageIndexLength = 0;
+
+    rebuild_last_message_indexes_ = true;
+}
+
+void McapRecovery::recover_chunks_()
+{
+    for (std::size_t i = 0; i < chunk_indexes_.size(); i++)
+    {
+        const auto& chunk_index = chunk_indexes_[i];
+        const bool rebuild_message_indexes = rebuild_last_message_indexes_ && i + 1 == chunk_indexes_.size();
+
+        const bool unknown_channels = std::any_of(
+            chunk_index.messageIndexOffsets.begin(), chunk_index.messageIndexOffsets.end(),
+            [this](const auto& message_index_offset)
+            {
+                return channels_.count(message_index_offset.first) == 0;
+            });
+
+        if (!unknown_channels && !rebuild_message_indexes)
+        {
+            continue;
+        }
+
+        if (!recover_chunk_(chunk_index, rebuild_message_indexes) && rebuild_message_indexes)
+        {
+            // The last chunk is dropped if its messages cannot be indexed
+            data_end_ = chunk_index.chunkStartOffset;
+            chunk_indexes_.pop_back();
+            statistics_.chunkCount--;
+        }
+    }
+
+    statistics_.schemaCount = static_cast<std::uint16_t>(schemas_.size());
+    statistics_.channelCount = static_cast<std::uint32_t>(channels_.size());
+
+    for (const auto& [channel_id, _] : statistics_.channelMessageCounts)
+    {
+        if (channels_.count(channel_id) == 0)
+        {
+            EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_RECOVERY,
+                    "MCAP_RECOVERY | Channel " << channel_id << " of " << input_file_ << " not found. Its messages "
+                    "will not be readable.");
+        }
+    }
+}
+
+bool McapRecovery::recover_chunk_(
+        const mcap::ChunkIndex& chunk_index,
+        const bool rebuild_message_indexes)
+{
+    mcap::Record record;
+    mcap::Chunk chunk;
+
+    const auto compression = mcap::McapReader::ParseCompression(chunk_index.compression);
+
+    if (!compression.has_value() ||
+            !mcap::McapReader::ReadRecord(*reader_, chunk_index.chunkStartOffset, &record).ok() ||
+            !mcap::McapReader::ParseChunk(record, &chunk).ok())
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_RECOVERY,
+                "MCAP_RECOVERY | Failed to read the chunk at offset " << chunk_index.chunkStartOffset << " of " <<
+                input_file_ << ".");
+        return false;
+    }
+
+    decompressed_chunk_count_++;
+
+    mcap::TypedChunkReader chunk_reader;
+    std::map<mcap::ChannelId, mcap::MessageIndex> message_indexes;
+
+    chunk_reader.onSchema = [this](const mcap::SchemaPtr schema, mcap::ByteOffset)
+            {
+                schemas_.try_emplace(schema->id, *schema);
+            };
+
+    chunk_reader.onChannel = [this](const mcap::ChannelPtr channel, mcap::ByteOffset)
+            {
+                channels_.try_emplace(channel->id, *channel);
+            };
+
+    if (rebuild_message_indexes)
+    {
+        chunk_reader.onMessage = [&message_indexes](const mcap::Message& message, mcap::ByteOffset offset)
+                {
+                    auto& message_index = message_indexes[message.channelId];
+                    message_index.channelId = message.channelId;
+                    message_index.records.emplace_back(message.logTime, offset);
+                };
+    }
+
+    chunk_reader.reset(chunk, compression.value());
+
+    while (chunk_reader.next())
+    {
+    }
+
+    if (!chunk_reader.status().ok())
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_RECOVERY,
+                "MCAP_RECOVERY | Failed to decompress the chunk at offset " << chunk_index.chunkStartOffset << " of " <<
+                input_file_ << ": " << chunk_reader.status().message << ".");
+        return !rebuild_message_indexes;
+    }
+
+    for (auto& [channel_id, message_index] : message_indexes)
+    {
+        for (const auto& [log_time, _] : message_index.records)
+        {
+            statistics_.messageStartTime = std::min(statistics_.messageStartTime, log_time);
+            statistics_.messageEndTime = std::max(statistics_.messageEndTime, log_time);
+        }
+
+        statistics_.channelMessageCounts[channel_id] += message_index.records.size();
+        statistics_.messageCount += message_index.records.size();
+    }
+
+    rebuilt_message_indexes_ = std::move(message_indexes);
+
+    return true;
+}
+
+void McapRecovery::copy_data_(
+        std::FILE* output)
+{
+    std::uint64_t offset = 0;
+
+    while (offset < data_end_)
+    {
+        const auto size = std::min(COPY_BUFFER_SIZE, data_end_ - offset);
+        const auto data = read_(offset, size);
+
+        if (data == nullptr || std::fwrite(data, 1, size, output) != size)
+        {
+            throw utils::InitializationException(
+                      STR_ENTRY << "Failed to copy the data of " << input_file_ << ".");
+        }
+
+        offset += size;
+    }
+}
+
+void McapRecovery::write_summary_(
+        std::FILE* output)
+{
+    mcap::BufferWriter buffer;
+
+    if (!rebuilt_message_indexes_.empty())
+    {
+        // The message indexes of the last chunk follow it
+        auto& chunk_index = chunk_indexes_.back();
+
+        for (const auto& [channel_id, message_index] : rebuilt_message_indexes_)
+        {
+            chunk_index.messageIndexOffsets[channel_id] = data_end_ + buffer.size();
+            mcap::McapWriter::write(buffer, message_index);
+        }
+
+        chunk_index.messageIndexLength = buffer.size();
+    }
+
+    // The data section CRC is not computed, so the data section is not read entirely
+    mcap::McapWriter::write(buffer, mcap::DataEnd{0});
+
+    buffer.crcEnabled = true;
+    buffer.resetCrc();
+
+    const auto summary_start = data_end_ + buffer.size();
+
+    const auto schema_start = data_end_ + buffer.size();
+    for (const auto& [_, schema] : schemas_)
+    {
+        mcap::McapWriter::write(buffer, schema);
+    }
+
+    const auto channel_start = data_end_ + buffer.size();
+    for (const auto& [_, channel] : channels_)
+    {
+        mcap::McapWriter::write(buffer, channel);
+    }
+
+    const auto statistics_start = data_end_ + buffer.size();
+    mcap::McapWriter::write(buffer, statistics_);
+
+    const auto chunk_index_start = data_end_ + buffer.size();
+    for (const auto& chunk_index : chunk_indexes_)
+    {
+        mcap::McapWriter::write(buffer, chunk_index);
+    }
+
+    const auto attachment_index_start = data_end_ + buffer.size();
+    for (const auto& attachment_index : attachment_indexes_)
+    {
+        mcap::McapWriter::write(buffer, attachment_index);
+    }
+
+    const auto metadata_index_start = data_end_ + buffer.size();
+    for (const auto& metadata_index : metadata_indexes_)
+    {
+        mcap::McapWriter::write(buffer, metadata_index);
+    }
+
+    const auto summary_offset_start = data_end_ + buffer.size();
+
+    const auto write_summary_offset = [&](
+        const mcap::OpCode opcode,
+        const std::uint64_t start,
+        const std::uint64_t end)
+            {
+                if (end > start)
+                {
+                    mcap::McapWriter::write(buffer, mcap::SummaryOffset{opcode, start, end - start});
+                }
+            };
+
+    write_summary_offset(mcap::OpCode::Schema, schema_start, channel_start);
+    write_summary_offset(mcap::OpCode::Channel, channel_start, statistics_start);
+    write_summary_offset(mcap::OpCode::Statistics, statistics_start, chunk_index_start);
+    write_summary_offset(mcap::OpCode::ChunkIndex, chunk_index_start, attachment_index_start);
+    write_summary_offset(mcap::OpCode::AttachmentIndex, attachment_index_start, metadata_index_start);
+    write_summary_offset(mcap::OpCode::MetadataIndex, metadata_index_start, summary_offset_start);
+
+    mcap::McapWriter::write(buffer, mcap::Footer{summary_start, summary_offset_start}, true);
+    mcap::McapWriter::writeMagic(buffer);
+
+    if (std::fwrite(buffer.data(), 1, buffer.size(), output) != buffer.size())
+    {
+        throw utils::InitializationException(
+                  STR_ENTRY << "Failed to write the summary of " << input_file_ << ".");
+    }
+}
+
+const std::byte* McapRecovery::read_(
+        const std::uint64_t offset,
+        const std::uint64_t size)
+{
+    std::byte* data = nullptr;
+
+    if (offset > reader_->size() || reader_->read(&data, offset, size) != size)
+    {
+        return nullptr;
+    }
+
+    return data;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
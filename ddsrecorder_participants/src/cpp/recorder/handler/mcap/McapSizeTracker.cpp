@@ -16,7 +16,6 @@
  * @file McapSizeTracker.cpp
  */
 
-#include <filesystem>
 #include <stdexcept>
 
 #include <mcap/internal.hpp>
@@ -42,7 +41,6 @@ McapSizeTracker::~McapSizeTracker()
 
 void McapSizeTracker::init(
         const std::uint64_t& space_available,
-        const std::uint64_t& size_tolerance,
         const std::string& file_path)
 {
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_SIZE_TRACKER,
@@ -62,17 +60,14 @@ void McapSizeTracker::init(
     potential_mcap_size_ = MCAP_FILE_OVERHEAD;
     written_mcap_size_ = MCAP_FILE_OVERHEAD;
     min_mcap_size_ = MCAP_FILE_OVERHEAD;
-
-    check_interval_ = size_tolerance / 2;
+    summary_mcap_size_ = MCAP_FILE_OVERHEAD;
+    channel_count_ = 0;
 
     space_available_ = space_available;
 
     file_path_ = file_path;
 
     enabled_ = true;
-
-    potential_count = 0;
-    written_count = 0;
 }
 
 void McapSizeTracker::reset()
@@ -139,6 +134,7 @@ void McapSizeTracker::schema_written(
         const mcap::Schema& schema)
 {
     check_and_increase_written_mcap_size_(get_schema_size_(schema));
+    summary_mcap_size_ += get_schema_size_(schema);
 }
 
 void McapSizeTracker::channel_to_write(
@@ -152,6 +148,8 @@ void McapSizeTracker::channel_written(
         const mcap::Channel& channel)
 {
     check_and_increase_written_mcap_size_(get_channel_size_(channel));
+    summary_mcap_size_ += get_channel_size_(channel);
+    channel_count_++;
 }
 
 void McapSizeTracker::attachment_to_write(
@@ -181,10 +179,70 @@ void McapSizeTracker::attachment_to_write(
     attachment_to_write(payload_size_to_write);
 }
 
+void McapSizeTracker::attachment_to_rewrite(
+        const uint64_t& payload_size_to_write,
+        const uint64_t& payload_size_written)
+{
+    const auto size_to_write = get_attachment_size_(payload_size_to_write);
+
+    if (!can_increase_potential_mcap_size_(size_to_write))
+    {
+        throw FullFileException(
+                  STR_ENTRY << "Attempted attachment write of size: " << utils::from_bytes(payload_size_to_write)
+                            << ", but there is not enough space allowed disk: " << utils::from_bytes(space_available_),
+                      payload_size_to_write);
+    }
+
+    check_and_increase_potential_mcap_size_(size_to_write);
+
+    // NOTE: The minimum size already accounts for the written version
+    const auto size_written = get_attachment_size_(payload_size_written);
+
+    if (size_to_write > size_written)
+    {
+        min_mcap_size_ += size_to_write - size_written;
+    }
+}
+
 void McapSizeTracker::attachment_written(
         const uint64_t& payload_size)
 {
     check_and_increase_written_mcap_size_(get_attachment_size_(payload_size));
+    summary_mcap_size_ += MCAP_ATTACHMENT_INDEX_OVERHEAD;
+}
+
+void McapSizeTracker::source_guid_index_to_write(
+        const uint64_t& payload_size_to_write,
+        const uint64_t& payload_size_to_remove)
+{
+    const auto size_to_write = payload_size_to_write > 0 ? get_attachment_size_(payload_size_to_write) : 0;
+    const auto size_to_remove = payload_size_to_remove > 0 ? get_attachment_size_(payload_size_to_remove) : 0;
+
+    if (!can_increase_potential_mcap_size_(size_to_write, size_to_remove))
+    {
+        throw FullFileException(
+                  STR_ENTRY << "Attempted source GUID index write of size: " << utils::from_bytes(payload_size_to_write)
+                            << ", but there is not enough space allowed disk: " << utils::from_bytes(space_available_),
+                      payload_size_to_write);
+    }
+
+    decrease_potential_mcap_size_(size_to_remove);
+    check_and_increase_potential_mcap_size_(size_to_write);
+}
+
+bool McapSizeTracker::checkpoint_to_write(
+        const uint64_t& payload_size)
+{
+    const auto size = get_attachment_size_(payload_size);
+
+    if (!can_increase_potential_mcap_size_(size))
+    {
+        return false;
+    }
+
+    check_and_increase_potential_mcap_size_(size);
+
+    return true;
 }
 
 void McapSizeTracker::metadata_to_write(
@@ -198,6 +256,27 @@ void McapSizeTracker::metadata_written(
         const mcap::Metadata& metadata)
 {
     check_and_increase_written_mcap_size_(get_metadata_size_(metadata), true);
+    summary_mcap_size_ += MCAP_METADATA_INDEX_OVERHEAD + metadata.name.size();
+}
+
+void McapSizeTracker::sync(
+        const std::uint64_t& flushed_size,
+        const std::uint64_t& buffered_size,
+        const std::uint64_t& chunk_count)
+{
+    if (!enabled_)
+    {
+        return;
+    }
+
+    const auto chunk_indexes_size = chunk_count *
+            (MCAP_CHUNK_INDEX_OVERHEAD + channel_count_ * MCAP_CHUNK_INDEX_CHANNEL_OVERHEAD);
+
+    // Signed to allow negative values in case of decrease (error?)
+    const std::int64_t dif_potential_written = potential_mcap_size_ - written_mcap_size_;
+
+    written_mcap_size_ = flushed_size + buffered_size + summary_mcap_size_ + chunk_indexes_size;
+    potential_mcap_size_ = written_mcap_size_ + dif_potential_written;
 }
 
 std::uint64_t McapSizeTracker::get_potential_mcap_size() const
@@ -272,14 +351,6 @@ void McapSizeTracker::check_and_increase_potential_mcap_size_(
         }
 
         potential_mcap_size_ += size;
-
-        // Add the size of the message in the dictionary of source_guid by sequence
-        // (the source_guid is an index instead of the full string to reduce the space)
-        potential_mcap_size_ += std::to_string(potential_count).size();
-        // Translation between the index with the source_guid in the dictionary
-        potential_mcap_size_ += 2;
-
-        potential_count++;
     }
 
     if (increase_min_mcap_size)
@@ -346,29 +417,6 @@ void McapSizeTracker::check_and_increase_written_mcap_size_(
         }
 
         written_mcap_size_ += size;
-
-        // Add the size of the message in the dictionary of source_guid by sequence
-        // (the source_guid is an index instead of the full string to reduce the space)
-        written_mcap_size_ += std::to_string(potential_count).size();
-        // Translation between the index with the source_guid in the dictionary
-        written_mcap_size_ += 2;
-
-        written_count++;
-    }
-
-    // Check the real size of the file every check_interval_ Bytes
-    if (written_mcap_size_ - checked_written_mcap_size_ > check_interval_)
-    {
-        auto file_size = std::filesystem::file_size(file_path_);
-        if (file_size != checked_actual_mcap_size_)
-        {
-            // The file has been updated
-            checked_actual_mcap_size_ = file_size;
-            std::int64_t dif_potential_written = potential_mcap_size_ - written_mcap_size_; // Signed to allow negative values in case of decrease (error?)
-            written_mcap_size_ = file_size;
-            potential_mcap_size_ = written_mcap_size_ + dif_potential_written;
-        }
-        checked_written_mcap_size_ = written_mcap_size_;
     }
 }
 
@@ -16,6 +16,9 @@
  * @file McapWriter.cpp
  */
 
+#include <algorithm>
+#include <filesystem>
+
 #include <mcap/internal.hpp>
 
 #include <cpp_utils/exception/InitializationException.hpp>
@@ -27,6 +30,8 @@
 #include <ddsrecorder_participants/recorder/exceptions/FullDiskException.hpp>
 #include <ddsrecorder_participants/recorder/exceptions/FullFileException.hpp>
 #include <ddsrecorder_participants/recorder/message/McapMessage.hpp>
+#include <ddsrecorder_participants/recorder/handler/mcap/DirectFileWriter.hpp>
+#include <ddsrecorder_participants/recorder/handler/mcap/McapRecovery.hpp>
 #include <ddsrecorder_participants/recorder/handler/mcap/McapWriter.hpp>
 #include <ddsrecorder_participants/constants.hpp>
 
@@ -34,71 +39,144 @@ namespace eprosima {
 namespace ddsrecorder {
 namespace participants {
 
+namespace {
+
+mcap::Attachment make_attachment(
+        const std::string& name,
+        const std::string& data)
+{
+    mcap::Attachment attachment;
+
+    attachment.name = name;
+    attachment.data = reinterpret_cast<const std::byte*>(data.data());
+    attachment.dataSize = data.size();
+    attachment.createTime = to_mcap_timestamp(utils::now());
+
+    return attachment;
+}
+
+} // namespace
+
 McapWriter::McapWriter(
         const OutputSettings& configuration,
         const mcap::McapWriterOptions& mcap_configuration,
         std::shared_ptr<FileTracker>& file_tracker,
-        const bool record_types)
+        const bool record_types,
+        const bool adaptive_compression,
+        const std::uint32_t dictionary_samples,
+        const std::uint64_t dictionary_max_size,
+        const std::uint32_t prepare_next_file,
+        const McapIoBackend io_backend,
+        const std::uint32_t checkpoint_period)
     : BaseWriter(configuration, file_tracker, record_types, MIN_MCAP_SIZE)
     , mcap_configuration_(mcap_configuration)
+    , writer_(std::make_unique<mcap::McapWriter>())
+    , compression_policy_(mcap_configuration, adaptive_compression)
+    , dictionary_samples_(dictionary_samples)
+    , dictionary_max_size_(dictionary_max_size)
+    , io_backend_(io_backend)
+    , prepare_next_file_(prepare_next_file)
+    , checkpoint_period_(checkpoint_period)
 {
-}
+    if (io_backend_ == McapIoBackend::direct && !DirectFileWriter::is_supported())
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | The direct I/O backend is not supported on this platform. Using the buffered one.");
+    }
 
-void McapWriter::disable()
-{
-    BaseWriter::disable();
+    if (prepare_next_file_ > 0)
+    {
+        rotation_thread_ = std::thread(&McapWriter::rotation_thread_routine_, this);
+    }
 
-    // Clear the channels when disabling the writer so the old channels are not rewritten in every new file
-    channels_.clear();
+    if (checkpoint_period_ > 0)
+    {
+        checkpoint_thread_ = std::thread(&McapWriter::checkpoint_thread_routine_, this);
+    }
 }
 
-void McapWriter::add_message_sourceguid(
-        uint32_t sequence_number,
-        const std::string source_guid)
+McapWriter::~McapWriter()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    {
+        std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+        checkpoint_stop_ = true;
+    }
 
-    std::string indx;
+    checkpoint_cv_.notify_all();
 
-    auto source_guid_it = sequence_by_source_guid_index_.find(source_guid);
-    if (source_guid_it == sequence_by_source_guid_index_.end())
+    if (checkpoint_thread_.joinable())
     {
-        indx = std::to_string(sequence_by_source_guid_index_.size());
+        checkpoint_thread_.join();
+    }
 
-        source_guid_by_sequence_index_[indx] = source_guid;
-        sequence_by_source_guid_index_[source_guid] = indx;
+    disable();
+
+    {
+        std::lock_guard<std::mutex> lock(rotation_mutex_);
+        rotation_stop_ = true;
     }
-    else
+
+    rotation_cv_.notify_all();
+
+    if (rotation_thread_.joinable())
     {
-        indx = source_guid_it->second;
+        rotation_thread_.join();
     }
+}
+
+void McapWriter::disable()
+{
+    BaseWriter::disable();
 
-    source_guid_by_sequence_[std::to_string(sequence_number)] = indx;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Leave no file half-written in the background
+    discard_next_file_nts_();
+    wait_rotation_tasks_();
+
+    // Clear the channels when disabling the writer so the old channels are not rewritten in every new file
+    channels_.clear();
 }
 
-void McapWriter::update_dynamic_types(
-        const std::string& dynamic_types)
+void McapWriter::add_dynamic_type(
+        const DynamicType& dynamic_type)
 {
+    // Serialize the new type only (outside the lock, as it does not depend on the writer)
+    std::string serialized_type;
+    SerializedDynamicTypesCollection::serialize(dynamic_type, serialized_type);
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     const auto& update_dynamic_types = [&]()
             {
+                const auto dynamic_types_length = dynamic_types_.size_after_append(serialized_type);
+
                 if (dynamic_types_.empty())
                 {
                     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
                             "MCAP_WRITE | Setting the dynamic types payload to " <<
-                            utils::from_bytes(dynamic_types.length()) << ".");
+                            utils::from_bytes(dynamic_types_length) << ".");
 
-                    size_tracker_.attachment_to_write(dynamic_types.length());
+                    size_tracker_.attachment_to_write(dynamic_types_length);
+                }
+                else if (dynamic_types_.str().length() == checkpointed_dynamic_types_size_)
+                {
+                    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+                            "MCAP_WRITE | Updating the checkpointed dynamic types payload from " <<
+                            utils::from_bytes(dynamic_types_.str().length()) << " to " <<
+                            utils::from_bytes(dynamic_types_length) << ".");
+
+                    // The space reserved for the previous payload was taken by the checkpoint
+                    size_tracker_.attachment_to_rewrite(dynamic_types_length, dynamic_types_.str().length());
                 }
                 else
                 {
                     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
                             "MCAP_WRITE | Updating the dynamic types payload from " <<
-                            utils::from_bytes(dynamic_types_.length()) << " to " <<
-                            utils::from_bytes(dynamic_types.length()) << ".");
+                            utils::from_bytes(dynamic_types_.str().length()) << " to " <<
+                            utils::from_bytes(dynamic_types_length) << ".");
 
-                    size_tracker_.attachment_to_write(dynamic_types.length(), dynamic_types_.length());
+                    size_tracker_.attachment_to_write(dynamic_types_length, dynamic_types_.str().length());
                 }
             };
 
@@ -121,7 +199,7 @@ void McapWriter::update_dynamic_types(
         }
     }
 
-    dynamic_types_ = dynamic_types;
+    dynamic_types_.append(serialized_type);
     file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
 }
 
@@ -140,33 +218,84 @@ void McapWriter::open_new_file_nts_(
     }
 
     const auto filename = file_tracker_->get_current_filename();
-    const auto status = writer_.open(filename, mcap_configuration_);
+    auto next_writer = take_next_writer_nts_(filename);
+    const bool file_prepared = next_writer != nullptr;
 
-    if (!status.ok())
+    if (file_prepared)
+    {
+        // The file was already opened by the rotation thread
+        writer_ = std::move(next_writer);
+    }
+    else
     {
-        const auto error_msg = "Failed to open MCAP file " + filename + " for writing: " + status.message;
+        const auto status = open_mcap_file_(*writer_, filename);
 
-        EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
-                "FAIL_MCAP_OPEN | " << error_msg);
-        throw utils::InitializationException(error_msg);
+        if (!status.ok())
+        {
+            const auto error_msg = "Failed to open MCAP file " + filename + " for writing: " + status.message;
+
+            EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+                    "FAIL_MCAP_OPEN | " << error_msg);
+            throw utils::InitializationException(error_msg);
+        }
     }
 
+    if (compression_policy_.step_index() > 0)
+    {
+        // Keep the compression the load called for
+        const auto& [compression, compression_level] = compression_policy_.step();
+        writer_->setCompression(compression, compression_level);
+    }
+
+    file_open_time_ = std::chrono::steady_clock::now();
+    last_chunk_count_ = 0;
+    last_chunk_time_ = file_open_time_;
+
+    // Nothing has been checkpointed in the new file (the schemas and channels below outdate its first checkpoint)
+    checkpoint_outdated_ = false;
+    checkpointed_message_count_ = 0;
+    checkpointed_dynamic_types_size_ = 0;
+    checkpointed_dictionaries_.clear();
+
     // Set the file's maximum size
     const auto max_file_size = std::min(
         configuration_.resource_limits.max_file_size_,
         configuration_.resource_limits.max_size_ - file_tracker_->get_total_size());
 
-    size_tracker_.init(max_file_size, configuration_.resource_limits.size_tolerance_,
-            file_tracker_->get_current_filename());
+    size_tracker_.init(max_file_size, file_tracker_->get_current_filename());
+
+    // Prepare the next file only if there can be more than one
+    prepare_next_file_size_ = 0;
+
+    if (prepare_next_file_ > 0 &&
+            configuration_.resource_limits.max_size_ > configuration_.resource_limits.max_file_size_)
+    {
+        prepare_next_file_size_ = std::max<std::uint64_t>(max_file_size / 100 * prepare_next_file_, 1);
+    }
 
     // NOTE: These writes should never fail since the minimum size accounts for them.
-    write_metadata_version_nts_();
-    write_schemas_nts_();
-    write_channels_nts_();
+    if (file_prepared)
+    {
+        write_prepared_file_nts_();
+    }
+    else
+    {
+        write_metadata_version_nts_();
+        write_schemas_nts_();
+        write_channels_nts_();
+    }
+
+    if (record_types_ && !dynamic_types_.empty())
+    {
+        size_tracker_.attachment_to_write(dynamic_types_.str().length());
+    }
 
-    if (record_types_ && dynamic_types_.length() > 0)
+    for (const auto& [_, dictionary] : dictionaries_)
     {
-        size_tracker_.attachment_to_write(dynamic_types_.length());
+        if (dictionary != nullptr)
+        {
+            size_tracker_.attachment_to_write(dictionary->data().size());
+        }
     }
 
     file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
@@ -174,23 +303,83 @@ void McapWriter::open_new_file_nts_(
 
 void McapWriter::close_current_file_nts_()
 {
-    if (record_types_ && dynamic_types_.length() > 0)
+    auto attachments = collect_attachments_nts_();
+
+    if (prepare_next_file_ == 0)
     {
-        // NOTE: This write should never fail since the minimum size accounts for it.
-        write_attachment_nts_();
-        // Add the metadata dictionaries of source_guid messages
-        write_metadata_messages_nts_(VERSION_METADATA_MESSAGE_NAME, source_guid_by_sequence_);
-        write_metadata_messages_nts_(VERSION_METADATA_MESSAGE_INDEX_NAME, source_guid_by_sequence_index_);
-        // Clear the dictionaries (resource-limits)
-        source_guid_by_sequence_.clear();
-        sequence_by_source_guid_index_.clear();
+        for (const auto& [name, data] : attachments)
+        {
+            // NOTE: These writes should never fail since the space for them is allocated as they grow.
+            write_nts_(make_attachment(name, data));
+        }
+
+        sync_size_nts_();
+        file_tracker_->set_current_file_size(size_tracker_.get_written_mcap_size());
+        size_tracker_.reset();
+
+        writer_->close();
+        file_tracker_->close_file();
+        return;
     }
 
-    file_tracker_->set_current_file_size(size_tracker_.get_written_mcap_size());
+    // The size allocated for the attachments and the summary is an upper bound of the size of the closed file
+    file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
     size_tracker_.reset();
 
-    writer_.close();
-    file_tracker_->close_file();
+    const auto file = file_tracker_->detach_file();
+    std::shared_ptr<mcap::McapWriter> writer = std::move(writer_);
+    writer_ = std::make_unique<mcap::McapWriter>();
+
+    // Write the attachments and the summary (and flush the last chunks) while the next file is written
+    post_rotation_task_([writer, attachments = std::move(attachments), file, file_tracker = file_tracker_]()
+            {
+                for (const auto& [name, data] : attachments)
+                {
+                    auto attachment = make_attachment(name, data);
+                    const auto status = writer->write(attachment);
+
+                    if (!status.ok())
+                    {
+                        EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+                                "MCAP_WRITE | Error writing in MCAP. Error message: " << status.message);
+                    }
+                }
+
+                writer->close();
+
+                if (!file.name.empty())
+                {
+                    file_tracker->finish_file(file);
+                }
+            });
+}
+
+void McapWriter::split_file_nts_()
+{
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+            "MCAP_WRITE | The MCAP file has been open for " << configuration_.resource_limits.max_file_duration_ <<
+            " seconds. Opening a new one.");
+
+    const auto min_file_size = size_tracker_.get_min_mcap_size();
+
+    close_current_file_nts_();
+
+    // Disable the writer in case opening a new file fails
+    enabled_ = false;
+
+    try
+    {
+        open_new_file_nts_(min_file_size);
+    }
+    catch (const FullDiskException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+                "FAIL_MCAP_WRITE | Disk is full. Error message:\n " << e.what());
+        on_disk_full_();
+        return;
+    }
+
+    enabled_ = true;
 }
 
 template <>
@@ -202,7 +391,7 @@ void McapWriter::write_nts_(
             ").");
 
     // NOTE: There is no need to check if the MCAP is full, since it is checked when adding a new dynamic_type.
-    const auto status = writer_.write(const_cast<mcap::Attachment&>(attachment));
+    const auto status = writer_->write(const_cast<mcap::Attachment&>(attachment));
 
     if (!status.ok())
     {
@@ -212,6 +401,7 @@ void McapWriter::write_nts_(
     }
 
     size_tracker_.attachment_written(attachment.dataSize);
+    sync_size_nts_();
     file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
 }
 
@@ -223,7 +413,7 @@ void McapWriter::write_nts_(
             "MCAP_WRITE | Writing channel " << channel.topic << ".");
 
     size_tracker_.channel_to_write(channel);
-    writer_.addChannel(const_cast<mcap::Channel&>(channel));
+    writer_->addChannel(const_cast<mcap::Channel&>(channel));
     size_tracker_.channel_written(channel);
 
     file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
@@ -234,6 +424,7 @@ void McapWriter::write_nts_(
 
     // Store the channel to write it on new MCAP files
     channels_[channel.id] = channel;
+    checkpoint_outdated_ = true;
 }
 
 template <>
@@ -247,10 +438,34 @@ void McapWriter::write_nts_(
         return;
     }
 
+    if (configuration_.resource_limits.max_file_duration_ > 0 &&
+            std::chrono::steady_clock::now() - file_open_time_ >=
+            std::chrono::seconds(configuration_.resource_limits.max_file_duration_))
+    {
+        // NOTE: The file is split when the first message past its duration arrives, so no file is left empty
+        split_file_nts_();
+
+        if (!enabled_)
+        {
+            return;
+        }
+    }
+
     EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER, "Writing message: " << utils::from_bytes(msg.dataSize) << ".");
 
-    size_tracker_.message_to_write(msg.dataSize);
-    const auto status = writer_.write(msg);
+    // NOTE: point to the current payload, as it is reallocated if the message was spilled from the event window
+    mcap::Message message = static_cast<const mcap::Message&>(msg);
+    message.data = msg.get_data_cdr();
+
+    if (dictionary_samples_ > 0)
+    {
+        compress_message_nts_(message);
+    }
+
+    size_tracker_.message_to_write(message.dataSize);
+    reserve_source_guid_index_nts_();
+
+    const auto status = writer_->write(message);
 
     if (!status.ok())
     {
@@ -259,8 +474,23 @@ void McapWriter::write_nts_(
         return;
     }
 
-    size_tracker_.message_written(msg.dataSize);
+    size_tracker_.message_written(message.dataSize);
+    sync_size_nts_();
+    check_data_sink_nts_();
     file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
+
+    if (prepare_next_file_size_ > 0 && !next_file_requested_ &&
+            size_tracker_.get_potential_mcap_size() >= prepare_next_file_size_)
+    {
+        prepare_next_file_nts_();
+    }
+
+    source_guid_index_.add(msg.sequence, msg.source_guid);
+
+    if (compression_policy_.is_adaptive())
+    {
+        adapt_compression_nts_();
+    }
 }
 
 template <>
@@ -271,7 +501,7 @@ void McapWriter::write_nts_(
             "MCAP_WRITE | Writing metadata: " << metadata.name << ".");
 
     size_tracker_.metadata_to_write(metadata);
-    const auto status = writer_.write(metadata);
+    const auto status = writer_->write(metadata);
 
     if (!status.ok())
     {
@@ -281,6 +511,7 @@ void McapWriter::write_nts_(
     }
 
     size_tracker_.metadata_written(metadata);
+    sync_size_nts_();
     file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
 }
 
@@ -292,26 +523,254 @@ void McapWriter::write_nts_(
             "MCAP_WRITE | Writing schema: " << schema.name << ".");
 
     size_tracker_.schema_to_write(schema);
-    writer_.addSchema(const_cast<mcap::Schema&>(schema));
+    writer_->addSchema(const_cast<mcap::Schema&>(schema));
     size_tracker_.schema_written(schema);
 
     file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
 
     // Store the schema to write it on new MCAP files
     schemas_[schema.id] = schema;
+    checkpoint_outdated_ = true;
 }
 
-void McapWriter::write_attachment_nts_()
+std::vector<std::pair<std::string, std::string>> McapWriter::collect_attachments_nts_()
 {
-    mcap::Attachment attachment;
+    std::vector<std::pair<std::string, std::string>> attachments;
 
-    // Write down the attachment with the dynamic types and guids dictionary
-    attachment.name = DYNAMIC_TYPES_ATTACHMENT_NAME;
-    attachment.data = reinterpret_cast<std::byte*>(const_cast<char*>(dynamic_types_.c_str()));
-    attachment.dataSize = dynamic_types_.length();
-    attachment.createTime = to_mcap_timestamp(utils::now());
+    // The zstd dictionary of each schema
+    for (const auto& [schema_name, dictionary] : dictionaries_)
+    {
+        if (dictionary != nullptr && checkpointed_dictionaries_.count(schema_name) == 0)
+        {
+            attachments.emplace_back(ZSTD_DICTIONARY_ATTACHMENT_PREFIX + schema_name, dictionary->data());
+        }
+    }
+
+    // The dynamic types
+    if (record_types_ && !dynamic_types_.empty() && dynamic_types_.str().length() > checkpointed_dynamic_types_size_)
+    {
+        attachments.emplace_back(DYNAMIC_TYPES_ATTACHMENT_NAME, dynamic_types_.str());
+    }
+
+    // The writer of each message
+    if (source_guid_index_reserved_ > 0)
+    {
+        std::string serialized_index;
+
+        if (!source_guid_index_.empty())
+        {
+            source_guid_index_.serialize(serialized_index);
+        }
+
+        // Release the space reserved for the index but not used
+        size_tracker_.source_guid_index_to_write(serialized_index.size(), source_guid_index_reserved_);
+
+        source_guid_index_.clear();
+        source_guid_index_reserved_ = 0;
+
+        if (!serialized_index.empty())
+        {
+            attachments.emplace_back(SOURCE_GUID_INDEX_ATTACHMENT_NAME, std::move(serialized_index));
+        }
+    }
+
+    return attachments;
+}
+
+void McapWriter::write_checkpoint_nts_()
+{
+    if (!enabled_ || writer_->dataSink() == nullptr)
+    {
+        // No file is open
+        return;
+    }
+
+    const auto message_count = writer_->statistics().messageCount;
+
+    if (message_count == checkpointed_message_count_ && !checkpoint_outdated_)
+    {
+        return;
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+            "MCAP_WRITE | Checkpointing the MCAP file.");
+
+    // Write the messages received so far
+    writer_->closeLastChunk();
+    sync_size_nts_();
+
+    const auto& write_attachment = [&](
+        const std::string& name,
+        const std::string& data,
+        const bool reserved)
+            {
+                // NOTE: The attachments written when closing the file already have their space reserved, so they take
+                // it instead of reserving it again (and are not written again when closing the file)
+                if (!reserved && !size_tracker_.checkpoint_to_write(data.size()))
+                {
+                    EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_WRITER,
+                            "MCAP_WRITE | No space left to checkpoint the attachment " << name << ".");
+                    return false;
+                }
+
+                write_nts_(make_attachment(name, data));
+                return true;
+            };
+
+    // NOTE: The dictionaries and the dynamic types are only needed to read the messages, so they are not rewritten
+    // when the file is closed (the readers take the last attachment of each name).
+    for (const auto& [schema_name, dictionary] : dictionaries_)
+    {
+        if (dictionary != nullptr && checkpointed_dictionaries_.count(schema_name) == 0 &&
+                write_attachment(ZSTD_DICTIONARY_ATTACHMENT_PREFIX + schema_name, dictionary->data(), true))
+        {
+            checkpointed_dictionaries_.insert(schema_name);
+        }
+    }
+
+    if (record_types_ && dynamic_types_.str().length() > checkpointed_dynamic_types_size_ &&
+            write_attachment(DYNAMIC_TYPES_ATTACHMENT_NAME, dynamic_types_.str(), true))
+    {
+        checkpointed_dynamic_types_size_ = dynamic_types_.str().length();
+    }
+
+    if (checkpoint_outdated_)
+    {
+        std::string checkpoint;
+        McapRecovery::serialize_checkpoint(schemas_, channels_, checkpoint);
+
+        if (write_attachment(CHECKPOINT_ATTACHMENT_NAME, checkpoint, false))
+        {
+            checkpoint_outdated_ = false;
+        }
+    }
+
+    // NOTE: The file is flushed to the OS, so it survives the recorder being killed (but not a power loss).
+    writer_->dataSink()->flush();
+    check_data_sink_nts_();
+    checkpointed_message_count_ = message_count;
+}
+
+void McapWriter::checkpoint_thread_routine_()
+{
+    std::unique_lock<std::mutex> lock(checkpoint_mutex_);
+
+    while (!checkpoint_cv_.wait_for(lock, std::chrono::seconds(checkpoint_period_), [&]()
+            {
+                return checkpoint_stop_;
+            }))
+    {
+        lock.unlock();
+
+        {
+            std::lock_guard<std::mutex> writer_lock(mutex_);
+
+            try
+            {
+                write_checkpoint_nts_();
+            }
+            catch (const FullDiskException& e)
+            {
+                on_write_failed_nts_(e);
+            }
+        }
+
+        lock.lock();
+    }
+}
+
+void McapWriter::reserve_source_guid_index_nts_()
+{
+    if (source_guid_index_.serialized_size() + SourceGuidIndex::MAX_MESSAGE_SIZE <= source_guid_index_reserved_)
+    {
+        return;
+    }
 
-    write_nts_(attachment);
+    // Reserve the space in blocks, so it is not accounted for on every message
+    const auto reserved = source_guid_index_reserved_ + SOURCE_GUID_INDEX_RESERVATION_STEP;
+    size_tracker_.source_guid_index_to_write(reserved, source_guid_index_reserved_);
+    source_guid_index_reserved_ = reserved;
+}
+
+void McapWriter::compress_message_nts_(
+        mcap::Message& message)
+{
+    if (message.dataSize > ZstdDictionary::MAX_MESSAGE_SIZE)
+    {
+        // Large messages compress well enough within the chunks
+        return;
+    }
+
+    const auto channel_it = channels_.find(message.channelId);
+
+    if (channel_it == channels_.end())
+    {
+        return;
+    }
+
+    const auto schema_it = schemas_.find(channel_it->second.schemaId);
+
+    if (schema_it == schemas_.end())
+    {
+        return;
+    }
+
+    const auto& schema_name = schema_it->second.name;
+    const auto dictionary_it = dictionaries_.find(schema_name);
+
+    if (dictionary_it != dictionaries_.end())
+    {
+        if (dictionary_it->second != nullptr &&
+                dictionary_it->second->compress(message.data, message.dataSize, compressed_message_))
+        {
+            message.data = compressed_message_.data();
+            message.dataSize = compressed_message_.size();
+        }
+
+        return;
+    }
+
+    // Collect the message to train the dictionary of its schema
+    auto& samples = dictionary_samples_by_schema_[schema_name];
+    samples.emplace_back(reinterpret_cast<const char*>(message.data), message.dataSize);
+
+    if (samples.size() < dictionary_samples_)
+    {
+        return;
+    }
+
+    const auto dictionary = ZstdDictionary::train(samples, dictionary_max_size_);
+
+    if (dictionary.empty())
+    {
+        EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Failed to train a zstd dictionary for schema " << schema_name << ". Its messages will "
+                "only be compressed within the chunks.");
+
+        dictionaries_[schema_name] = nullptr;
+        dictionary_samples_by_schema_.erase(schema_name);
+        return;
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+            "MCAP_WRITE | Trained a zstd dictionary of " << utils::from_bytes(dictionary.size()) << " for schema " <<
+            schema_name << ".");
+
+    try
+    {
+        size_tracker_.attachment_to_write(dictionary.size());
+    }
+    catch (const FullFileException&)
+    {
+        // The message is collected again (and the dictionary trained again) when retrying in the next file
+        samples.pop_back();
+        throw;
+    }
+
+    dictionaries_[schema_name] = std::make_unique<ZstdDictionary>(dictionary);
+    dictionary_samples_by_schema_.erase(schema_name);
+
+    file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
 }
 
 void McapWriter::write_channels_nts_()
@@ -332,6 +791,11 @@ void McapWriter::write_channels_nts_()
 }
 
 void McapWriter::write_metadata_version_nts_()
+{
+    write_nts_(version_metadata_());
+}
+
+mcap::Metadata McapWriter::version_metadata_()
 {
     mcap::Metadata metadata;
 
@@ -340,23 +804,48 @@ void McapWriter::write_metadata_version_nts_()
     metadata.metadata[VERSION_METADATA_RELEASE] = DDSRECORDER_PARTICIPANTS_VERSION_STRING;
     metadata.metadata[VERSION_METADATA_COMMIT] = DDSRECORDER_PARTICIPANTS_COMMIT_HASH;
 
-    write_nts_(metadata);
+    return metadata;
 }
 
-void McapWriter::write_metadata_messages_nts_(
-        const std::string metadata_name,
-        const mcap::KeyValueMap map)
+void McapWriter::write_prepared_file_nts_()
 {
-    mcap::Metadata metadata;
+    // Account for the records the rotation thread wrote
+    const auto metadata = version_metadata_();
+    size_tracker_.metadata_to_write(metadata);
+    size_tracker_.metadata_written(metadata);
 
-    // Write down the metadata with the version
-    metadata.name = metadata_name;
-    for (const auto& pair_message: map)
+    auto schema_it = schemas_.begin();
+
+    for (std::size_t i = 0; i < next_file_schemas_ && schema_it != schemas_.end(); ++i, ++schema_it)
     {
-        metadata.metadata[pair_message.first] = pair_message.second;
+        size_tracker_.schema_to_write(schema_it->second);
+        size_tracker_.schema_written(schema_it->second);
     }
 
-    write_nts_(metadata);
+    auto channel_it = channels_.begin();
+
+    for (std::size_t i = 0; i < next_file_channels_ && channel_it != channels_.end(); ++i, ++channel_it)
+    {
+        size_tracker_.channel_to_write(channel_it->second);
+        size_tracker_.channel_written(channel_it->second);
+    }
+
+    checkpoint_outdated_ = !schemas_.empty() || !channels_.empty();
+
+    sync_size_nts_();
+    file_tracker_->set_current_file_size(size_tracker_.get_potential_mcap_size());
+
+    // Write the schemas and channels received since the file was prepared
+    // NOTE: Their ids are consecutive, so they get the same ids as in the previous files
+    for (; schema_it != schemas_.end(); ++schema_it)
+    {
+        write_nts_(mcap::Schema(schema_it->second));
+    }
+
+    for (; channel_it != channels_.end(); ++channel_it)
+    {
+        write_nts_(mcap::Channel(channel_it->second));
+    }
 }
 
 void McapWriter::write_schemas_nts_()
@@ -376,6 +865,279 @@ void McapWriter::write_schemas_nts_()
     }
 }
 
+void McapWriter::sync_size_nts_()
+{
+    const auto data_sink = writer_->dataSink();
+
+    if (data_sink == nullptr)
+    {
+        return;
+    }
+
+    // NOTE: The bytes in the file are exact (and compressed), only the chunks not written yet are estimated.
+    size_tracker_.sync(data_sink->size(), writer_->bufferedSize(), writer_->statistics().chunkCount);
+}
+
+void McapWriter::check_data_sink_nts_() const
+{
+    // NOTE: Only the direct I/O backend reports its failed writes (the buffered one is flushed by the OS)
+    const auto direct_file_writer = dynamic_cast<DirectFileWriter*>(writer_->dataSink());
+
+    if (direct_file_writer != nullptr && direct_file_writer->failed())
+    {
+        throw FullDiskException(
+                  "Failed to write the MCAP file " + file_tracker_->get_current_filename() + ". The rest of the file "
+                  "would be dropped.");
+    }
+}
+
+void McapWriter::on_write_failed_nts_(
+        const FullDiskException& e)
+{
+    EPROSIMA_LOG_ERROR(DDSRECORDER_MCAP_WRITER,
+            "FAIL_MCAP_WRITE | " << e.what());
+
+    close_current_file_nts_();
+
+    // Disable the writer, so nothing else is written until a new file is opened
+    enabled_ = false;
+
+    on_disk_full_();
+}
+
+void McapWriter::adapt_compression_nts_()
+{
+    const auto chunk_count = writer_->statistics().chunkCount;
+
+    if (chunk_count == last_chunk_count_)
+    {
+        // The chunk in progress is not full yet
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto fill_time = now - last_chunk_time_;
+
+    last_chunk_count_ = chunk_count;
+    last_chunk_time_ = now;
+
+    if (!compression_policy_.on_chunk(fill_time, writer_->lastChunkCompressionTime(), writer_->pendingChunkCount()))
+    {
+        return;
+    }
+
+    const auto& [compression, compression_level] = compression_policy_.step();
+
+    if (compression == mcap::Compression::None)
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Writing the next chunks uncompressed.");
+    }
+    else
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+                "MCAP_WRITE | Compressing the next chunks with " << mcap::internal::CompressionString(compression) <<
+                " (level " << static_cast<int>(compression_level) << ").");
+    }
+
+    writer_->setCompression(compression, compression_level);
+}
+
+mcap::Status McapWriter::open_mcap_file_(
+        mcap::McapWriter& writer,
+        const std::string& filename) const
+{
+    if (io_backend_ != McapIoBackend::direct || !DirectFileWriter::is_supported())
+    {
+        return writer.open(filename, mcap_configuration_);
+    }
+
+    auto file_writer = std::make_unique<DirectFileWriter>();
+    const auto status = file_writer->open(filename, configuration_.resource_limits.max_file_size_);
+
+    if (!status.ok())
+    {
+        return status;
+    }
+
+    writer.open(std::move(file_writer), mcap_configuration_);
+
+    return mcap::StatusCode::Success;
+}
+
+void McapWriter::prepare_next_file_nts_()
+{
+    next_file_requested_ = true;
+
+    const auto filename = file_tracker_->reserve_next_filename();
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_MCAP_WRITER,
+            "MCAP_WRITE | Preparing the next MCAP file " << filename << ".");
+
+    // The schemas and channels known so far are written in the next file by the rotation thread, so switching to it
+    // only writes the ones received in the meantime
+    next_file_schemas_ = schemas_.size();
+    next_file_channels_ = channels_.size();
+
+    post_rotation_task_([this, filename, schemas = schemas_, channels = channels_]() mutable
+            {
+                auto writer = std::make_unique<mcap::McapWriter>();
+                auto status = open_mcap_file_(*writer, filename);
+
+                if (status.ok())
+                {
+                    status = writer->write(version_metadata_());
+                }
+
+                if (status.ok())
+                {
+                    for (auto& [_, schema] : schemas)
+                    {
+                        writer->addSchema(schema);
+                    }
+
+                    for (auto& [_, channel] : channels)
+                    {
+                        writer->addChannel(channel);
+                    }
+                }
+                else
+                {
+                    EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_WRITER,
+                            "MCAP_WRITE | Failed to prepare the next MCAP file " << filename << ": " <<
+                            status.message << ". It will be opened when the current file is full.");
+
+                    writer.reset();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(rotation_mutex_);
+
+                    next_writer_ = std::move(writer);
+                    next_filename_ = filename;
+                    next_file_prepared_ = true;
+                }
+
+                rotation_cv_.notify_all();
+            });
+}
+
+std::unique_ptr<mcap::McapWriter> McapWriter::take_next_writer_nts_(
+        const std::string& filename)
+{
+    std::string next_filename;
+    auto writer = wait_next_writer_nts_(next_filename);
+
+    if (writer == nullptr || next_filename == filename)
+    {
+        return writer;
+    }
+
+    EPROSIMA_LOG_WARNING(DDSRECORDER_MCAP_WRITER,
+            "MCAP_WRITE | The next MCAP file was prepared as " << next_filename << " but is " << filename << ". "
+            "Opening it again.");
+
+    writer->terminate();
+    std::filesystem::remove(next_filename);
+
+    return nullptr;
+}
+
+void McapWriter::discard_next_file_nts_()
+{
+    if (!next_file_requested_)
+    {
+        return;
+    }
+
+    std::string next_filename;
+    auto writer = wait_next_writer_nts_(next_filename);
+
+    file_tracker_->release_next_filename();
+
+    if (writer != nullptr)
+    {
+        writer->terminate();
+        std::filesystem::remove(next_filename);
+    }
+}
+
+std::unique_ptr<mcap::McapWriter> McapWriter::wait_next_writer_nts_(
+        std::string& filename)
+{
+    if (!next_file_requested_)
+    {
+        return nullptr;
+    }
+
+    next_file_requested_ = false;
+
+    std::unique_lock<std::mutex> lock(rotation_mutex_);
+
+    // NOTE: The file is prepared long before the current one is full, so this wait is normally instantaneous.
+    rotation_cv_.wait(lock, [&]()
+            {
+                return next_file_prepared_;
+            });
+
+    next_file_prepared_ = false;
+    filename = std::move(next_filename_);
+    next_filename_.clear();
+
+    return std::move(next_writer_);
+}
+
+void McapWriter::post_rotation_task_(
+        std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(rotation_mutex_);
+        rotation_tasks_.push_back(std::move(task));
+    }
+
+    rotation_cv_.notify_all();
+}
+
+void McapWriter::wait_rotation_tasks_()
+{
+    std::unique_lock<std::mutex> lock(rotation_mutex_);
+
+    rotation_cv_.wait(lock, [&]()
+            {
+                return rotation_tasks_.empty() && !rotation_busy_;
+            });
+}
+
+void McapWriter::rotation_thread_routine_()
+{
+    std::unique_lock<std::mutex> lock(rotation_mutex_);
+
+    while (true)
+    {
+        rotation_cv_.wait(lock, [&]()
+                {
+                    return rotation_stop_ || !rotation_tasks_.empty();
+                });
+
+        if (rotation_tasks_.empty())
+        {
+            // Stopped with no tasks left
+            return;
+        }
+
+        auto task = std::move(rotation_tasks_.front());
+        rotation_tasks_.pop_front();
+        rotation_busy_ = true;
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        rotation_busy_ = false;
+        rotation_cv_.notify_all();
+    }
+}
+
 } /* namespace participants */
 } /* namespace ddsrecorder */
 } /* namespace eprosima */
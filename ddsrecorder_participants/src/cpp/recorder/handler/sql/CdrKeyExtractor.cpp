@@ -0,0 +1,881 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file CdrKeyExtractor.cpp
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <fastdds/dds/xtypes/dynamic_types/DynamicTypeMember.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/MemberDescriptor.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/TypeDescriptor.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/Types.hpp>
+
+#include <cpp_utils/Log.hpp>
+
+#include <ddsrecorder_participants/recorder/handler/sql/CdrKeyExtractor.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+using namespace eprosima::fastdds::dds;
+
+struct CdrKeyExtractor::Node
+{
+    //! Kind of a type
+    enum class Kind
+    {
+        PRIMITIVE,
+        STRING,
+        STRUCTURE,
+        SEQUENCE,
+        ARRAY
+    };
+
+    //! Member of a structure
+    struct Member
+    {
+        //! Name of the member
+        std::string name;
+
+        //! Whether the member is part of the key
+        bool is_key;
+
+        //! Layout of the type of the member
+        std::shared_ptr<const Node> node;
+    };
+
+    //! Kind of the type
+    Kind kind;
+
+    //! (PRIMITIVE) Kind of the primitive type
+    TypeKind primitive_kind{TK_NONE};
+
+    //! (PRIMITIVE) Size [bytes] of the primitive type
+    std::uint32_t size{0};
+
+    //! (STRUCTURE) Whether it is appendable (preceded by a DHEADER in XCDRv2)
+    bool appendable{false};
+
+    //! (STRUCTURE) Members, in serialization order
+    std::vector<Member> members;
+
+    //! (STRUCTURE) Number of members to decode to get every key member
+    std::size_t key_members_end{0};
+
+    //! (SEQUENCE / ARRAY) Layout of the elements
+    std::shared_ptr<const Node> element;
+
+    //! (ARRAY) Number of elements
+    std::uint32_t length{0};
+};
+
+namespace {
+
+using Node = CdrKeyExtractor::Node;
+
+//! Max depth of nested types supported (also prevents building recursive types forever)
+constexpr unsigned MAX_DEPTH = 16;
+
+//! Size of the encapsulation header preceding the CDR serialized sample
+constexpr std::uint32_t ENCAPSULATION_SIZE = 4;
+
+/**
+ * Reads the values of a CDR serialized sample, keeping the alignment rules of its encoding.
+ */
+class CdrReader
+{
+public:
+
+    CdrReader(
+            const std::uint8_t* data,
+            std::uint32_t size,
+            bool little_endian,
+            bool xcdr2)
+        : data_(data)
+        , size_(size)
+        , little_endian_(little_endian)
+        , xcdr2_(xcdr2)
+    {
+    }
+
+    bool xcdr2() const noexcept
+    {
+        return xcdr2_;
+    }
+
+    std::uint32_t position() const noexcept
+    {
+        return position_;
+    }
+
+    std::uint32_t remaining() const noexcept
+    {
+        return size_ - position_;
+    }
+
+    bool align(
+            std::uint32_t size) noexcept
+    {
+        // XCDRv1 aligns values up to 8 bytes, XCDRv2 up to 4 bytes
+        const std::uint32_t alignment = std::min(size, xcdr2_ ? 4u : 8u);
+
+        if (alignment <= 1)
+        {
+            return true;
+        }
+
+        return skip((alignment - position_ % alignment) % alignment);
+    }
+
+    bool skip(
+            std::uint64_t size) noexcept
+    {
+        if (size > remaining())
+        {
+            return false;
+        }
+
+        position_ += static_cast<std::uint32_t>(size);
+        return true;
+    }
+
+    bool jump(
+            std::uint32_t position) noexcept
+    {
+        if (position > size_ || position < position_)
+        {
+            return false;
+        }
+
+        position_ = position;
+        return true;
+    }
+
+    bool read(
+            std::uint32_t size,
+            std::uint64_t& value) noexcept
+    {
+        if (!align(size) || size > remaining())
+        {
+            return false;
+        }
+
+        value = 0;
+
+        for (std::uint32_t i = 0; i < size; i++)
+        {
+            const std::uint64_t byte = data_[position_ + (little_endian_ ? i : size - 1 - i)];
+            value |= byte << (8 * i);
+        }
+
+        position_ += size;
+        return true;
+    }
+
+    bool read(
+            std::uint32_t& value) noexcept
+    {
+        std::uint64_t value_64;
+
+        if (!read(4, value_64))
+        {
+            return false;
+        }
+
+        value = static_cast<std::uint32_t>(value_64);
+        return true;
+    }
+
+    const std::uint8_t* current() const noexcept
+    {
+        return data_ + position_;
+    }
+
+protected:
+
+    const std::uint8_t* data_;
+
+    std::uint32_t size_;
+
+    std::uint32_t position_{0};
+
+    bool little_endian_;
+
+    bool xcdr2_;
+};
+
+DynamicType::_ref_type resolve_alias(
+        DynamicType::_ref_type dynamic_type)
+{
+    while (dynamic_type != nullptr && dynamic_type->get_kind() == TK_ALIAS)
+    {
+        TypeDescriptor::_ref_type descriptor{traits<TypeDescriptor>::make_shared()};
+
+        if (dynamic_type->get_descriptor(descriptor) != RETCODE_OK)
+        {
+            return nullptr;
+        }
+
+        dynamic_type = descriptor->base_type();
+    }
+
+    return dynamic_type;
+}
+
+std::uint32_t primitive_size(
+        TypeKind kind)
+{
+    switch (kind)
+    {
+        case TK_BOOLEAN:
+        case TK_BYTE:
+        case TK_INT8:
+        case TK_UINT8:
+        case TK_CHAR8:
+            return 1;
+
+        case TK_INT16:
+        case TK_UINT16:
+            return 2;
+
+        case TK_INT32:
+        case TK_UINT32:
+        case TK_FLOAT32:
+            return 4;
+
+        case TK_INT64:
+        case TK_UINT64:
+        case TK_FLOAT64:
+            return 8;
+
+        case TK_FLOAT128:
+            return 16;
+
+        default:
+            // Not a primitive, or not supported (e.g. wide chars, whose size depends on the encoding)
+            return 0;
+    }
+}
+
+bool is_key_primitive(
+        TypeKind kind)
+{
+    // Primitives whose JSON representation is known not to depend on the JSON serializer (i.e. no floats nor chars)
+    switch (kind)
+    {
+        case TK_BOOLEAN:
+        case TK_INT8:
+        case TK_UINT8:
+        case TK_INT16:
+        case TK_UINT16:
+        case TK_INT32:
+        case TK_UINT32:
+        case TK_INT64:
+        case TK_UINT64:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+std::shared_ptr<const Node> build_node(
+        const DynamicType::_ref_type& dynamic_type,
+        unsigned depth);
+
+std::shared_ptr<const Node> build_structure(
+        const DynamicType::_ref_type& dynamic_type,
+        const TypeDescriptor::_ref_type& descriptor,
+        bool top_level,
+        unsigned depth)
+{
+    if (descriptor->base_type() != nullptr ||
+            descriptor->extensibility_kind() == ExtensibilityKind::MUTABLE)
+    {
+        return nullptr;
+    }
+
+    auto node = std::make_shared<Node>();
+    node->kind = Node::Kind::STRUCTURE;
+    node->appendable = descriptor->extensibility_kind() == ExtensibilityKind::APPENDABLE;
+
+    std::vector<MemberDescriptor::_ref_type> member_descriptors;
+
+    for (std::uint32_t i = 0; i < dynamic_type->get_member_count(); i++)
+    {
+        DynamicTypeMember::_ref_type member;
+        MemberDescriptor::_ref_type member_descriptor{traits<MemberDescriptor>::make_shared()};
+
+        if (dynamic_type->get_member_by_index(member, i) != RETCODE_OK ||
+                member->get_descriptor(member_descriptor) != RETCODE_OK ||
+                member_descriptor->is_optional())
+        {
+            return nullptr;
+        }
+
+        if (member_descriptor->is_key())
+        {
+            node->key_members_end = i + 1;
+        }
+
+        member_descriptors.push_back(member_descriptor);
+    }
+
+    // The members following the last key member are never decoded in the top level structure
+    const auto members_end = top_level ? node->key_members_end : member_descriptors.size();
+
+    for (std::size_t i = 0; i < members_end; i++)
+    {
+        const auto& member_descriptor = member_descriptors[i];
+        auto member_node = build_node(member_descriptor->type(), depth + 1);
+
+        if (member_node == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (member_descriptor->is_key())
+        {
+            const bool is_key_type =
+                    (member_node->kind == Node::Kind::PRIMITIVE && is_key_primitive(member_node->primitive_kind)) ||
+                    member_node->kind == Node::Kind::STRING ||
+                    member_node->kind == Node::Kind::STRUCTURE;
+
+            if (!is_key_type)
+            {
+                return nullptr;
+            }
+        }
+
+        node->members.push_back({static_cast<std::string>(member_descriptor->name()), member_descriptor->is_key(),
+                                 std::move(member_node)});
+    }
+
+    return node;
+}
+
+std::shared_ptr<const Node> build_node(
+        const DynamicType::_ref_type& alias_type,
+        unsigned depth)
+{
+    if (depth > MAX_DEPTH)
+    {
+        return nullptr;
+    }
+
+    const auto dynamic_type = resolve_alias(alias_type);
+
+    if (dynamic_type == nullptr)
+    {
+        return nullptr;
+    }
+
+    TypeDescriptor::_ref_type descriptor{traits<TypeDescriptor>::make_shared()};
+
+    if (dynamic_type->get_descriptor(descriptor) != RETCODE_OK)
+    {
+        return nullptr;
+    }
+
+    const auto kind = dynamic_type->get_kind();
+
+    switch (kind)
+    {
+        case TK_STRING8:
+        {
+            auto node = std::make_shared<Node>();
+            node->kind = Node::Kind::STRING;
+            return node;
+        }
+
+        case TK_STRUCTURE:
+            return build_structure(dynamic_type, descriptor, false, depth);
+
+        case TK_SEQUENCE:
+        case TK_ARRAY:
+        {
+            auto element = build_node(descriptor->element_type(), depth + 1);
+
+            if (element == nullptr)
+            {
+                return nullptr;
+            }
+
+            auto node = std::make_shared<Node>();
+            node->kind = kind == TK_SEQUENCE ? Node::Kind::SEQUENCE : Node::Kind::ARRAY;
+            node->element = std::move(element);
+
+            if (kind == TK_ARRAY)
+            {
+                std::uint64_t length = 1;
+
+                for (const auto dimension : descriptor->bound())
+                {
+                    length *= dimension;
+
+                    if (length > UINT32_MAX)
+                    {
+                        return nullptr;
+                    }
+                }
+
+                node->length = static_cast<std::uint32_t>(length);
+            }
+
+            return node;
+        }
+
+        default:
+        {
+            const auto size = primitive_size(kind);
+
+            if (size == 0)
+            {
+                return nullptr;
+            }
+
+            auto node = std::make_shared<Node>();
+            node->kind = Node::Kind::PRIMITIVE;
+            node->primitive_kind = kind;
+            node->size = size;
+            return node;
+        }
+    }
+}
+
+bool skip(
+        const Node& node,
+        CdrReader& reader);
+
+bool skip_members(
+        const Node& node,
+        std::size_t begin,
+        CdrReader& reader)
+{
+    for (std::size_t i = begin; i < node.members.size(); i++)
+    {
+        if (!skip(*node.members[i].node, reader))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool skip(
+        const Node& node,
+        CdrReader& reader)
+{
+    switch (node.kind)
+    {
+        case Node::Kind::PRIMITIVE:
+            return reader.align(node.size) && reader.skip(node.size);
+
+        case Node::Kind::STRING:
+        {
+            std::uint32_t length;
+            return reader.read(length) && reader.skip(length);
+        }
+
+        case Node::Kind::STRUCTURE:
+        {
+            if (reader.xcdr2() && node.appendable)
+            {
+                std::uint32_t dheader;
+                return reader.read(dheader) && reader.skip(dheader);
+            }
+
+            return skip_members(node, 0, reader);
+        }
+
+        case Node::Kind::SEQUENCE:
+        case Node::Kind::ARRAY:
+        {
+            const auto& element = *node.element;
+            const bool primitive_elements = element.kind == Node::Kind::PRIMITIVE;
+
+            if (reader.xcdr2() && !primitive_elements)
+            {
+                // Collections of non-primitive elements are preceded by a DHEADER in XCDRv2
+                std::uint32_t dheader;
+                return reader.read(dheader) && reader.skip(dheader);
+            }
+
+            std::uint32_t length = node.length;
+
+            if (node.kind == Node::Kind::SEQUENCE && !reader.read(length))
+            {
+                return false;
+            }
+
+            if (length == 0)
+            {
+                return true;
+            }
+
+            if (primitive_elements)
+            {
+                return reader.align(element.size) &&
+                       reader.skip(static_cast<std::uint64_t>(length) * element.size);
+            }
+
+            // Every serialized element takes at least one byte (avoid looping on corrupted lengths)
+            if (length > reader.remaining())
+            {
+                return false;
+            }
+
+            for (std::uint32_t i = 0; i < length; i++)
+            {
+                if (!skip(element, reader))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+void append_json_string(
+        const char* data,
+        std::size_t size,
+        std::string& json)
+{
+    // NOTE: same escaping nlohmann::json::dump applies to ASCII strings
+    static const char* HEX_DIGITS = "0123456789abcdef";
+
+    json += '"';
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        const char c = data[i];
+
+        switch (c)
+        {
+            case '"':
+                json += "\\\"";
+                break;
+
+            case '\\':
+                json += "\\\\";
+                break;
+
+            case '\b':
+                json += "\\b";
+                break;
+
+            case '\f':
+                json += "\\f";
+                break;
+
+            case '\n':
+                json += "\\n";
+                break;
+
+            case '\r':
+                json += "\\r";
+                break;
+
+            case '\t':
+                json += "\\t";
+                break;
+
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    json += "\\u00";
+                    json += HEX_DIGITS[(c >> 4) & 0x0F];
+                    json += HEX_DIGITS[c & 0x0F];
+                }
+                else
+                {
+                    json += c;
+                }
+                break;
+        }
+    }
+
+    json += '"';
+}
+
+bool extract_structure(
+        const Node& node,
+        CdrReader& reader,
+        bool complete,
+        std::string& json);
+
+bool extract_value(
+        const Node& node,
+        CdrReader& reader,
+        std::string& json)
+{
+    switch (node.kind)
+    {
+        case Node::Kind::PRIMITIVE:
+        {
+            std::uint64_t value;
+
+            if (!reader.read(node.size, value))
+            {
+                return false;
+            }
+
+            switch (node.primitive_kind)
+            {
+                case TK_BOOLEAN:
+                    json += value != 0 ? "true" : "false";
+                    break;
+
+                case TK_INT8:
+                    json += std::to_string(static_cast<std::int8_t>(value));
+                    break;
+
+                case TK_INT16:
+                    json += std::to_string(static_cast<std::int16_t>(value));
+                    break;
+
+                case TK_INT32:
+                    json += std::to_string(static_cast<std::int32_t>(value));
+                    break;
+
+                case TK_INT64:
+                    json += std::to_string(static_cast<std::int64_t>(value));
+                    break;
+
+                default:
+                    json += std::to_string(value);
+                    break;
+            }
+
+            return true;
+        }
+
+        case Node::Kind::STRING:
+        {
+            std::uint32_t length;
+
+            // The length includes the null terminator
+            if (!reader.read(length) || length == 0 || length > reader.remaining())
+            {
+                return false;
+            }
+
+            const auto characters = reinterpret_cast<const char*>(reader.current());
+
+            // Non ASCII strings are left to the JSON serializer, which validates their encoding
+            if (std::any_of(characters, characters + length - 1, [](char c)
+                    {
+                        return static_cast<unsigned char>(c) >= 0x80;
+                    }))
+            {
+                return false;
+            }
+
+            append_json_string(characters, length - 1, json);
+            return reader.skip(length);
+        }
+
+        case Node::Kind::STRUCTURE:
+            return extract_structure(node, reader, true, json);
+
+        default:
+            return false;
+    }
+}
+
+bool extract_structure(
+        const Node& node,
+        CdrReader& reader,
+        bool complete,
+        std::string& json)
+{
+    bool delimited = false;
+    std::uint32_t end = 0;
+
+    if (reader.xcdr2() && node.appendable)
+    {
+        std::uint32_t dheader;
+
+        if (!reader.read(dheader) || dheader > reader.remaining())
+        {
+            return false;
+        }
+
+        delimited = true;
+        end = reader.position() + dheader;
+    }
+
+    // NOTE: the members of a JSON object are sorted by name once dumped
+    std::map<std::string, std::string> values;
+
+    for (std::size_t i = 0; i < node.key_members_end; i++)
+    {
+        const auto& member = node.members[i];
+
+        if (!member.is_key)
+        {
+            if (!skip(*member.node, reader))
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        std::string value;
+
+        if (!extract_value(*member.node, reader, value))
+        {
+            return false;
+        }
+
+        values[member.name] = std::move(value);
+    }
+
+    if (complete)
+    {
+        // Leave the reader after the structure, so the following members can be read
+        const bool skipped = delimited ? reader.jump(end) : skip_members(node, node.key_members_end, reader);
+
+        if (!skipped)
+        {
+            return false;
+        }
+    }
+
+    json += '{';
+
+    for (auto it = values.begin(); it != values.end(); ++it)
+    {
+        if (it != values.begin())
+        {
+            json += ',';
+        }
+
+        append_json_string(it->first.data(), it->first.size(), json);
+        json += ':';
+        json += it->second;
+    }
+
+    json += '}';
+
+    return true;
+}
+
+} /* namespace */
+
+CdrKeyExtractor::CdrKeyExtractor(
+        const DynamicType::_ref_type& dynamic_type)
+{
+    const auto resolved_type = resolve_alias(dynamic_type);
+
+    if (resolved_type == nullptr || resolved_type->get_kind() != TK_STRUCTURE)
+    {
+        return;
+    }
+
+    TypeDescriptor::_ref_type descriptor{traits<TypeDescriptor>::make_shared()};
+
+    if (resolved_type->get_descriptor(descriptor) != RETCODE_OK)
+    {
+        return;
+    }
+
+    root_ = build_structure(resolved_type, descriptor, true, 0);
+
+    if (root_ == nullptr)
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_CDR_KEY_EXTRACTOR,
+                "The keys of type " << resolved_type->get_name().to_string()
+                                    << " cannot be extracted from the CDR payload. They will be extracted from its JSON.");
+    }
+}
+
+bool CdrKeyExtractor::is_supported() const noexcept
+{
+    return root_ != nullptr;
+}
+
+bool CdrKeyExtractor::extract(
+        const ddspipe::core::types::Payload& payload,
+        std::string& key) const
+{
+    if (root_ == nullptr || payload.data == nullptr || payload.length < ENCAPSULATION_SIZE || payload.data[0] != 0)
+    {
+        return false;
+    }
+
+    bool xcdr2;
+    bool delimited = false;
+
+    // Plain (i.e. not parameter list) encapsulations
+    switch (payload.data[1])
+    {
+        case 0x00: // CDR_BE
+        case 0x01: // CDR_LE
+            xcdr2 = false;
+            break;
+
+        case 0x08: // D_CDR2_BE
+        case 0x09: // D_CDR2_LE
+            delimited = true;
+            xcdr2 = true;
+            break;
+
+        case 0x06: // CDR2_BE
+        case 0x07: // CDR2_LE
+            xcdr2 = true;
+            break;
+
+        default:
+            return false;
+    }
+
+    if (xcdr2 && delimited != root_->appendable)
+    {
+        // The sample was not serialized with the extensibility of the known type
+        return false;
+    }
+
+    const bool little_endian = (payload.data[1] & 0x01) != 0;
+
+    CdrReader reader(payload.data + ENCAPSULATION_SIZE, payload.length - ENCAPSULATION_SIZE, little_endian, xcdr2);
+
+    std::string json;
+
+    if (!extract_structure(*root_, reader, false, json))
+    {
+        return false;
+    }
+
+    key = std::move(json);
+    return true;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -0,0 +1,123 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file KeyCache.cpp
+ */
+
+#include <ddsrecorder_participants/recorder/handler/sql/KeyCache.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+KeyCache::KeyCache(
+        std::uint64_t max_entries /* = DEFAULT_MAX_ENTRIES */,
+        std::uint64_t max_memory /* = 0 */)
+    : max_entries_(max_entries)
+    , max_memory_(max_memory)
+{
+}
+
+const std::string* KeyCache::find(
+        const ddspipe::core::types::InstanceHandle& instance_handle) const
+{
+    const auto it = index_.find(instance_handle);
+
+    if (it == index_.end())
+    {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return &it->second->second;
+}
+
+void KeyCache::insert(
+        const ddspipe::core::types::InstanceHandle& instance_handle,
+        const std::string& key)
+{
+    const auto it = index_.find(instance_handle);
+
+    if (it != index_.end())
+    {
+        // Refresh the entry (the key of an instance never changes)
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+    }
+
+    entries_.emplace_front(instance_handle, key);
+    index_.emplace(instance_handle, entries_.begin());
+    memory_ += entry_memory_(entries_.front());
+
+    evict_();
+}
+
+std::size_t KeyCache::size() const noexcept
+{
+    return entries_.size();
+}
+
+std::uint64_t KeyCache::memory() const noexcept
+{
+    return memory_;
+}
+
+void KeyCache::take_accesses(
+        std::uint64_t& hits,
+        std::uint64_t& misses)
+{
+    hits = hits_.exchange(0, std::memory_order_relaxed);
+    misses = misses_.exchange(0, std::memory_order_relaxed);
+}
+
+std::size_t KeyCache::InstanceHandleHash::operator ()(
+        const ddspipe::core::types::InstanceHandle& instance_handle) const noexcept
+{
+    // FNV-1a over the 16 bytes of the handle (which are already a hash of the key for most types)
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for (std::size_t i = 0; i < 16; i++)
+    {
+        hash ^= static_cast<std::uint8_t>(instance_handle.value[i]);
+        hash *= 1099511628211ull;
+    }
+
+    return static_cast<std::size_t>(hash);
+}
+
+std::uint64_t KeyCache::entry_memory_(
+        const Entry& entry) noexcept
+{
+    // Approximate memory of the list node and the index node too
+    return sizeof(Entry) + entry.second.size() + 4 * sizeof(void*);
+}
+
+void KeyCache::evict_()
+{
+    while (entries_.size() > 1 &&
+            ((max_entries_ > 0 && entries_.size() > max_entries_) || (max_memory_ > 0 && memory_ > max_memory_)))
+    {
+        const auto& oldest_entry = entries_.back();
+
+        memory_ -= entry_memory_(oldest_entry);
+        index_.erase(oldest_entry.first);
+        entries_.pop_back();
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
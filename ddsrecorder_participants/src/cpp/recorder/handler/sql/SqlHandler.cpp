@@ -18,9 +18,15 @@
 
 #define SQL_IMPLEMENTATION  // Define this in exactly one .cpp file
 
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
 #include <ddsrecorder_participants/common/serialize/Serializer.hpp>
 #include <ddsrecorder_participants/recorder/handler/sql/SqlHandler.hpp>
 #include <ddsrecorder_participants/recorder/message/SqlMessage.hpp>
+#include <ddsrecorder_participants/recorder/monitoring/producers/DdsRecorderStatusMonitorProducer.hpp>
 
 namespace eprosima {
 namespace ddsrecorder {
@@ -37,6 +43,7 @@ SqlHandler::SqlHandler(
     : BaseHandler(config, payload_pool)
     , configuration_(config)
     , sql_writer_(config.output_settings, file_tracker, config.record_types, config.ros2_types, config.data_format)
+    , keys_(config.max_key_cache_entries, config.max_key_cache_memory)
 {
     EPROSIMA_LOG_INFO(DDSRECORDER_SQL_HANDLER, "Creating SQL handler instance.");
 
@@ -60,7 +67,7 @@ void SqlHandler::add_schema(
         const fastdds::dds::xtypes::TypeIdentifier& type_identifier)
 {
     // NOTE: Process schemas even if in STOPPED state to avoid losing them (only sent/received once in discovery)
-    std::lock_guard<std::mutex> lock(mtx_);
+    std::unique_lock<std::mutex> lock(mtx_);
 
     if (dynamic_type == nullptr)
     {
@@ -76,8 +83,20 @@ void SqlHandler::add_schema(
         return;
     }
 
-    // Add type to the list of received types
-    received_types_[type_name] = dynamic_type;
+    {
+        // Add type to the list of received types
+        // NOTE: take write_mtx_ too, as received types are accessed when writing samples (maybe by the writer thread)
+        std::lock_guard<std::mutex> write_lock(write_mtx_);
+        received_types_[type_name] = dynamic_type;
+
+        // Build the extractor of the keys of the type (once, so keys can be extracted straight from the payloads)
+        CdrKeyExtractor key_extractor(dynamic_type);
+
+        if (key_extractor.is_supported())
+        {
+            key_extractors_.emplace(type_name, std::move(key_extractor));
+        }
+    }
 
     if (configuration_.record_types)
     {
@@ -100,6 +119,10 @@ void SqlHandler::add_schema(
 
     // Check if there are any pending samples for this new type. If so, dump them.
     dump_pending_samples_nts_(type_name);
+
+    // Write the buffer if it was filled by the pending samples
+    lock.unlock();
+    write_dispatched_samples_();
 }
 
 void SqlHandler::add_data(
@@ -109,11 +132,15 @@ void SqlHandler::add_data(
     std::unique_lock<std::mutex> lock(mtx_);
 
     process_new_sample_nts_(std::make_shared<const SqlMessage>(
-                data, payload_pool_, topic));
+                data, payload_pool_, topics_.intern(topic)));
+
+    // Write the buffer (if full) once the lock is released
+    lock.unlock();
+    write_dispatched_samples_();
 }
 
 void SqlHandler::write_samples_(
-        std::list<std::shared_ptr<const BaseMessage>>& samples)
+        SamplesBatch& samples)
 {
     EPROSIMA_LOG_INFO(DDSRECORDER_SQL_HANDLER, "Writing samples to SQL file.");
 
@@ -121,9 +148,9 @@ void SqlHandler::write_samples_(
     std::vector<SqlMessage> samples_to_write;
     samples_to_write.reserve(samples.size());
 
-    while (!samples.empty())
+    for (const auto& sample : samples)
     {
-        auto sql_sample = static_cast<SqlMessage*>(const_cast<BaseMessage*>(samples.front().get()));
+        auto sql_sample = static_cast<SqlMessage*>(const_cast<BaseMessage*>(sample.get()));
 
         if (sql_sample == nullptr)
         {
@@ -131,7 +158,7 @@ void SqlHandler::write_samples_(
             continue;
         }
 
-        const auto topic = sql_sample->topic;
+        const auto& topic = *sql_sample->topic;
 
         std::ostringstream guid_ss;
         std::string writer_partitions;
@@ -158,7 +185,6 @@ void SqlHandler::write_samples_(
         {
             // (writers with the empty partition do not enters here,
             // the topic partition would be "")
-            samples.pop_front();
             continue;
         }
 
@@ -183,57 +209,146 @@ void SqlHandler::write_samples_(
         }
 
 
-        if (configuration_.data_format == DataFormat::json || configuration_.data_format == DataFormat::both)
+        samples_to_write.push_back(*sql_sample);
+    }
+
+    samples.clear();
+
+    // Deserialize the payloads and calculate the keys (possibly in parallel)
+    hydrate_samples_(samples_to_write);
+
+    // Store the calculated keys (and refresh the cached ones), so they are not calculated again for the same instance
+    for (const auto& sql_sample : samples_to_write)
+    {
+        if (!sql_sample.key.empty())
+        {
+            keys_.insert(sql_sample.instance_handle, sql_sample.key);
+        }
+    }
+
+    std::uint64_t key_cache_hits;
+    std::uint64_t key_cache_misses;
+    keys_.take_accesses(key_cache_hits, key_cache_misses);
+
+    if (key_cache_hits > 0 || key_cache_misses > 0)
+    {
+        monitor_key_cache_accesses(key_cache_hits, key_cache_misses);
+    }
+
+    // Write the samples in bulk
+    sql_writer_.write_messages(samples_to_write);
+}
+
+void SqlHandler::hydrate_samples_(
+        std::vector<SqlMessage>& samples) const
+{
+    // 1. Do not use more threads than cores the computer has
+    // 2. Do not create threads if the batch is small
+    const auto hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    const auto worker_count = std::min<std::size_t>(
+        hardware_threads, // 1.
+        (samples.size() + MIN_SAMPLES_PER_HYDRATION_WORKER_ - 1) / MIN_SAMPLES_PER_HYDRATION_WORKER_); // 2.
+
+    if (worker_count <= 1)
+    {
+        // Small batch, avoid the overhead of launching threads
+        hydrate_sample_range_(samples, 0, samples.size());
+        return;
+    }
+
+    // Divide the batch in similar size slices
+    const auto slice_size = (samples.size() + worker_count - 1) / worker_count;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(worker_count - 1);
+
+    for (std::size_t begin = slice_size; begin < samples.size(); begin += slice_size)
+    {
+        const auto end = std::min(samples.size(), begin + slice_size);
+
+        futures.push_back(std::async(
+                    std::launch::async,
+                    [this, &samples, begin, end]()
+                    {
+                        hydrate_sample_range_(samples, begin, end);
+                    }));
+    }
+
+    // The calling thread takes care of the first slice
+    hydrate_sample_range_(samples, 0, std::min(samples.size(), slice_size));
+
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+}
+
+void SqlHandler::hydrate_sample_range_(
+        std::vector<SqlMessage>& samples,
+        std::size_t begin,
+        std::size_t end) const
+{
+    const bool format_json =
+            configuration_.data_format == DataFormat::json || configuration_.data_format == DataFormat::both;
+
+    for (std::size_t i = begin; i < end; i++)
+    {
+        auto& sql_sample = samples[i];
+
+        const auto type_it = received_types_.find(sql_sample.topic->type_name);
+
+        if (format_json)
         {
-            if (received_types_.find(sql_sample->topic.type_name) == received_types_.end())
+            if (type_it == received_types_.end())
             {
                 EPROSIMA_LOG_WARNING(DDSRECORDER_SQL_HANDLER,
-                        "Message on topic " << sql_sample->topic.m_topic_name
-                                            << " with type " << sql_sample->topic.type_name
+                        "Message on topic " << sql_sample.topic->m_topic_name
+                                            << " with type " << sql_sample.topic->type_name
                                             << " cannot be formatted to JSON since the type has not been received.");
             }
             else
             {
                 // Deserialize the payload
-                sql_sample->deserialize(received_types_[sql_sample->topic.type_name]);
+                sql_sample.deserialize(type_it->second);
             }
         }
 
-        if (sql_sample->key.empty())
+        if (sql_sample.key.empty())
         {
-            set_key_(*sql_sample);
+            set_key_(sql_sample, type_it == received_types_.end() ? nullptr : type_it->second);
         }
-
-        samples_to_write.push_back(*sql_sample);
-
-        samples.pop_front();
     }
-
-    // Write the samples in bulk
-    sql_writer_.write(samples_to_write);
 }
 
 void SqlHandler::set_key_(
-        SqlMessage& sql_sample)
+        SqlMessage& sql_sample,
+        const fastdds::dds::DynamicType::_ref_type& dynamic_type) const
 {
-    if (keys_.find(sql_sample.instance_handle) != keys_.end())
+    const auto cached_key = keys_.find(sql_sample.instance_handle);
+
+    if (cached_key != nullptr)
     {
         // The key has already been calculated
-        sql_sample.key = keys_[sql_sample.instance_handle];
+        sql_sample.key = *cached_key;
         return;
     }
 
-    if (received_types_.find(sql_sample.topic.type_name) == received_types_.end())
+    const auto extractor_it = key_extractors_.find(sql_sample.topic->type_name);
+
+    if (extractor_it != key_extractors_.end() && extractor_it->second.extract(sql_sample.payload, sql_sample.key))
     {
-        // The type is not known. The key can't be calculated
+        // The key has been extracted straight from the payload
         return;
     }
 
-    // Calculate the key
-    sql_sample.set_key(received_types_[sql_sample.topic.type_name]);
+    if (dynamic_type == nullptr)
+    {
+        // The type is not known. The key can't be calculated
+        return;
+    }
 
-    // Store the key
-    keys_[sql_sample.instance_handle] = sql_sample.key;
+    // Calculate the key from the JSON-serialized payload
+    sql_sample.set_key(dynamic_type);
 }
 
 } /* namespace participants */
@@ -16,8 +16,12 @@
  * @file SqlWriter.cpp
  */
 
+#include <chrono>
+#include <functional>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <sqlite/sqlite3.h>
@@ -33,6 +37,7 @@
 #include <ddsrecorder_participants/common/serialize/Serializer.hpp>
 #include <ddsrecorder_participants/common/time_utils.hpp>
 #include <ddsrecorder_participants/common/types/dynamic_types_collection/DynamicTypesCollection.hpp>
+#include <ddsrecorder_participants/constants.hpp>
 #include <ddsrecorder_participants/recorder/handler/sql/SqlHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/handler/sql/SqlWriter.hpp>
 #include <ddsrecorder_participants/recorder/message/SqlMessage.hpp>
@@ -44,6 +49,115 @@ namespace eprosima {
 namespace ddsrecorder {
 namespace participants {
 
+namespace {
+
+/**
+ * Resets a cached statement and clears its bindings when going out of scope, so it can be executed again and it does
+ * not keep pointers to data bound with \c SQLITE_STATIC .
+ */
+class StatementReset
+{
+public:
+
+    explicit StatementReset(
+            sqlite3_stmt* statement)
+        : statement_(statement)
+    {
+    }
+
+    ~StatementReset()
+    {
+        sqlite3_reset(statement_);
+        sqlite3_clear_bindings(statement_);
+    }
+
+private:
+
+    sqlite3_stmt* statement_;
+};
+
+/**
+ * Rolls back the transaction in progress when going out of scope, unless it has been committed, so no error (nor
+ * exception) leaves it open.
+ */
+class TransactionRollback
+{
+public:
+
+    explicit TransactionRollback(
+            sqlite3* database)
+        : database_(database)
+    {
+    }
+
+    ~TransactionRollback()
+    {
+        if (!committed_)
+        {
+            sqlite3_exec(database_, "ROLLBACK;", nullptr, nullptr, nullptr);
+        }
+    }
+
+    //! Marks the transaction as committed
+    void committed() noexcept
+    {
+        committed_ = true;
+    }
+
+private:
+
+    sqlite3* database_;
+
+    bool committed_{false};
+};
+
+/**
+ * Executes a statement on the catalog of the SQL shards (or on the shard itself), binding its parameters as text.
+ *
+ * The catalog is auxiliary to the recording, so its errors are logged rather than thrown.
+ */
+void exec_catalog_statement(
+        sqlite3* database,
+        const char* query,
+        const std::vector<std::string>& bind_values,
+        const std::function<void(sqlite3_stmt*)>& process_row = nullptr)
+{
+    sqlite3_stmt* statement = nullptr;
+
+    if (sqlite3_prepare_v2(database, query, -1, &statement, nullptr) != SQLITE_OK)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER,
+                "FAIL_SQL_CATALOG | Failed to prepare SQL statement: " << sqlite3_errmsg(database));
+        sqlite3_finalize(statement);
+        return;
+    }
+
+    for (std::size_t i = 0; i < bind_values.size(); i++)
+    {
+        sqlite3_bind_text(statement, static_cast<int>(i + 1), bind_values[i].c_str(), -1, SQLITE_STATIC);
+    }
+
+    int step_ret;
+
+    while ((step_ret = sqlite3_step(statement)) == SQLITE_ROW)
+    {
+        if (process_row != nullptr)
+        {
+            process_row(statement);
+        }
+    }
+
+    if (step_ret != SQLITE_DONE)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER,
+                "FAIL_SQL_CATALOG | Failed to execute SQL statement: " << sqlite3_errmsg(database));
+    }
+
+    sqlite3_finalize(statement);
+}
+
+} // namespace
+
 SqlWriter::SqlWriter(
         const OutputSettings& configuration,
         std::shared_ptr<FileTracker>& file_tracker,
@@ -56,6 +170,38 @@ SqlWriter::SqlWriter(
     , check_interval_(configuration.resource_limits.size_tolerance_ / 2)
     , size_checkpoint_(configuration.resource_limits.size_tolerance_ / 4)
 {
+    if (configuration_.resource_limits.max_file_duration_ > 0)
+    {
+        rotation_thread_ = std::thread(&SqlWriter::rotation_thread_routine_, this);
+    }
+}
+
+SqlWriter::~SqlWriter()
+{
+    disable();
+
+    {
+        std::lock_guard<std::mutex> lock(rotation_mutex_);
+        rotation_stop_ = true;
+    }
+
+    rotation_cv_.notify_all();
+
+    if (rotation_thread_.joinable())
+    {
+        rotation_thread_.join();
+    }
+}
+
+void SqlWriter::disable()
+{
+    BaseWriter::disable();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Leave no shard half-written in the background
+    discard_next_file_nts_();
+    wait_rotation_tasks_();
 }
 
 void SqlWriter::update_dynamic_types(
@@ -100,38 +246,75 @@ void SqlWriter::open_new_file_nts_(
 
     const auto filename = file_tracker_->get_current_filename();
 
+    // Take the shard prepared in the background, if any
+    database_ = take_next_database_nts_(filename, page_size_);
+
+    if (database_ == nullptr)
+    {
+        open_database_(filename, database_, page_size_);
+    }
+
+    // The ids of the topics and writers, and the partitions, belong to the new file
+    topic_ids_.clear();
+    writer_ids_.clear();
+    written_partitions_.clear();
+    written_topic_partitions_.clear();
+
+    written_sql_size_ = MIN_SQL_SIZE;
+    file_open_time_ = std::chrono::steady_clock::now();
+
+    if (configuration_.resource_limits.max_file_duration_ > 0)
+    {
+        // NOTE: The shards are stored by their final name (without the temporary suffix), relative to the catalog
+        shard_name_ = std::filesystem::path(filename).stem().string();
+
+        post_rotation_task_([this, shard_name = shard_name_]()
+                {
+                    add_shard_to_catalog_(shard_name);
+                });
+
+        // Open the next shard in the background, so switching to it does not stall the writes
+        prepare_next_file_nts_();
+    }
+}
+
+void SqlWriter::open_database_(
+        const std::string& filename,
+        sqlite3*& database,
+        std::uint64_t& page_size) const
+{
     // Create SQLite database
-    const auto ret = sqlite3_open(filename.c_str(), &database_);
+    const auto ret = sqlite3_open(filename.c_str(), &database);
 
     if (ret != SQLITE_OK)
     {
         const std::string error_msg = utils::Formatter() << "Failed to open SQL file " << filename
-                                                         << " for writing: " << sqlite3_errmsg(database_);
-        sqlite3_close(database_);
+                                                         << " for writing: " << sqlite3_errmsg(database);
+        sqlite3_close(database);
 
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_OPEN | " << error_msg);
         throw utils::InitializationException(error_msg);
     }
 
     // Enable WAL mode: appends changes to a separate file before applying them to the main database, reducing the risk of corruption in the event of a crash
-    sqlite3_exec(database_, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
+    sqlite3_exec(database, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
 
     // Get the page size for later vacuuming and auto checkpointing
     sqlite3_stmt* stmt;
     const char* query = "PRAGMA page_size;";
 
-    if (sqlite3_prepare_v2(database_, query, -1, &stmt, nullptr) == SQLITE_OK)
+    if (sqlite3_prepare_v2(database, query, -1, &stmt, nullptr) == SQLITE_OK)
     {
         if (sqlite3_step(stmt) == SQLITE_ROW)
         {
-            page_size_ = sqlite3_column_int(stmt, 0);
+            page_size = sqlite3_column_int(stmt, 0);
         }
     }
     else
     {
         const std::string error_msg = utils::Formatter() << "Failed to calculate SQL page size: " << sqlite3_errmsg(
-            database_);
-        sqlite3_close(database_);
+            database);
+        sqlite3_close(database);
 
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_OPEN | " << error_msg);
         throw utils::InitializationException(error_msg);
@@ -140,17 +323,15 @@ void SqlWriter::open_new_file_nts_(
     sqlite3_finalize(stmt);
 
     // Set autocheckpoint every size_checkpoint_ bytes
-    const int checkpoint_pages = size_checkpoint_ / page_size_;
+    const int checkpoint_pages = size_checkpoint_ / page_size;
     std::string pragma_cmd = "PRAGMA wal_autocheckpoint = " + std::to_string(checkpoint_pages) + ";";
-    sqlite3_exec(database_, pragma_cmd.c_str(), nullptr, nullptr, nullptr);
+    sqlite3_exec(database, pragma_cmd.c_str(), nullptr, nullptr, nullptr);
 
     // Enable Incremental Auto-Vacuum mode (for antifragmentation memory management)
-    sqlite3_exec(database_, "PRAGMA auto_vacuum = INCREMENTAL;", nullptr, nullptr, nullptr);
+    sqlite3_exec(database, "PRAGMA auto_vacuum = INCREMENTAL;", nullptr, nullptr, nullptr);
 
     // Perform an initial VACUUM if needed (only on new databases, as it can be costly)
-    sqlite3_exec(database_, "VACUUM;", nullptr, nullptr, nullptr);
-
-
+    sqlite3_exec(database, "VACUUM;", nullptr, nullptr, nullptr);
 
     // Create Types table
     // NOTE: These tables creation should never fail since the minimum size accounts for them.
@@ -164,43 +345,78 @@ void SqlWriter::open_new_file_nts_(
         );
     )"};
 
-    create_sql_table_("Types", create_types_table);
+    create_sql_table_(database, "Types", create_types_table);
 
     // Create Topics table
     const std::string create_topics_table{
         R"(
         CREATE TABLE IF NOT EXISTS Topics (
+            id INTEGER PRIMARY KEY,
             name TEXT NOT NULL,
             type TEXT NOT NULL,
             qos TEXT NOT NULL,
             is_ros2_topic TEXT NOT NULL,
-            PRIMARY KEY(name, type),
+            UNIQUE(name, type),
             FOREIGN KEY(type) REFERENCES Types(name)
         );
     )"};
 
-    create_sql_table_("Topics", create_topics_table);
+    create_sql_table_(database, "Topics", create_topics_table);
 
-    // Create Messages table
+    // Create Writers table
+    const std::string create_writers_table{
+        R"(
+        CREATE TABLE IF NOT EXISTS Writers (
+            id INTEGER PRIMARY KEY,
+            guid TEXT NOT NULL UNIQUE
+        );
+    )"};
+
+    create_sql_table_(database, "Writers", create_writers_table);
+
+    // Create MessagesData table
+    // NOTE: The writer and the topic of each message are stored as the ids of their rows in Writers and Topics, since
+    //       their names are often longer than the payloads. The Messages view joins them back.
     const std::string create_messages_table{
         R"(
-        CREATE TABLE IF NOT EXISTS Messages (
-            writer_guid TEXT NOT NULL,
+        CREATE TABLE IF NOT EXISTS MessagesData (
+            writer_id INTEGER NOT NULL,
             sequence_number INTEGER NOT NULL,
             data_json TEXT,
             data_cdr BLOB,
             data_cdr_size INTEGER,
-            topic TEXT NOT NULL,
-            type TEXT NOT NULL,
+            topic_id INTEGER NOT NULL,
             key TEXT NOT NULL,
-            log_time DATETIME NOT NULL,
-            publish_time DATETIME NOT NULL,
-            PRIMARY KEY(writer_guid, sequence_number),
-            FOREIGN KEY(topic, type) REFERENCES Topics(name, type)
+            log_time INTEGER NOT NULL,
+            publish_time INTEGER NOT NULL,
+            PRIMARY KEY(writer_id, sequence_number),
+            FOREIGN KEY(writer_id) REFERENCES Writers(id),
+            FOREIGN KEY(topic_id) REFERENCES Topics(id)
         );
     )"};
 
-    create_sql_table_("Messages", create_messages_table);
+    create_sql_table_(database, "MessagesData", create_messages_table);
+
+    // Create the index of the MessagesData table in the order they are replayed, so the replayer does not sort them
+    const std::string create_messages_index{
+        R"(
+        CREATE INDEX IF NOT EXISTS MessagesLogTime ON MessagesData (log_time, writer_id, sequence_number);
+    )"};
+
+    create_sql_table_(database, "MessagesLogTime", create_messages_index);
+
+    // Create Messages view (with the columns of the Messages table of the files recorded before MessagesData)
+    const std::string create_messages_view{
+        R"(
+        CREATE VIEW IF NOT EXISTS Messages AS
+            SELECT w.guid AS writer_guid, m.sequence_number, m.data_json, m.data_cdr, m.data_cdr_size,
+                   t.name AS topic, t.type AS type, m.key, m.log_time, m.publish_time
+            FROM MessagesData m
+            JOIN Writers w ON m.writer_id = w.id
+            JOIN Topics t ON m.topic_id = t.id;
+    )"};
+
+    create_sql_table_(database, "Messages", create_messages_view);
 
     // Create Partitions table
     const std::string create_partitions_table{
@@ -211,7 +427,7 @@ void SqlWriter::open_new_file_nts_(
         );
     )"};
 
-    create_sql_table_("Partitions", create_partitions_table);
+    create_sql_table_(database, "Partitions", create_partitions_table);
 
     // Create TopicPartitions table
     const std::string create_topic_partitions_table{
@@ -226,25 +442,37 @@ void SqlWriter::open_new_file_nts_(
         );
     )"};
 
-    create_sql_table_("TopicsPartitions", create_topic_partitions_table);
+    create_sql_table_(database, "TopicsPartitions", create_topic_partitions_table);
 
-    // Create MessagePartitions table
+    // Create MessagesPartitionsData table
     const std::string create_message_partitions_table{
         R"(
-        CREATE TABLE IF NOT EXISTS MessagesPartitions (
-            writer_guid TEXT NOT NULL,
+        CREATE TABLE IF NOT EXISTS MessagesPartitionsData (
+            writer_id INTEGER NOT NULL,
             sequence_number INTEGER NOT NULL,
             partition TEXT NOT NULL,
-            PRIMARY KEY (writer_guid, sequence_number, partition),
-            FOREIGN KEY (writer_guid, sequence_number) REFERENCES Messages(writer_guid, sequence_number) ON DELETE CASCADE,
+            PRIMARY KEY (writer_id, sequence_number, partition),
+            FOREIGN KEY (writer_id, sequence_number) REFERENCES MessagesData(writer_id, sequence_number) ON DELETE CASCADE,
             FOREIGN KEY (partition) REFERENCES Partitions(name)   ON DELETE CASCADE
         );
     )"};
 
-    create_sql_table_("MessagesPartitions", create_message_partitions_table);
+    create_sql_table_(database, "MessagesPartitionsData", create_message_partitions_table);
 
+    // Create MessagesPartitions view (with the columns of the MessagesPartitions table of the previous files)
+    const std::string create_message_partitions_view{
+        R"(
+        CREATE VIEW IF NOT EXISTS MessagesPartitions AS
+            SELECT w.guid AS writer_guid, mp.sequence_number, mp.partition
+            FROM MessagesPartitionsData mp
+            JOIN Writers w ON mp.writer_id = w.id;
+    )"};
 
-    written_sql_size_ = MIN_SQL_SIZE;
+    create_sql_table_(database, "MessagesPartitions", create_message_partitions_view);
+
+    // Store the version of the schema, so the readers know how to read the file
+    pragma_cmd = "PRAGMA user_version = " + std::to_string(SQL_SCHEMA_VERSION) + ";";
+    sqlite3_exec(database, pragma_cmd.c_str(), nullptr, nullptr, nullptr);
 }
 
 // (Tables: Types)
@@ -267,29 +495,20 @@ void SqlWriter::write_nts_(
         VALUES (?, ?, ?, ?);
     )";
 
-    // Prepare the SQL statement
-    sqlite3_stmt* statement;
-    const auto prep_ret = sqlite3_prepare_v2(database_, insert_statement, -1, &statement, nullptr);
-
-    if (prep_ret != SQLITE_OK)
-    {
-        const std::string error_msg = utils::Formatter() << "Failed to prepare SQL statement to write dynamic type: "
-                                                         << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement);
-
-        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
-        throw utils::InconsistencyException(error_msg);
-    }
+    // Prepare the SQL statement (only the first time since the file was opened)
+    prepare_statement_nts_(insert_type_statement_, insert_statement, "write dynamic type");
+    const StatementReset statement_reset(insert_type_statement_);
 
     // Bind the DynamicType to the SQL statement
+    // NOTE: The bound data outlives the execution of the statement, so it is not copied by SQLite
     const auto type_name =
             ros2_types_ ? utils::demangle_if_ros_type(dynamic_type.type_name()) : dynamic_type.type_name();
     const auto is_type_ros2_type = ros2_types_ && type_name != dynamic_type.type_name();
 
-    sqlite3_bind_text(statement, 1, type_name.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(statement, 2, dynamic_type.type_identifier().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(statement, 3, dynamic_type.type_object().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(statement, 4, is_type_ros2_type ? "true" : "false", -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(insert_type_statement_, 1, type_name.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(insert_type_statement_, 2, dynamic_type.type_identifier().c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(insert_type_statement_, 3, dynamic_type.type_object().c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(insert_type_statement_, 4, is_type_ros2_type ? "true" : "false", -1, SQLITE_STATIC);
 
     // Calculate the estimated size of this entry
     size_t entry_size = 0;
@@ -305,37 +524,29 @@ void SqlWriter::write_nts_(
     }
     catch (const FullFileException& e)
     {
-        sqlite3_finalize(statement);
-
         EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
         throw e;
     }
     catch (const utils::InconsistencyException& e)
     {
-        sqlite3_finalize(statement);
-
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
         throw e;
     }
 
     // Execute the SQL statement
-    const auto step_ret = sqlite3_step(statement);
+    const auto step_ret = sqlite3_step(insert_type_statement_);
 
     if (step_ret != SQLITE_DONE)
     {
         const std::string error_msg = utils::Formatter() << "Failed to write dynamic type to SQL database: "
                                                          << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement);
 
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
         throw utils::InconsistencyException(error_msg);
     }
-
-    // Finalize the SQL statement
-    sqlite3_finalize(statement);
 }
 
-// (Tables: Messages and MessagesPartitions)
+// (Tables: MessagesData and MessagesPartitionsData)
 template<>
 void SqlWriter::write_nts_(
         const std::vector<SqlMessage>& messages)
@@ -346,52 +557,63 @@ void SqlWriter::write_nts_(
         return;
     }
 
+    if (configuration_.resource_limits.max_file_duration_ > 0 &&
+            std::chrono::steady_clock::now() - file_open_time_ >=
+            std::chrono::seconds(configuration_.resource_limits.max_file_duration_))
+    {
+        // NOTE: The file is split when the first messages past its duration arrive, so no shard is left empty
+        split_file_nts_();
+
+        if (!enabled_)
+        {
+            return;
+        }
+    }
+
     EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER, "Writing << " << messages.size() << " messages.");
 
-    // (Table: Messages) Define the SQL statement for batch insert
+    // (Table: MessagesData) Define the SQL statement for batch insert
     const char* insert_statement_message =
             R"(
-        INSERT INTO Messages (writer_guid, sequence_number, data_json, data_cdr, data_cdr_size, topic, type, key, log_time, publish_time)
-        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);
+        INSERT INTO MessagesData (writer_id, sequence_number, data_json, data_cdr, data_cdr_size, topic_id, key, log_time, publish_time)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);
     )";
 
-    // (Table: MessagesPartitions) Define the SQL statement for batch insert
+    // (Table: MessagesPartitionsData) Define the SQL statement for batch insert
     const char* insert_statement_partition =
             R"(
-        INSERT INTO MessagesPartitions (writer_guid, sequence_number, partition)
+        INSERT INTO MessagesPartitionsData (writer_id, sequence_number, partition)
         VALUES (?, ?, ?);
     )";
 
-    // (Table: Messages) Prepare the SQL statement
-    sqlite3_stmt* statement_message;
-    const auto prep_ret = sqlite3_prepare_v2(database_, insert_statement_message, -1, &statement_message, nullptr);
+    // Prepare the SQL statements (only the first time since the file was opened)
+    prepare_statement_nts_(insert_message_statement_, insert_statement_message, "write in MessagesData table");
+    prepare_statement_nts_(insert_message_partition_statement_, insert_statement_partition,
+            "write in MessagesPartitionsData table");
 
-    if (prep_ret != SQLITE_OK)
-    {
-        const std::string error_msg = utils::Formatter()
-                << "Failed to prepare SQL statement to write in Messages table: "
-                << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement_message);
-
-        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
-        throw utils::InconsistencyException(error_msg);
-    }
-
-    // (Table: MessagesPartitions) Prepare the SQL statement
-    sqlite3_stmt* statement_partition;
-    const auto prep_ret_partition = sqlite3_prepare_v2(database_, insert_statement_partition, -1, &statement_partition,
-                    nullptr);
+    // (Tables: Writers and Topics) Get the ids of the writers and the topics, writing the new ones
+    // NOTE: They are written before the transaction so that the ids cached are not lost if it is rolled back
+    std::vector<std::string> writer_guid_strs;
+    std::vector<std::pair<std::int64_t, std::int64_t>> ids;
+    writer_guid_strs.reserve(messages.size());
+    ids.reserve(messages.size());
 
-    if (prep_ret_partition != SQLITE_OK)
+    for (const auto& message : messages)
     {
-        const std::string error_msg = utils::Formatter()
-                << "Failed to prepare SQL statement to write in MessagesPartitions table: "
-                << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement_message);
-        sqlite3_finalize(statement_partition);
+        // Get the writer_guid from the message if available, to reduce time complexity
+        std::string writer_guid_str = message.writer_guid_string;
+        if (writer_guid_str.empty())
+        {
+            std::ostringstream writer_guid_ss;
+            writer_guid_ss << message.writer_guid;
+            writer_guid_str = writer_guid_ss.str();
+        }
 
-        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
-        throw utils::InconsistencyException(error_msg);
+        ids.emplace_back(get_writer_id_nts_(writer_guid_str), get_topic_id_nts_(*message.topic));
+
+        // (Tables: Partitions and TopicsPartitions) Write the partitions of the writer, if they are new in this file
+        write_partitions_nts_(*message.topic, writer_guid_str);
+        writer_guid_strs.push_back(std::move(writer_guid_str));
     }
 
     // Begin transaction
@@ -399,29 +621,33 @@ void SqlWriter::write_nts_(
     {
         const std::string error_msg = utils::Formatter() << "Failed to begin transaction: "
                                                          << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement_message);
-        sqlite3_finalize(statement_partition);
 
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
         throw utils::InconsistencyException(error_msg);
     }
 
-    for (const auto& message : messages)
+    // Discard the messages of the batch written so far if any of them fails (e.g. so the whole batch is written to the
+    // next file when this one is full)
+    TransactionRollback transaction_rollback(database_);
+
+    for (std::size_t i = 0; i < messages.size(); i++)
     {
-        // (Table: Messages) Bind the SqlMessage to the SQL statement
+        const auto& message = messages[i];
+        const auto& writer_guid_str = writer_guid_strs[i];
+        const auto writer_id = ids[i].first;
+        const auto topic_id = ids[i].second;
 
-        // Bind the sample identity
-        // Get the writer_guid from the message if available, to reduce time complexity
-        std::string writer_guid_str = message.writer_guid_string;
-        if (writer_guid_str.empty())
-        {
-            std::ostringstream writer_guid_ss;
-            writer_guid_ss << message.writer_guid;
-            writer_guid_str = writer_guid_ss.str();
-        }
+        // Reset the statements for the next execution (or after an error)
+        const StatementReset message_reset(insert_message_statement_);
+        const StatementReset partition_reset(insert_message_partition_statement_);
+
+        // (Table: MessagesData) Bind the SqlMessage to the SQL statement
+        // NOTE: The messages (and the strings built for them below) outlive the execution of the statements, so the
+        //       data is bound without being copied by SQLite
 
-        sqlite3_bind_text(statement_message, 1, writer_guid_str.c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_bind_int64(statement_message, 2, message.sequence_number.to64long());
+        // Bind the sample identity
+        sqlite3_bind_int64(insert_message_statement_, 1, writer_id);
+        sqlite3_bind_int64(insert_message_statement_, 2, message.sequence_number.to64long());
 
         // Bind the sample data
         static const std::string empty_string;
@@ -442,62 +668,64 @@ void SqlWriter::write_nts_(
             data_cdr_size = message.get_data_cdr_size();
         }
 
-        sqlite3_bind_text(statement_message, 3, data_json->c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_bind_blob(statement_message, 4, data_cdr, data_cdr_size, SQLITE_TRANSIENT);
-        sqlite3_bind_int64(statement_message, 5, data_cdr_size);
+        sqlite3_bind_text(insert_message_statement_, 3, data_json->c_str(), static_cast<int>(data_json->size()),
+                SQLITE_STATIC);
+        sqlite3_bind_blob(insert_message_statement_, 4, data_cdr, data_cdr_size, SQLITE_STATIC);
+        sqlite3_bind_int64(insert_message_statement_, 5, data_cdr_size);
 
         // Bind the topic data
-        sqlite3_bind_text(statement_message, 6, message.topic.topic_name().c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_bind_text(statement_message, 7, message.topic.type_name.c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_bind_text(statement_message, 8, message.key.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(insert_message_statement_, 6, topic_id);
+        sqlite3_bind_text(insert_message_statement_, 7, message.key.c_str(), -1, SQLITE_STATIC);
 
-        // Bind the time data
-        const auto& log_time_str =
-                message.log_time_sql.empty() ? to_sql_timestamp(message.log_time) : message.log_time_sql;
-        const auto& publish_time_str =
-                message.publish_time_sql.empty() ? to_sql_timestamp(message.publish_time) : message.publish_time_sql;
-        sqlite3_bind_text(statement_message, 9, log_time_str.c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_bind_text(statement_message, 10, publish_time_str.c_str(), -1, SQLITE_TRANSIENT);
+        // Bind the time data (in nanoseconds)
+        const auto log_time = static_cast<std::int64_t>(to_ticks(message.log_time));
+        const auto publish_time = static_cast<std::int64_t>(to_ticks(message.publish_time));
+        sqlite3_bind_int64(insert_message_statement_, 8, log_time);
+        sqlite3_bind_int64(insert_message_statement_, 9, publish_time);
 
 
-        // (Table: MessagesPartitions)
+        // (Table: MessagesPartitionsData)
 
-        sqlite3_bind_text(statement_partition, 1, writer_guid_str.c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_bind_int64(statement_partition, 2, message.sequence_number.to64long());
+        sqlite3_bind_int64(insert_message_partition_statement_, 1, writer_id);
+        sqlite3_bind_int64(insert_message_partition_statement_, 2, message.sequence_number.to64long());
 
         // Get the partition from the message if available, to reduce time complexity
         const auto& partitions_set_string = message.partition.empty() ? [&message,
                         &writer_guid_str]()->const std::string &
         {
             static const std::string empty_partition;
-            const auto it = message.topic.partition_name.find(writer_guid_str);
-            return it != message.topic.partition_name.end() ? it->second : empty_partition;
+            const auto it = message.topic->partition_name.find(writer_guid_str);
+            return it != message.topic->partition_name.end() ? it->second : empty_partition;
         } () : message.partition;
 
-        sqlite3_bind_text(statement_partition, 3, partitions_set_string.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(insert_message_partition_statement_, 3, partitions_set_string.c_str(), -1, SQLITE_STATIC);
 
         // Calculate the estimated size of this entry
         size_t entry_size_message = 0;
         size_t entry_size_partition = 0;
 
-        size_t entry_size_writer_guid = writer_guid_str.size();
+        size_t entry_size_writer_id = calculate_int_storage_size(writer_id);
         size_t entry_size_sequence_number =
                 calculate_int_storage_size(message.sequence_number.to64long());
 
-        // (Table: Messages) Entry size
-        entry_size_message += entry_size_writer_guid;
+        // (Table: MessagesData) Entry size
+        entry_size_message += entry_size_writer_id;
         entry_size_message += entry_size_sequence_number;
         entry_size_message += data_json->size();
         entry_size_message += data_cdr_size;
         entry_size_message += calculate_int_storage_size(data_cdr_size);
-        entry_size_message += message.topic.topic_name().size();
-        entry_size_message += message.topic.type_name.size();
+        entry_size_message += calculate_int_storage_size(topic_id);
         entry_size_message += message.key.size();
-        entry_size_message += log_time_str.size();
-        entry_size_message += publish_time_str.size();
+        entry_size_message += calculate_int_storage_size(log_time);
+        entry_size_message += calculate_int_storage_size(publish_time);
+
+        // (Index: MessagesLogTime) Entry size
+        entry_size_message += calculate_int_storage_size(log_time);
+        entry_size_message += entry_size_writer_id;
+        entry_size_message += entry_size_sequence_number;
 
-        // (Table: MessagesPartitions) Entry size
-        entry_size_partition += entry_size_writer_guid;
+        // (Table: MessagesPartitionsData) Entry size
+        entry_size_partition += entry_size_writer_id;
         entry_size_partition += entry_size_sequence_number;
         entry_size_partition += partitions_set_string.size();
 
@@ -508,55 +736,39 @@ void SqlWriter::write_nts_(
         }
         catch (const FullFileException& e)
         {
-            sqlite3_finalize(statement_message);
-            sqlite3_finalize(statement_partition);
-
             EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
             throw e;
         }
         catch (const utils::InconsistencyException& e)
         {
-            sqlite3_finalize(statement_message);
-            sqlite3_finalize(statement_partition);
-
             EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
             throw e;
         }
 
 
-        // (Table: Messages) Execute the SQL statement
-        const auto step_ret = sqlite3_step(statement_message);
+        // (Table: MessagesData) Execute the SQL statement
+        const auto step_ret = sqlite3_step(insert_message_statement_);
 
         if (step_ret != SQLITE_DONE)
         {
             const std::string error_msg = utils::Formatter() << "Failed to write message to SQL database: "
                                                              << sqlite3_errmsg(database_);
-            sqlite3_finalize(statement_message);
-            sqlite3_finalize(statement_partition);
-            sqlite3_exec(database_, "ROLLBACK;", nullptr, nullptr, nullptr);
 
             EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
             throw utils::InconsistencyException(error_msg);
         }
 
-        // (Table: MessagesPartitions) Execute the SQL statement
-        const auto step_ret_partition = sqlite3_step(statement_partition);
+        // (Table: MessagesPartitionsData) Execute the SQL statement
+        const auto step_ret_partition = sqlite3_step(insert_message_partition_statement_);
 
         if (step_ret_partition != SQLITE_DONE)
         {
             const std::string error_msg = utils::Formatter() << "Failed to write partition message to SQL database: "
                                                              << sqlite3_errmsg(database_);
-            sqlite3_finalize(statement_message);
-            sqlite3_finalize(statement_partition);
-            sqlite3_exec(database_, "ROLLBACK;", nullptr, nullptr, nullptr);
 
             EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
             throw utils::InconsistencyException(error_msg);
         }
-
-        // Reset the statement for the next execution
-        sqlite3_reset(statement_message);
-        sqlite3_reset(statement_partition);
     }
 
     // Commit transaction
@@ -564,17 +776,12 @@ void SqlWriter::write_nts_(
     {
         const std::string error_msg = utils::Formatter() << "Failed to commit transaction: "
                                                          << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement_message);
-        sqlite3_finalize(statement_partition);
 
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
         throw utils::InconsistencyException(error_msg);
     }
 
-
-    // Finalize the SQL statement
-    sqlite3_finalize(statement_message);
-    sqlite3_finalize(statement_partition);
+    transaction_rollback.committed();
 }
 
 // (Tables: Topics)
@@ -588,6 +795,12 @@ void SqlWriter::write_nts_(
         return;
     }
 
+    // The topic is written once per file, either when it is discovered or with its first message
+    if (find_topic_id_nts_(topic) != nullptr)
+    {
+        return;
+    }
+
     EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER, "Writing topic " << topic.topic_name() << ".");
 
     // Define the SQL statement
@@ -597,30 +810,21 @@ void SqlWriter::write_nts_(
         VALUES (?, ?, ?, ?);
     )";
 
-    // Prepare the SQL statement
-    sqlite3_stmt* statement;
-    const auto prep_ret = sqlite3_prepare_v2(database_, insert_statement, -1, &statement, nullptr);
-
-    if (prep_ret != SQLITE_OK)
-    {
-        const std::string error_msg = utils::Formatter() << "Failed to prepare SQL statement to write topic: "
-                                                         << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement);
-
-        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
-        throw utils::InconsistencyException(error_msg);
-    }
+    // Prepare the SQL statement (only the first time since the file was opened)
+    prepare_statement_nts_(insert_topic_statement_, insert_statement, "write topic");
+    const StatementReset statement_reset(insert_topic_statement_);
 
     // Bind the Topic to the SQL statement
+    // NOTE: The bound data outlives the execution of the statement, so it is not copied by SQLite
     const auto topic_name = ros2_types_ ? utils::demangle_if_ros_topic(topic.topic_name()) : topic.topic_name();
     std::string topic_qos_serialized;
     Serializer::serialize(topic.topic_qos, topic_qos_serialized);
     const auto is_topic_ros2_type = ros2_types_ && topic_name != topic.topic_name();
 
-    sqlite3_bind_text(statement, 1, topic_name.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(statement, 2, topic.type_name.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(statement, 3, topic_qos_serialized.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(statement, 4, is_topic_ros2_type ? "true" : "false", -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(insert_topic_statement_, 1, topic_name.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(insert_topic_statement_, 2, topic.type_name.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(insert_topic_statement_, 3, topic_qos_serialized.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(insert_topic_statement_, 4, is_topic_ros2_type ? "true" : "false", -1, SQLITE_STATIC);
 
     // Calculate the estimated size of this entry
     size_t entry_size = 0;
@@ -636,33 +840,28 @@ void SqlWriter::write_nts_(
     }
     catch (const FullFileException& e)
     {
-        sqlite3_finalize(statement);
-
         EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
         throw e;
     }
     catch (const utils::InconsistencyException& e)
     {
-        sqlite3_finalize(statement);
-
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
         throw e;
     }
 
     // Execute the SQL statement
-    const auto step_ret = sqlite3_step(statement);
+    const auto step_ret = sqlite3_step(insert_topic_statement_);
 
     if (step_ret != SQLITE_DONE)
     {
         const std::string error_msg = utils::Formatter() << "Failed to write topic to SQL database: "
                                                          << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement);
 
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
         throw utils::InconsistencyException(error_msg);
     }
-    // Finalize the SQL statement
-    sqlite3_finalize(statement);
+
+    topic_ids_[topic.topic_name()][topic.type_name] = sqlite3_last_insert_rowid(database_);
 }
 
 // (Tables: Partitions)
@@ -676,6 +875,12 @@ void SqlWriter::write_nts_(
         return;
     }
 
+    // The partition set is written once per file, either when it is discovered or with its first message
+    if (written_partitions_.count(partition_set) > 0)
+    {
+        return;
+    }
+
     EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER, "Writing Partition set \"" << partition_set << "\".");
 
     // Define the SQL statement
@@ -685,21 +890,11 @@ void SqlWriter::write_nts_(
         VALUES (?);
     )";
 
-    // Prepare the SQL statement
-    sqlite3_stmt* statement;
-    const auto prep_ret = sqlite3_prepare_v2(database_, insert_statement, -1, &statement, nullptr);
-
-    if (prep_ret != SQLITE_OK)
-    {
-        const std::string error_msg = utils::Formatter() << "Failed to prepare SQL statement to write Partition set: "
-                                                         << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement);
-
-        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
-        throw utils::InconsistencyException(error_msg);
-    }
+    // Prepare the SQL statement (only the first time since the file was opened)
+    prepare_statement_nts_(insert_partition_statement_, insert_statement, "write Partition set");
+    const StatementReset statement_reset(insert_partition_statement_);
 
-    sqlite3_bind_text(statement, 1, partition_set.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(insert_partition_statement_, 1, partition_set.c_str(), -1, SQLITE_STATIC);
 
     // Calculate the estimated size of this entry
     size_t entry_size = 0;
@@ -712,34 +907,28 @@ void SqlWriter::write_nts_(
     }
     catch (const FullFileException& e)
     {
-        sqlite3_finalize(statement);
-
         EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
         throw e;
     }
     catch (const utils::InconsistencyException& e)
     {
-        sqlite3_finalize(statement);
-
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
         throw e;
     }
 
     // Execute the SQL statement
-    const auto step_ret = sqlite3_step(statement);
+    const auto step_ret = sqlite3_step(insert_partition_statement_);
 
     if (step_ret != SQLITE_DONE)
     {
         const std::string error_msg = utils::Formatter() << "Failed to write Partition set to SQL database: "
                                                          << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement);
 
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
         throw utils::InconsistencyException(error_msg);
     }
 
-    // Finalize the SQL statement
-    sqlite3_finalize(statement);
+    written_partitions_.insert(partition_set);
 }
 
 // (Tables: TopicsPartitions)
@@ -754,6 +943,15 @@ void SqlWriter::write_nts_(
         return;
     }
 
+    // The partitions of the topic are written once per file, either when they are discovered or with their first
+    // message
+    const auto topic_partition_key = std::make_tuple(topic_name, topic_type, topic_partition);
+
+    if (written_topic_partitions_.count(topic_partition_key) > 0)
+    {
+        return;
+    }
+
     EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER, "Writing Partitions of topic: " << topic_name
                                                                               << ", with type: " << topic_type << ".");
 
@@ -764,24 +962,13 @@ void SqlWriter::write_nts_(
         VALUES (?, ?, ?);
     )";
 
-    // Prepare the SQL statement
-    sqlite3_stmt* statement;
-    const auto prep_ret = sqlite3_prepare_v2(database_, insert_statement, -1, &statement, nullptr);
+    // Prepare the SQL statement (only the first time since the file was opened)
+    prepare_statement_nts_(insert_topic_partition_statement_, insert_statement, "write topic partition");
+    const StatementReset statement_reset(insert_topic_partition_statement_);
 
-    if (prep_ret != SQLITE_OK)
-    {
-        const std::string error_msg = utils::Formatter() << "Failed to prepare SQL statement to write topic: "
-                                                         << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement);
-
-        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
-        throw utils::InconsistencyException(error_msg);
-    }
-
-
-    sqlite3_bind_text(statement, 1, topic_name.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(statement, 2, topic_type.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(statement, 3, topic_partition.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(insert_topic_partition_statement_, 1, topic_name.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(insert_topic_partition_statement_, 2, topic_type.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(insert_topic_partition_statement_, 3, topic_partition.c_str(), -1, SQLITE_STATIC);
 
     // Calculate the estimated size of this entry
     size_t entry_size = 0;
@@ -796,34 +983,44 @@ void SqlWriter::write_nts_(
     }
     catch (const FullFileException& e)
     {
-        sqlite3_finalize(statement);
-
         EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
         throw e;
     }
     catch (const utils::InconsistencyException& e)
     {
-        sqlite3_finalize(statement);
-
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
         throw e;
     }
 
     // Execute the SQL statement
-    const auto step_ret = sqlite3_step(statement);
+    const auto step_ret = sqlite3_step(insert_topic_partition_statement_);
 
     if (step_ret != SQLITE_DONE)
     {
         const std::string error_msg = utils::Formatter() << "Failed to write partition topic to SQL database: "
                                                          << sqlite3_errmsg(database_);
-        sqlite3_finalize(statement);
 
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
         throw utils::InconsistencyException(error_msg);
     }
-    // Finalize the SQL statement
-    sqlite3_finalize(statement);
 
+    written_topic_partitions_.insert(topic_partition_key);
+}
+
+// (Tables: Partitions and TopicsPartitions)
+void SqlWriter::write_partitions_nts_(
+        const ddspipe::core::types::DdsTopic& topic,
+        const std::string& writer_guid)
+{
+    const auto partition_it = topic.partition_name.find(writer_guid);
+
+    if (partition_it == topic.partition_name.end())
+    {
+        return;
+    }
+
+    write_nts_(partition_it->second);
+    write_nts_(topic.m_topic_name, topic.type_name, partition_it->second);
 }
 
 // (Tables: TopicsPartitions) Function Call
@@ -845,6 +1042,9 @@ void SqlWriter::write_partition(
         try
         {
             on_file_full_nts_(e, MIN_SQL_SIZE);
+
+            // Write the data that did not fit in the full file to the new one
+            write_nts_(topic_name, topic_type, topic_partition);
         }
         catch (const FullDiskException& e)
         {
@@ -852,6 +1052,11 @@ void SqlWriter::write_partition(
                     "FAIL_SQL_WRITE | Disk is full. Error message:\n " << e.what());
             on_disk_full_();
         }
+        catch (const FullFileException& e)
+        {
+            EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_HANDLER,
+                    "FAIL_SQL_WRITE | The data does not fit in a new SQL file. Error message:\n " << e.what());
+        }
     }
 }
 
@@ -867,26 +1072,506 @@ void SqlWriter::close_current_file_nts_()
         }
     }
 
-    // Checkpoint any remaining data in the WAL file
-    sqlite3_wal_checkpoint_v2(database_, nullptr, SQLITE_CHECKPOINT_FULL, nullptr, nullptr);
+    if (configuration_.resource_limits.max_file_duration_ == 0)
+    {
+        // Checkpoint any remaining data in the WAL file
+        sqlite3_wal_checkpoint_v2(database_, nullptr, SQLITE_CHECKPOINT_FULL, nullptr, nullptr);
+
+        file_tracker_->set_current_file_size(written_sql_size_);
+
+        // The statements belong to the database, so they cannot outlive it
+        finalize_statements_nts_();
+
+        sqlite3_close(database_);
+        file_tracker_->close_file();
+        return;
+    }
 
     file_tracker_->set_current_file_size(written_sql_size_);
 
-    sqlite3_close(database_);
-    file_tracker_->close_file();
+    // The statements belong to the database, so they cannot outlive it
+    finalize_statements_nts_();
+
+    const auto file = file_tracker_->detach_file();
+    sqlite3* database = database_;
+    database_ = nullptr;
+
+    // Checkpoint the WAL file, write the time range of the shard to the catalog and close it while the next shard is
+    // written
+    post_rotation_task_([this, database, file, shard_name = std::move(shard_name_)]()
+            {
+                sqlite3_wal_checkpoint_v2(database, nullptr, SQLITE_CHECKPOINT_FULL, nullptr, nullptr);
+
+                close_shard_in_catalog_(database, shard_name);
+
+                sqlite3_close(database);
+
+                if (!file.name.empty())
+                {
+                    file_tracker_->finish_file(file);
+                }
+            });
+
+    shard_name_.clear();
+}
+
+void SqlWriter::split_file_nts_()
+{
+    EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER,
+            "SQL_WRITE | The SQL file has been open for " << configuration_.resource_limits.max_file_duration_ <<
+            " seconds. Opening a new one.");
+
+    close_current_file_nts_();
+
+    // Disable the writer in case opening a new file fails
+    enabled_ = false;
+
+    try
+    {
+        open_new_file_nts_(MIN_SQL_SIZE);
+    }
+    catch (const FullDiskException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER,
+                "FAIL_SQL_WRITE | Disk is full. Error message:\n " << e.what());
+        on_disk_full_();
+        return;
+    }
+
+    enabled_ = true;
+}
+
+sqlite3* SqlWriter::open_catalog_() const
+{
+    const auto catalog_path = configuration_.filepath + "/" + configuration_.filename + SQL_CATALOG_SUFFIX +
+            configuration_.extension;
+
+    sqlite3* catalog = nullptr;
+
+    if (sqlite3_open(catalog_path.c_str(), &catalog) != SQLITE_OK)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER,
+                "FAIL_SQL_CATALOG | Failed to open SQL catalog " << catalog_path << ": " << sqlite3_errmsg(catalog));
+        sqlite3_close(catalog);
+        return nullptr;
+    }
+
+    // Create Shards table
+    // NOTE: The time range of a shard (log time of its first and last messages) is only set when it is closed
+    const char* create_shards_table =
+            R"(
+        CREATE TABLE IF NOT EXISTS Shards (
+            name TEXT PRIMARY KEY NOT NULL,
+            begin_time INTEGER,
+            end_time INTEGER
+        );
+    )";
+
+    if (sqlite3_exec(catalog, create_shards_table, nullptr, nullptr, nullptr) != SQLITE_OK)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER,
+                "FAIL_SQL_CATALOG | Failed to create Shards table: " << sqlite3_errmsg(catalog));
+        sqlite3_close(catalog);
+        return nullptr;
+    }
+
+    const std::string pragma_cmd = "PRAGMA user_version = " + std::to_string(SQL_SCHEMA_VERSION) + ";";
+    sqlite3_exec(catalog, pragma_cmd.c_str(), nullptr, nullptr, nullptr);
+
+    return catalog;
+}
+
+void SqlWriter::add_shard_to_catalog_(
+        const std::string& shard_name) const
+{
+    sqlite3* catalog = open_catalog_();
+
+    if (catalog == nullptr)
+    {
+        return;
+    }
+
+    // Forget the shards removed by the log rotation
+    std::vector<std::string> removed_shards;
+
+    exec_catalog_statement(catalog, "SELECT name FROM Shards;", {}, [&](sqlite3_stmt* stmt)
+            {
+                const std::string name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+
+                if (!std::filesystem::exists(std::filesystem::path(configuration_.filepath) / name))
+                {
+                    removed_shards.push_back(name);
+                }
+            });
+
+    for (const auto& name : removed_shards)
+    {
+        exec_catalog_statement(catalog, "DELETE FROM Shards WHERE name = ?;", {name});
+    }
+
+    exec_catalog_statement(catalog, "INSERT OR REPLACE INTO Shards (name) VALUES (?);", {shard_name});
+
+    sqlite3_close(catalog);
+}
+
+void SqlWriter::close_shard_in_catalog_(
+        sqlite3* shard,
+        const std::string& shard_name) const
+{
+    if (shard_name.empty())
+    {
+        return;
+    }
+
+    // Read the time range of the shard
+    // NOTE: The subqueries look the bounds up in the index of the messages by log time, instead of scanning the table
+    const char* select_range_statement =
+            "SELECT (SELECT MIN(log_time) FROM MessagesData), (SELECT MAX(log_time) FROM MessagesData);";
+
+    bool empty = true;
+    std::string begin_time;
+    std::string end_time;
+
+    exec_catalog_statement(shard, select_range_statement, {}, [&](sqlite3_stmt* stmt)
+            {
+                empty = sqlite3_column_type(stmt, 0) == SQLITE_NULL;
+
+                if (!empty)
+                {
+                    begin_time = std::to_string(sqlite3_column_int64(stmt, 0));
+                    end_time = std::to_string(sqlite3_column_int64(stmt, 1));
+                }
+            });
+
+    sqlite3* catalog = open_catalog_();
+
+    if (catalog != nullptr)
+    {
+        if (empty)
+        {
+            // A shard without messages has nothing to replay
+            exec_catalog_statement(catalog, "DELETE FROM Shards WHERE name = ?;", {shard_name});
+        }
+        else
+        {
+            exec_catalog_statement(catalog, "UPDATE Shards SET begin_time = ?, end_time = ? WHERE name = ?;",
+                    {begin_time, end_time, shard_name});
+        }
+
+        sqlite3_close(catalog);
+    }
+}
+
+void SqlWriter::prepare_next_file_nts_()
+{
+    next_file_requested_ = true;
+
+    const auto filename = file_tracker_->reserve_next_filename();
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER,
+            "SQL_WRITE | Preparing the next SQL shard " << filename << ".");
+
+    post_rotation_task_([this, filename]()
+            {
+                sqlite3* database = nullptr;
+                std::uint64_t page_size = 0;
+
+                try
+                {
+                    open_database_(filename, database, page_size);
+                }
+                catch (const utils::InitializationException& e)
+                {
+                    EPROSIMA_LOG_WARNING(DDSRECORDER_SQL_WRITER,
+                            "SQL_WRITE | Failed to prepare the next SQL shard " << filename << ": " << e.what() <<
+                            ". It will be opened when the current shard is closed.");
+
+                    database = nullptr;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(rotation_mutex_);
+
+                    next_database_ = database;
+                    next_page_size_ = page_size;
+                    next_filename_ = filename;
+                    next_file_prepared_ = true;
+                }
+
+                rotation_cv_.notify_all();
+            });
+}
+
+sqlite3* SqlWriter::take_next_database_nts_(
+        const std::string& filename,
+        std::uint64_t& page_size)
+{
+    std::string next_filename;
+    auto database = wait_next_database_nts_(next_filename, page_size);
+
+    if (database == nullptr || next_filename == filename)
+    {
+        return database;
+    }
+
+    EPROSIMA_LOG_WARNING(DDSRECORDER_SQL_WRITER,
+            "SQL_WRITE | The next SQL shard was prepared as " << next_filename << " but is " << filename << ". "
+            "Opening it again.");
+
+    sqlite3_close(database);
+    std::filesystem::remove(next_filename);
+
+    return nullptr;
+}
+
+void SqlWriter::discard_next_file_nts_()
+{
+    if (!next_file_requested_)
+    {
+        return;
+    }
+
+    std::string next_filename;
+    std::uint64_t page_size;
+    auto database = wait_next_database_nts_(next_filename, page_size);
+
+    file_tracker_->release_next_filename();
+
+    if (database != nullptr)
+    {
+        sqlite3_close(database);
+        std::filesystem::remove(next_filename);
+    }
+}
+
+sqlite3* SqlWriter::wait_next_database_nts_(
+        std::string& filename,
+        std::uint64_t& page_size)
+{
+    if (!next_file_requested_)
+    {
+        return nullptr;
+    }
+
+    next_file_requested_ = false;
+
+    std::unique_lock<std::mutex> lock(rotation_mutex_);
+
+    // NOTE: The shard is prepared as soon as the previous one is opened, so this wait is normally instantaneous.
+    rotation_cv_.wait(lock, [&]()
+            {
+                return next_file_prepared_;
+            });
+
+    next_file_prepared_ = false;
+    filename = std::move(next_filename_);
+    next_filename_.clear();
+    page_size = next_page_size_;
+
+    auto database = next_database_;
+    next_database_ = nullptr;
+
+    return database;
+}
+
+void SqlWriter::post_rotation_task_(
+        std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(rotation_mutex_);
+        rotation_tasks_.push_back(std::move(task));
+    }
+
+    rotation_cv_.notify_all();
+}
+
+void SqlWriter::wait_rotation_tasks_()
+{
+    std::unique_lock<std::mutex> lock(rotation_mutex_);
+
+    rotation_cv_.wait(lock, [&]()
+            {
+                return rotation_tasks_.empty() && !rotation_busy_;
+            });
+}
+
+void SqlWriter::rotation_thread_routine_()
+{
+    std::unique_lock<std::mutex> lock(rotation_mutex_);
+
+    while (true)
+    {
+        rotation_cv_.wait(lock, [&]()
+                {
+                    return rotation_stop_ || !rotation_tasks_.empty();
+                });
+
+        if (rotation_tasks_.empty())
+        {
+            // Stopped with no tasks left
+            return;
+        }
+
+        auto task = std::move(rotation_tasks_.front());
+        rotation_tasks_.pop_front();
+        rotation_busy_ = true;
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        rotation_busy_ = false;
+        rotation_cv_.notify_all();
+    }
+}
+
+void SqlWriter::prepare_statement_nts_(
+        sqlite3_stmt*& statement,
+        const char* query,
+        const std::string& description)
+{
+    if (statement != nullptr)
+    {
+        return;
+    }
+
+    if (sqlite3_prepare_v2(database_, query, -1, &statement, nullptr) != SQLITE_OK)
+    {
+        const std::string error_msg = utils::Formatter() << "Failed to prepare SQL statement to " << description
+                                                         << ": " << sqlite3_errmsg(database_);
+        sqlite3_finalize(statement);
+        statement = nullptr;
+
+        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_PREPARE | " << error_msg);
+        throw utils::InconsistencyException(error_msg);
+    }
+}
+
+void SqlWriter::finalize_statements_nts_()
+{
+    for (auto* statement : {
+                &insert_type_statement_,
+                &insert_topic_statement_,
+                &insert_writer_statement_,
+                &insert_partition_statement_,
+                &insert_topic_partition_statement_,
+                &insert_message_statement_,
+                &insert_message_partition_statement_,
+                &select_oldest_statement_,
+                &delete_message_partition_statement_,
+                &delete_message_statement_})
+    {
+        // NOTE: Finalizing a nullptr is a harmless no-op
+        sqlite3_finalize(*statement);
+        *statement = nullptr;
+    }
+}
+
+const std::int64_t* SqlWriter::find_topic_id_nts_(
+        const ddspipe::core::types::DdsTopic& topic) const
+{
+    const auto topic_it = topic_ids_.find(topic.topic_name());
+
+    if (topic_it == topic_ids_.end())
+    {
+        return nullptr;
+    }
+
+    const auto type_it = topic_it->second.find(topic.type_name);
+
+    return type_it == topic_it->second.end() ? nullptr : &type_it->second;
+}
+
+std::int64_t SqlWriter::get_topic_id_nts_(
+        const ddspipe::core::types::DdsTopic& topic)
+{
+    const auto* topic_id = find_topic_id_nts_(topic);
+
+    if (topic_id == nullptr)
+    {
+        // The topic has not been written in this file yet (e.g. it was discovered while a previous file was open)
+        write_nts_(topic);
+        topic_id = find_topic_id_nts_(topic);
+    }
+
+    return *topic_id;
+}
+
+std::int64_t SqlWriter::get_writer_id_nts_(
+        const std::string& writer_guid)
+{
+    const auto writer_it = writer_ids_.find(writer_guid);
+
+    if (writer_it != writer_ids_.end())
+    {
+        return writer_it->second;
+    }
+
+    EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER, "Writing writer " << writer_guid << ".");
+
+    // Define the SQL statement
+    const char* insert_statement =
+            R"(
+        INSERT INTO Writers (guid)
+        VALUES (?);
+    )";
+
+    // Prepare the SQL statement (only the first time since the file was opened)
+    prepare_statement_nts_(insert_writer_statement_, insert_statement, "write writer");
+    const StatementReset statement_reset(insert_writer_statement_);
+
+    // Bind the writer to the SQL statement
+    sqlite3_bind_text(insert_writer_statement_, 1, writer_guid.c_str(), -1, SQLITE_STATIC);
+
+    // Calculate the estimated size of this entry (the guid is stored both in the table and in its unique index)
+    const auto entry_size = 2 * writer_guid.size() +
+            2 * calculate_int_storage_size(static_cast<std::int64_t>(writer_ids_.size() + 1));
+
+    try
+    {
+        size_control_(entry_size, false);
+    }
+    catch (const FullFileException& e)
+    {
+        EPROSIMA_LOG_INFO(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
+        throw e;
+    }
+    catch (const utils::InconsistencyException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << e.what());
+        throw e;
+    }
+
+    // Execute the SQL statement
+    const auto step_ret = sqlite3_step(insert_writer_statement_);
+
+    if (step_ret != SQLITE_DONE)
+    {
+        const std::string error_msg = utils::Formatter() << "Failed to write writer to SQL database: "
+                                                         << sqlite3_errmsg(database_);
+
+        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_WRITE | " << error_msg);
+        throw utils::InconsistencyException(error_msg);
+    }
+
+    const auto writer_id = sqlite3_last_insert_rowid(database_);
+    writer_ids_[writer_guid] = writer_id;
+
+    return writer_id;
 }
 
 void SqlWriter::create_sql_table_(
+        sqlite3* database,
         const std::string& table_name,
-        const std::string& table_definition)
+        const std::string& table_definition) const
 {
-    const auto ret = sqlite3_exec(database_, table_definition.c_str(), nullptr, nullptr, nullptr);
+    const auto ret = sqlite3_exec(database, table_definition.c_str(), nullptr, nullptr, nullptr);
 
     if (ret != SQLITE_OK)
     {
         const std::string error_msg = utils::Formatter() << "Failed to create " << table_name << " table: "
-                                                         << sqlite3_errmsg(database_);
-        close_current_file_nts_();
+                                                         << sqlite3_errmsg(database);
+        sqlite3_close(database);
 
         EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_OPEN | " << error_msg);
         throw utils::InitializationException(error_msg);
@@ -896,91 +1581,93 @@ void SqlWriter::create_sql_table_(
 std::uint64_t SqlWriter::remove_oldest_entries_(
         const std::uint64_t size_required)
 {
-    std::uint64_t freed_size = 0;
+    // SQL query to select the oldest messages with their sizes
+    // NOTE: The messages are inserted in the order they are received and the oldest ones are removed first, so their
+    //       rowids grow with their log time and the rowid B-tree is walked in order without sorting the table
+    const char* select_oldest_statement =
+            R"(
+        SELECT rowid, LENGTH(writer_id), LENGTH(sequence_number), LENGTH(data_json),
+               LENGTH(data_cdr), data_cdr_size, LENGTH(topic_id),
+               LENGTH(key), LENGTH(log_time), LENGTH(publish_time)
+        FROM MessagesData
+        ORDER BY rowid ASC;
+    )";
 
-    while (freed_size < size_required)
-    {
-        // SQL query to select the oldest message based on publish_time
-        const char* select_oldest_statement =
-                R"(
-            SELECT rowid, LENGTH(writer_guid), LENGTH(sequence_number), LENGTH(data_json),
-                   LENGTH(data_cdr), data_cdr_size, LENGTH(topic), LENGTH(type),
-                   LENGTH(key), LENGTH(log_time), LENGTH(publish_time)
-            FROM Messages
-            ORDER BY publish_time ASC
-            LIMIT 1;
-        )";
-
-        sqlite3_stmt* select_stmt;
-        if (sqlite3_prepare_v2(database_, select_oldest_statement, -1, &select_stmt, nullptr) != SQLITE_OK)
-        {
-            // Failed to prepare select statement
-            const std::string error_msg = utils::Formatter() << "Failed to prepare SQL select statement to free space: "
-                                                             << sqlite3_errmsg(database_);
-            sqlite3_finalize(select_stmt);
+    // SQL queries to delete the oldest messages (and their partitions) up to a rowid
+    const char* delete_partitions_statement =
+            R"(
+        DELETE FROM MessagesPartitionsData
+        WHERE (writer_id, sequence_number) IN (SELECT writer_id, sequence_number FROM MessagesData WHERE rowid <= ?);
+    )";
+    const char* delete_statement = "DELETE FROM MessagesData WHERE rowid <= ?;";
 
-            EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_REMOVE | " << error_msg);
-            throw utils::InconsistencyException(error_msg);
-        }
+    // Prepare the SQL statements (only the first time since the file was opened)
+    try
+    {
+        prepare_statement_nts_(select_oldest_statement_, select_oldest_statement, "select messages to free space");
+        prepare_statement_nts_(delete_message_partition_statement_, delete_partitions_statement,
+                "delete message partitions to free space");
+        prepare_statement_nts_(delete_message_statement_, delete_statement, "delete messages to free space");
+    }
+    catch (const utils::InconsistencyException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_REMOVE | " << e.what());
+        throw e;
+    }
+
+    // Find the newest message to remove, adding up the sizes of the oldest ones until enough space would be freed
+    std::uint64_t freed_size = 0;
+    std::int64_t last_rowid = 0;
+
+    {
+        const StatementReset select_reset(select_oldest_statement_);
 
-        // Fetch the oldest entry's size
-        if (sqlite3_step(select_stmt) == SQLITE_ROW)
+        while (freed_size < size_required && sqlite3_step(select_oldest_statement_) == SQLITE_ROW)
         {
-            // Calculate the size of the row data in bytes
-            size_t entry_size = 0;
-            for (int i = 1; i <= 10; ++i) // Skipping rowid (index 0) and summing lengths of columns
+            last_rowid = sqlite3_column_int64(select_oldest_statement_, 0);
+
+            for (int i = 1; i <= 9; ++i) // Skipping rowid (index 0) and summing lengths of columns
             {
-                entry_size += sqlite3_column_int(select_stmt, i);
+                freed_size += static_cast<std::uint64_t>(sqlite3_column_int64(select_oldest_statement_, i));
             }
+        }
+    }
 
-            // Get the rowid of the entry to delete
-            int rowid = sqlite3_column_int(select_stmt, 0);
+    if (freed_size < size_required)
+    {
+        // No more rows to delete, unable to free enough space
+        EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_REMOVE | No more rows to delete.");
+        throw FullFileException("SQL file is full and not removable.", size_required);
+    }
 
-            // Prepare delete statement
-            const char* delete_statement = "DELETE FROM Messages WHERE rowid = ?;";
-            sqlite3_stmt* delete_stmt;
-            if (sqlite3_prepare_v2(database_, delete_statement, -1, &delete_stmt, nullptr) != SQLITE_OK)
-            {
-                sqlite3_finalize(delete_stmt);
-                sqlite3_finalize(select_stmt);
-                return 0; // Failed to prepare delete statement
-            }
+    // Delete the messages in a single range, within a savepoint so that it also works inside the transaction of the
+    // messages being written
+    sqlite3_exec(database_, "SAVEPOINT remove_oldest_entries;", nullptr, nullptr, nullptr);
 
-            // Bind the rowid to the delete statement
-            sqlite3_bind_int(delete_stmt, 1, rowid);
+    for (auto* statement : {delete_message_partition_statement_, delete_message_statement_})
+    {
+        const StatementReset delete_reset(statement);
 
-            // Execute delete statement
-            if (sqlite3_step(delete_stmt) == SQLITE_DONE)
-            {
-                freed_size += static_cast<std::uint64_t>(entry_size); // Update the freed size
-            }
+        sqlite3_bind_int64(statement, 1, last_rowid);
 
-            sqlite3_finalize(delete_stmt);
-        }
-        else
+        if (sqlite3_step(statement) != SQLITE_DONE)
         {
-            sqlite3_finalize(select_stmt);
+            const std::string error_msg = utils::Formatter() << "Failed to remove the oldest messages: "
+                                                             << sqlite3_errmsg(database_);
+            sqlite3_exec(database_, "ROLLBACK TO remove_oldest_entries; RELEASE remove_oldest_entries;", nullptr,
+                    nullptr, nullptr);
 
-            // No more rows to delete, unable to free enough space
-            EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_REMOVE | No more rows to delete.");
-            throw FullFileException("SQL file is full and not removable.", size_required);
+            EPROSIMA_LOG_ERROR(DDSRECORDER_SQL_WRITER, "FAIL_SQL_REMOVE | " << error_msg);
+            throw utils::InconsistencyException(error_msg);
         }
-
-        // Reclaim 10 pages after freeing space, adjustable based on observation
-        sqlite3_exec(database_, "PRAGMA incremental_vacuum = 10;", nullptr, nullptr, nullptr);
-
-        sqlite3_finalize(select_stmt);
     }
 
-    // Vacuum as many pages as the freed size in bytes
-    int pages_to_reclaim = size_required / page_size_;
-    if (pages_to_reclaim > 0)
-    {
-        sqlite3_exec(database_, ("PRAGMA incremental_vacuum = " + std::to_string(
-                    pages_to_reclaim) + ";").c_str(), nullptr, nullptr, nullptr);
-    }
+    sqlite3_exec(database_, "RELEASE remove_oldest_entries;", nullptr, nullptr, nullptr);
+
+    // Reclaim the pages freed by the removed messages at once
+    sqlite3_exec(database_, "PRAGMA incremental_vacuum;", nullptr, nullptr, nullptr);
 
-    return(freed_size);
+    return freed_size;
 }
 
 size_t SqlWriter::calculate_int_storage_size(
@@ -1025,7 +1712,8 @@ void SqlWriter::size_control_(
     {
         bool free_space = false;
         // Free space in case of file rotation
-        if (configuration_.resource_limits.file_rotation_)
+        // NOTE: The shards split by duration are rotated as whole files by the FileTracker when a new one is opened
+        if (configuration_.resource_limits.file_rotation_ && configuration_.resource_limits.max_file_duration_ == 0)
         {
             try
             {
@@ -48,10 +48,10 @@ BaseMessage::BaseMessage(
 BaseMessage::BaseMessage(
         const ddspipe::core::types::RtpsPayloadData& data,
         std::shared_ptr<ddspipe::core::PayloadPool> payload_pool,
-        const ddspipe::core::types::DdsTopic& topic)
+        std::shared_ptr<const ddspipe::core::types::DdsTopic> topic)
     : BaseMessage(data.payload, payload_pool.get())
 {
-    this->topic = topic;
+    this->topic = std::move(topic);
     ddspipe::core::types::DataTime::now(log_time);
     publish_time = data.source_timestamp;
 }
@@ -84,6 +84,32 @@ std::uint32_t BaseMessage::get_data_cdr_size() const
     return payload.length;
 }
 
+std::shared_ptr<const BaseMessage> BaseMessage::copy_with_payload(
+        const ddspipe::core::types::Payload& payload) const
+{
+    auto message = std::make_shared<BaseMessage>();
+    message->copy_from_(*this, payload);
+
+    return message;
+}
+
+void BaseMessage::copy_from_(
+        const BaseMessage& msg,
+        const ddspipe::core::types::Payload& payload)
+{
+    payload_owner = msg.payload_owner;
+    topic = msg.topic;
+    log_time = msg.log_time;
+    publish_time = msg.publish_time;
+
+    if (payload.length > 0)
+    {
+        payload_owner->get_payload(
+            payload,
+            this->payload);
+    }
+}
+
 } /* namespace participants */
 } /* namespace ddsrecorder */
 } /* namespace eprosima */
@@ -29,14 +29,15 @@ std::atomic<std::uint32_t> McapMessage::number_of_msgs = 0;
 McapMessage::McapMessage(
         const ddspipe::core::types::RtpsPayloadData& data,
         std::shared_ptr<ddspipe::core::PayloadPool> payload_pool,
-        const ddspipe::core::types::DdsTopic& topic,
+        std::shared_ptr<const ddspipe::core::types::DdsTopic> topic,
         const mcap::ChannelId channel_id,
         const bool log_publish_time)
-    : BaseMessage(data, payload_pool, topic)
+    : BaseMessage(data, payload_pool, std::move(topic))
     , mcap::Message()
 {
     sequence = number_of_msgs.fetch_add(1);
     channelId = channel_id;
+    source_guid = data.source_guid;
 
     this->data = get_data_cdr();
     dataSize = get_data_cdr_size();
@@ -52,6 +53,21 @@ McapMessage::McapMessage(
     }
 }
 
+std::shared_ptr<const BaseMessage> McapMessage::copy_with_payload(
+        const ddspipe::core::types::Payload& payload) const
+{
+    auto message = std::make_shared<McapMessage>();
+    message->copy_from_(*this, payload);
+
+    static_cast<mcap::Message&>(*message) = static_cast<const mcap::Message&>(*this);
+    message->source_guid = source_guid;
+
+    // Point to the payload of the copy
+    message->data = message->get_data_cdr();
+
+    return message;
+}
+
 } /* namespace participants */
 } /* namespace ddsrecorder */
 } /* namespace eprosima */
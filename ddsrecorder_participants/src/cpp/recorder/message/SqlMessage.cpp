@@ -87,9 +87,9 @@ std::atomic<std::uint64_t> SqlMessage::number_of_msgs = 0;
 SqlMessage::SqlMessage(
         const ddspipe::core::types::RtpsPayloadData& payload,
         std::shared_ptr<ddspipe::core::PayloadPool> payload_pool,
-        const ddspipe::core::types::DdsTopic& topic,
+        std::shared_ptr<const ddspipe::core::types::DdsTopic> topic,
         const std::string& key /* = "" */)
-    : BaseMessage(payload, payload_pool, topic)
+    : BaseMessage(payload, payload_pool, std::move(topic))
     , writer_guid(payload.source_guid)
     , sequence_number(fastdds::rtps::SequenceNumber_t(number_of_msgs.fetch_add(1)))
     , instance_handle(payload.instanceHandle)
@@ -97,6 +97,23 @@ SqlMessage::SqlMessage(
 {
 }
 
+std::shared_ptr<const BaseMessage> SqlMessage::copy_with_payload(
+        const ddspipe::core::types::Payload& payload) const
+{
+    auto message = std::make_shared<SqlMessage>();
+    message->copy_from_(*this, payload);
+
+    message->writer_guid = writer_guid;
+    message->writer_guid_string = writer_guid_string;
+    message->sequence_number = sequence_number;
+    message->instance_handle = instance_handle;
+    message->data_json = data_json;
+    message->key = key;
+    message->partition = partition;
+
+    return message;
+}
+
 void SqlMessage::deserialize(
         const fastdds::dds::DynamicType::_ref_type& dynamic_type)
 {
@@ -0,0 +1,51 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TopicRegistry.cpp
+ */
+
+#include <ddsrecorder_participants/recorder/message/TopicRegistry.hpp>
+
+namespace eprosima {
+namespace ddsrecorder {
+namespace participants {
+
+std::shared_ptr<const ddspipe::core::types::DdsTopic> TopicRegistry::intern(
+        const ddspipe::core::types::DdsTopic& topic)
+{
+    // NOTE: lookups do not allocate, the names are only copied when registering a new topic
+    auto topics_by_type = topics_.find(topic.m_topic_name);
+
+    if (topics_by_type == topics_.end())
+    {
+        topics_by_type = topics_.emplace(topic.m_topic_name, decltype(topics_)::mapped_type{}).first;
+    }
+
+    auto& registered_topic = topics_by_type->second[topic.type_name];
+
+    // The partitions of a topic are updated as its writers are discovered
+    if (!registered_topic ||
+            registered_topic->partition_name != topic.partition_name ||
+            !(registered_topic->topic_qos == topic.topic_qos))
+    {
+        registered_topic = std::make_shared<const ddspipe::core::types::DdsTopic>(topic);
+    }
+
+    return registered_topic;
+}
+
+} /* namespace participants */
+} /* namespace ddsrecorder */
+} /* namespace eprosima */
@@ -104,11 +104,16 @@ void DdsRecorderStatusMonitorProducer::clear_data()
     error_status_.qos_mismatch(false);
     ddsrecorder_error_status_.mcap_file_creation_failure(false);
     ddsrecorder_error_status_.disk_full(false);
+    ddsrecorder_error_status_.buffer_memory_full(false);
     has_errors_ = false;
+    key_cache_hits_ = 0;
+    key_cache_misses_ = 0;
 
     data_.error_status(error_status_);
     data_.ddsrecorder_error_status(ddsrecorder_error_status_);
     data_.has_errors(has_errors_);
+    data_.key_cache_hits(key_cache_hits_);
+    data_.key_cache_misses(key_cache_misses_);
 }
 
 void DdsRecorderStatusMonitorProducer::add_error_to_status(
@@ -143,10 +148,43 @@ void DdsRecorderStatusMonitorProducer::add_error_to_status(
     {
         ddsrecorder_error_status_.disk_full(true);
     }
+    else if (error == "BUFFER_MEMORY_FULL")
+    {
+        ddsrecorder_error_status_.buffer_memory_full(true);
+    }
 
     has_errors_  = true;
 }
 
+void DdsRecorderStatusMonitorProducer::add_key_cache_accesses_to_status(
+        std::uint64_t hits,
+        std::uint64_t misses)
+{
+    if (!enabled_)
+    {
+        // Don't save the data if the producer is not enabled
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    key_cache_hits_ += hits;
+    key_cache_misses_ += misses;
+}
+
+void DdsRecorderStatusMonitorProducer::report_key_cache_accesses(
+        std::uint64_t hits,
+        std::uint64_t misses)
+{
+    auto producer = dynamic_cast<DdsRecorderStatusMonitorProducer*>(
+        ddspipe::core::StatusMonitorProducer::get_instance());
+
+    if (producer != nullptr)
+    {
+        producer->add_key_cache_accesses_to_status(hits, misses);
+    }
+}
+
 void DdsRecorderStatusMonitorProducer::produce_nts_()
 {
     EPROSIMA_LOG_INFO(DDSRECORDER_MONITOR, "MONITOR | Producing DdsRecorderMonitoringStatus.");
@@ -154,6 +192,8 @@ void DdsRecorderStatusMonitorProducer::produce_nts_()
     data_.error_status(error_status_);
     data_.ddsrecorder_error_status(ddsrecorder_error_status_);
     data_.has_errors(has_errors_);
+    data_.key_cache_hits(key_cache_hits_);
+    data_.key_cache_misses(key_cache_misses_);
 }
 
 void DdsRecorderStatusMonitorProducer::consume_nts_()
@@ -203,6 +243,11 @@ std::ostream& operator <<(
         print_error("DISK_FULL");
     }
 
+    if (status.buffer_memory_full())
+    {
+        print_error("BUFFER_MEMORY_FULL");
+    }
+
     if (data.error_status().type_mismatch())
     {
         print_error("TYPE_MISMATCH");
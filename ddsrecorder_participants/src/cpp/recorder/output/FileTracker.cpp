@@ -16,6 +16,7 @@
  * @file FileTracker.cpp
  */
 
+#include <algorithm>
 #include <filesystem>
 #include <stdexcept>
 
@@ -54,7 +55,7 @@ FileTracker::~FileTracker()
 void FileTracker::new_file(
         const std::uint64_t min_file_size)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
 
     if (min_file_size > configuration_.resource_limits.max_file_size_)
     {
@@ -92,6 +93,17 @@ void FileTracker::new_file(
                       " to create a new file with a minimum file size of " + utils::from_bytes(min_file_size) + ".");
         }
 
+        // The oldest file cannot be removed until its output library is done with it
+        file_finished_cv_.wait(lock, [&]()
+                {
+                    return closed_files_.empty() || unfinished_files_.count(closed_files_.front().id) == 0;
+                });
+
+        if (closed_files_.empty())
+        {
+            continue;
+        }
+
         const auto oldest_file_size = remove_oldest_file_nts_();
 
         size_ -= oldest_file_size;
@@ -104,15 +116,18 @@ void FileTracker::new_file(
     // Generate the new file's ID
     const auto id = closed_files_.empty() ? 0 : closed_files_.back().id + 1;
 
-    // Generate the new file's name
-    const auto name = generate_filename_(id);
+    // Generate the new file's name (unless it was reserved, in which case its temporary file may already exist)
+    const bool reserved = !next_file_.name.empty() && next_file_.id == id;
+    const auto name = reserved ? next_file_.name : generate_filename_(id);
     const auto tmp_name = make_filename_tmp_(name);
 
+    next_file_ = File();
+
     if (std::filesystem::exists(name))
     {
         EPROSIMA_LOG_ERROR(DDSRECORDER_FILE_TRACKER, "File " + name + " already exists.");
     }
-    else if (std::filesystem::exists(tmp_name))
+    else if (!reserved && std::filesystem::exists(tmp_name))
     {
         EPROSIMA_LOG_ERROR(DDSRECORDER_FILE_TRACKER, "File " + tmp_name + " already exists.");
     }
@@ -122,6 +137,16 @@ void FileTracker::new_file(
 }
 
 void FileTracker::close_file() noexcept
+{
+    const auto file = detach_file();
+
+    if (!file.name.empty())
+    {
+        finish_file(file);
+    }
+}
+
+File FileTracker::detach_file() noexcept
 {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -130,7 +155,7 @@ void FileTracker::close_file() noexcept
     if (current_file_.name.empty())
     {
         EPROSIMA_LOG_WARNING(DDSRECORDER_FILE_TRACKER, "No file to close.");
-        return;
+        return File();
     }
 
     if (current_file_.size > configuration_.resource_limits.max_file_size_)
@@ -143,18 +168,82 @@ void FileTracker::close_file() noexcept
     // Save the current file as closed
     closed_files_.push_back(current_file_);
     size_ += current_file_.size;
+    unfinished_files_.insert(current_file_.id);
+
+    const auto file = current_file_;
+    current_file_ = File();
+
+    return file;
+}
+
+void FileTracker::finish_file(
+        const File& file) noexcept
+{
+    const auto tmp_name = make_filename_tmp_(file.name);
+
+    // The size the file was closed with may be an estimate (e.g. when closed in the background)
+    auto file_size = file.size;
 
     try
     {
-        std::filesystem::rename(get_current_filename(), current_file_.name);
+        std::filesystem::rename(tmp_name, file.name);
+        file_size = std::filesystem::file_size(file.name);
     }
     catch (const std::filesystem::filesystem_error& e)
     {
         EPROSIMA_LOG_ERROR(DDSRECORDER_FILE_TRACKER,
-                "Error renaming " + get_current_filename() + ": " << e.what());
+                "Error renaming " + tmp_name + ": " << e.what());
     }
 
-    current_file_ = File();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        unfinished_files_.erase(file.id);
+
+        // Account for the actual size of the file
+        const auto closed_file = std::find_if(closed_files_.begin(), closed_files_.end(), [&](const File& closed)
+                        {
+                            return closed.id == file.id;
+                        });
+
+        if (closed_file != closed_files_.end() && closed_file->size != file_size)
+        {
+            EPROSIMA_LOG_INFO(DDSRECORDER_FILE_TRACKER,
+                    "Closed " << closed_file->to_str() << " with an actual size of " << utils::from_bytes(file_size) <<
+                    ".");
+
+            size_ = size_ - closed_file->size + file_size;
+            closed_file->size = file_size;
+        }
+    }
+
+    file_finished_cv_.notify_all();
+}
+
+std::string FileTracker::reserve_next_filename() noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::uint64_t id = 0;
+
+    if (!current_file_.name.empty())
+    {
+        id = current_file_.id + 1;
+    }
+    else if (!closed_files_.empty())
+    {
+        id = closed_files_.back().id + 1;
+    }
+
+    next_file_ = {id, generate_filename_(id), 0};
+
+    return make_filename_tmp_(next_file_.name);
+}
+
+void FileTracker::release_next_filename() noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    next_file_ = File();
 }
 
 std::uint64_t FileTracker::get_total_size() const noexcept
@@ -240,7 +329,8 @@ std::string FileTracker::generate_filename_(
 
     filename += configuration_.filename;
 
-    if (configuration_.resource_limits.max_size_ > configuration_.resource_limits.max_file_size_)
+    if (configuration_.resource_limits.max_size_ > configuration_.resource_limits.max_file_size_ ||
+            configuration_.resource_limits.max_file_duration_ > 0)
     {
         // There may be multiple output files. Include the file's id to make the filename unique.
         // NOTE: Appending the timestamp doesn't make the filename unique, since multiple can be created simultaneously.
@@ -308,6 +308,20 @@ void McapReaderParticipant::process_summary(
         Serializer::deserialize<DynamicTypesCollection>(dynamic_types_str, types);
     }
 
+    // Get the zstd dictionaries from their attachments
+    const std::string dictionary_prefix = ZSTD_DICTIONARY_ATTACHMENT_PREFIX;
+
+    for (const auto& [attachment_name, attachment] : attachments)
+    {
+        if (attachment_name.compare(0, dictionary_prefix.size(), dictionary_prefix) != 0)
+        {
+            continue;
+        }
+
+        const std::string dictionary(reinterpret_cast<const char*>(attachment.data), attachment.dataSize);
+        dictionaries_[attachment_name.substr(dictionary_prefix.size())] = std::make_unique<ZstdDictionary>(dictionary);
+    }
+
     close_file_();
 }
 
@@ -346,19 +360,9 @@ void McapReaderParticipant::process_messages()
             continue;
         }
         const auto& topic = topic_it->second;
-        const std::string seq_num_str = std::to_string(it.message.sequence);
-        std::string writer_guid = "";
-        const auto source_guid_it = source_guid_by_sequence_.find(seq_num_str);
-        if (source_guid_it != source_guid_by_sequence_.end())
-        {
-            const auto writer_guid_it = sequence_by_source_guid_index_.find(source_guid_it->second);
-            if (writer_guid_it != sequence_by_source_guid_index_.end())
-            {
-                writer_guid = writer_guid_it->second;
-            }
-        }
-
-        if (filtered_writersguid_list_.find(writer_guid) != filtered_writersguid_list_.end())
+        if (!filtered_writersguid_list_.empty() &&
+                filtered_writersguid_list_.find(get_writer_guid_(it.message.sequence)) !=
+                filtered_writersguid_list_.end())
         {
             // current message do not pass the filter
             continue;
@@ -383,7 +387,12 @@ void McapReaderParticipant::process_messages()
                         std::chrono::duration_cast<std::chrono::nanoseconds>(delay / configuration_->rate));
 
         // Create RTPS data
-        auto data = create_payload_(it.message.data, it.message.dataSize);
+        auto data = create_message_payload_(it);
+
+        if (data == nullptr)
+        {
+            continue;
+        }
 
         // Rebuild a deterministic instance handle for keyed topics
         if (topic.topic_qos.keyed)
@@ -473,6 +482,37 @@ void McapReaderParticipant::process_messages()
     close_file_();
 }
 
+std::unique_ptr<ddspipe::core::types::RtpsPayloadData> McapReaderParticipant::create_message_payload_(
+        const mcap::MessageView& message)
+{
+    // NOTE: Only the channels marked when recording may hold messages compressed with a dictionary
+    if (message.channel->messageEncoding != ZSTD_DICTIONARY_MESSAGE_ENCODING ||
+            !ZstdDictionary::is_compressed(message.message.data, message.message.dataSize))
+    {
+        return create_payload_(message.message.data, message.message.dataSize);
+    }
+
+    const auto dictionary_it = dictionaries_.find(message.schema->name);
+
+    if (dictionary_it == dictionaries_.end())
+    {
+        EPROSIMA_LOG_WARNING(DDSREPLAYER_MCAP_READER_PARTICIPANT,
+                "Skipping message in topic " << message.channel->topic << ": the zstd dictionary of type "
+                                             << message.schema->name << " is missing.");
+        return nullptr;
+    }
+
+    if (!dictionary_it->second->decompress(message.message.data, message.message.dataSize, decompressed_message_))
+    {
+        EPROSIMA_LOG_WARNING(DDSREPLAYER_MCAP_READER_PARTICIPANT,
+                "Skipping message in topic " << message.channel->topic << ": failed to decompress it with the zstd "
+                "dictionary of type " << message.schema->name << ".");
+        return nullptr;
+    }
+
+    return create_payload_(decompressed_message_.data(), static_cast<std::uint32_t>(decompressed_message_.size()));
+}
+
 void McapReaderParticipant::open_file_()
 {
     const auto status = mcap_reader_.open(file_path_);
@@ -533,6 +573,29 @@ void McapReaderParticipant::read_mcap_summary_()
                 << "), incompatibilities might arise...");
     }
 
+    source_guid_index_.clear();
+    source_guid_by_sequence_.clear();
+    sequence_by_source_guid_index_.clear();
+
+    const auto attachments = mcap_reader_.attachments();
+    const auto source_guid_index_it = attachments.find(SOURCE_GUID_INDEX_ATTACHMENT_NAME);
+
+    if (source_guid_index_it != attachments.end())
+    {
+        const auto& source_guid_index_attachment = source_guid_index_it->second;
+        const std::string serialized_index(
+            reinterpret_cast<const char*>(source_guid_index_attachment.data), source_guid_index_attachment.dataSize);
+
+        if (!source_guid_index_.deserialize(serialized_index))
+        {
+            EPROSIMA_LOG_WARNING(DDSREPLAYER_MCAP_READER_PARTICIPANT,
+                    "MCAP source GUID index is not valid, the writer of the messages is unknown.");
+        }
+
+        return;
+    }
+
+    // Files recorded before the source GUID index store the writers in the metadata
     const auto sequence_metadata_it = metadata.find(VERSION_METADATA_MESSAGE_NAME);
     if (sequence_metadata_it != metadata.end())
     {
@@ -550,11 +613,30 @@ void McapReaderParticipant::read_mcap_summary_()
             sequence_by_source_guid_index_.clear();
         }
     }
-    else
+}
+
+std::string McapReaderParticipant::get_writer_guid_(
+        std::uint32_t sequence) const
+{
+    if (!source_guid_index_.empty())
     {
-        source_guid_by_sequence_.clear();
-        sequence_by_source_guid_index_.clear();
+        const auto writer_guid = source_guid_index_.find(sequence);
+        return writer_guid != nullptr ? *writer_guid : "";
     }
+
+    const auto source_guid_it = source_guid_by_sequence_.find(std::to_string(sequence));
+    if (source_guid_it == source_guid_by_sequence_.end())
+    {
+        return "";
+    }
+
+    const auto writer_guid_it = sequence_by_source_guid_index_.find(source_guid_it->second);
+    if (writer_guid_it == sequence_by_source_guid_index_.end())
+    {
+        return "";
+    }
+
+    return writer_guid_it->second;
 }
 
 mcap::LinearMessageView McapReaderParticipant::read_mcap_messages_()
@@ -18,6 +18,7 @@
 
 #include <cstring>
 #include <exception>
+#include <filesystem>
 #include <map>
 #include <sstream>
 #include <stdexcept>
@@ -108,16 +109,87 @@ void SqlReaderParticipant::process_summary(
         std::set<utils::Heritable<ddspipe::core::types::DdsTopic>>& topics,
         DynamicTypesCollection& types)
 {
-    open_file_();
-
     {
         std::lock_guard<std::mutex> lock(filter_mutex_);
         filter_updating_ = true;
     }
 
+    // Read the files one after the other (several if they are the shards of a catalog)
+    for (const auto& file_path : find_files_())
+    {
+        process_summary_(file_path, topics, types);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(filter_mutex_);
+        filter_updating_ = false;
+    }
+    filter_cv_.notify_all();
+}
+
+void SqlReaderParticipant::process_messages()
+{
+    // Define the time to start replaying messages
+    const auto initial_timestamp = when_to_start_replay_(configuration_->start_replay_time);
+
+    const auto begin_time = configuration_->begin_time.is_set() ?
+            configuration_->begin_time.get_reference() :
+            utils::the_beginning_of_time();
+
+    const auto end_time = configuration_->end_time.is_set() ?
+            configuration_->end_time.get_reference() :
+            utils::the_end_of_time();
+
+    bool first_message_timestamp_set = false;
+    utils::Timestamp first_message_timestamp{};
+
+    // Read the files one after the other (several if they are the shards of a catalog, which are sorted in time)
+    for (const auto& file_path : find_files_())
+    {
+        process_messages_(file_path, initial_timestamp, begin_time, end_time, first_message_timestamp_set,
+                first_message_timestamp);
+    }
+}
+
+void SqlReaderParticipant::process_summary_(
+        const std::string& file_path,
+        std::set<utils::Heritable<ddspipe::core::types::DdsTopic>>& topics,
+        DynamicTypesCollection& types)
+{
+    open_file_(file_path);
+
+    // Files recorded before version 2 of the SQL schema store the writers, topics and types as text in the Messages
+    // table, instead of the ids of the Writers and Topics tables
+    const auto lookup_tables = read_schema_version_() >= 2;
+
     // SQL query. Gets the Topic, Type, Qos, ROS2_Topic, Partitions and WriterGuid
     // using Topic, Type and Partitions as primary keys
     exec_sql_statement_(
+        lookup_tables ?
+        R"SQL(
+                            SELECT
+                                t.name          AS topic_name,
+                                t.type          AS topic_type,
+                                t.qos           AS qos,
+                                t.is_ros2_topic AS is_ros2_topic,
+                                GROUP_CONCAT(DISTINCT tp.partition)     AS partitions,
+                                GROUP_CONCAT(DISTINCT w.guid)           AS writer_guids
+                            FROM Topics t
+                            LEFT JOIN TopicsPartitions tp
+                                ON t.name = tp.topic AND t.type = tp.type
+                            LEFT JOIN MessagesPartitionsData mp
+                                ON tp.partition = mp.partition
+                            LEFT JOIN MessagesData m
+                                ON mp.writer_id = m.writer_id
+                                AND mp.sequence_number = m.sequence_number
+                                AND t.id = m.topic_id
+                            LEFT JOIN Writers w
+                                ON m.writer_id = w.id
+                            GROUP BY
+                                t.name, t.type, tp.partition;
+
+
+                        )SQL" :
         R"SQL(
                             SELECT
                                 t.name          AS topic_name,
@@ -313,47 +385,72 @@ void SqlReaderParticipant::process_summary(
                 type.type_identifier(type_information);
                 type.type_object(type_object);
 
+                // Every shard of a catalog stores every type, so they are only stored once
+                for (const auto& stored_type : types.dynamic_types())
+                {
+                    if (stored_type.type_name() == type.type_name())
+                    {
+                        return;
+                    }
+                }
+
                 // Store the DynamicType in the DynamicTypesCollection
                 types.dynamic_types().push_back(type);
             });
 
     close_file_();
-
-    {
-        std::lock_guard<std::mutex> lock(filter_mutex_);
-        filter_updating_ = false;
-    }
-    filter_cv_.notify_all();
 }
 
-void SqlReaderParticipant::process_messages()
+void SqlReaderParticipant::process_messages_(
+        const std::string& file_path,
+        const utils::Timestamp& initial_timestamp,
+        const utils::Timestamp& begin_time,
+        const utils::Timestamp& end_time,
+        bool& first_message_timestamp_set,
+        utils::Timestamp& first_message_timestamp)
 {
-    open_file_();
-
-    // Define the time to start replaying messages
-    const auto initial_timestamp = when_to_start_replay_(configuration_->start_replay_time);
-
-    const auto begin_time = to_sql_timestamp(
-        configuration_->begin_time.is_set() ?
-        configuration_->begin_time.get_reference() :
-        utils::the_beginning_of_time());
-
-    const auto end_time = to_sql_timestamp(
-        configuration_->end_time.is_set() ?
-        configuration_->end_time.get_reference() :
-        utils::the_end_of_time());
-
-    bool first_message_timestamp_set = false;
-    utils::Timestamp first_message_timestamp{};
+    open_file_(file_path);
+
+    const auto schema_version = read_schema_version_();
+
+    // Files recorded before the SQL schema was versioned (version 0) store the timestamps as text
+    const auto integer_timestamps = schema_version >= 1;
+
+    // Files recorded before version 2 store the writers, topics and types as text in the Messages table, instead of
+    // the ids of the Writers and Topics tables
+    const auto lookup_tables = schema_version >= 2;
+
+    // NOTE: The bounds are compared as integers so the index of the messages on their log time, writer and sequence
+    //       number serves both the range and the order, instead of sorting the whole table
+    const std::string timestamp_parameter = integer_timestamps ? "CAST(? AS INTEGER)" : "?";
+
+    // NOTE: The Topics table stores the names of the ROS 2 topics demangled, so they are mangled back below
+    const std::string select_statement = lookup_tables ?
+            "SELECT m.log_time, t.name, t.type, m.data_cdr, m.data_cdr_size, w.guid, m.key, m.sequence_number, "
+            "t.is_ros2_topic FROM MessagesData m "
+            "JOIN Topics t ON m.topic_id = t.id "
+            "JOIN Writers w ON m.writer_id = w.id "
+            "WHERE m.log_time >= " + timestamp_parameter + " AND m.log_time <= " + timestamp_parameter + " "
+            "AND m.data_cdr_size > 0 "
+            "ORDER BY m.log_time, m.writer_id, m.sequence_number;" :
+            "SELECT log_time, topic, type, data_cdr, data_cdr_size, writer_guid, key, sequence_number, 'false' "
+            "FROM Messages "
+            "WHERE log_time >= " + timestamp_parameter + " AND log_time <= " + timestamp_parameter + " "
+            "AND data_cdr_size > 0 "
+            "ORDER BY log_time, writer_guid, sequence_number;";
+
+    const std::vector<std::string> bind_values = integer_timestamps ?
+            std::vector<std::string>{std::to_string(to_ticks(begin_time)), std::to_string(to_ticks(end_time))} :
+            std::vector<std::string>{to_sql_timestamp(begin_time), to_sql_timestamp(end_time)};
 
     exec_sql_statement_(
-        "SELECT log_time, topic, type, data_cdr, data_cdr_size, writer_guid, key, sequence_number FROM Messages "
-        "WHERE log_time >= ? AND log_time <= ? AND data_cdr_size > 0 "
-        "ORDER BY log_time, writer_guid, sequence_number;",
-        {begin_time, end_time},
+        select_statement,
+        bind_values,
         [&](sqlite3_stmt* stmt)
         {
-            const auto log_time = to_std_timestamp(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+            const auto log_time = integer_timestamps ?
+            to_std_timestamp(static_cast<mcap::Timestamp>(sqlite3_column_int64(stmt, 0))) :
+            to_std_timestamp(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
 
             // Store the timestamp of the first recorded message in this replay execution.
             if (!first_message_timestamp_set)
@@ -364,7 +461,11 @@ void SqlReaderParticipant::process_messages()
 
             // Create a DdsTopic to publish the message
             ddspipe::core::types::DdsTopic topic;
-            const std::string topic_name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+            const bool is_topic_ros2_type =
+            strcmp(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 8)), "true") == 0;
+            const std::string topic_name = is_topic_ros2_type ?
+            utils::mangle_if_ros_topic(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1))) :
+            reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
             const std::string type_name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
 
             const std::string writer_guid = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5));
@@ -519,13 +620,14 @@ void SqlReaderParticipant::process_messages()
     close_file_();
 }
 
-void SqlReaderParticipant::open_file_()
+void SqlReaderParticipant::open_file_(
+        const std::string& file_path)
 {
-    const auto ret = sqlite3_open(file_path_.c_str(), &database_);
+    const auto ret = sqlite3_open(file_path.c_str(), &database_);
 
     if (ret != SQLITE_OK)
     {
-        const std::string error_msg = utils::Formatter() << "Failed to open SQL file " << file_path_
+        const std::string error_msg = utils::Formatter() << "Failed to open SQL file " << file_path
                                                          << " for reading: " << sqlite3_errmsg(database_);
         sqlite3_close(database_);
 
@@ -539,6 +641,78 @@ void SqlReaderParticipant::close_file_()
     sqlite3_close(database_);
 }
 
+std::vector<std::string> SqlReaderParticipant::find_files_()
+{
+    open_file_(file_path_);
+
+    bool is_catalog = false;
+
+    exec_sql_statement_("SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name = 'Shards';", {},
+            [&](sqlite3_stmt* stmt)
+            {
+                is_catalog = sqlite3_column_int(stmt, 0) > 0;
+            });
+
+    if (!is_catalog)
+    {
+        close_file_();
+        return {file_path_};
+    }
+
+    const auto begin_time = configuration_->begin_time.is_set() ?
+            configuration_->begin_time.get_reference() :
+            utils::the_beginning_of_time();
+
+    const auto end_time = configuration_->end_time.is_set() ?
+            configuration_->end_time.get_reference() :
+            utils::the_end_of_time();
+
+    // The shards are stored next to their catalog
+    const auto directory = std::filesystem::path(file_path_).parent_path();
+
+    std::vector<std::string> files;
+
+    // Read only the shards overlapping the time range to replay, in the order they were recorded
+    // NOTE: The time range of a shard is written when it is closed, so the shards without one are read too
+    exec_sql_statement_(
+        "SELECT name FROM Shards "
+        "WHERE begin_time IS NULL OR (begin_time <= CAST(? AS INTEGER) AND end_time >= CAST(? AS INTEGER)) "
+        "ORDER BY rowid;",
+        {std::to_string(to_ticks(end_time)), std::to_string(to_ticks(begin_time))},
+        [&](sqlite3_stmt* stmt)
+        {
+            const auto file = (directory / reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0))).string();
+
+            if (!std::filesystem::exists(file))
+            {
+                EPROSIMA_LOG_WARNING(DDSREPLAYER_SQL_READER_PARTICIPANT,
+                "SQL shard " << file << " not found (it may have been removed by the log rotation). Skipping...");
+                return;
+            }
+
+            files.push_back(file);
+        });
+
+    close_file_();
+
+    EPROSIMA_LOG_INFO(DDSREPLAYER_SQL_READER_PARTICIPANT,
+            "Reading " << files.size() << " SQL shards of catalog " << file_path_ << ".");
+
+    return files;
+}
+
+int SqlReaderParticipant::read_schema_version_()
+{
+    int schema_version = 0;
+
+    exec_sql_statement_("PRAGMA user_version;", {}, [&](sqlite3_stmt* stmt)
+            {
+                schema_version = sqlite3_column_int(stmt, 0);
+            });
+
+    return schema_version;
+}
+
 void SqlReaderParticipant::exec_sql_statement_(
         const std::string& statement,
         const std::vector<std::string>& bind_values,
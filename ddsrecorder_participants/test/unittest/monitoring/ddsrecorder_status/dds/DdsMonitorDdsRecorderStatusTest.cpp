@@ -216,6 +216,36 @@ TEST_F(DdsMonitorDdsRecorderStatusTest, disk_full)
     ASSERT_FALSE(status.error_status().type_mismatch());
     ASSERT_FALSE(status.ddsrecorder_error_status().mcap_file_creation_failure());
     ASSERT_TRUE(status.ddsrecorder_error_status().disk_full());
+    ASSERT_FALSE(status.ddsrecorder_error_status().buffer_memory_full());
+    ASSERT_TRUE(status.has_errors());
+}
+
+/**
+ * Test that the Monitor monitors the buffer memory full correctly.
+ *
+ * CASES:
+ * - check that the Monitor publishes the buffer_memory_full correctly.
+ */
+TEST_F(DdsMonitorDdsRecorderStatusTest, buffer_memory_full)
+{
+    // Mock a buffer memory full
+    monitor_error("BUFFER_MEMORY_FULL");
+
+    DdsRecorderMonitoringStatus status;
+    SampleInfo info;
+
+    // Wait for the monitor to publish the next message
+    ASSERT_TRUE(reader_->wait_for_unread_message(test::monitor::MAX_WAITING_TIME));
+
+    ASSERT_EQ(reader_->take_next_sample(&status, &info), RETCODE_OK);
+    ASSERT_EQ(info.instance_state, ALIVE_INSTANCE_STATE);
+
+    // Verify that the content of the DdsRecorderMonitoringStatus published by the Monitor is correct
+    ASSERT_FALSE(status.error_status().qos_mismatch());
+    ASSERT_FALSE(status.error_status().type_mismatch());
+    ASSERT_FALSE(status.ddsrecorder_error_status().mcap_file_creation_failure());
+    ASSERT_FALSE(status.ddsrecorder_error_status().disk_full());
+    ASSERT_TRUE(status.ddsrecorder_error_status().buffer_memory_full());
     ASSERT_TRUE(status.has_errors());
 }
 
@@ -170,6 +170,27 @@ TEST_F(LogMonitorDdsRecorderStatusTest, disk_full)
             "DdsRecorder Monitoring Status: [DISK_FULL]"));
 }
 
+/**
+ * Test that the Monitor monitors the buffer memory full correctly.
+ *
+ * CASES:
+ * - check that the Monitor logs the buffer_memory_full correctly.
+ */
+TEST_F(LogMonitorDdsRecorderStatusTest, buffer_memory_full)
+{
+    // Mock a buffer memory full
+    monitor_error("BUFFER_MEMORY_FULL");
+
+    testing::internal::CaptureStdout();
+
+    // Wait for the monitor to log the message
+    std::this_thread::sleep_for(std::chrono::milliseconds(test::monitor::PERIOD_MS*2));
+    utils::Log::Flush();
+
+    ASSERT_TRUE(contains_(testing::internal::GetCapturedStdout(),
+            "DdsRecorder Monitoring Status: [BUFFER_MEMORY_FULL]"));
+}
+
 int main(
         int argc,
         char** argv)
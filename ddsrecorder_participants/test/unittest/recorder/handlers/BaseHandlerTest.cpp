@@ -0,0 +1,350 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddspipe_core/efficiency/payload/FastPayloadPool.hpp>
+#include <ddspipe_core/types/data/RtpsPayloadData.hpp>
+#include <ddspipe_core/types/topic/dds/DdsTopic.hpp>
+
+#include <ddsrecorder_participants/recorder/handler/BaseHandler.hpp>
+#include <ddsrecorder_participants/recorder/handler/BaseWriter.hpp>
+
+using namespace eprosima;
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+/**
+ * Writer without output file.
+ */
+class Writer : public BaseWriter
+{
+public:
+
+    Writer(
+            std::shared_ptr<FileTracker>& file_tracker)
+        : BaseWriter(OutputSettings(), file_tracker)
+    {
+    }
+
+    ~Writer()
+    {
+        // NOTE: disable before destruction, since the base destructor cannot call the overridden methods
+        disable();
+    }
+
+protected:
+
+    void open_new_file_nts_(
+            const std::uint64_t) override
+    {
+    }
+
+    void close_current_file_nts_() override
+    {
+    }
+
+};
+
+/**
+ * Handler keeping the index (stored in the payload) of every sample written.
+ */
+class Handler : public BaseHandler
+{
+public:
+
+    Handler(
+            const BaseHandlerConfiguration& config,
+            const std::shared_ptr<ddspipe::core::PayloadPool>& payload_pool,
+            BaseWriter* writer,
+            std::chrono::milliseconds write_delay = std::chrono::milliseconds(0))
+        : BaseHandler(config, payload_pool)
+        , write_delay_(write_delay)
+    {
+        writer_ = writer;
+        init();
+    }
+
+    ~Handler()
+    {
+        stop(true);
+    }
+
+    void add_schema(
+            const fastdds::dds::DynamicType::_ref_type&,
+            const fastdds::dds::xtypes::TypeIdentifier&) override
+    {
+    }
+
+    void add_data(
+            const ddspipe::core::types::DdsTopic& topic,
+            ddspipe::core::types::RtpsPayloadData& data) override
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+
+        if (state_ != BaseHandlerStateCode::STOPPED)
+        {
+            process_new_sample_nts_(std::make_shared<const BaseMessage>(data, payload_pool_, topics_.intern(topic)));
+        }
+
+        lock.unlock();
+        write_dispatched_samples_();
+    }
+
+    //! Number of written batches kept to be reused
+    std::size_t spare_batches()
+    {
+        std::lock_guard<std::mutex> writer_lock(writer_cv_mutex_);
+        return spare_batches_.size();
+    }
+
+    //! Capacity of the buffer where samples are received
+    std::size_t buffer_capacity()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return samples_buffer_.capacity();
+    }
+
+    //! Indexes of the samples written (in writing order)
+    std::vector<std::uint32_t> written;
+
+    //! Storage of the batches written
+    std::set<const void*> batch_addresses;
+
+    //! Min capacity of the batches written
+    std::size_t min_batch_capacity{std::numeric_limits<std::size_t>::max()};
+
+    //! Max number of samples left in the writer queue seen when writing
+    std::size_t max_queue_size{0};
+
+protected:
+
+    void write_samples_(
+            SamplesBatch& samples) override
+    {
+        {
+            std::lock_guard<std::mutex> writer_lock(writer_cv_mutex_);
+            max_queue_size = std::max(max_queue_size, writer_queue_size_);
+        }
+
+        batch_addresses.insert(samples.data());
+        min_batch_capacity = std::min(min_batch_capacity, samples.capacity());
+
+        std::this_thread::sleep_for(write_delay_);
+
+        for (const auto& sample : samples)
+        {
+            std::uint32_t index;
+            std::memcpy(&index, sample->payload.data, sizeof(index));
+            written.push_back(index);
+        }
+
+        samples.clear();
+    }
+
+    //! Time taken to write every batch
+    const std::chrono::milliseconds write_delay_;
+};
+
+BaseHandlerConfiguration configuration(
+        unsigned int buffer_size)
+{
+    return BaseHandlerConfiguration(OutputSettings(), 0, buffer_size, 0, 0, false, false, false);
+}
+
+ddspipe::core::types::DdsTopic topic(
+        const std::string& type_name = "type")
+{
+    ddspipe::core::types::DdsTopic topic;
+    topic.m_topic_name = "topic";
+    topic.type_name = type_name;
+
+    return topic;
+}
+
+/**
+ * Add to \c handler a sample in \c topic whose payload is \c index .
+ */
+void add_sample(
+        BaseHandler& handler,
+        const std::shared_ptr<ddspipe::core::PayloadPool>& payload_pool,
+        const ddspipe::core::types::DdsTopic& topic,
+        std::uint32_t index)
+{
+    ddspipe::core::types::RtpsPayloadData data;
+
+    ASSERT_TRUE(payload_pool->get_payload(sizeof(index), data.payload));
+    std::memcpy(data.payload.data, &index, sizeof(index));
+    data.payload.length = sizeof(index);
+    data.payload_owner = payload_pool.get();
+
+    handler.add_data(topic, data);
+}
+
+} // namespace test
+
+/**
+ * Check that the writer thread writes the samples in the order they were received, and that the reception blocks
+ * while its queue is full.
+ */
+TEST(BaseHandlerTest, async_write_order)
+{
+    auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+    std::shared_ptr<FileTracker> file_tracker;
+    test::Writer writer(file_tracker);
+
+    auto configuration = test::configuration(1);
+    configuration.async_write = true;
+    configuration.async_write_queue_size = 4;
+
+    test::Handler handler(configuration, payload_pool, &writer, std::chrono::milliseconds(1));
+
+    constexpr std::uint32_t SAMPLES = 100;
+
+    for (std::uint32_t i = 0; i < SAMPLES; i++)
+    {
+        test::add_sample(handler, payload_pool, test::topic(), i);
+    }
+
+    handler.stop();
+
+    ASSERT_EQ(handler.written.size(), SAMPLES);
+
+    for (std::uint32_t i = 0; i < SAMPLES; i++)
+    {
+        ASSERT_EQ(handler.written[i], i);
+    }
+
+    // A full queue blocks the reception until the writer thread takes a batch from it
+    ASSERT_LE(handler.max_queue_size, configuration.async_write_queue_size);
+}
+
+/**
+ * Check that stopping the handler writes the samples in the buffer and every sample queued to the writer thread
+ * before returning.
+ */
+TEST(BaseHandlerTest, flush_on_stop)
+{
+    auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+    std::shared_ptr<FileTracker> file_tracker;
+    test::Writer writer(file_tracker);
+
+    auto configuration = test::configuration(5);
+    configuration.async_write = true;
+
+    test::Handler handler(configuration, payload_pool, &writer, std::chrono::milliseconds(20));
+
+    // 4 full batches queued to the (slow) writer thread, and 3 samples left in the buffer
+    constexpr std::uint32_t SAMPLES = 23;
+
+    for (std::uint32_t i = 0; i < SAMPLES; i++)
+    {
+        test::add_sample(handler, payload_pool, test::topic(), i);
+    }
+
+    handler.stop();
+
+    ASSERT_EQ(handler.written.size(), SAMPLES);
+    ASSERT_EQ(handler.written.back(), SAMPLES - 1);
+}
+
+/**
+ * Check that a full buffer is swapped with an empty batch of the same capacity, and that the written batches are
+ * reused instead of allocating new ones.
+ */
+TEST(BaseHandlerTest, batch_reuse)
+{
+    auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+    std::shared_ptr<FileTracker> file_tracker;
+    test::Writer writer(file_tracker);
+
+    const auto configuration = test::configuration(4);
+
+    test::Handler handler(configuration, payload_pool, &writer);
+
+    // 3 full batches, written as soon as the buffer is full
+    constexpr std::uint32_t SAMPLES = 12;
+
+    for (std::uint32_t i = 0; i < SAMPLES; i++)
+    {
+        test::add_sample(handler, payload_pool, test::topic(), i);
+    }
+
+    ASSERT_EQ(handler.written.size(), SAMPLES);
+
+    // The buffer keeps its capacity after being swapped
+    ASSERT_GE(handler.buffer_capacity(), configuration.buffer_size);
+    ASSERT_GE(handler.min_batch_capacity, configuration.buffer_size);
+
+    // The buffer and a single spare batch are swapped with each other
+    ASSERT_EQ(handler.batch_addresses.size(), 2u);
+    ASSERT_EQ(handler.spare_batches(), 1u);
+}
+
+/**
+ * Check that, when the memory limit is reached, the oldest pending samples are released first whatever their type.
+ */
+TEST(BaseHandlerTest, memory_limit_releases_oldest)
+{
+    auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+    std::shared_ptr<FileTracker> file_tracker;
+    test::Writer writer(file_tracker);
+
+    // Room for 3 pending samples (of 4 bytes)
+    auto configuration = test::configuration(100);
+    configuration.max_pending_samples = 100;
+    configuration.max_buffer_memory = 3 * sizeof(std::uint32_t);
+
+    test::Handler handler(configuration, payload_pool, &writer);
+
+    // Samples of two types whose schema is never received, interleaved
+    constexpr std::uint32_t SAMPLES = 10;
+
+    for (std::uint32_t i = 0; i < SAMPLES; i++)
+    {
+        test::add_sample(handler, payload_pool, test::topic(i % 2 == 0 ? "type_a" : "type_b"), i);
+
+        // Ensure every sample has a different reception time
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // The released samples are written without schema, in reception order
+    ASSERT_EQ(handler.written.size(), SAMPLES - 3);
+
+    for (std::uint32_t i = 0; i < SAMPLES - 3; i++)
+    {
+        ASSERT_EQ(handler.written[i], i);
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,291 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <fastdds/dds/xtypes/dynamic_types/DynamicData.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicDataFactory.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicPubSubType.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicTypeBuilder.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicTypeBuilderFactory.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/MemberDescriptor.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/TypeDescriptor.hpp>
+
+#include <ddspipe_core/types/dds/Payload.hpp>
+
+#include <ddsrecorder_participants/recorder/handler/sql/CdrKeyExtractor.hpp>
+#include <ddsrecorder_participants/recorder/message/SqlMessage.hpp>
+
+using namespace eprosima;
+using namespace eprosima::fastdds::dds;
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+//! Member of a test structure: name, type and whether it is a key member
+using Member = std::tuple<std::string, DynamicType::_ref_type, bool>;
+
+const std::vector<DataRepresentationId_t> REPRESENTATIONS = {
+    DataRepresentationId_t::XCDR_DATA_REPRESENTATION,
+    DataRepresentationId_t::XCDR2_DATA_REPRESENTATION
+};
+
+DynamicType::_ref_type primitive(
+        TypeKind kind)
+{
+    return DynamicTypeBuilderFactory::get_instance()->get_primitive_type(kind);
+}
+
+DynamicType::_ref_type string()
+{
+    return DynamicTypeBuilderFactory::get_instance()->create_string_type(
+        static_cast<uint32_t>(LENGTH_UNLIMITED))->build();
+}
+
+DynamicType::_ref_type sequence(
+        const DynamicType::_ref_type& element_type)
+{
+    return DynamicTypeBuilderFactory::get_instance()->create_sequence_type(
+        element_type, static_cast<uint32_t>(LENGTH_UNLIMITED))->build();
+}
+
+DynamicType::_ref_type structure(
+        const std::string& name,
+        const std::vector<Member>& members,
+        ExtensibilityKind extensibility = ExtensibilityKind::FINAL)
+{
+    TypeDescriptor::_ref_type type_descriptor{traits<TypeDescriptor>::make_shared()};
+    type_descriptor->kind(TK_STRUCTURE);
+    type_descriptor->name(name);
+    type_descriptor->extensibility_kind(extensibility);
+
+    auto builder = DynamicTypeBuilderFactory::get_instance()->create_type(type_descriptor);
+
+    for (const auto& member : members)
+    {
+        MemberDescriptor::_ref_type member_descriptor{traits<MemberDescriptor>::make_shared()};
+        member_descriptor->name(std::get<0>(member));
+        member_descriptor->type(std::get<1>(member));
+        member_descriptor->is_key(std::get<2>(member));
+        builder->add_member(member_descriptor);
+    }
+
+    return builder->build();
+}
+
+ddspipe::core::types::Payload serialize(
+        const DynamicType::_ref_type& dynamic_type,
+        const DynamicData::_ref_type& dynamic_data,
+        DataRepresentationId_t representation)
+{
+    DynamicPubSubType pub_sub_type(dynamic_type);
+
+    ddspipe::core::types::Payload payload(pub_sub_type.calculate_serialized_size(&dynamic_data, representation));
+    pub_sub_type.serialize(&dynamic_data, payload, representation);
+
+    return payload;
+}
+
+/**
+ * Calculate the key of the sample serialized in \c payload the way the extractor replaces (through its JSON form).
+ */
+std::string set_key(
+        const DynamicType::_ref_type& dynamic_type,
+        const ddspipe::core::types::Payload& payload)
+{
+    SqlMessage message;
+    message.payload.copy(&payload, false);
+    message.set_key(dynamic_type);
+
+    return message.key;
+}
+
+/**
+ * Extract the key of the sample, checking that it is the same key \c SqlMessage::set_key calculates.
+ */
+std::string extract(
+        const DynamicType::_ref_type& dynamic_type,
+        const DynamicData::_ref_type& dynamic_data,
+        DataRepresentationId_t representation)
+{
+    CdrKeyExtractor key_extractor(dynamic_type);
+    EXPECT_TRUE(key_extractor.is_supported());
+
+    const auto payload = serialize(dynamic_type, dynamic_data, representation);
+
+    std::string key;
+    EXPECT_TRUE(key_extractor.extract(payload, key));
+
+    // The same instance must get the same key whichever way it is calculated
+    EXPECT_EQ(key, set_key(dynamic_type, payload));
+
+    return key;
+}
+
+} // namespace test
+
+/**
+ * Check that primitive and string key members are extracted (sorted by name), and non-key members are left out.
+ */
+TEST(CdrKeyExtractorTest, keyed_members)
+{
+    const auto dynamic_type = test::structure("KeyedType", {
+        {"value", test::primitive(TK_FLOAT64), false},
+        {"name", test::string(), true},
+        {"id", test::primitive(TK_INT32), true},
+        {"active", test::primitive(TK_BOOLEAN), true},
+        {"comment", test::string(), false}
+    });
+
+    auto dynamic_data = DynamicDataFactory::get_instance()->create_data(dynamic_type);
+    dynamic_data->set_float64_value(dynamic_data->get_member_id_by_name("value"), 3.5);
+    dynamic_data->set_string_value(dynamic_data->get_member_id_by_name("name"), "robot \"1\"");
+    dynamic_data->set_int32_value(dynamic_data->get_member_id_by_name("id"), -7);
+    dynamic_data->set_boolean_value(dynamic_data->get_member_id_by_name("active"), true);
+    dynamic_data->set_string_value(dynamic_data->get_member_id_by_name("comment"), "not a key");
+
+    for (const auto representation : test::REPRESENTATIONS)
+    {
+        ASSERT_EQ(test::extract(dynamic_type, dynamic_data, representation),
+                "{\"active\":true,\"id\":-7,\"name\":\"robot \\\"1\\\"\"}");
+    }
+}
+
+/**
+ * Check that non-key members of variable size preceding the key members are skipped correctly.
+ */
+TEST(CdrKeyExtractorTest, skip_non_key_members)
+{
+    const auto dynamic_type = test::structure("SkipType", {
+        {"flag", test::primitive(TK_UINT8), false},
+        {"values", test::sequence(test::primitive(TK_FLOAT64)), false},
+        {"names", test::sequence(test::string()), false},
+        {"id", test::primitive(TK_UINT64), true}
+    });
+
+    auto dynamic_data = DynamicDataFactory::get_instance()->create_data(dynamic_type);
+    dynamic_data->set_uint8_value(dynamic_data->get_member_id_by_name("flag"), 1);
+    dynamic_data->set_float64_values(dynamic_data->get_member_id_by_name("values"), {1.0, 2.0, 3.0});
+    dynamic_data->set_string_values(dynamic_data->get_member_id_by_name("names"), {"a", "bc"});
+    dynamic_data->set_uint64_value(dynamic_data->get_member_id_by_name("id"), 18446744073709551615ull);
+
+    for (const auto representation : test::REPRESENTATIONS)
+    {
+        ASSERT_EQ(test::extract(dynamic_type, dynamic_data, representation), "{\"id\":18446744073709551615}");
+    }
+}
+
+/**
+ * Check the keys of nested (final and appendable) structures.
+ */
+TEST(CdrKeyExtractorTest, nested_structures)
+{
+    for (const auto extensibility : {ExtensibilityKind::FINAL, ExtensibilityKind::APPENDABLE})
+    {
+        const auto nested_type = test::structure("NestedType", {
+            {"description", test::string(), false},
+            {"index", test::primitive(TK_INT16), true}
+        }, extensibility);
+
+        const auto dynamic_type = test::structure("ParentType", {
+            {"nested", nested_type, true},
+            {"id", test::primitive(TK_UINT32), true}
+        }, extensibility);
+
+        auto dynamic_data = DynamicDataFactory::get_instance()->create_data(dynamic_type);
+        auto nested_data = dynamic_data->loan_value(dynamic_data->get_member_id_by_name("nested"));
+        nested_data->set_string_value(nested_data->get_member_id_by_name("description"), "nested");
+        nested_data->set_int16_value(nested_data->get_member_id_by_name("index"), 3);
+        dynamic_data->return_loaned_value(nested_data);
+        dynamic_data->set_uint32_value(dynamic_data->get_member_id_by_name("id"), 42);
+
+        for (const auto representation : test::REPRESENTATIONS)
+        {
+            ASSERT_EQ(test::extract(dynamic_type, dynamic_data, representation),
+                    "{\"id\":42,\"nested\":{\"index\":3}}");
+        }
+    }
+}
+
+/**
+ * Check that the key of a type without key members is an empty object.
+ */
+TEST(CdrKeyExtractorTest, unkeyed)
+{
+    const auto dynamic_type = test::structure("UnkeyedType", {
+        {"value", test::primitive(TK_FLOAT32), false}
+    });
+
+    auto dynamic_data = DynamicDataFactory::get_instance()->create_data(dynamic_type);
+
+    for (const auto representation : test::REPRESENTATIONS)
+    {
+        ASSERT_EQ(test::extract(dynamic_type, dynamic_data, representation), "{}");
+    }
+}
+
+/**
+ * Check that types or payloads whose key cannot be extracted straight from the CDR payload are rejected.
+ */
+TEST(CdrKeyExtractorTest, unsupported)
+{
+    // Floating point key
+    {
+        const auto dynamic_type = test::structure("FloatKeyType", {
+            {"id", test::primitive(TK_FLOAT64), true}
+        });
+
+        ASSERT_FALSE(CdrKeyExtractor(dynamic_type).is_supported());
+    }
+
+    // Mutable type
+    {
+        const auto dynamic_type = test::structure("MutableType", {
+            {"id", test::primitive(TK_INT32), true}
+        }, ExtensibilityKind::MUTABLE);
+
+        ASSERT_FALSE(CdrKeyExtractor(dynamic_type).is_supported());
+    }
+
+    // Non-ASCII string key
+    {
+        const auto dynamic_type = test::structure("StringKeyType", {
+            {"name", test::string(), true}
+        });
+
+        auto dynamic_data = DynamicDataFactory::get_instance()->create_data(dynamic_type);
+        dynamic_data->set_string_value(dynamic_data->get_member_id_by_name("name"), "\xC3\xB1");
+
+        CdrKeyExtractor key_extractor(dynamic_type);
+        ASSERT_TRUE(key_extractor.is_supported());
+
+        std::string key;
+        ASSERT_FALSE(key_extractor.extract(
+                    test::serialize(dynamic_type, dynamic_data, DataRepresentationId_t::XCDR2_DATA_REPRESENTATION), key));
+        ASSERT_TRUE(key.empty());
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,204 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/recorder/handler/mcap/DirectFileWriter.hpp>
+
+using namespace eprosima;
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+const std::string FILENAME = "direct_file_writer_test.bin";
+
+void write(
+        DirectFileWriter& writer,
+        const std::string& data)
+{
+    writer.write(reinterpret_cast<const std::byte*>(data.data()), data.size());
+}
+
+std::string read_file()
+{
+    std::ifstream file(FILENAME, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+
+    return content.str();
+}
+
+} // namespace test
+
+/**
+ * Check that the bytes written (in writes smaller and larger than the buffers, with more buffers than can be in
+ * flight) are read back from the file.
+ */
+TEST(DirectFileWriterTest, round_trip)
+{
+    std::string expected;
+
+    {
+        DirectFileWriter writer(DirectFileWriter::ALIGNMENT, 2);
+        ASSERT_TRUE(writer.open(test::FILENAME, 0).ok());
+
+        for (std::uint32_t i = 0; i < 200; i++)
+        {
+            const std::string data((i * 37) % 9000, static_cast<char>('a' + i % 26));
+            test::write(writer, data);
+            expected += data;
+
+            ASSERT_EQ(writer.size(), expected.size());
+        }
+
+        writer.end();
+    }
+
+    ASSERT_EQ(test::read_file(), expected);
+
+    std::filesystem::remove(test::FILENAME);
+}
+
+/**
+ * Check that the file is truncated to the bytes written when it ends, even if it was preallocated beyond them.
+ */
+TEST(DirectFileWriterTest, preallocation_truncated)
+{
+    {
+        DirectFileWriter writer;
+        ASSERT_TRUE(writer.open(test::FILENAME, 4 * 1024 * 1024).ok());
+
+        test::write(writer, "MCAP file shorter than its alignment");
+    }
+
+    ASSERT_EQ(std::filesystem::file_size(test::FILENAME), std::string("MCAP file shorter than its alignment").size());
+
+    std::filesystem::remove(test::FILENAME);
+}
+
+/**
+ * Check that the bytes written before a flush are in the file (padded to the alignment), and that the padded copy of
+ * the buffer being filled is overwritten by the bytes written after it.
+ */
+TEST(DirectFileWriterTest, flush)
+{
+    constexpr auto ALIGNMENT = DirectFileWriter::ALIGNMENT;
+
+    DirectFileWriter writer(2 * ALIGNMENT, 2);
+    ASSERT_TRUE(writer.open(test::FILENAME, 0).ok());
+
+    std::string expected;
+
+    // Flush half of the first buffer
+    {
+        const std::string data(ALIGNMENT / 2, 'a');
+        test::write(writer, data);
+        expected += data;
+
+        writer.flush();
+
+        const auto content = test::read_file();
+        ASSERT_EQ(content.size(), ALIGNMENT);
+        ASSERT_EQ(content.substr(0, expected.size()), expected);
+        ASSERT_EQ(content.substr(expected.size()), std::string(ALIGNMENT - expected.size(), '\0'));
+    }
+
+    // Fill the rest of the first buffer (overwriting its padded copy) and part of the second, and flush again
+    {
+        const std::string data(2 * ALIGNMENT, 'b');
+        test::write(writer, data);
+        expected += data;
+
+        writer.flush();
+
+        const auto content = test::read_file();
+        ASSERT_EQ(content.size(), 3 * ALIGNMENT);
+        ASSERT_EQ(content.substr(0, expected.size()), expected);
+        ASSERT_EQ(content.substr(expected.size()), std::string(3 * ALIGNMENT - expected.size(), '\0'));
+    }
+
+    // Flushing twice writes the same padded copy
+    writer.flush();
+    ASSERT_EQ(test::read_file().substr(0, expected.size()), expected);
+
+    // Keep writing after the flushes
+    for (std::uint32_t i = 0; i < 20; i++)
+    {
+        const std::string data((i * 1237) % 5000, static_cast<char>('c' + i % 20));
+        test::write(writer, data);
+        expected += data;
+
+        if (i % 3 == 0)
+        {
+            writer.flush();
+            ASSERT_EQ(test::read_file().substr(0, expected.size()), expected);
+        }
+    }
+
+    ASSERT_EQ(writer.size(), expected.size());
+    ASSERT_FALSE(writer.failed());
+
+    writer.end();
+
+    ASSERT_EQ(test::read_file(), expected);
+
+    std::filesystem::remove(test::FILENAME);
+}
+
+/**
+ * Check that a failed write is reported, and that flushing or ending the file after it does not block.
+ */
+TEST(DirectFileWriterTest, write_failure)
+{
+    // NOTE: Every write to /dev/full fails with ENOSPC
+    const std::string FULL_DEVICE = "/dev/full";
+
+    if (!std::filesystem::exists(FULL_DEVICE))
+    {
+        GTEST_SKIP() << FULL_DEVICE << " is not available.";
+    }
+
+    DirectFileWriter writer(DirectFileWriter::ALIGNMENT, 2);
+    ASSERT_TRUE(writer.open(FULL_DEVICE, 0).ok());
+    ASSERT_FALSE(writer.failed());
+
+    test::write(writer, std::string(DirectFileWriter::ALIGNMENT / 2, 'a'));
+    writer.flush();
+
+    ASSERT_TRUE(writer.failed());
+
+    // The bytes after the failure are dropped, but still counted
+    test::write(writer, std::string(4 * DirectFileWriter::ALIGNMENT, 'b'));
+    writer.flush();
+
+    ASSERT_TRUE(writer.failed());
+    ASSERT_EQ(writer.size(), DirectFileWriter::ALIGNMENT / 2 + 4 * DirectFileWriter::ALIGNMENT);
+
+    writer.end();
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,179 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddspipe_core/efficiency/payload/FastPayloadPool.hpp>
+#include <ddspipe_core/types/data/RtpsPayloadData.hpp>
+#include <ddspipe_core/types/topic/dds/DdsTopic.hpp>
+
+#include <ddsrecorder_participants/recorder/handler/EventWindowBuffer.hpp>
+
+using namespace eprosima;
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+constexpr std::uint32_t HALF_SECOND = 500000000;
+
+const std::string SPILL_FILE = "event_window_buffer_test.spill";
+
+/**
+ * Create a message received at \c seconds + \c nanoseconds whose payload is \c size bytes.
+ */
+std::shared_ptr<const BaseMessage> message(
+        const std::shared_ptr<ddspipe::core::PayloadPool>& payload_pool,
+        std::int32_t seconds,
+        std::uint32_t nanoseconds,
+        std::uint32_t size = 10,
+        std::uint8_t value = 0)
+{
+    static const auto topic = std::make_shared<const ddspipe::core::types::DdsTopic>();
+
+    ddspipe::core::types::RtpsPayloadData data;
+
+    payload_pool->get_payload(size, data.payload);
+    std::memset(data.payload.data, value, size);
+    data.payload.length = size;
+    data.payload_owner = payload_pool.get();
+
+    auto message = std::make_shared<BaseMessage>(data, payload_pool, topic);
+    message->log_time = ddspipe::core::types::DataTime(seconds, nanoseconds);
+
+    return message;
+}
+
+} // namespace test
+
+/**
+ * Check that the buckets older than the threshold are dropped, that only the samples older than the threshold are
+ * removed from the bucket containing it, and that the memory of the removed samples is released.
+ */
+TEST(EventWindowBufferTest, remove_outdated)
+{
+    auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+    EventWindowBuffer buffer;
+
+    for (std::int32_t second = 10; second <= 12; second++)
+    {
+        buffer.push_back(test::message(payload_pool, second, 0));
+        buffer.push_back(test::message(payload_pool, second, test::HALF_SECOND));
+    }
+
+    ASSERT_EQ(buffer.size(), 6u);
+    ASSERT_EQ(buffer.memory(), 60u);
+
+    // Nothing is older than the first sample
+    buffer.remove_outdated(ddspipe::core::types::DataTime(10, 0));
+    ASSERT_EQ(buffer.size(), 6u);
+
+    // Drops the bucket of second 10, and the first sample of second 11
+    buffer.remove_outdated(ddspipe::core::types::DataTime(11, test::HALF_SECOND));
+    ASSERT_EQ(buffer.size(), 3u);
+    ASSERT_EQ(buffer.memory(), 30u);
+
+    EventWindowBuffer::SamplesBatch samples;
+    buffer.move_to(samples);
+
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_EQ(buffer.memory(), 0u);
+    ASSERT_EQ(samples.size(), 3u);
+    ASSERT_EQ(samples[0]->log_time, ddspipe::core::types::DataTime(11, test::HALF_SECOND));
+    ASSERT_EQ(samples[1]->log_time, ddspipe::core::types::DataTime(12, 0));
+    ASSERT_EQ(samples[2]->log_time, ddspipe::core::types::DataTime(12, test::HALF_SECOND));
+}
+
+/**
+ * Check that every sample is removed when the threshold is newer than all of them.
+ */
+TEST(EventWindowBufferTest, remove_outdated_all)
+{
+    auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+    EventWindowBuffer buffer;
+
+    buffer.push_back(test::message(payload_pool, 10, 0));
+    buffer.push_back(test::message(payload_pool, 11, 0));
+
+    buffer.remove_outdated(ddspipe::core::types::DataTime(20, 0));
+
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_EQ(buffer.memory(), 0u);
+}
+
+/**
+ * Check that spilling a sample does not modify it (so it can be shared), and that its payload is restored when the
+ * buffer is moved.
+ */
+TEST(EventWindowBufferTest, spill_keeps_sample)
+{
+    auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+    EventWindowBuffer buffer;
+    buffer.enable_spill(std::make_unique<EventWindowSpill>(test::SPILL_FILE, 100), 0);
+
+    const auto sample = test::message(payload_pool, 10, 0, 10, 0x2A);
+    buffer.push_back(sample);
+
+    // The payload of the buffered sample is spilled, but the sample referenced outside the buffer is untouched
+    ASSERT_EQ(buffer.memory(), 0u);
+    ASSERT_EQ(sample->payload.length, 10u);
+    ASSERT_NE(sample->payload.data, nullptr);
+
+    EventWindowBuffer::SamplesBatch samples;
+    buffer.move_to(samples);
+
+    ASSERT_EQ(samples.size(), 1u);
+    ASSERT_EQ(samples[0]->log_time, sample->log_time);
+    ASSERT_EQ(samples[0]->payload.length, 10u);
+    ASSERT_EQ(std::memcmp(samples[0]->payload.data, sample->payload.data, 10), 0);
+}
+
+/**
+ * Check that a sample received after every sample in its bucket has been visited by the spill is spilled too.
+ */
+TEST(EventWindowBufferTest, spill_same_second)
+{
+    auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+    EventWindowBuffer buffer;
+    buffer.enable_spill(std::make_unique<EventWindowSpill>(test::SPILL_FILE, 15), 0);
+
+    // Too large to be spilled: kept in memory
+    buffer.push_back(test::message(payload_pool, 10, 0, 20));
+    ASSERT_EQ(buffer.memory(), 20u);
+
+    // Received in the same second: spilled
+    buffer.push_back(test::message(payload_pool, 10, test::HALF_SECOND, 10));
+    ASSERT_EQ(buffer.memory(), 20u);
+
+    EventWindowBuffer::SamplesBatch samples;
+    buffer.move_to(samples);
+
+    ASSERT_EQ(samples.size(), 2u);
+    ASSERT_EQ(samples[0]->payload.length, 20u);
+    ASSERT_EQ(samples[1]->payload.length, 10u);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,129 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <vector>
+
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/recorder/handler/EventWindowSpill.hpp>
+
+using namespace eprosima;
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+constexpr const char* SPILL_FILE = "event_window_spill_test.spill";
+
+std::vector<char> payload(
+        std::size_t size,
+        char value)
+{
+    return std::vector<char>(size, value);
+}
+
+} // namespace test
+
+/**
+ * Check that a payload written to the spill file is read back unchanged, and that the file is removed on destruction.
+ */
+TEST(EventWindowSpillTest, write_read)
+{
+    {
+        EventWindowSpill spill(test::SPILL_FILE, 64);
+
+        ASSERT_TRUE(std::filesystem::exists(test::SPILL_FILE));
+        ASSERT_EQ(std::filesystem::file_size(test::SPILL_FILE), 64u);
+
+        const auto data = test::payload(10, 'a');
+
+        EventWindowSpill::RecordId record;
+        ASSERT_TRUE(spill.write(data.data(), data.size(), record));
+        ASSERT_EQ(spill.size(record), 10u);
+
+        std::vector<char> read_data(10);
+        spill.read(record, read_data.data());
+        ASSERT_EQ(read_data, data);
+    }
+
+    ASSERT_FALSE(std::filesystem::exists(test::SPILL_FILE));
+}
+
+/**
+ * Check that writing fails once the spill file is full, and that the space is reused (wrapping around) only once the
+ * oldest payloads are released.
+ */
+TEST(EventWindowSpillTest, ring)
+{
+    EventWindowSpill spill(test::SPILL_FILE, 30);
+
+    EventWindowSpill::RecordId first, second, third, fourth;
+
+    ASSERT_TRUE(spill.write(test::payload(10, 'a').data(), 10, first));
+    ASSERT_TRUE(spill.write(test::payload(10, 'b').data(), 10, second));
+    ASSERT_TRUE(spill.write(test::payload(10, 'c').data(), 10, third));
+    ASSERT_FALSE(spill.write(test::payload(10, 'd').data(), 10, fourth));
+
+    // Releasing a payload other than the oldest one does not free space
+    spill.release(second);
+    ASSERT_FALSE(spill.write(test::payload(10, 'd').data(), 10, fourth));
+
+    // Releasing the oldest payload frees its space and the one of the already released payloads
+    spill.release(first);
+    ASSERT_TRUE(spill.write(test::payload(20, 'd').data(), 20, fourth));
+
+    std::vector<char> read_data(10);
+    spill.read(third, read_data.data());
+    ASSERT_EQ(read_data, test::payload(10, 'c'));
+
+    read_data.resize(20);
+    spill.read(fourth, read_data.data());
+    ASSERT_EQ(read_data, test::payload(20, 'd'));
+}
+
+/**
+ * Check that payloads larger than the spill file are rejected, and that clearing the spill file frees all its space.
+ */
+TEST(EventWindowSpillTest, clear)
+{
+    EventWindowSpill spill(test::SPILL_FILE, 30);
+
+    EventWindowSpill::RecordId record;
+
+    ASSERT_FALSE(spill.write(test::payload(31, 'a').data(), 31, record));
+
+    ASSERT_TRUE(spill.write(test::payload(20, 'a').data(), 20, record));
+    ASSERT_FALSE(spill.write(test::payload(20, 'b').data(), 20, record));
+
+    spill.clear();
+    ASSERT_TRUE(spill.write(test::payload(30, 'b').data(), 30, record));
+}
+
+/**
+ * Check that a spill file of size 0 cannot be created.
+ */
+TEST(EventWindowSpillTest, empty_capacity)
+{
+    ASSERT_THROW(EventWindowSpill(test::SPILL_FILE, 0), utils::InitializationException);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
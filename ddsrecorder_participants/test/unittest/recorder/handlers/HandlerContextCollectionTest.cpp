@@ -17,9 +17,22 @@
 #include <cpp_utils/testing/gtest_aux.hpp>
 #include <gtest/gtest.h>
 
+#include <fastdds/dds/xtypes/type_representation/TypeObject.hpp>
+
+#include <ddspipe_core/dynamic/DiscoveryDatabase.hpp>
+#include <ddspipe_core/dynamic/ParticipantsDatabase.hpp>
+#include <ddspipe_core/efficiency/payload/FastPayloadPool.hpp>
+#include <ddspipe_core/types/data/RtpsPayloadData.hpp>
+#include <ddspipe_core/types/topic/dds/DdsTopic.hpp>
+#include <ddspipe_participants/configuration/ParticipantConfiguration.hpp>
+
 #include <ddsrecorder_participants/recorder/handler/HandlerContextCollection.hpp>
+#include <ddsrecorder_participants/recorder/handler/HandlerFanOut.hpp>
 #include <ddsrecorder_participants/recorder/handler/mcap/McapHandler.hpp>
+#include <ddsrecorder_participants/recorder/handler/mcap/McapHandlerConfiguration.hpp>
 #include <ddsrecorder_participants/recorder/handler/sql/SqlHandler.hpp>
+#include <ddsrecorder_participants/recorder/handler/sql/SqlHandlerConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/output/OutputSettings.hpp>
 
 using namespace eprosima;
 using namespace eprosima::fastdds::dds;
@@ -40,6 +53,15 @@ public:
 
 };
 
+struct MockHandlerFanOut
+    : public ddsrecorder::participants::HandlerFanOut
+{
+public:
+
+    // Expose the handlers fed by the fan-out
+    using HandlerFanOut::handlers_;
+};
+
 class HandlerContextCollectionTest : public testing::Test
 {
 public:
@@ -60,6 +82,46 @@ public:
 
 protected:
 
+    /**
+     * Create a MCAP and a SQL handler contexts fed by \c fan_out, and return their handlers (in that order).
+     */
+    std::vector<std::shared_ptr<BaseHandler>> create_fan_out_contexts_(
+            const std::shared_ptr<MockHandlerFanOut>& fan_out)
+    {
+        auto participant_configuration = std::make_shared<ddspipe::participants::ParticipantConfiguration>();
+        participant_configuration->id = "RecorderParticipant";
+
+        OutputSettings output_settings;
+
+        McapHandlerConfiguration mcap_configuration(output_settings, 5000, 100, 20, 0, false, false,
+                mcap::McapWriterOptions("ros2"), false, false);
+        SqlHandlerConfiguration sql_configuration(output_settings, 5000, 100, 20, 0, false, false, false,
+                DataFormat::both);
+
+        handler_contexts_->init_handler_context(HandlerContext::create_context(
+                    HandlerContext::HandlerKind::MCAP, &mcap_configuration, participant_configuration, payload_pool_,
+                    participants_database_, discovery_database_, BaseHandlerStateCode::RUNNING, nullptr, fan_out));
+
+        handler_contexts_->init_handler_context(HandlerContext::create_context(
+                    HandlerContext::HandlerKind::SQL, &sql_configuration, participant_configuration, payload_pool_,
+                    participants_database_, discovery_database_, BaseHandlerStateCode::RUNNING, nullptr, fan_out));
+
+        std::vector<std::shared_ptr<BaseHandler>> handlers;
+
+        for (const auto& handler : fan_out->handlers_)
+        {
+            handlers.push_back(std::dynamic_pointer_cast<BaseHandler>(handler));
+        }
+
+        return handlers;
+    }
+
+    std::shared_ptr<ddspipe::core::PayloadPool> payload_pool_{std::make_shared<ddspipe::core::FastPayloadPool>()};
+    std::shared_ptr<ddspipe::core::ParticipantsDatabase> participants_database_{
+        std::make_shared<ddspipe::core::ParticipantsDatabase>()};
+    std::shared_ptr<ddspipe::core::DiscoveryDatabase> discovery_database_{
+        std::make_shared<ddspipe::core::DiscoveryDatabase>()};
+
     std::unique_ptr<ddsrecorder::participants::HandlerContextCollection> handler_contexts_{nullptr};
     std::shared_ptr<BaseHandler> mcap_handler_{nullptr};
     std::shared_ptr<BaseHandler> sql_handler_{nullptr};
@@ -105,6 +167,91 @@ TEST_F(HandlerContextCollectionTest, bad_initialization)
     EXPECT_EQ(ret, utils::ReturnCode::RETCODE_PRECONDITION_NOT_MET);
 }
 
+/**
+ * Test that the MCAP and SQL handlers are fed by a single participant through a fan-out.
+ * CASES:
+ * - A single participant is registered for both handlers.
+ * - Both handlers are fed by the fan-out, in the order their contexts were created.
+ */
+TEST_F(HandlerContextCollectionTest, fan_out_single_participant)
+{
+    auto fan_out = std::make_shared<MockHandlerFanOut>();
+    const auto handlers = create_fan_out_contexts_(fan_out);
+
+    ASSERT_EQ(participants_database_->get_participants_ids().size(), 1u);
+    ASSERT_NE(fan_out->get_schema_participant(), nullptr);
+
+    ASSERT_EQ(handlers.size(), 2u);
+    ASSERT_NE(handlers[0], nullptr);
+    ASSERT_NE(handlers[1], nullptr);
+    ASSERT_NE(handlers[0], handlers[1]);
+}
+
+/**
+ * Test that the fan-out forwards every schema and sample to every handler exactly once.
+ * CASES:
+ * - Each schema and sample reaches both handlers once.
+ * - Stopping one handler does not prevent the other from receiving the samples.
+ * - Pausing one handler does not prevent the other from receiving the samples.
+ */
+TEST_F(HandlerContextCollectionTest, fan_out_forward_once)
+{
+    constexpr unsigned int NUMBER_OF_SAMPLES = 10;
+
+    auto fan_out = std::make_shared<MockHandlerFanOut>();
+    const auto handlers = create_fan_out_contexts_(fan_out);
+
+    ASSERT_EQ(handlers.size(), 2u);
+
+    const auto& mcap_handler = handlers[0];
+    const auto& sql_handler = handlers[1];
+
+    handler_contexts_->start_nts();
+
+    ddspipe::core::types::DdsTopic topic;
+    ddspipe::core::types::RtpsPayloadData data;
+
+    const auto send_samples = [&]()
+            {
+                for (unsigned int i = 0; i < NUMBER_OF_SAMPLES; i++)
+                {
+                    fan_out->add_data(topic, data);
+                }
+            };
+
+    fan_out->add_schema(fastdds::dds::DynamicType::_ref_type(), fastdds::dds::xtypes::TypeIdentifier());
+    send_samples();
+
+    ASSERT_EQ(mcap_handler->schemas_received, 1u);
+    ASSERT_EQ(sql_handler->schemas_received, 1u);
+    ASSERT_EQ(mcap_handler->samples_received, NUMBER_OF_SAMPLES);
+    ASSERT_EQ(sql_handler->samples_received, NUMBER_OF_SAMPLES);
+
+    // Stop the MCAP handler: the SQL handler still receives every sample
+    mcap_handler->stop();
+    send_samples();
+
+    ASSERT_EQ(mcap_handler->samples_received, NUMBER_OF_SAMPLES);
+    ASSERT_EQ(sql_handler->samples_received, 2 * NUMBER_OF_SAMPLES);
+
+    // Pause the SQL handler and stop it afterwards: the MCAP handler still receives every sample
+    mcap_handler->start();
+    sql_handler->pause();
+    send_samples();
+
+    ASSERT_EQ(mcap_handler->samples_received, 2 * NUMBER_OF_SAMPLES);
+    ASSERT_EQ(sql_handler->samples_received, 3 * NUMBER_OF_SAMPLES);
+
+    sql_handler->stop();
+    send_samples();
+
+    ASSERT_EQ(mcap_handler->samples_received, 3 * NUMBER_OF_SAMPLES);
+    ASSERT_EQ(sql_handler->samples_received, 3 * NUMBER_OF_SAMPLES);
+
+    ASSERT_EQ(mcap_handler->schemas_received, 1u);
+    ASSERT_EQ(sql_handler->schemas_received, 1u);
+}
+
 int main(
         int argc,
         char** argv)
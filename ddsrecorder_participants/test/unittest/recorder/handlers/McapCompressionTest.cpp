@@ -0,0 +1,584 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <mcap/internal.hpp>
+#include <mcap/mcap.hpp>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/recorder/handler/mcap/McapCompressionPolicy.hpp>
+
+using namespace eprosima::ddsrecorder::participants;
+using namespace std::chrono_literals;
+
+namespace test {
+
+const std::string FILENAME = "mcap_compression_test.mcap";
+
+constexpr std::uint64_t CHUNK_SIZE = 4 * 1024;
+
+constexpr std::uint32_t COMPRESSION_THREADS = 4;
+
+/**
+ * Options of the MCAP writer, with chunks small enough for a few hundred messages to fill many of them.
+ */
+mcap::McapWriterOptions options(
+        mcap::Compression compression,
+        std::uint32_t compression_threads)
+{
+    mcap::McapWriterOptions options("ros2");
+    options.compression = compression;
+    options.compressionLevel = mcap::CompressionLevel::Default;
+    options.chunkSize = CHUNK_SIZE;
+    options.compressionThreads = compression_threads;
+
+    return options;
+}
+
+/**
+ * The (compressible) data of the message with sequence number \c sequence .
+ */
+std::string message_data(
+        std::uint32_t sequence)
+{
+    return "message " + std::to_string(sequence) + " " + std::string(200, static_cast<char>('a' + sequence % 26));
+}
+
+/**
+ * Writes an MCAP file with a single channel in memory.
+ */
+class McapFile
+{
+public:
+
+    McapFile(
+            const mcap::McapWriterOptions& options)
+    {
+        writer_.open(stream_, options);
+
+        mcap::Schema schema("test_type", "omgidl", "struct test_type { string value; };");
+        writer_.addSchema(schema);
+
+        mcap::Channel channel("test_topic", "cdr", schema.id);
+        writer_.addChannel(channel);
+        channel_id_ = channel.id;
+    }
+
+    ~McapFile()
+    {
+        writer_.terminate();
+    }
+
+    //! Writes the next message
+    void write()
+    {
+        const auto data = message_data(message_count_);
+
+        mcap::Message message;
+        message.channelId = channel_id_;
+        message.sequence = message_count_;
+        message.logTime = 1000 + message_count_;
+        message.publishTime = message.logTime;
+        message.data = reinterpret_cast<const std::byte*>(data.data());
+        message.dataSize = data.size();
+
+        ASSERT_TRUE(writer_.write(message).ok());
+        message_count_++;
+    }
+
+    //! Writes the next \c count messages
+    void write(
+            std::uint32_t count)
+    {
+        for (std::uint32_t i = 0; i < count; i++)
+        {
+            write();
+        }
+    }
+
+    //! Compresses the next chunks with \c compression
+    void set_compression(
+            mcap::Compression compression,
+            mcap::CompressionLevel compression_level = mcap::CompressionLevel::Default)
+    {
+        writer_.setCompression(compression, compression_level);
+    }
+
+    //! The number of full chunks not written yet
+    std::size_t pending_chunk_count() const
+    {
+        return writer_.pendingChunkCount();
+    }
+
+    //! The number of messages written so far
+    std::uint32_t message_count() const
+    {
+        return message_count_;
+    }
+
+    //! Closes the file and returns its bytes
+    std::string close()
+    {
+        writer_.close();
+        return stream_.str();
+    }
+
+protected:
+
+    std::ostringstream stream_;
+    mcap::McapWriter writer_;
+    mcap::ChannelId channel_id_{0};
+    std::uint32_t message_count_{0};
+};
+
+/**
+ * Reads back an MCAP file through its summary, and checks that:
+ * - Its chunk indexes point to its chunks and message indexes.
+ * - Its message indexes point to its messages, which are read in the order they were written.
+ *
+ * @return The compression of each chunk, in the order they were written.
+ */
+std::vector<std::string> check_file(
+        std::string bytes,
+        const std::uint32_t message_count)
+{
+    std::vector<std::string> compressions;
+
+    {
+        std::ofstream file(FILENAME, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), bytes.size());
+    }
+
+    mcap::McapReader reader;
+    EXPECT_TRUE(reader.open(FILENAME).ok());
+    EXPECT_TRUE(reader.readSummary(mcap::ReadSummaryMethod::NoFallbackScan).ok());
+
+    const auto data = reinterpret_cast<std::byte*>(bytes.data());
+    std::uint64_t indexed_message_count = 0;
+
+    for (const auto& chunk_index : reader.chunkIndexes())
+    {
+        EXPECT_LE(chunk_index.chunkStartOffset + chunk_index.chunkLength + chunk_index.messageIndexLength,
+                bytes.size());
+        EXPECT_EQ(static_cast<mcap::OpCode>(data[chunk_index.chunkStartOffset]), mcap::OpCode::Chunk);
+
+        for (const auto& [channel_id, offset] : chunk_index.messageIndexOffsets)
+        {
+            EXPECT_EQ(static_cast<mcap::OpCode>(data[offset]), mcap::OpCode::MessageIndex);
+
+            const mcap::Record record{mcap::OpCode::MessageIndex, mcap::internal::ParseUint64(data + offset + 1),
+                                      data + offset + 9};
+
+            mcap::MessageIndex message_index;
+            EXPECT_TRUE(mcap::McapReader::ParseMessageIndex(record, &message_index).ok());
+            EXPECT_EQ(message_index.channelId, channel_id);
+
+            indexed_message_count += message_index.records.size();
+        }
+
+        compressions.push_back(chunk_index.compression);
+    }
+
+    EXPECT_EQ(indexed_message_count, message_count);
+
+    // NOTE: The messages are read at the offsets in the message indexes of the chunks
+    std::uint32_t messages_read = 0;
+    std::uint32_t problems = 0;
+
+    for (const auto& message_view : reader.readMessages([&](const mcap::Status&)
+            {
+                problems++;
+            }))
+    {
+        EXPECT_EQ(message_view.message.sequence, messages_read);
+        EXPECT_EQ(std::string(reinterpret_cast<const char*>(message_view.message.data),
+                message_view.message.dataSize), message_data(messages_read));
+        EXPECT_TRUE(message_view.messageOffset.chunkOffset.has_value());
+
+        messages_read++;
+    }
+
+    EXPECT_EQ(problems, 0u);
+    EXPECT_EQ(messages_read, message_count);
+
+    reader.close();
+    std::filesystem::remove(FILENAME);
+
+    return compressions;
+}
+
+/**
+ * Feeds \c count chunks to \c policy , and returns how many of them changed its compression settings.
+ */
+std::uint32_t on_chunks(
+        McapCompressionPolicy& policy,
+        const std::uint32_t count,
+        const std::chrono::nanoseconds fill_time,
+        const std::chrono::nanoseconds compression_time,
+        const std::size_t pending_chunks = 0)
+{
+    std::uint32_t changes = 0;
+
+    for (std::uint32_t i = 0; i < count; i++)
+    {
+        if (policy.on_chunk(fill_time, compression_time, pending_chunks))
+        {
+            changes++;
+        }
+    }
+
+    return changes;
+}
+
+} // namespace test
+
+/**
+ * Check that the chunks compressed by the compression threads are written exactly as if compressed inline.
+ */
+TEST(McapCompressionTest, threaded_identical)
+{
+    constexpr std::uint32_t MESSAGE_COUNT = 500;
+
+    for (const auto compression : {mcap::Compression::Zstd, mcap::Compression::Lz4})
+    {
+        test::McapFile inline_file(test::options(compression, 0));
+        inline_file.write(MESSAGE_COUNT);
+
+        test::McapFile threaded_file(test::options(compression, test::COMPRESSION_THREADS));
+        threaded_file.write(MESSAGE_COUNT);
+
+        const auto bytes = threaded_file.close();
+        ASSERT_EQ(bytes, inline_file.close());
+
+        const auto compressions = test::check_file(bytes, MESSAGE_COUNT);
+        ASSERT_GT(compressions.size(), 1u);
+
+        for (const auto& chunk_compression : compressions)
+        {
+            ASSERT_EQ(chunk_compression, mcap::internal::CompressionString(compression));
+        }
+    }
+}
+
+/**
+ * Check that closing the file while chunks are still being compressed writes every one of them, in order.
+ */
+TEST(McapCompressionTest, threaded_close_with_queued_chunks)
+{
+    constexpr std::uint32_t MAX_MESSAGE_COUNT = 1000;
+
+    test::McapFile threaded_file(test::options(mcap::Compression::Zstd, test::COMPRESSION_THREADS));
+
+    // Write a few chunks, and stop right after a chunk is handed over to the compression threads
+    threaded_file.write(100);
+
+    do
+    {
+        threaded_file.write();
+    }
+    while (threaded_file.pending_chunk_count() == 0 && threaded_file.message_count() < MAX_MESSAGE_COUNT);
+
+    ASSERT_GT(threaded_file.pending_chunk_count(), 0u);
+
+    // Leave a chunk in progress too
+    threaded_file.write(3);
+
+    const auto message_count = threaded_file.message_count();
+    const auto bytes = threaded_file.close();
+
+    test::McapFile inline_file(test::options(mcap::Compression::Zstd, 0));
+    inline_file.write(message_count);
+
+    ASSERT_EQ(bytes, inline_file.close());
+
+    test::check_file(bytes, message_count);
+}
+
+/**
+ * Check that the compression settings changed in the middle of a file (with chunks in progress and being compressed)
+ * apply to the next chunks, the same as if compressed inline.
+ */
+TEST(McapCompressionTest, threaded_change_compression)
+{
+    constexpr std::uint32_t MESSAGES_PER_STEP = 150;
+
+    const auto write = [&](test::McapFile& file)
+            {
+                file.write(MESSAGES_PER_STEP);
+                file.set_compression(mcap::Compression::Lz4);
+                file.write(MESSAGES_PER_STEP);
+                file.set_compression(mcap::Compression::None);
+                file.write(MESSAGES_PER_STEP);
+                file.set_compression(mcap::Compression::Zstd, mcap::CompressionLevel::Fastest);
+                file.write(MESSAGES_PER_STEP);
+            };
+
+    test::McapFile inline_file(test::options(mcap::Compression::Zstd, 0));
+    write(inline_file);
+
+    test::McapFile threaded_file(test::options(mcap::Compression::Zstd, test::COMPRESSION_THREADS));
+    write(threaded_file);
+
+    const auto bytes = threaded_file.close();
+    ASSERT_EQ(bytes, inline_file.close());
+
+    const auto compressions = test::check_file(bytes, 4 * MESSAGES_PER_STEP);
+
+    ASSERT_EQ(compressions.front(), "zstd");
+    ASSERT_NE(std::find(compressions.begin(), compressions.end(), "lz4"), compressions.end());
+    ASSERT_NE(std::find(compressions.begin(), compressions.end(), ""), compressions.end());
+    ASSERT_EQ(compressions.back(), "zstd");
+}
+
+/**
+ * Check the compression settings the policy steps through, from the configured ones down to no compression.
+ */
+TEST(McapCompressionTest, policy_steps)
+{
+    using Step = McapCompressionPolicy::Step;
+
+    const auto steps = [](mcap::Compression compression, mcap::CompressionLevel compression_level, bool adaptive)
+            {
+                auto options = test::options(compression, 0);
+                options.compressionLevel = compression_level;
+                return McapCompressionPolicy(options, adaptive).steps();
+            };
+
+    // Not adaptive
+    ASSERT_EQ(steps(mcap::Compression::Zstd, mcap::CompressionLevel::Default, false),
+            (std::vector<Step>{{mcap::Compression::Zstd, mcap::CompressionLevel::Default}}));
+
+    // Nothing to step down to
+    ASSERT_EQ(steps(mcap::Compression::None, mcap::CompressionLevel::Default, true),
+            (std::vector<Step>{{mcap::Compression::None, mcap::CompressionLevel::Default}}));
+
+    // zstd steps down its levels, then to LZ4
+    ASSERT_EQ(steps(mcap::Compression::Zstd, mcap::CompressionLevel::Default, true),
+            (std::vector<Step>{
+        {mcap::Compression::Zstd, mcap::CompressionLevel::Default},
+        {mcap::Compression::Zstd, mcap::CompressionLevel::Fast},
+        {mcap::Compression::Zstd, mcap::CompressionLevel::Fastest},
+        {mcap::Compression::Lz4, mcap::CompressionLevel::Fastest},
+        {mcap::Compression::None, mcap::CompressionLevel::Default}}));
+
+    // LZ4 at a slower level steps down to the fastest one
+    ASSERT_EQ(steps(mcap::Compression::Lz4, mcap::CompressionLevel::Slow, true),
+            (std::vector<Step>{
+        {mcap::Compression::Lz4, mcap::CompressionLevel::Slow},
+        {mcap::Compression::Lz4, mcap::CompressionLevel::Fastest},
+        {mcap::Compression::None, mcap::CompressionLevel::Default}}));
+
+    ASSERT_EQ(steps(mcap::Compression::Lz4, mcap::CompressionLevel::Fastest, true),
+            (std::vector<Step>{
+        {mcap::Compression::Lz4, mcap::CompressionLevel::Fastest},
+        {mcap::Compression::None, mcap::CompressionLevel::Default}}));
+}
+
+/**
+ * Check that the policy lowers the compression one step per chunk compressed in more than half the time it took to
+ * fill, down to no compression.
+ */
+TEST(McapCompressionTest, policy_step_down)
+{
+    McapCompressionPolicy policy(test::options(mcap::Compression::Zstd, 0), true);
+    ASSERT_TRUE(policy.is_adaptive());
+
+    const auto step_count = policy.steps().size();
+
+    // Exactly half the fill time is fast enough
+    ASSERT_EQ(test::on_chunks(policy, 10, 100ms, 50ms), 0u);
+    ASSERT_EQ(policy.step_index(), 0u);
+
+    for (std::size_t step = 1; step < step_count; step++)
+    {
+        ASSERT_TRUE(policy.on_chunk(100ms, 51ms, 0));
+        ASSERT_EQ(policy.step_index(), step);
+    }
+
+    ASSERT_EQ(policy.step(), std::make_pair(mcap::Compression::None, mcap::CompressionLevel::Default));
+
+    // There is no lighter compression than none
+    ASSERT_EQ(test::on_chunks(policy, 10, 100ms, 1s), 0u);
+    ASSERT_EQ(policy.step_index(), step_count - 1);
+}
+
+/**
+ * Check that the compression threads have as much time to compress a chunk as it takes to fill one per thread, and
+ * that the policy lowers the compression when they fall behind.
+ */
+TEST(McapCompressionTest, policy_step_down_backlog)
+{
+    McapCompressionPolicy policy(test::options(mcap::Compression::Zstd, test::COMPRESSION_THREADS), true);
+
+    // The compression time is compared to the fill time of every thread
+    ASSERT_EQ(test::on_chunks(policy, 10, 100ms, 200ms, test::COMPRESSION_THREADS - 1), 0u);
+    ASSERT_EQ(policy.step_index(), 0u);
+
+    ASSERT_TRUE(policy.on_chunk(100ms, 201ms, 0));
+    ASSERT_EQ(policy.step_index(), 1u);
+
+    // A chunk per thread waiting to be written is a backlog, however fast the last chunk was compressed
+    ASSERT_TRUE(policy.on_chunk(100ms, 1ms, test::COMPRESSION_THREADS));
+    ASSERT_EQ(policy.step_index(), 2u);
+}
+
+/**
+ * Check that the policy raises the compression one step after enough consecutive chunks compressed in less than a
+ * tenth of the time it took to fill them, up to the configured compression.
+ */
+TEST(McapCompressionTest, policy_step_up)
+{
+    constexpr auto IDLE_CHUNKS = McapCompressionPolicy::IDLE_CHUNKS_TO_RAISE_COMPRESSION;
+
+    McapCompressionPolicy policy(test::options(mcap::Compression::Zstd, 0), true);
+
+    // Nothing to raise above the configured compression
+    ASSERT_EQ(test::on_chunks(policy, 10 * IDLE_CHUNKS, 100ms, 1ms), 0u);
+    ASSERT_EQ(policy.step_index(), 0u);
+
+    ASSERT_EQ(test::on_chunks(policy, 2, 100ms, 1s), 2u);
+    ASSERT_EQ(policy.step_index(), 2u);
+
+    ASSERT_EQ(test::on_chunks(policy, IDLE_CHUNKS - 1, 100ms, 9ms), 0u);
+    ASSERT_EQ(policy.step_index(), 2u);
+
+    ASSERT_TRUE(policy.on_chunk(100ms, 9ms, 0));
+    ASSERT_EQ(policy.step_index(), 1u);
+
+    // The idle chunks are counted again from the step up
+    ASSERT_EQ(test::on_chunks(policy, IDLE_CHUNKS - 1, 100ms, 9ms), 0u);
+    ASSERT_TRUE(policy.on_chunk(100ms, 9ms, 0));
+    ASSERT_EQ(policy.step_index(), 0u);
+
+    ASSERT_EQ(test::on_chunks(policy, 10 * IDLE_CHUNKS, 100ms, 1ms), 0u);
+    ASSERT_EQ(policy.step_index(), 0u);
+}
+
+/**
+ * Check that the policy only raises the compression after consecutive idle chunks, so it does not oscillate between
+ * two steps: a chunk between the thresholds to lower and raise the compression, or one above the threshold to lower
+ * it, starts the count again.
+ */
+TEST(McapCompressionTest, policy_hysteresis)
+{
+    constexpr auto IDLE_CHUNKS = McapCompressionPolicy::IDLE_CHUNKS_TO_RAISE_COMPRESSION;
+
+    McapCompressionPolicy policy(test::options(mcap::Compression::Zstd, 0), true);
+
+    ASSERT_TRUE(policy.on_chunk(100ms, 60ms, 0));
+    ASSERT_EQ(policy.step_index(), 1u);
+
+    // Between the thresholds, the compression is kept
+    ASSERT_EQ(test::on_chunks(policy, 10 * IDLE_CHUNKS, 100ms, 10ms), 0u);
+    ASSERT_EQ(test::on_chunks(policy, 10 * IDLE_CHUNKS, 100ms, 50ms), 0u);
+    ASSERT_EQ(policy.step_index(), 1u);
+
+    // A chunk between the thresholds resets the idle chunks
+    ASSERT_EQ(test::on_chunks(policy, IDLE_CHUNKS - 1, 100ms, 1ms), 0u);
+    ASSERT_FALSE(policy.on_chunk(100ms, 30ms, 0));
+    ASSERT_EQ(test::on_chunks(policy, IDLE_CHUNKS - 1, 100ms, 1ms), 0u);
+    ASSERT_EQ(policy.step_index(), 1u);
+
+    // A slow chunk resets them too (and lowers the compression)
+    ASSERT_TRUE(policy.on_chunk(100ms, 60ms, 0));
+    ASSERT_EQ(policy.step_index(), 2u);
+    ASSERT_EQ(test::on_chunks(policy, IDLE_CHUNKS - 1, 100ms, 1ms), 0u);
+    ASSERT_EQ(policy.step_index(), 2u);
+
+    ASSERT_TRUE(policy.on_chunk(100ms, 1ms, 0));
+    ASSERT_EQ(policy.step_index(), 1u);
+}
+
+/**
+ * Check that a file whose chunks are compressed with every step of the policy reads back.
+ */
+TEST(McapCompressionTest, mixed_compressions)
+{
+    constexpr std::uint32_t MESSAGES_PER_STEP = 60;
+
+    auto options = test::options(mcap::Compression::Zstd, 0);
+    options.compressionLevel = mcap::CompressionLevel::Slowest;
+
+    McapCompressionPolicy policy(options, true);
+
+    test::McapFile file(options);
+    std::vector<std::string> expected_compressions;
+
+    do
+    {
+        const auto& [compression, compression_level] = policy.step();
+
+        file.set_compression(compression, compression_level);
+        file.write(MESSAGES_PER_STEP);
+        expected_compressions.push_back(mcap::internal::CompressionString(compression));
+    }
+    while (policy.on_chunk(100ms, 1s, 0));
+
+    // ... and back up
+    while (policy.step_index() > 0)
+    {
+        test::on_chunks(policy, McapCompressionPolicy::IDLE_CHUNKS_TO_RAISE_COMPRESSION, 100ms, 1ms);
+
+        const auto& [compression, compression_level] = policy.step();
+
+        file.set_compression(compression, compression_level);
+        file.write(MESSAGES_PER_STEP);
+        expected_compressions.push_back(mcap::internal::CompressionString(compression));
+    }
+
+    const auto message_count = file.message_count();
+    const auto compressions = test::check_file(file.close(), message_count);
+
+    // Every step writes a few chunks (the chunk in progress when the compression changes is written with the previous
+    // compression)
+    std::vector<std::string> step_compressions;
+
+    for (const auto& compression : compressions)
+    {
+        if (step_compressions.empty() || step_compressions.back() != compression)
+        {
+            step_compressions.push_back(compression);
+        }
+    }
+
+    std::vector<std::string> expected_step_compressions;
+
+    for (const auto& compression : expected_compressions)
+    {
+        if (expected_step_compressions.empty() || expected_step_compressions.back() != compression)
+        {
+            expected_step_compressions.push_back(compression);
+        }
+    }
+
+    ASSERT_EQ(step_compressions, expected_step_compressions);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
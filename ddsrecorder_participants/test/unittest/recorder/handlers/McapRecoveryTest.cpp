@@ -0,0 +1,332 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <mcap/internal.hpp>
+#include <mcap/mcap.hpp>
+
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/constants.hpp>
+#include <ddsrecorder_participants/recorder/handler/mcap/McapRecovery.hpp>
+
+using namespace eprosima;
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+const std::string FILENAME = "mcap_recovery_test.mcap";
+const std::string OUTPUT_FILENAME = "mcap_recovery_test_output.mcap";
+
+constexpr std::uint32_t MESSAGES_PER_CHUNK = 10;
+
+/**
+ * Writes an MCAP file chunk by chunk and takes its bytes at any point, as if the recorder had been killed then.
+ */
+class CrashedMcap
+{
+public:
+
+    CrashedMcap()
+    {
+        mcap::McapWriterOptions options("ros2");
+        options.compression = mcap::Compression::None;
+        options.chunkSize = 1024 * 1024;
+
+        writer_.open(stream_, options);
+    }
+
+    ~CrashedMcap()
+    {
+        writer_.terminate();
+    }
+
+    //! Adds a channel (and its schema), and writes a chunk with its messages
+    void write_chunk(
+            const std::string& topic)
+    {
+        auto channel_it = channels_.find(topic);
+
+        if (channel_it == channels_.end())
+        {
+            mcap::Schema schema(topic + "_type", "omgidl", "struct " + topic + "_type { long value; };");
+            writer_.addSchema(schema);
+            schemas_[schema.id] = schema;
+
+            mcap::Channel channel(topic, "cdr", schema.id);
+            writer_.addChannel(channel);
+            channel_it = channels_.emplace(topic, channel).first;
+        }
+
+        const std::string data = "payload of " + topic;
+
+        for (std::uint32_t i = 0; i < MESSAGES_PER_CHUNK; i++)
+        {
+            mcap::Message message;
+            message.channelId = channel_it->second.id;
+            message.sequence = message_count_;
+            message.logTime = 1000 + message_count_;
+            message.publishTime = message.logTime;
+            message.data = reinterpret_cast<const std::byte*>(data.data());
+            message.dataSize = data.size();
+
+            ASSERT_TRUE(writer_.write(message).ok());
+            message_count_++;
+        }
+
+        chunk_start_ = stream_.str().size();
+        writer_.closeLastChunk();
+    }
+
+    //! Writes a checkpoint with the schemas and channels added so far
+    void write_checkpoint()
+    {
+        std::map<mcap::SchemaId, mcap::Schema> schemas(schemas_.begin(), schemas_.end());
+        std::map<mcap::ChannelId, mcap::Channel> channels;
+
+        for (const auto& [_, channel] : channels_)
+        {
+            channels[channel.id] = channel;
+        }
+
+        std::string checkpoint;
+        McapRecovery::serialize_checkpoint(schemas, channels, checkpoint);
+
+        mcap::Attachment attachment;
+        attachment.name = CHECKPOINT_ATTACHMENT_NAME;
+        attachment.data = reinterpret_cast<const std::byte*>(checkpoint.data());
+        attachment.dataSize = checkpoint.size();
+
+        ASSERT_TRUE(writer_.write(attachment).ok());
+    }
+
+    //! The bytes written so far
+    std::string bytes() const
+    {
+        return stream_.str();
+    }
+
+    //! The offset at which the last chunk starts
+    std::uint64_t last_chunk_start() const
+    {
+        return chunk_start_;
+    }
+
+    //! The offset at which the message indexes of the last chunk start
+    std::uint64_t last_chunk_end() const
+    {
+        const auto bytes = stream_.str();
+        const auto length = mcap::internal::ParseUint64(reinterpret_cast<const std::byte*>(bytes.data()) +
+                        chunk_start_ + 1);
+
+        return chunk_start_ + 9 + length;
+    }
+
+    //! The number of messages written so far
+    std::uint64_t message_count() const
+    {
+        return message_count_;
+    }
+
+    //! Closes the file
+    void close()
+    {
+        writer_.close();
+    }
+
+protected:
+
+    std::ostringstream stream_;
+    mcap::McapWriter writer_;
+    std::map<std::string, mcap::Channel> channels_;
+    std::map<mcap::SchemaId, mcap::Schema> schemas_;
+    std::uint64_t message_count_{0};
+    std::uint64_t chunk_start_{0};
+};
+
+void write_file(
+        const std::string& filename,
+        const std::string& bytes)
+{
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), bytes.size());
+}
+
+/**
+ * Reads the summary of an MCAP file (without scanning it) and checks its statistics and that every message is read.
+ */
+void check_summary(
+        const std::string& filename,
+        const std::uint64_t message_count,
+        const std::uint32_t channel_count)
+{
+    mcap::McapReader reader;
+    ASSERT_TRUE(reader.open(filename).ok());
+    ASSERT_TRUE(reader.readSummary(mcap::ReadSummaryMethod::NoFallbackScan).ok());
+
+    const auto statistics = reader.statistics();
+    ASSERT_TRUE(statistics.has_value());
+    ASSERT_EQ(statistics->messageCount, message_count);
+    ASSERT_EQ(statistics->channelCount, channel_count);
+    ASSERT_EQ(reader.channels().size(), channel_count);
+
+    std::uint64_t messages_read = 0;
+
+    for (const auto& message_view : reader.readMessages())
+    {
+        ASSERT_NE(message_view.channel, nullptr);
+        messages_read++;
+    }
+
+    ASSERT_EQ(messages_read, message_count);
+
+    reader.close();
+}
+
+} // namespace test
+
+/**
+ * Check that a file killed in the middle of a chunk is recovered in place, with the channels added before and after
+ * its last checkpoint.
+ */
+TEST(McapRecoveryTest, recover_in_place)
+{
+    test::CrashedMcap mcap;
+    mcap.write_chunk("topic_0");
+    mcap.write_chunk("topic_1");
+    mcap.write_checkpoint();
+    mcap.write_chunk("topic_0");
+    mcap.write_chunk("topic_2");
+
+    const auto bytes = mcap.bytes();
+
+    // Part of a chunk that was being written
+    test::write_file(test::FILENAME, bytes + bytes.substr(mcap.last_chunk_start(), 100));
+
+    McapRecovery recovery(test::FILENAME);
+    const auto result = recovery.recover();
+
+    // NOTE: The message indexes of the last chunk may be incomplete, since no record follows them, so they are rebuilt
+    ASSERT_FALSE(result.complete);
+    ASSERT_EQ(result.data_size, mcap.last_chunk_end());
+    ASSERT_EQ(result.dropped_size, bytes.size() + 100 - mcap.last_chunk_end());
+    ASSERT_EQ(result.chunk_count, 4u);
+    ASSERT_EQ(result.message_count, mcap.message_count());
+
+    // Only the last chunk, with the channel added after the checkpoint, is decompressed
+    ASSERT_EQ(result.decompressed_chunk_count, 1u);
+
+    test::check_summary(test::FILENAME, mcap.message_count(), 3);
+
+    std::filesystem::remove(test::FILENAME);
+}
+
+/**
+ * Check that a file with no checkpoints is recovered to another file, finding its channels in its chunks.
+ */
+TEST(McapRecoveryTest, recover_without_checkpoint)
+{
+    test::CrashedMcap mcap;
+    mcap.write_chunk("topic_0");
+    mcap.write_chunk("topic_0");
+    mcap.write_chunk("topic_1");
+
+    const auto bytes = mcap.bytes();
+    test::write_file(test::FILENAME, bytes);
+
+    McapRecovery recovery(test::FILENAME);
+    const auto result = recovery.recover(test::OUTPUT_FILENAME);
+
+    ASSERT_FALSE(result.complete);
+    ASSERT_EQ(result.dropped_size, bytes.size() - mcap.last_chunk_end());
+    ASSERT_EQ(result.chunk_count, 3u);
+    ASSERT_EQ(result.decompressed_chunk_count, 2u);
+
+    test::check_summary(test::OUTPUT_FILENAME, mcap.message_count(), 2);
+
+    // The input file is left untouched
+    ASSERT_EQ(std::filesystem::file_size(test::FILENAME), bytes.size());
+
+    std::filesystem::remove(test::FILENAME);
+    std::filesystem::remove(test::OUTPUT_FILENAME);
+}
+
+/**
+ * Check that the message indexes of the last chunk are rebuilt if the file was killed before they were written.
+ */
+TEST(McapRecoveryTest, rebuild_message_indexes)
+{
+    test::CrashedMcap mcap;
+    mcap.write_chunk("topic_0");
+    mcap.write_checkpoint();
+    mcap.write_chunk("topic_0");
+
+    const auto bytes = mcap.bytes();
+    test::write_file(test::FILENAME, bytes.substr(0, mcap.last_chunk_end()));
+
+    McapRecovery recovery(test::FILENAME);
+    const auto result = recovery.recover();
+
+    ASSERT_FALSE(result.complete);
+    ASSERT_EQ(result.chunk_count, 2u);
+    ASSERT_EQ(result.decompressed_chunk_count, 1u);
+    ASSERT_EQ(result.message_count, mcap.message_count());
+
+    test::check_summary(test::FILENAME, mcap.message_count(), 1);
+
+    std::filesystem::remove(test::FILENAME);
+}
+
+/**
+ * Check that a closed file is left untouched, and that a file that is not an MCAP is rejected.
+ */
+TEST(McapRecoveryTest, complete_and_invalid)
+{
+    {
+        test::CrashedMcap mcap;
+        mcap.write_chunk("topic_0");
+        mcap.close();
+
+        test::write_file(test::FILENAME, mcap.bytes());
+    }
+
+    const auto size = std::filesystem::file_size(test::FILENAME);
+
+    McapRecovery recovery(test::FILENAME);
+    ASSERT_TRUE(recovery.recover().complete);
+    ASSERT_EQ(std::filesystem::file_size(test::FILENAME), size);
+
+    test::write_file(test::FILENAME, "not an MCAP file");
+
+    McapRecovery invalid_recovery(test::FILENAME);
+    ASSERT_THROW(invalid_recovery.recover(), utils::InitializationException);
+
+    std::filesystem::remove(test::FILENAME);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/common/serialize/SerializedDynamicTypesCollection.hpp>
+#include <ddsrecorder_participants/common/serialize/Serializer.hpp>
+
+using namespace eprosima;
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+/**
+ * Dynamic type whose strings have different lengths, so the types in the collection need different paddings.
+ */
+DynamicType dynamic_type(
+        unsigned int index)
+{
+    DynamicType type;
+    type.type_name("type_" + std::string(index, 'n'));
+    type.type_identifier(std::string(index * 3 + 1, 'i'));
+    type.type_object(std::string(index * 5 + 2, 'o'));
+
+    return type;
+}
+
+} // namespace test
+
+/**
+ * Check that a collection built one type at a time is deserialized into the same types, and that its size is the
+ * one anticipated before each append.
+ */
+TEST(SerializedDynamicTypesCollectionTest, round_trip)
+{
+    SerializedDynamicTypesCollection collection;
+
+    for (unsigned int i = 0; i < 10; i++)
+    {
+        std::string serialized_type;
+        SerializedDynamicTypesCollection::serialize(test::dynamic_type(i), serialized_type);
+
+        const auto expected_size = collection.size_after_append(serialized_type);
+        collection.append(serialized_type);
+
+        ASSERT_EQ(collection.str().size(), expected_size);
+        ASSERT_EQ(collection.count(), i + 1);
+    }
+
+    DynamicTypesCollection dynamic_types;
+    ASSERT_TRUE(Serializer::deserialize(collection.str(), dynamic_types));
+    ASSERT_EQ(dynamic_types.dynamic_types().size(), 10u);
+
+    for (unsigned int i = 0; i < 10; i++)
+    {
+        const auto expected_type = test::dynamic_type(i);
+        const auto& dynamic_type = dynamic_types.dynamic_types()[i];
+
+        ASSERT_EQ(dynamic_type.type_name(), expected_type.type_name());
+        ASSERT_EQ(dynamic_type.type_identifier(), expected_type.type_identifier());
+        ASSERT_EQ(dynamic_type.type_object(), expected_type.type_object());
+    }
+}
+
+/**
+ * Check that a collection without types is empty.
+ */
+TEST(SerializedDynamicTypesCollectionTest, empty)
+{
+    SerializedDynamicTypesCollection collection;
+
+    ASSERT_TRUE(collection.empty());
+    ASSERT_EQ(collection.count(), 0u);
+    ASSERT_TRUE(collection.str().empty());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,150 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddspipe_core/types/dds/Guid.hpp>
+
+#include <ddsrecorder_participants/common/serialize/SourceGuidIndex.hpp>
+
+using namespace eprosima;
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+ddspipe::core::types::Guid writer_guid(
+        std::uint8_t index)
+{
+    ddspipe::core::types::Guid guid;
+    guid.guidPrefix.value[0] = 0x01;
+    guid.guidPrefix.value[11] = index;
+    guid.entityId.value[3] = 0x03;
+
+    return guid;
+}
+
+std::string to_string(
+        const ddspipe::core::types::Guid& guid)
+{
+    std::ostringstream guid_ss;
+    guid_ss << guid;
+
+    return guid_ss.str();
+}
+
+} // namespace test
+
+/**
+ * Check that the writer of each message is found after serializing and deserializing the index, with messages written
+ * in runs of consecutive sequences, gaps between runs and runs written out of sequence order.
+ */
+TEST(SourceGuidIndexTest, round_trip)
+{
+    SourceGuidIndex index;
+
+    // Written before the messages 0-99, as a pending sample would be
+    index.add(150, test::writer_guid(2));
+
+    for (std::uint32_t sequence = 0; sequence < 100; sequence++)
+    {
+        index.add(sequence, test::writer_guid(sequence % 3));
+    }
+
+    for (std::uint32_t sequence = 200; sequence < 210; sequence++)
+    {
+        index.add(sequence, test::writer_guid(1));
+    }
+
+    std::string serialized;
+    index.serialize(serialized);
+    ASSERT_EQ(serialized.size(), index.serialized_size());
+
+    SourceGuidIndex deserialized_index;
+    ASSERT_TRUE(deserialized_index.deserialize(serialized));
+
+    for (std::uint32_t sequence = 0; sequence < 100; sequence++)
+    {
+        const auto writer_guid = deserialized_index.find(sequence);
+        ASSERT_NE(writer_guid, nullptr);
+        ASSERT_EQ(*writer_guid, test::to_string(test::writer_guid(sequence % 3)));
+    }
+
+    ASSERT_NE(deserialized_index.find(150), nullptr);
+    ASSERT_EQ(*deserialized_index.find(150), test::to_string(test::writer_guid(2)));
+
+    // Look up the messages out of order
+    ASSERT_EQ(*deserialized_index.find(209), test::to_string(test::writer_guid(1)));
+    ASSERT_EQ(*deserialized_index.find(4), test::to_string(test::writer_guid(1)));
+}
+
+/**
+ * Check that the messages that were not indexed are not found.
+ */
+TEST(SourceGuidIndexTest, unknown_sequence)
+{
+    SourceGuidIndex index;
+
+    for (std::uint32_t sequence = 10; sequence < 20; sequence++)
+    {
+        index.add(sequence, test::writer_guid(0));
+    }
+
+    std::string serialized;
+    index.serialize(serialized);
+
+    SourceGuidIndex deserialized_index;
+    ASSERT_TRUE(deserialized_index.deserialize(serialized));
+
+    ASSERT_EQ(deserialized_index.find(9), nullptr);
+    ASSERT_EQ(deserialized_index.find(20), nullptr);
+    ASSERT_NE(deserialized_index.find(15), nullptr);
+}
+
+/**
+ * Check that truncated or unversioned indexes are rejected and leave the index empty.
+ */
+TEST(SourceGuidIndexTest, malformed)
+{
+    SourceGuidIndex index;
+    index.add(0, test::writer_guid(0));
+    index.add(1, test::writer_guid(1));
+
+    std::string serialized;
+    index.serialize(serialized);
+
+    SourceGuidIndex deserialized_index;
+
+    for (std::size_t size = 0; size < serialized.size(); size++)
+    {
+        ASSERT_FALSE(deserialized_index.deserialize(serialized.substr(0, size)));
+        ASSERT_TRUE(deserialized_index.empty());
+    }
+
+    serialized[0] = 0x7F;
+    ASSERT_FALSE(deserialized_index.deserialize(serialized));
+    ASSERT_TRUE(deserialized_index.empty());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
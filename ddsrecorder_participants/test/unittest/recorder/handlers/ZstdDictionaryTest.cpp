@@ -0,0 +1,120 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <cpp_utils/testing/gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrecorder_participants/common/compression/ZstdDictionary.hpp>
+
+using namespace eprosima;
+using namespace eprosima::ddsrecorder::participants;
+
+namespace test {
+
+/**
+ * Small CDR-like message: the encapsulation, a few fixed fields and a counter, so the messages share most of their
+ * content.
+ */
+std::string message(
+        unsigned int index)
+{
+    std::string data("\x00\x01\x00\x00", 4);
+    data += "{\"robot\": \"robot_" + std::to_string(index % 8) + "\", \"status\": \"operational\", ";
+    data += "\"position\": {\"x\": " + std::to_string(index * 3 % 97) + ", ";
+    data += "\"y\": " + std::to_string(index % 13) + "}, ";
+    data += "\"sequence\": " + std::to_string(index) + "}";
+
+    return data;
+}
+
+std::vector<std::string> messages(
+        unsigned int count)
+{
+    std::vector<std::string> data;
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        data.push_back(message(i));
+    }
+
+    return data;
+}
+
+const std::byte* bytes(
+        const std::string& data)
+{
+    return reinterpret_cast<const std::byte*>(data.data());
+}
+
+} // namespace test
+
+/**
+ * Check that a message compressed with a trained dictionary is smaller, recognized as compressed, and decompressed
+ * back to the original message (also by a dictionary rebuilt from the stored one, as the replayer does).
+ */
+TEST(ZstdDictionaryTest, round_trip)
+{
+    const auto dictionary_data = ZstdDictionary::train(test::messages(1000), 4096);
+    ASSERT_FALSE(dictionary_data.empty());
+    ASSERT_LE(dictionary_data.size(), 4096u);
+
+    ZstdDictionary dictionary(dictionary_data);
+    ASSERT_TRUE(dictionary.is_valid());
+
+    ZstdDictionary stored_dictionary(dictionary.data());
+
+    const auto message = test::message(123456);
+
+    std::vector<std::byte> compressed;
+    ASSERT_TRUE(dictionary.compress(test::bytes(message), message.size(), compressed));
+    ASSERT_LT(compressed.size(), message.size());
+    ASSERT_TRUE(ZstdDictionary::is_compressed(compressed.data(), compressed.size()));
+
+    std::vector<std::byte> decompressed;
+    ASSERT_TRUE(stored_dictionary.decompress(compressed.data(), compressed.size(), decompressed));
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(decompressed.data()), decompressed.size()), message);
+}
+
+/**
+ * Check that CDR payloads (and payloads too small to hold a zstd frame) are not mistaken for compressed messages.
+ */
+TEST(ZstdDictionaryTest, not_compressed)
+{
+    const auto message = test::message(0);
+    ASSERT_FALSE(ZstdDictionary::is_compressed(test::bytes(message), message.size()));
+
+    const std::string magic_number("\x28\xB5\x2F\xFD", 4);
+    ASSERT_TRUE(ZstdDictionary::is_compressed(test::bytes(magic_number), magic_number.size()));
+    ASSERT_FALSE(ZstdDictionary::is_compressed(test::bytes(magic_number), magic_number.size() - 1));
+}
+
+/**
+ * Check that no dictionary is trained from too few samples.
+ */
+TEST(ZstdDictionaryTest, untrainable)
+{
+    ASSERT_TRUE(ZstdDictionary::train(test::messages(1), 4096).empty());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
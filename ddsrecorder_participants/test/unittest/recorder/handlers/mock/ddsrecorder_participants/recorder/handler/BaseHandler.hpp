@@ -15,7 +15,7 @@
 #pragma once
 
 #include <memory>
-#include <list>
+#include <vector>
 
 #include <ddspipe_participants/participant/dynamic_types/ISchemaHandler.hpp>
 
@@ -51,17 +51,17 @@ public:
 
     virtual void start()
     {
-
+        state = BaseHandlerStateCode::RUNNING;
     }
 
     virtual void stop()
     {
-
+        state = BaseHandlerStateCode::STOPPED;
     }
 
     virtual void pause()
     {
-
+        state = BaseHandlerStateCode::PAUSED;
     }
 
     virtual void trigger_event()
@@ -75,11 +75,34 @@ public:
     }
 
     virtual void write_samples_(
-            std::list<std::shared_ptr<const BaseMessage>>&)
+            std::vector<std::shared_ptr<const BaseMessage>>&)
     {
 
     }
 
+    void add_schema(
+            const fastdds::dds::DynamicType::_ref_type&,
+            const fastdds::dds::xtypes::TypeIdentifier& ) override
+    {
+        schemas_received++;
+    }
+
+    void add_data(
+            const ddspipe::core::types::DdsTopic&,
+            ddspipe::core::types::RtpsPayloadData& ) override
+    {
+        // Samples received while stopped are discarded
+        if (state != BaseHandlerStateCode::STOPPED)
+        {
+            samples_received++;
+        }
+    }
+
+    BaseHandlerStateCode state{BaseHandlerStateCode::RUNNING};
+
+    unsigned int schemas_received{0};
+
+    unsigned int samples_received{0};
 };
 
 } // namespace participants
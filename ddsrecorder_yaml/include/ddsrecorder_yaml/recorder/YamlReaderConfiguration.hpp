@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <mcap/mcap.hpp>
 
@@ -41,6 +42,9 @@
 #include <ddspipe_yaml/Yaml.hpp>
 #include <ddspipe_yaml/YamlReader.hpp>
 
+#include <ddsrecorder_participants/common/compression/ZstdDictionary.hpp>
+#include <ddsrecorder_participants/recorder/handler/mcap/McapHandlerConfiguration.hpp>
+#include <ddsrecorder_participants/recorder/handler/sql/KeyCache.hpp>
 #include <ddsrecorder_participants/recorder/handler/sql/SqlHandlerConfiguration.hpp>
 
 #include <ddsrecorder_yaml/library/library_dll.h>
@@ -91,9 +95,12 @@ public:
     unsigned int cleanup_period;
     unsigned int event_window = 20;
     int max_pending_samples = 5000;  // -1 <-> no limit || 0 <-> no pending samples
+    std::uint64_t max_buffer_memory = 0;  // 0 <-> no limit
     bool only_with_type = false;
     bool record_types = true;
     bool ros2_types = false;
+    bool async_write = false;
+    unsigned int async_write_queue_size = 10000;
 
     // Output file params
     std::string output_filepath = ".";
@@ -102,14 +109,30 @@ public:
     bool output_local_timestamp = true;
     std::uint64_t output_safety_margin = OUTPUT_SAFETY_MARGIN_MIN; // Force always the system to have at least 10MB free
 
+    // Event window spill params
+    bool event_window_spill_enabled = false;
+    std::string event_window_spill_path = ".";
+    std::uint64_t event_window_spill_size = 1024 * 1024 * 1024;  // 1GB
+    std::uint64_t event_window_spill_memory_threshold = 64 * 1024 * 1024;  // 64MB
+
     // Mcap params
     bool mcap_enabled = true;
     bool mcap_log_publish_time = false;
     mcap::McapWriterOptions mcap_writer_options{"ros2"};
+    bool mcap_adaptive_compression = false;
+    bool mcap_dictionary_enabled = false;
+    std::uint32_t mcap_dictionary_samples = 1000;
+    std::uint64_t mcap_dictionary_max_size = ddsrecorder::participants::ZstdDictionary::DEFAULT_MAX_SIZE;
+    std::uint32_t mcap_prepare_next_file = 0;  // Disabled
+    ddsrecorder::participants::McapIoBackend mcap_io_backend = ddsrecorder::participants::McapIoBackend::buffered;
+    std::uint32_t mcap_checkpoint_period = 0;  // Disabled
+    std::vector<ddsrecorder::participants::McapTopicGroup> mcap_topic_groups;
 
     // Sql params
     bool sql_enabled = false;
     ddsrecorder::participants::DataFormat sql_data_format = ddsrecorder::participants::DataFormat::both;
+    std::uint64_t sql_key_cache_max_entries = ddsrecorder::participants::KeyCache::DEFAULT_MAX_ENTRIES;
+    std::uint64_t sql_key_cache_max_memory = 0;  // No limit
 
     // Resource limits params
     ResourceLimitsConfiguration mcap_resource_limits;
@@ -143,14 +166,30 @@ protected:
             const Yaml& yml,
             const ddspipe::yaml::YamlReaderVersion& version);
 
+    void load_recorder_event_window_spill_configuration_(
+            const Yaml& yml,
+            const ddspipe::yaml::YamlReaderVersion& version);
+
     void load_recorder_mcap_configuration_(
             const Yaml& yml,
             const ddspipe::yaml::YamlReaderVersion& version);
 
+    void load_recorder_mcap_dictionary_configuration_(
+            const Yaml& yml,
+            const ddspipe::yaml::YamlReaderVersion& version);
+
+    void load_recorder_mcap_topic_groups_configuration_(
+            const Yaml& yml,
+            const ddspipe::yaml::YamlReaderVersion& version);
+
     void load_recorder_sql_configuration_(
             const Yaml& yml,
             const ddspipe::yaml::YamlReaderVersion& version);
 
+    void load_recorder_sql_key_cache_configuration_(
+            const Yaml& yml,
+            const ddspipe::yaml::YamlReaderVersion& version);
+
     void load_controller_configuration_(
             const Yaml& yml,
             const ddspipe::yaml::YamlReaderVersion& version);
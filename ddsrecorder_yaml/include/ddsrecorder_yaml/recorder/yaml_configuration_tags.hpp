@@ -41,9 +41,12 @@ constexpr const char* RECORDER_BUFFER_SIZE_TAG("buffer-size");
 constexpr const char* RECORDER_CLEANUP_PERIOD_TAG("cleanup-period");
 constexpr const char* RECORDER_EVENT_WINDOW_TAG("event-window");
 constexpr const char* RECORDER_MAX_PENDING_SAMPLES_TAG("max-pending-samples");
+constexpr const char* RECORDER_MAX_BUFFER_MEMORY_TAG("max-buffer-memory");
 constexpr const char* RECORDER_ONLY_WITH_TYPE_TAG("only-with-type");
 constexpr const char* RECORDER_RECORD_TYPES_TAG("record-types");
 constexpr const char* RECORDER_ROS2_TYPES_TAG("ros2-types");
+constexpr const char* RECORDER_ASYNC_WRITE_TAG("async-write");
+constexpr const char* RECORDER_ASYNC_WRITE_QUEUE_SIZE_TAG("async-write-queue-size");
 
 // Output related tags
 constexpr const char* RECORDER_OUTPUT_TAG("output");
@@ -53,6 +56,13 @@ constexpr const char* RECORDER_OUTPUT_TIMESTAMP_FORMAT_TAG("timestamp-format");
 constexpr const char* RECORDER_OUTPUT_LOCAL_TIMESTAMP_TAG("local-timestamp");
 constexpr const char* RECORDER_OUTPUT_SAFETY_MARGIN_TAG("safety-margin");
 
+// Event window spill related tags
+constexpr const char* RECORDER_EVENT_WINDOW_SPILL_TAG("event-window-spill");
+constexpr const char* RECORDER_EVENT_WINDOW_SPILL_ENABLE_TAG("enable");
+constexpr const char* RECORDER_EVENT_WINDOW_SPILL_PATH_TAG("path");
+constexpr const char* RECORDER_EVENT_WINDOW_SPILL_SIZE_TAG("size");
+constexpr const char* RECORDER_EVENT_WINDOW_SPILL_MEMORY_THRESHOLD_TAG("memory-threshold");
+
 ///////////////
 // Mcap tags //
 ///////////////
@@ -60,6 +70,14 @@ constexpr const char* RECORDER_OUTPUT_SAFETY_MARGIN_TAG("safety-margin");
 constexpr const char* RECORDER_MCAP_TAG("mcap");
 constexpr const char* RECORDER_MCAP_ENABLE_TAG("enable");
 constexpr const char* RECORDER_MCAP_LOG_PUBLISH_TIME_TAG("log-publish-time");
+constexpr const char* RECORDER_MCAP_PREPARE_NEXT_FILE_TAG("prepare-next-file");
+constexpr const char* RECORDER_MCAP_IO_BACKEND_TAG("io-backend");
+constexpr const char* RECORDER_MCAP_IO_BACKEND_BUFFERED_TAG("buffered");
+constexpr const char* RECORDER_MCAP_IO_BACKEND_DIRECT_TAG("direct");
+constexpr const char* RECORDER_MCAP_CHECKPOINT_PERIOD_TAG("checkpoint-period");
+constexpr const char* RECORDER_MCAP_TOPIC_GROUPS_TAG("topic-groups");
+constexpr const char* RECORDER_MCAP_TOPIC_GROUPS_NAME_TAG("name");
+constexpr const char* RECORDER_MCAP_TOPIC_GROUPS_TOPICS_TAG("topics");
 
 // Compression settings
 constexpr const char* RECORDER_MCAP_COMPRESSION_SETTINGS_TAG("compression");
@@ -74,6 +92,12 @@ constexpr const char* RECORDER_MCAP_COMPRESSION_SETTINGS_LEVEL_DEFAULT_TAG("defa
 constexpr const char* RECORDER_MCAP_COMPRESSION_SETTINGS_LEVEL_SLOW_TAG("slow");
 constexpr const char* RECORDER_MCAP_COMPRESSION_SETTINGS_LEVEL_SLOWEST_TAG("slowest");
 constexpr const char* RECORDER_MCAP_COMPRESSION_SETTINGS_FORCE_TAG("force");
+constexpr const char* RECORDER_MCAP_COMPRESSION_SETTINGS_THREADS_TAG("threads");
+constexpr const char* RECORDER_MCAP_COMPRESSION_SETTINGS_ADAPTIVE_TAG("adaptive");
+constexpr const char* RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_TAG("dictionary");
+constexpr const char* RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_ENABLE_TAG("enable");
+constexpr const char* RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_SAMPLES_TAG("samples");
+constexpr const char* RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_MAX_SIZE_TAG("max-size");
 
 
 //////////////
@@ -86,6 +110,9 @@ constexpr const char* RECORDER_SQL_DATA_FORMAT_TAG("data-format");
 constexpr const char* RECORDER_SQL_DATA_FORMAT_CDR_TAG("cdr");
 constexpr const char* RECORDER_SQL_DATA_FORMAT_JSON_TAG("json");
 constexpr const char* RECORDER_SQL_DATA_FORMAT_BOTH_TAG("both");
+constexpr const char* RECORDER_SQL_KEY_CACHE_TAG("key-cache");
+constexpr const char* RECORDER_SQL_KEY_CACHE_MAX_ENTRIES_TAG("max-entries");
+constexpr const char* RECORDER_SQL_KEY_CACHE_MAX_MEMORY_TAG("max-memory");
 
 
 //////////////////////////
@@ -96,6 +123,7 @@ constexpr const char* RECORDER_RESOURCE_LIMITS_LOG_ROTATION_TAG("log-rotation");
 constexpr const char* RECORDER_RESOURCE_LIMITS_MAX_SIZE_TAG("max-size");
 constexpr const char* RECORDER_RESOURCE_LIMITS_MAX_FILE_SIZE_TAG("max-file-size");
 constexpr const char* RECORDER_RESOURCE_LIMITS_SIZE_TOLERANCE_TAG("size-tolerance");
+constexpr const char* RECORDER_RESOURCE_LIMITS_MAX_FILE_DURATION_TAG("max-file-duration");
 
 ////////////////////////////////////
 // Remote controller related tags //
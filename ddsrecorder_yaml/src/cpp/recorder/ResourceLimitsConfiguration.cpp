@@ -20,6 +20,7 @@
 #include <string>
 #include <iostream>
 
+#include <cpp_utils/exception/ConfigurationException.hpp>
 #include <cpp_utils/Log.hpp>
 
 #include <ddspipe_yaml/yaml_configuration_tags.hpp>
@@ -72,6 +73,23 @@ ResourceLimitsConfiguration::ResourceLimitsConfiguration(
     }
     // TODO: In SQL configuration, max file size is not used. It is only used in MCAP configuration. This is a temporary solution.
 
+    /////
+    // Get optional max file duration
+    if (YamlReader::is_tag_present(yml, RECORDER_RESOURCE_LIMITS_MAX_FILE_DURATION_TAG))
+    {
+        const auto max_file_duration = YamlReader::get<int>(yml, RECORDER_RESOURCE_LIMITS_MAX_FILE_DURATION_TAG,
+                        version);
+
+        if (max_file_duration < 0)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" <<
+                          RECORDER_RESOURCE_LIMITS_MAX_FILE_DURATION_TAG << "> : value cannot be negative.");
+        }
+
+        resource_limits_struct.max_file_duration_ = static_cast<std::uint32_t>(max_file_duration);
+    }
+
     /////
     // Get optional size tolerance
     if (YamlReader::is_tag_present(yml, RECORDER_RESOURCE_LIMITS_SIZE_TOLERANCE_TAG))
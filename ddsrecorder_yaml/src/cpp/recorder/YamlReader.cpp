@@ -14,6 +14,9 @@
 
 #include <mcap/mcap.hpp>
 
+#include <cpp_utils/exception/ConfigurationException.hpp>
+#include <cpp_utils/Formatter.hpp>
+
 #include <ddspipe_yaml/YamlReader.hpp>
 
 #include <ddsrecorder_yaml/recorder/yaml_configuration_tags.hpp>
@@ -65,6 +68,22 @@ YamlReader::get<mcap::McapWriterOptions>(
                         version);
     }
 
+    // Parse optional compression threads
+    if (YamlReader::is_tag_present(yml, RECORDER_MCAP_COMPRESSION_SETTINGS_THREADS_TAG))
+    {
+        const auto threads = YamlReader::get<int>(yml, RECORDER_MCAP_COMPRESSION_SETTINGS_THREADS_TAG, version);
+
+        if (threads < 0)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <"
+                                         << RECORDER_MCAP_COMPRESSION_SETTINGS_THREADS_TAG
+                                         << "> : value cannot be negative.");
+        }
+
+        mcap_writer_options.compressionThreads = static_cast<uint32_t>(threads);
+    }
+
     return mcap_writer_options;
 }
 
@@ -18,6 +18,8 @@
  */
 
 #include <cstdint>
+#include <regex>
+#include <set>
 #include <string>
 
 #include <cpp_utils/Log.hpp>
@@ -108,15 +110,42 @@ bool RecorderConfiguration::is_valid(
         return false;
     }
 
+    if (mcap_enabled)
+    {
+        for (const auto& topic_group : mcap_topic_groups)
+        {
+            ResourceLimitsConfiguration topic_group_resource_limits;
+            topic_group_resource_limits.resource_limits_struct = topic_group.resource_limits;
+
+            // NOTE: The groups without a max size share the MCAP one
+            if (topic_group_resource_limits.resource_limits_struct.max_size_ == 0)
+            {
+                topic_group_resource_limits.resource_limits_struct.max_size_ =
+                        mcap_resource_limits.resource_limits_struct.max_size_;
+            }
+
+            if (!topic_group_resource_limits.are_limits_valid(error_msg,
+                    output_safety_margin > OUTPUT_SAFETY_MARGIN_MIN))
+            {
+                error_msg << " (in topic group " << topic_group.name << ")";
+                return false;
+            }
+        }
+    }
+
+    // NOTE: SQL records everything in just one file, unless it is split in shards by a max file duration
     if (sql_enabled &&
+            sql_resource_limits.resource_limits_struct.max_file_duration_ == 0 &&
             sql_resource_limits.resource_limits_struct.max_file_size_ !=
             sql_resource_limits.resource_limits_struct.max_size_)
     {
         EPROSIMA_LOG_ERROR(DDSRECORDER,
-                "SQL max file size is not used as SQL records everything in just one file. It is only used in MCAP configuration.");
+                "SQL max file size is not used as SQL records everything in just one file. It is only used in MCAP configuration "
+                "or with a SQL max file duration.");
         error_msg
             <<
-            "SQL max file size is not used as SQL records everything in just one file. It is only used in MCAP configuration.";
+            "SQL max file size is not used as SQL records everything in just one file. It is only used in MCAP configuration "
+            "or with a SQL max file duration.";
         return false;
     }
 
@@ -300,6 +329,16 @@ void RecorderConfiguration::load_recorder_configuration_(
         }
     }
 
+    /////
+    // Get optional max buffer memory
+    if (YamlReader::is_tag_present(yml, RECORDER_MAX_BUFFER_MEMORY_TAG))
+    {
+        const auto& max_buffer_memory_str = YamlReader::get<std::string>(yml,
+                        RECORDER_MAX_BUFFER_MEMORY_TAG,
+                        version);
+        max_buffer_memory = eprosima::utils::to_bytes(max_buffer_memory_str);
+    }
+
     /////
     // Get optional only_with_type
     if (YamlReader::is_tag_present(yml, RECORDER_ONLY_WITH_TYPE_TAG))
@@ -321,6 +360,20 @@ void RecorderConfiguration::load_recorder_configuration_(
         ros2_types = YamlReader::get<bool>(yml, RECORDER_ROS2_TYPES_TAG, version);
     }
 
+    /////
+    // Get optional async_write
+    if (YamlReader::is_tag_present(yml, RECORDER_ASYNC_WRITE_TAG))
+    {
+        async_write = YamlReader::get<bool>(yml, RECORDER_ASYNC_WRITE_TAG, version);
+    }
+
+    /////
+    // Get optional async_write_queue_size
+    if (YamlReader::is_tag_present(yml, RECORDER_ASYNC_WRITE_QUEUE_SIZE_TAG))
+    {
+        async_write_queue_size = YamlReader::get_positive_int(yml, RECORDER_ASYNC_WRITE_QUEUE_SIZE_TAG);
+    }
+
     /////
     // Get optional output configuration
     if (YamlReader::is_tag_present(yml, RECORDER_OUTPUT_TAG))
@@ -329,6 +382,14 @@ void RecorderConfiguration::load_recorder_configuration_(
         load_recorder_output_configuration_(output_yml, version);
     }
 
+    /////
+    // Get optional event window spill configuration
+    if (YamlReader::is_tag_present(yml, RECORDER_EVENT_WINDOW_SPILL_TAG))
+    {
+        const auto spill_yml = YamlReader::get_value_in_tag(yml, RECORDER_EVENT_WINDOW_SPILL_TAG);
+        load_recorder_event_window_spill_configuration_(spill_yml, version);
+    }
+
     /////
     // Get optional sql configuration
     if (YamlReader::is_tag_present(yml, RECORDER_SQL_TAG))
@@ -404,6 +465,50 @@ void RecorderConfiguration::load_recorder_output_configuration_(
     }
 }
 
+void RecorderConfiguration::load_recorder_event_window_spill_configuration_(
+        const Yaml& yml,
+        const YamlReaderVersion& version)
+{
+    /////
+    // Get optional enable
+    if (YamlReader::is_tag_present(yml, RECORDER_EVENT_WINDOW_SPILL_ENABLE_TAG))
+    {
+        event_window_spill_enabled = YamlReader::get<bool>(yml, RECORDER_EVENT_WINDOW_SPILL_ENABLE_TAG, version);
+    }
+
+    /////
+    // Get optional path
+    if (YamlReader::is_tag_present(yml, RECORDER_EVENT_WINDOW_SPILL_PATH_TAG))
+    {
+        event_window_spill_path = YamlReader::get<std::string>(yml, RECORDER_EVENT_WINDOW_SPILL_PATH_TAG, version);
+    }
+
+    /////
+    // Get optional size
+    if (YamlReader::is_tag_present(yml, RECORDER_EVENT_WINDOW_SPILL_SIZE_TAG))
+    {
+        const auto& size_str = YamlReader::get<std::string>(yml, RECORDER_EVENT_WINDOW_SPILL_SIZE_TAG, version);
+        event_window_spill_size = eprosima::utils::to_bytes(size_str);
+
+        if (event_window_spill_size == 0)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << RECORDER_EVENT_WINDOW_SPILL_SIZE_TAG
+                                         << "> : value must be greater than 0.");
+        }
+    }
+
+    /////
+    // Get optional memory threshold
+    if (YamlReader::is_tag_present(yml, RECORDER_EVENT_WINDOW_SPILL_MEMORY_THRESHOLD_TAG))
+    {
+        const auto& memory_threshold_str = YamlReader::get<std::string>(yml,
+                        RECORDER_EVENT_WINDOW_SPILL_MEMORY_THRESHOLD_TAG,
+                        version);
+        event_window_spill_memory_threshold = eprosima::utils::to_bytes(memory_threshold_str);
+    }
+}
+
 void RecorderConfiguration::load_recorder_mcap_configuration_(
         const Yaml& yml,
         const YamlReaderVersion& version)
@@ -424,12 +529,71 @@ void RecorderConfiguration::load_recorder_mcap_configuration_(
         mcap_log_publish_time = YamlReader::get<bool>(yml, RECORDER_MCAP_LOG_PUBLISH_TIME_TAG, version);
     }
 
+    /////
+    // Get optional percentage of the max file size at which to prepare the next file
+    if (YamlReader::is_tag_present(yml, RECORDER_MCAP_PREPARE_NEXT_FILE_TAG))
+    {
+        const auto prepare_next_file = YamlReader::get<int>(yml, RECORDER_MCAP_PREPARE_NEXT_FILE_TAG, version);
+
+        if (prepare_next_file <= 0 || prepare_next_file > 100)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << RECORDER_MCAP_PREPARE_NEXT_FILE_TAG
+                                         << "> : value must be a percentage between 1 and 100.");
+        }
+
+        mcap_prepare_next_file = static_cast<std::uint32_t>(prepare_next_file);
+    }
+
+    /////
+    // Get optional I/O backend
+    if (YamlReader::is_tag_present(yml, RECORDER_MCAP_IO_BACKEND_TAG))
+    {
+        const auto io_backend_yml = YamlReader::get_value_in_tag(yml, RECORDER_MCAP_IO_BACKEND_TAG);
+        mcap_io_backend = YamlReader::get_enumeration<ddsrecorder::participants::McapIoBackend>(io_backend_yml,
+                        {
+                            {RECORDER_MCAP_IO_BACKEND_BUFFERED_TAG, ddsrecorder::participants::McapIoBackend::buffered},
+                            {RECORDER_MCAP_IO_BACKEND_DIRECT_TAG, ddsrecorder::participants::McapIoBackend::direct}
+                        });
+    }
+
+    /////
+    // Get optional checkpoint period
+    if (YamlReader::is_tag_present(yml, RECORDER_MCAP_CHECKPOINT_PERIOD_TAG))
+    {
+        const auto checkpoint_period = YamlReader::get<int>(yml, RECORDER_MCAP_CHECKPOINT_PERIOD_TAG, version);
+
+        if (checkpoint_period < 0)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << RECORDER_MCAP_CHECKPOINT_PERIOD_TAG
+                                         << "> : value cannot be negative.");
+        }
+
+        mcap_checkpoint_period = static_cast<std::uint32_t>(checkpoint_period);
+    }
+
     /////
     // Get optional compression settings
     if (YamlReader::is_tag_present(yml, RECORDER_MCAP_COMPRESSION_SETTINGS_TAG))
     {
         mcap_writer_options = YamlReader::get<mcap::McapWriterOptions>(yml, RECORDER_MCAP_COMPRESSION_SETTINGS_TAG,
                         version);
+
+        const auto compression_yml = YamlReader::get_value_in_tag(yml, RECORDER_MCAP_COMPRESSION_SETTINGS_TAG);
+
+        if (YamlReader::is_tag_present(compression_yml, RECORDER_MCAP_COMPRESSION_SETTINGS_ADAPTIVE_TAG))
+        {
+            mcap_adaptive_compression = YamlReader::get<bool>(compression_yml,
+                            RECORDER_MCAP_COMPRESSION_SETTINGS_ADAPTIVE_TAG, version);
+        }
+
+        if (YamlReader::is_tag_present(compression_yml, RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_TAG))
+        {
+            const auto dictionary_yml = YamlReader::get_value_in_tag(compression_yml,
+                            RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_TAG);
+            load_recorder_mcap_dictionary_configuration_(dictionary_yml, version);
+        }
     }
 
     /////
@@ -440,6 +604,80 @@ void RecorderConfiguration::load_recorder_mcap_configuration_(
         mcap_resource_limits_enabled = true;
         mcap_resource_limits = ResourceLimitsConfiguration(mcap_resource_limits_yml, version);
     }
+
+    /////
+    // Get optional topic groups
+    // WARNING: Parse the topic groups AFTER the resource limits, as the groups without resource limits take them
+    if (YamlReader::is_tag_present(yml, RECORDER_MCAP_TOPIC_GROUPS_TAG))
+    {
+        const auto topic_groups_yml = YamlReader::get_value_in_tag(yml, RECORDER_MCAP_TOPIC_GROUPS_TAG);
+        load_recorder_mcap_topic_groups_configuration_(topic_groups_yml, version);
+    }
+}
+
+void RecorderConfiguration::load_recorder_mcap_topic_groups_configuration_(
+        const Yaml& yml,
+        const YamlReaderVersion& version)
+{
+    // The name of a group is appended to the name of its files
+    static const std::regex VALID_NAME("[A-Za-z0-9_\\-]+");
+
+    std::set<std::string> names;
+
+    for (const auto& topic_group_yml : yml)
+    {
+        ddsrecorder::participants::McapTopicGroup topic_group;
+
+        /////
+        // Get mandatory name
+        topic_group.name = YamlReader::get<std::string>(topic_group_yml, RECORDER_MCAP_TOPIC_GROUPS_NAME_TAG, version);
+
+        if (!std::regex_match(topic_group.name, VALID_NAME))
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << RECORDER_MCAP_TOPIC_GROUPS_NAME_TAG
+                                         << "> : " << topic_group.name << " is not a valid name (only letters, "
+                                         << "digits, '_' and '-' are allowed).");
+        }
+
+        if (!names.insert(topic_group.name).second)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << RECORDER_MCAP_TOPIC_GROUPS_NAME_TAG
+                                         << "> : topic group " << topic_group.name << " is repeated.");
+        }
+
+        /////
+        // Get mandatory topics regex
+        topic_group.topics = YamlReader::get<std::string>(topic_group_yml, RECORDER_MCAP_TOPIC_GROUPS_TOPICS_TAG,
+                        version);
+
+        try
+        {
+            std::regex topics_regex(topic_group.topics);
+        }
+        catch (const std::regex_error& e)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << RECORDER_MCAP_TOPIC_GROUPS_TOPICS_TAG
+                                         << "> : " << topic_group.topics << " is not a valid regex: " << e.what());
+        }
+
+        /////
+        // Get optional resource limits (the MCAP ones by default, sharing the MCAP max size)
+        topic_group.resource_limits = mcap_resource_limits.resource_limits_struct;
+        topic_group.resource_limits.max_size_ = 0;
+
+        if (YamlReader::is_tag_present(topic_group_yml, RECORDER_RESOURCE_LIMITS_TAG))
+        {
+            const auto resource_limits_yml = YamlReader::get_value_in_tag(topic_group_yml,
+                            RECORDER_RESOURCE_LIMITS_TAG);
+            topic_group.resource_limits =
+                    ResourceLimitsConfiguration(resource_limits_yml, version).resource_limits_struct;
+        }
+
+        mcap_topic_groups.push_back(topic_group);
+    }
 }
 
 void RecorderConfiguration::load_recorder_sql_configuration_(
@@ -468,6 +706,14 @@ void RecorderConfiguration::load_recorder_sql_configuration_(
                         });
     }
 
+    /////
+    // Get optional key cache configuration
+    if (YamlReader::is_tag_present(yml, RECORDER_SQL_KEY_CACHE_TAG))
+    {
+        const auto key_cache_yml = YamlReader::get_value_in_tag(yml, RECORDER_SQL_KEY_CACHE_TAG);
+        load_recorder_sql_key_cache_configuration_(key_cache_yml, version);
+    }
+
     /////
     // Get optional resource limits
     if (YamlReader::is_tag_present(yml, RECORDER_RESOURCE_LIMITS_TAG))
@@ -494,6 +740,84 @@ void RecorderConfiguration::load_recorder_sql_configuration_(
     }
 }
 
+void RecorderConfiguration::load_recorder_mcap_dictionary_configuration_(
+        const Yaml& yml,
+        const YamlReaderVersion& version)
+{
+    /////
+    // Get optional enable
+    if (YamlReader::is_tag_present(yml, RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_ENABLE_TAG))
+    {
+        mcap_dictionary_enabled = YamlReader::get<bool>(yml, RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_ENABLE_TAG,
+                        version);
+    }
+
+    /////
+    // Get optional number of samples
+    if (YamlReader::is_tag_present(yml, RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_SAMPLES_TAG))
+    {
+        const auto samples = YamlReader::get<int>(yml, RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_SAMPLES_TAG,
+                        version);
+
+        if (samples <= 0)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <"
+                                         << RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_SAMPLES_TAG
+                                         << "> : value must be greater than 0.");
+        }
+
+        mcap_dictionary_samples = static_cast<std::uint32_t>(samples);
+    }
+
+    /////
+    // Get optional max size
+    if (YamlReader::is_tag_present(yml, RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_MAX_SIZE_TAG))
+    {
+        const auto& max_size_str = YamlReader::get<std::string>(yml,
+                        RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_MAX_SIZE_TAG, version);
+        mcap_dictionary_max_size = eprosima::utils::to_bytes(max_size_str);
+
+        // NOTE: zstd cannot train dictionaries smaller than 256 bytes
+        if (mcap_dictionary_max_size < 256)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <"
+                                         << RECORDER_MCAP_COMPRESSION_SETTINGS_DICTIONARY_MAX_SIZE_TAG
+                                         << "> : value must be at least 256B.");
+        }
+    }
+}
+
+void RecorderConfiguration::load_recorder_sql_key_cache_configuration_(
+        const Yaml& yml,
+        const YamlReaderVersion& version)
+{
+    /////
+    // Get optional max entries
+    if (YamlReader::is_tag_present(yml, RECORDER_SQL_KEY_CACHE_MAX_ENTRIES_TAG))
+    {
+        const auto max_entries = YamlReader::get<int>(yml, RECORDER_SQL_KEY_CACHE_MAX_ENTRIES_TAG, version);
+
+        if (max_entries < 0)
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Error reading value under tag <" << RECORDER_SQL_KEY_CACHE_MAX_ENTRIES_TAG
+                                         << "> : value cannot be negative.");
+        }
+
+        sql_key_cache_max_entries = static_cast<std::uint64_t>(max_entries);
+    }
+
+    /////
+    // Get optional max memory
+    if (YamlReader::is_tag_present(yml, RECORDER_SQL_KEY_CACHE_MAX_MEMORY_TAG))
+    {
+        const auto& max_memory_str = YamlReader::get<std::string>(yml, RECORDER_SQL_KEY_CACHE_MAX_MEMORY_TAG, version);
+        sql_key_cache_max_memory = eprosima::utils::to_bytes(max_memory_str);
+    }
+}
+
 void RecorderConfiguration::load_controller_configuration_(
         const Yaml& yml,
         const YamlReaderVersion& version)
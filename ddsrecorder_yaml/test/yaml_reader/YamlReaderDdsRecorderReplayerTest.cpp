@@ -17,6 +17,7 @@
 
 #include <cpp_utils/exception/ConfigurationException.hpp>
 #include <cpp_utils/testing/gtest_aux.hpp>
+#include <cpp_utils/utils.hpp>
 #include <gtest/gtest.h>
 
 #include <ddspipe_yaml/YamlReader.hpp>
@@ -86,6 +87,463 @@ TEST(YamlReaderDdsRecorderReplayerTest, recorder_max_pending_samples_below_minus
     ASSERT_THROW(RecorderConfiguration configuration(yml), utils::ConfigurationException);
 }
 
+/**
+ * Check that the asynchronous write options are loaded, and that they are disabled by default.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_async_write)
+{
+    {
+        Yaml yml = YAML::Load("recorder: {}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_FALSE(configuration.async_write);
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  async-write: true
+                  async-write-queue-size: 500
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_TRUE(configuration.async_write);
+        ASSERT_EQ(configuration.async_write_queue_size, 500u);
+    }
+}
+
+/**
+ * Check that 'max-buffer-memory' is parsed as a size string, and that no limit is set by default.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_max_buffer_memory)
+{
+    {
+        Yaml yml = YAML::Load("recorder: {}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.max_buffer_memory, 0u);
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  max-buffer-memory: "1000B"
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.max_buffer_memory, 1000u);
+    }
+}
+
+/**
+ * Check that the event window spill options are loaded, that spilling is disabled by default, and that a spill file
+ * of size 0 is rejected.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_event_window_spill)
+{
+    {
+        Yaml yml = YAML::Load("recorder: {}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_FALSE(configuration.event_window_spill_enabled);
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  event-window-spill:
+                    enable: true
+                    path: "/tmp"
+                    size: "1000B"
+                    memory-threshold: "100B"
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_TRUE(configuration.event_window_spill_enabled);
+        ASSERT_EQ(configuration.event_window_spill_path, "/tmp");
+        ASSERT_EQ(configuration.event_window_spill_size, 1000u);
+        ASSERT_EQ(configuration.event_window_spill_memory_threshold, 100u);
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  event-window-spill:
+                    enable: true
+                    size: "0B"
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        ASSERT_THROW(RecorderConfiguration configuration(yml), utils::ConfigurationException);
+    }
+}
+
+/**
+ * Check that the number of MCAP compression threads is loaded, that chunks are compressed inline by default, and that
+ * a negative number of threads is rejected.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_mcap_compression_threads)
+{
+    {
+        Yaml yml = YAML::Load("recorder: {}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.mcap_writer_options.compressionThreads, 0u);
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  mcap:
+                    enable: true
+                    compression:
+                      algorithm: zstd
+                      threads: 2
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.mcap_writer_options.compressionThreads, 2u);
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  mcap:
+                    enable: true
+                    compression:
+                      threads: -1
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        ASSERT_THROW(RecorderConfiguration configuration(yml), utils::ConfigurationException);
+    }
+}
+
+/**
+ * Check that the adaptive MCAP compression is loaded along with the compression settings, and that it is disabled by
+ * default.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_mcap_adaptive_compression)
+{
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true, compression: {algorithm: zstd}}}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_FALSE(configuration.mcap_adaptive_compression);
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  mcap:
+                    enable: true
+                    compression:
+                      algorithm: zstd
+                      level: slow
+                      adaptive: true
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_TRUE(configuration.mcap_adaptive_compression);
+        ASSERT_EQ(configuration.mcap_writer_options.compression, mcap::Compression::Zstd);
+        ASSERT_EQ(configuration.mcap_writer_options.compressionLevel, mcap::CompressionLevel::Slow);
+    }
+}
+
+/**
+ * Check that the MCAP dictionary compression is loaded along with the compression settings, that it is disabled by
+ * default, and that invalid values are rejected.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_mcap_dictionary)
+{
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true, compression: {algorithm: zstd}}}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_FALSE(configuration.mcap_dictionary_enabled);
+        ASSERT_EQ(configuration.mcap_dictionary_samples, 1000u);
+        ASSERT_EQ(configuration.mcap_dictionary_max_size, ddsrecorder::participants::ZstdDictionary::DEFAULT_MAX_SIZE);
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  mcap:
+                    enable: true
+                    compression:
+                      algorithm: zstd
+                      dictionary:
+                        enable: true
+                        samples: 200
+                        max-size: "8000B"
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_TRUE(configuration.mcap_dictionary_enabled);
+        ASSERT_EQ(configuration.mcap_dictionary_samples, 200u);
+        ASSERT_EQ(configuration.mcap_dictionary_max_size, 8000u);
+    }
+
+    for (const auto& dictionary : {"{samples: 0}", "{max-size: \"100B\"}"})
+    {
+        Yaml yml = YAML::Load(std::string("recorder: {mcap: {enable: true, compression: {dictionary: ") + dictionary +
+                        "}}}");
+
+        ASSERT_THROW(RecorderConfiguration configuration(yml), utils::ConfigurationException);
+    }
+}
+
+/**
+ * Check that the percentage of the MCAP file at which the next one is prepared is loaded, that it is disabled by
+ * default, and that values out of the 1-100 range are rejected.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_mcap_prepare_next_file)
+{
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true}}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.mcap_prepare_next_file, 0u);
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  mcap:
+                    enable: true
+                    prepare-next-file: 80
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.mcap_prepare_next_file, 80u);
+    }
+
+    for (const auto& prepare_next_file : {"0", "101"})
+    {
+        Yaml yml = YAML::Load(std::string("recorder: {mcap: {enable: true, prepare-next-file: ") + prepare_next_file +
+                        "}}");
+
+        ASSERT_THROW(RecorderConfiguration configuration(yml), utils::ConfigurationException);
+    }
+}
+
+/**
+ * Check that the MCAP I/O backend is loaded, that it is buffered by default, and that unknown backends are rejected.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_mcap_io_backend)
+{
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true}}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.mcap_io_backend, ddsrecorder::participants::McapIoBackend::buffered);
+    }
+
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true, io-backend: direct}}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.mcap_io_backend, ddsrecorder::participants::McapIoBackend::direct);
+    }
+
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true, io-backend: io_uring}}");
+
+        ASSERT_THROW(RecorderConfiguration configuration(yml), utils::ConfigurationException);
+    }
+}
+
+/**
+ * Check that the MCAP checkpoint period is loaded, that the checkpoints are disabled by default, and that negative
+ * periods are rejected.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_mcap_checkpoint_period)
+{
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true}}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.mcap_checkpoint_period, 0u);
+    }
+
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true, checkpoint-period: 5}}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.mcap_checkpoint_period, 5u);
+    }
+
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true, checkpoint-period: -1}}");
+
+        ASSERT_THROW(RecorderConfiguration configuration(yml), utils::ConfigurationException);
+    }
+}
+
+/**
+ * Check that the MCAP max file duration is loaded, that the files are not split by duration by default, and that
+ * negative durations are rejected.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_mcap_max_file_duration)
+{
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true, resource-limits: {max-size: 10MB}}}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.mcap_resource_limits.resource_limits_struct.max_file_duration_, 0u);
+    }
+
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true, resource-limits: {max-file-duration: 60}}}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.mcap_resource_limits.resource_limits_struct.max_file_duration_, 60u);
+    }
+
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true, resource-limits: {max-file-duration: -1}}}");
+
+        ASSERT_THROW(RecorderConfiguration configuration(yml), utils::ConfigurationException);
+    }
+}
+
+/**
+ * Check that the SQL max file duration is loaded, and that it allows a 'max-file-size' different from 'max-size'
+ * (the SQL output is split in several files).
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_sql_max_file_duration)
+{
+    const char* yml_str =
+            R"(
+            recorder:
+              sql:
+                enable: true
+                resource-limits:
+                  max-file-size: "10MB"
+                  max-size: "50MB"
+                  max-file-duration: 60
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    RecorderConfiguration configuration(yml);
+
+    const auto& resource_limits = configuration.sql_resource_limits.resource_limits_struct;
+    ASSERT_EQ(resource_limits.max_file_duration_, 60u);
+    ASSERT_NE(resource_limits.max_file_size_, resource_limits.max_size_);
+}
+
+/**
+ * Check that the MCAP topic groups are loaded, that the groups without resource limits take the MCAP ones (sharing the
+ * MCAP max size), and that repeated names and invalid regexes are rejected.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_mcap_topic_groups)
+{
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  mcap:
+                    enable: true
+                    resource-limits:
+                      max-size: "200MB"
+                      max-file-size: "10MB"
+                    topic-groups:
+                      - name: "camera"
+                        topics: "rt/camera/.*"
+                        resource-limits:
+                          max-size: "100MB"
+                          max-file-duration: 30
+                      - name: "diagnostics"
+                        topics: "rt/diagnostics"
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.mcap_topic_groups.size(), 2u);
+
+        const auto& camera = configuration.mcap_topic_groups[0];
+        ASSERT_EQ(camera.name, "camera");
+        ASSERT_EQ(camera.topics, "rt/camera/.*");
+        ASSERT_EQ(camera.resource_limits.max_size_, utils::to_bytes("100MB"));
+        ASSERT_EQ(camera.resource_limits.max_file_duration_, 30u);
+
+        const auto& diagnostics = configuration.mcap_topic_groups[1];
+        ASSERT_EQ(diagnostics.name, "diagnostics");
+        ASSERT_EQ(diagnostics.resource_limits.max_size_, 0u);
+        ASSERT_EQ(diagnostics.resource_limits.max_file_size_,
+                configuration.mcap_resource_limits.resource_limits_struct.max_file_size_);
+    }
+
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true}}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_TRUE(configuration.mcap_topic_groups.empty());
+    }
+
+    {
+        Yaml yml = YAML::Load(
+            "recorder: {mcap: {enable: true, topic-groups: [{name: a, topics: x}, {name: a, topics: y}]}}");
+
+        ASSERT_THROW(RecorderConfiguration configuration(yml), utils::ConfigurationException);
+    }
+
+    {
+        Yaml yml = YAML::Load("recorder: {mcap: {enable: true, topic-groups: [{name: a, topics: \"rt/(camera\"}]}}");
+
+        ASSERT_THROW(RecorderConfiguration configuration(yml), utils::ConfigurationException);
+    }
+}
+
 /**
  * Check that, when only 'max-size' is set for the SQL resource limits (and 'max-file-size' is left
  * unset), 'max-file-size' is copied from 'max-size' (the SQL handler only writes a single file).
@@ -111,6 +569,56 @@ TEST(YamlReaderDdsRecorderReplayerTest, recorder_sql_resource_limits_max_size_co
     ASSERT_NE(configuration.sql_resource_limits.resource_limits_struct.max_size_, 0u);
 }
 
+/**
+ * Check that the SQL key cache limits are loaded, that they default to a bounded number of entries, and that a
+ * negative number of entries is rejected.
+ */
+TEST(YamlReaderDdsRecorderReplayerTest, recorder_sql_key_cache)
+{
+    {
+        Yaml yml = YAML::Load("recorder: {sql: {enable: true}}");
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.sql_key_cache_max_entries, ddsrecorder::participants::KeyCache::DEFAULT_MAX_ENTRIES);
+        ASSERT_EQ(configuration.sql_key_cache_max_memory, 0u);
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  sql:
+                    enable: true
+                    key-cache:
+                      max-entries: 10
+                      max-memory: "1000B"
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        RecorderConfiguration configuration(yml);
+
+        ASSERT_EQ(configuration.sql_key_cache_max_entries, 10u);
+        ASSERT_EQ(configuration.sql_key_cache_max_memory, 1000u);
+    }
+
+    {
+        const char* yml_str =
+                R"(
+                recorder:
+                  sql:
+                    enable: true
+                    key-cache:
+                      max-entries: -1
+            )";
+
+        Yaml yml = YAML::Load(yml_str);
+
+        ASSERT_THROW(RecorderConfiguration configuration(yml), utils::ConfigurationException);
+    }
+}
+
 /**
  * Check that, when two manual topics share the same name, the last one's filter overwrites the
  * previous one in the resulting content_topic_filter_dict.
@@ -2,9 +2,15 @@
 
 #include "types.hpp"
 #include "visibility.hpp"
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -77,6 +83,15 @@ struct MCAP_PUBLIC McapWriterOptions {
    * Chunks. This option is ignored if `noChunking=true`.
    */
   bool forceCompression = false;
+  /**
+   * @brief Number of background threads compressing Chunks. When zero (the
+   * default), each Chunk is compressed on the thread writing the message that
+   * fills it. Otherwise, full Chunks are handed over to these threads while the
+   * next Chunk keeps filling, and are written to the output in order once
+   * compressed (so the file is identical), with at most this many Chunks in
+   * flight. This option is ignored if `noChunking=true`.
+   */
+  uint32_t compressionThreads = 0;
   /**
    * @brief The recording profile. See
    * <https://github.com/foxglove/mcap/tree/main/docs/specification/profiles>
@@ -127,6 +142,12 @@ public:
    * file.
    */
   virtual void end() = 0;
+  /**
+   * @brief Called when the writer needs the data written so far to reach the
+   * output MCAP file (e.g. to survive a crash of the process). Does nothing by
+   * default.
+   */
+  virtual void flush() {}
   /**
    * @brief Returns the current size of the file in bytes. This must be equal to
    * the sum of all `size` parameters passed to `write()`.
@@ -160,6 +181,7 @@ public:
 
   void handleWrite(const std::byte* data, uint64_t size) override;
   void end() override;
+  void flush() override;
   uint64_t size() const override;
 
 private:
@@ -177,6 +199,7 @@ public:
 
   void handleWrite(const std::byte* data, uint64_t size) override;
   void end() override;
+  void flush() override;
   uint64_t size() const override;
 
 private:
@@ -331,6 +354,16 @@ public:
    */
   void open(std::ostream& stream, const McapWriterOptions& options);
 
+  /**
+   * @brief Open a new MCAP file for writing and write the header, taking
+   * ownership of the output.
+   *
+   * @param writer An implementation of the IWritable interface, destroyed when
+   *   the writer is closed or terminated.
+   * @param options Options for MCAP writing. `profile` is required.
+   */
+  void open(std::unique_ptr<IWritable> writer, const McapWriterOptions& options);
+
   /**
    * @brief Write the MCAP footer, flush pending writes to the output stream,
    * and reset internal state.
@@ -406,6 +439,33 @@ public:
    */
   void closeLastChunk();
 
+  /**
+   * @brief Change the compression algorithm and level of the next Chunks.
+   * The Chunk in progress (if not empty) and the Chunks in flight keep their
+   * own, as each Chunk records the compression it was written with. This
+   * option is ignored if `noChunking=true`.
+   */
+  void setCompression(Compression compression, CompressionLevel compressionLevel);
+
+  /**
+   * @brief Returns the number of full Chunks handed over to the compression
+   * threads and not written yet (always zero if `compressionThreads=0`).
+   */
+  size_t pendingChunkCount() const;
+
+  /**
+   * @brief Returns an upper bound of the bytes written to this writer but not
+   * to the data sink yet: the Chunk in progress and the Chunks in flight, along
+   * with their Message Index records, as if they were not compressed. Always
+   * zero if `noChunking=true`.
+   */
+  uint64_t bufferedSize() const;
+
+  /**
+   * @brief Returns the time spent compressing the last Chunk written.
+   */
+  std::chrono::nanoseconds lastChunkCompressionTime() const;
+
   // The following static methods are used for serialization of records and
   // primitives to an output stream. They are not intended to be used directly
   // unless you are implementing a lower level writer or tests
@@ -444,9 +504,8 @@ private:
   IWritable* output_ = nullptr;
   std::unique_ptr<FileWriter> fileOutput_;
   std::unique_ptr<StreamWriter> streamOutput_;
-  std::unique_ptr<BufferWriter> uncompressedChunk_;
-  std::unique_ptr<LZ4Writer> lz4Chunk_;
-  std::unique_ptr<ZStdWriter> zstdChunk_;
+  std::unique_ptr<IWritable> ownedOutput_;
+  std::unique_ptr<IChunkWriter> chunkWriter_;
   std::vector<Schema> schemas_;
   std::vector<Channel> channels_;
   std::vector<AttachmentIndex> attachmentIndex_;
@@ -460,10 +519,58 @@ private:
   Compression compression_ = Compression::None;
   uint64_t uncompressedSize_ = 0;
   bool opened_ = false;
+  // Compression of the Chunk in progress, and generation of the compression
+  // settings it was created with (bumped on every setCompression)
+  Compression chunkWriterCompression_ = Compression::None;
+  uint64_t chunkWriterGeneration_ = 0;
+  uint64_t compressionGeneration_ = 0;
+  std::chrono::nanoseconds lastChunkCompressionTime_{0};
+
+  /**
+   * @brief A full Chunk handed over to the compression threads, along with
+   * the state needed to write it once compressed.
+   */
+  struct PendingChunk {
+    std::unique_ptr<IChunkWriter> chunkData;
+    uint64_t uncompressedSize = 0;
+    Timestamp startTime = MaxTime;
+    Timestamp endTime = 0;
+    std::unordered_map<ChannelId, MessageIndex> messageIndex;
+    Compression algorithm = Compression::None;
+    uint64_t generation = 0;
+    Compression compression = Compression::None;
+    std::chrono::nanoseconds compressionTime{0};
+    bool compressed = false;
+  };
+
+  // Chunks in flight, in output order. Only accessed by the writing thread
+  std::deque<std::shared_ptr<PendingChunk>> pendingChunks_;
+  // Empty chunk writers ready to be filled. Only accessed by the writing thread
+  std::vector<std::unique_ptr<IChunkWriter>> freeChunkWriters_;
+  // Chunks waiting for a compression thread
+  std::deque<std::shared_ptr<PendingChunk>> compressionQueue_;
+  std::mutex compressionMutex_;
+  std::condition_variable chunkSubmitted_;
+  std::condition_variable chunkCompressed_;
+  bool stopCompression_ = false;
+  std::vector<std::thread> compressionThreads_;
 
   IWritable& getOutput();
   IChunkWriter* getChunkWriter();
+  std::unique_ptr<IChunkWriter> makeChunkWriter() const;
+  void renewChunkWriter();
+  bool isPipelined() const;
   void writeChunk(IWritable& output, IChunkWriter& chunkData);
+  void writeChunkRecords(IWritable& output, IChunkWriter& chunkData, Compression compression,
+                         uint64_t uncompressedSize, Timestamp startTime, Timestamp endTime,
+                         std::unordered_map<ChannelId, MessageIndex>& messageIndex);
+  void submitChunk();
+  void writeCompressedChunks(size_t maxPendingChunks);
+  void compressChunks();
+  void stopCompressionThreads();
+
+  static Compression compressChunk(IChunkWriter& chunkData, uint64_t uncompressedSize,
+                                   Compression compression, bool forceCompression);
 };
 
 }  // namespace mcap
@@ -65,6 +65,12 @@ void FileWriter::end() {
   size_ = 0;
 }
 
+void FileWriter::flush() {
+  if (file_) {
+    std::fflush(file_);
+  }
+}
+
 uint64_t FileWriter::size() const {
   return size_;
 }
@@ -84,6 +90,10 @@ void StreamWriter::end() {
   stream_.flush();
 }
 
+void StreamWriter::flush() {
+  stream_.flush();
+}
+
 uint64_t StreamWriter::size() const {
   return size_;
 }
@@ -290,23 +300,12 @@ void McapWriter::open(IWritable& writer, const McapWriterOptions& options) {
   opened_ = true;
   chunkSize_ = options.noChunking ? 0 : options.chunkSize;
   compression_ = chunkSize_ > 0 ? options.compression : Compression::None;
-  switch (compression_) {
-    case Compression::None:
-    default:
-      uncompressedChunk_ = std::make_unique<BufferWriter>();
-      break;
-    case Compression::Lz4:
-      lz4Chunk_ = std::make_unique<LZ4Writer>(options.compressionLevel, chunkSize_);
-      break;
-    case Compression::Zstd:
-      zstdChunk_ = std::make_unique<ZStdWriter>(options.compressionLevel, chunkSize_);
-      break;
-  }
-  auto* chunkWriter = getChunkWriter();
-  if (chunkWriter) {
-    chunkWriter->crcEnabled = !options.noChunkCRC;
-    if (chunkWriter->crcEnabled) {
-      chunkWriter->resetCrc();
+  lastChunkCompressionTime_ = std::chrono::nanoseconds{0};
+  renewChunkWriter();
+  if (isPipelined() && compressionThreads_.empty()) {
+    stopCompression_ = false;
+    for (uint32_t i = 0; i < options.compressionThreads; ++i) {
+      compressionThreads_.emplace_back(&McapWriter::compressChunks, this);
     }
   }
   writer.crcEnabled = options.enableDataCRC;
@@ -331,13 +330,24 @@ void McapWriter::open(std::ostream& stream, const McapWriterOptions& options) {
   open(*streamOutput_, options);
 }
 
+void McapWriter::open(std::unique_ptr<IWritable> writer, const McapWriterOptions& options) {
+  ownedOutput_ = std::move(writer);
+  open(*ownedOutput_, options);
+}
+
 void McapWriter::closeLastChunk() {
   if (!opened_ || !output_) {
     return;
   }
   auto& fileOutput = *output_;
   auto* chunkWriter = getChunkWriter();
-  if (chunkWriter && !chunkWriter->empty()) {
+  if (isPipelined()) {
+    if (chunkWriter && !chunkWriter->empty()) {
+      submitChunk();
+    }
+    // Wait for every Chunk in flight to be compressed and written
+    writeCompressedChunks(0);
+  } else if (chunkWriter && !chunkWriter->empty()) {
     writeChunk(fileOutput, *chunkWriter);
   }
 }
@@ -453,11 +463,15 @@ void McapWriter::close() {
 }
 
 void McapWriter::terminate() {
+  stopCompressionThreads();
+  pendingChunks_.clear();
+  freeChunkWriters_.clear();
+
   output_ = nullptr;
   fileOutput_.reset();
   streamOutput_.reset();
-  uncompressedChunk_.reset();
-  zstdChunk_.reset();
+  ownedOutput_.reset();
+  chunkWriter_.reset();
 
   channels_.clear();
   schemas_.clear();
@@ -557,8 +571,12 @@ Status McapWriter::write(const Message& message) {
 
     // Check if the current chunk is ready to close
     if (uncompressedSize_ >= chunkSize_) {
-      auto& fileOutput = *output_;
-      writeChunk(fileOutput, *chunkWriter);
+      if (isPipelined()) {
+        submitChunk();
+      } else {
+        auto& fileOutput = *output_;
+        writeChunk(fileOutput, *chunkWriter);
+      }
     }
   }
 
@@ -571,11 +589,8 @@ Status McapWriter::write(Attachment& attachment) {
   }
   auto& fileOutput = *output_;
 
-  // Check if we have an open chunk that needs to be closed
-  auto* chunkWriter = getChunkWriter();
-  if (chunkWriter && !chunkWriter->empty()) {
-    writeChunk(fileOutput, *chunkWriter);
-  }
+  // Check if we have an open chunk (or chunks in flight) that needs to be closed
+  closeLastChunk();
 
   if (!options_.noAttachmentCRC) {
     // Calculate the CRC32 of the attachment
@@ -619,11 +634,8 @@ Status McapWriter::write(const Metadata& metadata) {
   }
   auto& fileOutput = *output_;
 
-  // Check if we have an open chunk that needs to be closed
-  auto* chunkWriter = getChunkWriter();
-  if (chunkWriter && !chunkWriter->empty()) {
-    writeChunk(fileOutput, *chunkWriter);
-  }
+  // Check if we have an open chunk (or chunks in flight) that needs to be closed
+  closeLastChunk();
 
   const uint64_t fileOffset = fileOutput.size();
 
@@ -641,6 +653,66 @@ Status McapWriter::write(const Metadata& metadata) {
   return StatusCode::Success;
 }
 
+void McapWriter::setCompression(Compression compression, CompressionLevel compressionLevel) {
+  if (chunkSize_ == 0) {
+    return;
+  }
+  if (compression == compression_ && compressionLevel == options_.compressionLevel) {
+    return;
+  }
+
+  compression_ = compression;
+  options_.compression = compression;
+  options_.compressionLevel = compressionLevel;
+  ++compressionGeneration_;
+
+  // The recycled chunk writers use the previous settings
+  freeChunkWriters_.clear();
+
+  if (chunkWriter_ && chunkWriter_->empty()) {
+    renewChunkWriter();
+  }
+}
+
+size_t McapWriter::pendingChunkCount() const {
+  return pendingChunks_.size();
+}
+
+uint64_t McapWriter::bufferedSize() const {
+  // Size of a Chunk record around its records, and of a Message Index record
+  // around its entries (see the corresponding write() methods)
+  constexpr uint64_t ChunkRecordOverhead = 9 + 8 + 8 + 8 + 4 + 4 + 4 + 8;
+  constexpr uint64_t MessageIndexRecordOverhead = 9 + 2 + 4;
+  constexpr uint64_t MessageIndexEntrySize = 16;
+
+  const auto chunkSize = [&](uint64_t uncompressedSize,
+                             const std::unordered_map<ChannelId, MessageIndex>& messageIndex) {
+    if (uncompressedSize == 0) {
+      return uint64_t(0);
+    }
+    // Compressed data may be slightly larger than uncompressed data
+    uint64_t size = ChunkRecordOverhead + uncompressedSize + uncompressedSize / 128 + 64;
+    for (const auto& [_, channelMessageIndex] : messageIndex) {
+      size += MessageIndexRecordOverhead + channelMessageIndex.records.size() * MessageIndexEntrySize;
+    }
+    return size;
+  };
+
+  if (chunkSize_ == 0) {
+    return 0;
+  }
+
+  uint64_t size = chunkSize(uncompressedSize_, currentMessageIndex_);
+  for (const auto& pendingChunk : pendingChunks_) {
+    size += chunkSize(pendingChunk->uncompressedSize, pendingChunk->messageIndex);
+  }
+  return size;
+}
+
+std::chrono::nanoseconds McapWriter::lastChunkCompressionTime() const {
+  return lastChunkCompressionTime_;
+}
+
 const Statistics& McapWriter::statistics() const {
   return statistics_;
 }
@@ -655,65 +727,112 @@ IWritable& McapWriter::getOutput() {
   if (chunkSize_ == 0) {
     return *output_;
   }
-  switch (compression_) {
-    default:
-    case Compression::None:
-      return *uncompressedChunk_;
-    case Compression::Zstd:
-      return *zstdChunk_;
-    case Compression::Lz4:
-      return *lz4Chunk_;
-  }
+  return *chunkWriter_;
 }
 
 IChunkWriter* McapWriter::getChunkWriter() {
   if (chunkSize_ == 0) {
     return nullptr;
   }
+  return chunkWriter_.get();
+}
 
+std::unique_ptr<IChunkWriter> McapWriter::makeChunkWriter() const {
+  std::unique_ptr<IChunkWriter> chunkWriter;
   switch (compression_) {
     case Compression::None:
     default:
-      return uncompressedChunk_.get();
+      chunkWriter = std::make_unique<BufferWriter>();
+      break;
     case Compression::Lz4:
-      return lz4Chunk_.get();
+      chunkWriter = std::make_unique<LZ4Writer>(options_.compressionLevel, chunkSize_);
+      break;
     case Compression::Zstd:
-      return zstdChunk_.get();
+      chunkWriter = std::make_unique<ZStdWriter>(options_.compressionLevel, chunkSize_);
+      break;
   }
+  chunkWriter->crcEnabled = !options_.noChunkCRC;
+  chunkWriter->resetCrc();
+  return chunkWriter;
+}
+
+void McapWriter::renewChunkWriter() {
+  if (freeChunkWriters_.empty()) {
+    chunkWriter_ = makeChunkWriter();
+  } else {
+    chunkWriter_ = std::move(freeChunkWriters_.back());
+    freeChunkWriters_.pop_back();
+  }
+  chunkWriterCompression_ = compression_;
+  chunkWriterGeneration_ = compressionGeneration_;
+}
+
+bool McapWriter::isPipelined() const {
+  return chunkSize_ > 0 && options_.compressionThreads > 0;
 }
 
 void McapWriter::writeChunk(IWritable& output, IChunkWriter& chunkData) {
+  const auto compressionStart = std::chrono::steady_clock::now();
+  const Compression compression =
+    compressChunk(chunkData, uncompressedSize_, chunkWriterCompression_, options_.forceCompression);
+  lastChunkCompressionTime_ = std::chrono::steady_clock::now() - compressionStart;
+
+  writeChunkRecords(output, chunkData, compression, uncompressedSize_, currentChunkStart_,
+                    currentChunkEnd_, currentMessageIndex_);
+
+  // Reset uncompressedSize and start/end times for the next chunk
+  uncompressedSize_ = 0;
+  currentChunkStart_ = MaxTime;
+  currentChunkEnd_ = 0;
+
+  // Update statistics
+  ++statistics_.chunkCount;
+
+  // Reset the chunk writer, or replace it if the compression settings changed
+  chunkData.clear();
+  if (chunkWriterGeneration_ != compressionGeneration_) {
+    renewChunkWriter();
+  }
+}
+
+Compression McapWriter::compressChunk(IChunkWriter& chunkData, uint64_t uncompressedSize,
+                                      Compression compression, bool forceCompression) {
   // Both LZ4 and ZSTD recommend ~1KB as the minimum size for compressed data
   constexpr uint64_t MIN_COMPRESSION_SIZE = 1024;
   // Throw away any compression results that save less than 2% of the original size
   constexpr double MIN_COMPRESSION_RATIO = 1.02;
 
-  Compression compression = Compression::None;
-  const uint64_t uncompressedSize = uncompressedSize_;
-  uint64_t compressedSize = uncompressedSize;
-  const std::byte* compressedData = chunkData.data();
-
-  if (options_.forceCompression || uncompressedSize >= MIN_COMPRESSION_SIZE) {
-    // Flush any in-progress compression stream
-    chunkData.end();
-
-    // Only use the compressed data if it is materially smaller than the
-    // uncompressed data
-    const double compressionRatio = double(uncompressedSize) / double(chunkData.compressedSize());
-    if (options_.forceCompression || compressionRatio >= MIN_COMPRESSION_RATIO) {
-      compression = compression_;
-      compressedSize = chunkData.compressedSize();
-      compressedData = chunkData.compressedData();
-    }
+  if (!forceCompression && uncompressedSize < MIN_COMPRESSION_SIZE) {
+    return Compression::None;
   }
 
+  // Flush any in-progress compression stream
+  chunkData.end();
+
+  // Only use the compressed data if it is materially smaller than the
+  // uncompressed data
+  const double compressionRatio = double(uncompressedSize) / double(chunkData.compressedSize());
+  if (forceCompression || compressionRatio >= MIN_COMPRESSION_RATIO) {
+    return compression;
+  }
+  return Compression::None;
+}
+
+void McapWriter::writeChunkRecords(IWritable& output, IChunkWriter& chunkData,
+                                   Compression compression, uint64_t uncompressedSize,
+                                   Timestamp startTime, Timestamp endTime,
+                                   std::unordered_map<ChannelId, MessageIndex>& messageIndex) {
+  const bool isCompressed = compression != Compression::None;
+  const uint64_t compressedSize = isCompressed ? chunkData.compressedSize() : uncompressedSize;
+  const std::byte* compressedData = isCompressed ? chunkData.compressedData() : chunkData.data();
+
   const auto compressionStr = internal::CompressionString(compression);
   const uint32_t uncompressedCrc = chunkData.crc();
 
   // Write the chunk
   const uint64_t chunkStartOffset = output.size();
-  write(output, Chunk{currentChunkStart_, currentChunkEnd_, uncompressedSize, uncompressedCrc,
-                      compressionStr, compressedSize, compressedData});
+  write(output, Chunk{startTime, endTime, uncompressedSize, uncompressedCrc, compressionStr,
+                      compressedSize, compressedData});
 
   const uint64_t chunkLength = output.size() - chunkStartOffset;
 
@@ -724,18 +843,18 @@ void McapWriter::writeChunk(IWritable& output, IChunkWriter& chunkData) {
     const uint64_t messageIndexOffset = output.size();
     if (!options_.noMessageIndex) {
       // Write the message index records
-      for (const auto& [channelId, messageIndex] : currentMessageIndex_) {
+      for (const auto& [channelId, channelMessageIndex] : messageIndex) {
         chunkIndexRecord.messageIndexOffsets.emplace(channelId, output.size());
-        write(output, messageIndex);
+        write(output, channelMessageIndex);
       }
-      currentMessageIndex_.clear();
+      messageIndex.clear();
     }
     const uint64_t messageIndexLength = output.size() - messageIndexOffset;
 
     // Fill in the newly created chunk index record. This will be written into
     // the summary section when close() is called
-    chunkIndexRecord.messageStartTime = currentChunkStart_;
-    chunkIndexRecord.messageEndTime = currentChunkEnd_;
+    chunkIndexRecord.messageStartTime = startTime;
+    chunkIndexRecord.messageEndTime = endTime;
     chunkIndexRecord.chunkStartOffset = chunkStartOffset;
     chunkIndexRecord.chunkLength = chunkLength;
     chunkIndexRecord.messageIndexLength = messageIndexLength;
@@ -744,11 +863,24 @@ void McapWriter::writeChunk(IWritable& output, IChunkWriter& chunkData) {
     chunkIndexRecord.uncompressedSize = uncompressedSize;
   } else if (!options_.noMessageIndex) {
     // Write the message index records
-    for (const auto& [channelId, messageIndex] : currentMessageIndex_) {
-      write(output, messageIndex);
+    for (const auto& [channelId, channelMessageIndex] : messageIndex) {
+      write(output, channelMessageIndex);
     }
-    currentMessageIndex_.clear();
+    messageIndex.clear();
   }
+}
+
+void McapWriter::submitChunk() {
+  // Hand the full chunk over to the compression threads, along with its indexes
+  auto pendingChunk = std::make_shared<PendingChunk>();
+  pendingChunk->chunkData = std::move(chunkWriter_);
+  pendingChunk->algorithm = chunkWriterCompression_;
+  pendingChunk->generation = chunkWriterGeneration_;
+  pendingChunk->uncompressedSize = uncompressedSize_;
+  pendingChunk->startTime = currentChunkStart_;
+  pendingChunk->endTime = currentChunkEnd_;
+  pendingChunk->messageIndex = std::move(currentMessageIndex_);
+  currentMessageIndex_.clear();
 
   // Reset uncompressedSize and start/end times for the next chunk
   uncompressedSize_ = 0;
@@ -758,8 +890,93 @@ void McapWriter::writeChunk(IWritable& output, IChunkWriter& chunkData) {
   // Update statistics
   ++statistics_.chunkCount;
 
-  // Reset the chunk writer
-  chunkData.clear();
+  {
+    std::lock_guard<std::mutex> lock(compressionMutex_);
+    compressionQueue_.push_back(pendingChunk);
+  }
+  chunkSubmitted_.notify_one();
+  pendingChunks_.push_back(std::move(pendingChunk));
+
+  // Write the chunks already compressed, waiting for the oldest ones if too
+  // many are in flight
+  writeCompressedChunks(options_.compressionThreads);
+
+  // Keep filling the next chunk while the previous ones are being compressed
+  renewChunkWriter();
+}
+
+void McapWriter::writeCompressedChunks(size_t maxPendingChunks) {
+  // Chunks are written in submission order, so the offsets in the indexes are
+  // the same as if they were compressed inline
+  while (!pendingChunks_.empty()) {
+    auto& pendingChunk = *pendingChunks_.front();
+    {
+      std::unique_lock<std::mutex> lock(compressionMutex_);
+      if (!pendingChunk.compressed) {
+        if (pendingChunks_.size() <= maxPendingChunks) {
+          return;
+        }
+        chunkCompressed_.wait(lock, [&pendingChunk] {
+          return pendingChunk.compressed;
+        });
+      }
+    }
+
+    writeChunkRecords(*output_, *pendingChunk.chunkData, pendingChunk.compression,
+                      pendingChunk.uncompressedSize, pendingChunk.startTime, pendingChunk.endTime,
+                      pendingChunk.messageIndex);
+
+    lastChunkCompressionTime_ = pendingChunk.compressionTime;
+
+    // Recycle the chunk writer, unless the compression settings changed since
+    if (pendingChunk.generation == compressionGeneration_) {
+      pendingChunk.chunkData->clear();
+      freeChunkWriters_.push_back(std::move(pendingChunk.chunkData));
+    }
+    pendingChunks_.pop_front();
+  }
+}
+
+void McapWriter::compressChunks() {
+  while (true) {
+    std::shared_ptr<PendingChunk> pendingChunk;
+    {
+      std::unique_lock<std::mutex> lock(compressionMutex_);
+      chunkSubmitted_.wait(lock, [this] {
+        return stopCompression_ || !compressionQueue_.empty();
+      });
+      if (stopCompression_) {
+        return;
+      }
+      pendingChunk = std::move(compressionQueue_.front());
+      compressionQueue_.pop_front();
+    }
+
+    const auto compressionStart = std::chrono::steady_clock::now();
+    pendingChunk->compression = compressChunk(*pendingChunk->chunkData, pendingChunk->uncompressedSize,
+                                              pendingChunk->algorithm, options_.forceCompression);
+    pendingChunk->compressionTime = std::chrono::steady_clock::now() - compressionStart;
+
+    {
+      std::lock_guard<std::mutex> lock(compressionMutex_);
+      pendingChunk->compressed = true;
+    }
+    chunkCompressed_.notify_all();
+  }
+}
+
+void McapWriter::stopCompressionThreads() {
+  {
+    std::lock_guard<std::mutex> lock(compressionMutex_);
+    stopCompression_ = true;
+    // Discard the chunks not picked up by a compression thread yet
+    compressionQueue_.clear();
+  }
+  chunkSubmitted_.notify_all();
+  for (auto& thread : compressionThreads_) {
+    thread.join();
+  }
+  compressionThreads_.clear();
 }
 
 void McapWriter::writeMagic(IWritable& output) {